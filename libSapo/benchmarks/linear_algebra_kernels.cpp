@@ -0,0 +1,183 @@
+/**
+ * @file linear_algebra_kernels.cpp
+ * @author Alberto Casagrande <acasagrande@units.it>
+ * @brief Micro-benchmark for the linear algebra kernels
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This program measures the average time of the dot product,
+ * axpy, and row elimination kernels on the dimensions that
+ * are typical of Sapo models, i.e., from 3 to 20, for all the
+ * instruction sets supported by the CPU. The column "loop"
+ * reports the time of the plain loops that the kernels replace.
+ * The kernels are called through the run-time dispatch, even on
+ * the arrays shorter than `Kernels::dispatch_threshold` that
+ * `Kernels::dot`, `Kernels::axpy`, and `Kernels::eliminate`
+ * process by inlined scalar code.
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "LinearAlgebraKernels.h"
+
+using namespace LinearAlgebra;
+
+/// @private
+constexpr size_t repetitions = 2000000;
+
+/// @private
+volatile double sink; // prevent the compiler from removing the calls
+
+/// @private
+volatile double pivot = 1.0; // prevent the compiler from simplifying
+
+/**
+ * @brief Measure the average time of a function call
+ *
+ * @tparam FUNCTION is the type of the function
+ * @param function is the function to be measured
+ * @return the average time, in nanoseconds, of a call of `function`
+ */
+template<typename FUNCTION>
+double measure(FUNCTION function)
+{
+  using namespace std::chrono;
+
+  const auto start = steady_clock::now();
+  for (size_t i = 0; i < repetitions; ++i) {
+    function();
+  }
+  const auto end = steady_clock::now();
+
+  return duration<double, std::nano>(end - start).count() / repetitions;
+}
+
+/// @private
+double dot_loop(const double *a, const double *b, const size_t size)
+{
+  double res = 0;
+  for (size_t i = 0; i < size; ++i) {
+    res += a[i] * b[i];
+  }
+
+  return res;
+}
+
+/// @private
+void axpy_loop(const double alpha, const double *x, double *y,
+               const size_t size)
+{
+  for (size_t i = 0; i < size; ++i) {
+    y[i] += alpha * x[i];
+  }
+}
+
+/// @private
+void eliminate_loop(double *row, const double *pivot_row, const double coeff,
+                    const double pivot_value, const size_t size)
+{
+  for (size_t i = 0; i < size; ++i) {
+    const double term = coeff * pivot_row[i];
+    if (row[i] * pivot_value == term) {
+      row[i] = 0;
+    } else {
+      row[i] -= term / pivot_value;
+    }
+  }
+}
+
+/**
+ * @brief Print the times of a kernel for all the instruction sets
+ *
+ * @tparam LOOP is the type of the plain loop function
+ * @tparam KERNEL is the type of the kernel function
+ * @param name is the kernel name
+ * @param size is the vector size
+ * @param loop calls the plain loop
+ * @param kernel calls the kernel
+ */
+template<typename LOOP, typename KERNEL>
+void benchmark(const std::string &name, const size_t size, LOOP loop,
+               KERNEL kernel)
+{
+  std::cout << std::setw(10) << name << std::setw(6) << size << std::setw(10)
+            << measure(loop);
+
+  for (const auto &instruction_set:
+       {Kernels::InstructionSet::SCALAR, Kernels::InstructionSet::AVX2,
+        Kernels::InstructionSet::AVX512}) {
+    if (Kernels::select(instruction_set)) {
+      std::cout << std::setw(10) << measure(kernel);
+    } else {
+      std::cout << std::setw(10) << "-";
+    }
+  }
+  std::cout << std::endl;
+}
+
+int main()
+{
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<double> dist(-1, 1);
+
+  const auto default_set = Kernels::instruction_set();
+
+  std::cout << "Average time per call (ns)" << std::endl
+            << std::setw(10) << "kernel" << std::setw(6) << "dim"
+            << std::setw(10) << "loop" << std::setw(10) << "scalar"
+            << std::setw(10) << "AVX2" << std::setw(10) << "AVX-512"
+            << std::endl;
+
+  for (size_t size = 3; size <= 20; ++size) {
+    std::vector<double> a(size), b(size), y(size);
+    for (size_t i = 0; i < size; ++i) {
+      a[i] = dist(gen);
+      b[i] = dist(gen);
+    }
+
+    benchmark(
+        "dot", size,
+        [&]() { sink = dot_loop(a.data(), b.data(), size); },
+        [&]() { sink = Kernels::dispatched_dot(a.data(), b.data(), size); });
+
+    // alternate the sign of alpha to keep the values bounded
+    double alpha = 1e-3;
+    benchmark(
+        "axpy", size,
+        [&]() {
+          alpha = -alpha;
+          axpy_loop(alpha, a.data(), y.data(), size);
+        },
+        [&]() {
+          alpha = -alpha;
+          Kernels::dispatched_axpy(alpha, a.data(), y.data(), size);
+        });
+    sink = y[0];
+
+    y = b;
+    const double pivot_value = pivot;
+    benchmark(
+        "eliminate", size,
+        [&]() {
+          alpha = -alpha;
+          eliminate_loop(y.data(), a.data(), alpha, pivot_value, size);
+        },
+        [&]() {
+          alpha = -alpha;
+          Kernels::dispatched_eliminate(y.data(), a.data(), alpha,
+                                        pivot_value, size);
+        });
+    sink = y[0];
+  }
+
+  Kernels::select(default_set);
+
+  return 0;
+}
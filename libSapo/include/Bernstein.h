@@ -17,7 +17,9 @@
 
 #include "ErrorHandling.h"
 #include "LinearAlgebra.h"
+#include "FixedLinearAlgebra.h"
 #include "SymbolicAlgebra.h"
+#include "Polynomial.h"
 
 template<typename C>
 class Bernstein
@@ -563,7 +565,323 @@ private:
     return bernCoeffs;
   }
 
+  /**
+   * @brief Turn monomial coefficients into Bernstein ones along a line
+   *
+   * This method applies in place the Garloff's transformation to the
+   * coefficients of a line of the dense coefficient tensor, i.e., to
+   * the coefficients whose multi-indices differ exclusively in one
+   * variable. It divides the \f$k\f$-th coefficient by
+   * \f$\binom{d}{k}\f$ and, then, it performs the de Casteljau
+   * sums \f$a_k \gets a_k + a_{k-1}\f$.
+   *
+   * @param[in, out] coeffs is the dense coefficient tensor
+   * @param[in] degree is the degree of the line variable
+   * @param[in] stride is the distance between two consecutive line
+   *            coefficients in `coeffs`
+   * @param[in] base is the position of the first line coefficient
+   */
+  static void to_Bernstein_along_line(std::vector<C> &coeffs,
+                                      const unsigned int degree,
+                                      const size_t stride, const size_t base)
+  {
+    C binomial = 1;
+    for (unsigned int k = 1; k <= degree; ++k) {
+      binomial = (binomial * (degree - k + 1)) / k;
+      coeffs[base + k * stride] /= binomial;
+    }
+
+    for (unsigned int r = 1; r <= degree; ++r) {
+      for (unsigned int k = degree; k >= r; --k) {
+        coeffs[base + k * stride] += coeffs[base + (k - 1) * stride];
+      }
+    }
+  }
+
+  /**
+   * @brief Compute the Bernstein coefficient bounds of a dense tensor
+   *
+   * This method turns in place a dense tensor of monomial coefficients
+   * into Bernstein coefficients one variable per time and returns the
+   * minimum and the maximum among them. The lines of the last variable
+   * are processed at the end, one by one: when the early termination
+   * is enabled and both the minimum and the maximum found so far are
+   * dominated by the thresholds, i.e., the minimum is lesser than or
+   * equal to `lower_threshold` and the maximum is greater than or equal
+   * to `upper_threshold`, the remaining lines are skipped.
+   *
+   * @tparam INDICES is the type of the degree and shift vectors, i.e.,
+   *         either `std::vector<unsigned int>` or a fixed-dimension
+   *         vector of `unsigned int`
+   * @param[in] degrees is the vector of the variable degrees
+   * @param[in] shifts is the shift vector of `degrees`
+   * @param[in, out] coeffs is the dense coefficient tensor
+   * @param[in] early_termination enables the early termination
+   * @param[in] lower_threshold is the lower threshold
+   * @param[in] upper_threshold is the upper threshold
+   * @return the pair minimum-maximum among the computed Bernstein
+   *         coefficients
+   */
+  template<typename INDICES>
+  static std::pair<C, C>
+  compute_bounds_from_dense_tensor(const INDICES &degrees,
+                                   const INDICES &shifts,
+                                   std::vector<C> &coeffs,
+                                   const bool early_termination,
+                                   const C &lower_threshold,
+                                   const C &upper_threshold)
+  {
+    if (coeffs.size() != shifts[0]) {
+      SAPO_ERROR("the coefficient tensor size does not match the degrees",
+                 std::domain_error);
+    }
+
+    const size_t last = degrees.size() - 1;
+    for (size_t i = 0; i < last; ++i) {
+      const size_t stride = shifts[i + 1];
+      for (size_t block = 0; block < coeffs.size(); block += shifts[i]) {
+        for (size_t base = block; base < block + stride; ++base) {
+          to_Bernstein_along_line(coeffs, degrees[i], stride, base);
+        }
+      }
+    }
+
+    const size_t line_size = degrees[last] + 1;
+
+    to_Bernstein_along_line(coeffs, degrees[last], 1, 0);
+    std::pair<C, C> bounds(coeffs[0], coeffs[0]);
+    for (size_t base = 0; base < coeffs.size(); base += line_size) {
+      if (base > 0) {
+        to_Bernstein_along_line(coeffs, degrees[last], 1, base);
+      }
+
+      for (size_t k = base; k < base + line_size; ++k) {
+        if (coeffs[k] < bounds.first) {
+          bounds.first = coeffs[k];
+        }
+        if (coeffs[k] > bounds.second) {
+          bounds.second = coeffs[k];
+        }
+      }
+
+      if (early_termination && bounds.first <= lower_threshold
+          && bounds.second >= upper_threshold) {
+        return bounds;
+      }
+    }
+
+    return bounds;
+  }
+
+  /**
+   * @brief Move a multi-index to the next tensor position
+   *
+   * @tparam N is the number of variables
+   * @param[in, out] multi_index is the multi-index of a tensor position
+   * @param[in] degrees is the vector of the variable degrees
+   */
+  template<size_t N>
+  static inline void
+  next_multi_index(LinearAlgebra::Fixed::Vector<unsigned int, N> &multi_index,
+                   const LinearAlgebra::Fixed::Vector<unsigned int, N> &degrees)
+  {
+    size_t i = N;
+    do {
+      --i;
+      if (multi_index[i] < degrees[i]) {
+        ++multi_index[i];
+
+        return;
+      }
+      multi_index[i] = 0;
+    } while (i > 0);
+  }
+
+  /**
+   * @brief Initialize the degree shift vector of a fixed number of variables
+   *
+   * @tparam N is the number of variables
+   * @param degrees is the vector of variable degrees in polynomial
+   * @return the shift vector of `degrees`
+   */
+  template<size_t N>
+  static LinearAlgebra::Fixed::Vector<unsigned int, N>
+  get_shifts(const LinearAlgebra::Fixed::Vector<unsigned int, N> &degrees)
+  {
+    LinearAlgebra::Fixed::Vector<unsigned int, N> shifts{};
+
+    shifts[N - 1] = degrees[N - 1] + 1;
+    for (size_t i = N - 1; i > 0; --i) {
+      shifts[i - 1] = (degrees[i - 1] + 1) * shifts[i];
+    }
+
+    return shifts;
+  }
+
+  /**
+   * @brief Compute the bounds of a dense tensor on a fixed number of variables
+   *
+   * This method reduces the tensor to the polynomial degrees as
+   * `reduce_dense_tensor` does and, then, it computes the Bernstein
+   * coefficient bounds with early termination. The degrees, the
+   * shifts, and the multi-indices are fixed-dimension vectors and
+   * the multi-indices of the tensor positions are enumerated
+   * in order rather than decoded one by one. The results equal
+   * those of the generic version.
+   *
+   * @tparam N is the number of variables
+   * @param[in] degrees is the vector of the variable degrees
+   * @param[in, out] coeffs is the dense coefficient tensor
+   * @param[in] lower_threshold is the lower threshold
+   * @param[in] upper_threshold is the upper threshold
+   * @return the pair minimum-maximum among the Bernstein coefficients
+   *         or a pair dominated by the thresholds
+   */
+  template<size_t N>
+  static std::pair<C, C>
+  get_fixed_dimension_bounds(const std::vector<unsigned int> &degrees,
+                             std::vector<C> &coeffs,
+                             const C &lower_threshold,
+                             const C &upper_threshold)
+  {
+    using namespace LinearAlgebra;
+
+    const Fixed::Vector<unsigned int, N> tensor_degrees
+        = Fixed::to_fixed<N>(degrees);
+    const auto shifts = get_shifts(tensor_degrees);
+
+    if (coeffs.size() != shifts[0]) {
+      SAPO_ERROR("the coefficient tensor size does not match the degrees",
+                 std::domain_error);
+    }
+
+    Fixed::Vector<unsigned int, N> poly_degrees{}, multi_index{};
+    for (size_t pos = 0; pos < coeffs.size(); ++pos) {
+      if (coeffs[pos] != 0) {
+        for (size_t i = 0; i < N; ++i) {
+          poly_degrees[i] = std::max(poly_degrees[i], multi_index[i]);
+        }
+      }
+      next_multi_index(multi_index, tensor_degrees);
+    }
+
+    if (poly_degrees == tensor_degrees) {
+      return compute_bounds_from_dense_tensor(tensor_degrees, shifts, coeffs,
+                                              true, lower_threshold,
+                                              upper_threshold);
+    }
+
+    // compact the tensor in place: the reduced tensor positions are
+    // enumerated in the same order and none of them follows the
+    // corresponding position in the original tensor
+    const auto poly_shifts = get_shifts(poly_degrees);
+    multi_index = Fixed::Vector<unsigned int, N>{};
+    for (size_t pos = 0; pos < coeffs.size(); ++pos) {
+      bool in_poly = true;
+      for (size_t i = 0; i < N; ++i) {
+        in_poly = in_poly && (multi_index[i] <= poly_degrees[i]);
+      }
+      if (in_poly) {
+        size_t poly_pos = multi_index[N - 1];
+        for (size_t i = 0; i + 1 < N; ++i) {
+          poly_pos += multi_index[i] * poly_shifts[i + 1];
+        }
+        coeffs[poly_pos] = coeffs[pos];
+      }
+      next_multi_index(multi_index, tensor_degrees);
+    }
+    coeffs.resize(poly_shifts[0]);
+
+    return compute_bounds_from_dense_tensor(poly_degrees, poly_shifts, coeffs,
+                                            true, lower_threshold,
+                                            upper_threshold);
+  }
+
+  /**
+   * @brief Compute the bounds of a dense tensor on any number of variables
+   *
+   * See `get_fixed_dimension_bounds`.
+   *
+   * @param[in] degrees is the vector of the variable degrees
+   * @param[in, out] coeffs is the dense coefficient tensor
+   * @param[in] lower_threshold is the lower threshold
+   * @param[in] upper_threshold is the upper threshold
+   * @return the pair minimum-maximum among the Bernstein coefficients
+   *         or a pair dominated by the thresholds
+   */
+  static std::pair<C, C>
+  get_generic_dimension_bounds(const std::vector<unsigned int> &degrees,
+                               std::vector<C> &coeffs,
+                               const C &lower_threshold,
+                               const C &upper_threshold)
+  {
+    auto reduced_degrees = degrees;
+    reduce_dense_tensor(reduced_degrees, coeffs);
+
+    return compute_bounds_from_dense_tensor(
+        reduced_degrees, get_shifts(reduced_degrees), coeffs, true,
+        lower_threshold, upper_threshold);
+  }
+
 public:
+  /**
+   * @brief The type of the functions reducing dense tensors and computing
+   *        their Bernstein coefficient bounds
+   */
+  typedef std::pair<C, C> (*DenseTensorBounds)(
+      const std::vector<unsigned int> &degrees, std::vector<C> &coeffs,
+      const C &lower_threshold, const C &upper_threshold);
+
+  /**
+   * @brief The dense tensor bound functions of the dimensions
+   *
+   * `DenseTensorBoundsInstance<N>::get()` returns the fixed-dimension
+   * function for `N` variables if `N` is positive and the generic
+   * function otherwise. This class is meant to be used with
+   * `LinearAlgebra::Fixed::dispatch_on_dimension`.
+   *
+   * @tparam N is the number of variables or 0
+   */
+  template<size_t N>
+  struct DenseTensorBoundsInstance {
+    /**
+     * @brief Get the dense tensor bound function
+     *
+     * @return the dense tensor bound function for `N` variables
+     */
+    static DenseTensorBounds get()
+    {
+      if constexpr (N == 0) {
+        return &get_generic_dimension_bounds;
+      } else {
+        return &get_fixed_dimension_bounds<N>;
+      }
+    }
+  };
+
+  /**
+   * @brief Get the dense tensor bound function of a number of variables
+   *
+   * The returned function reduces a dense tensor to the polynomial
+   * degrees (see `reduce_dense_tensor`) and computes its Bernstein
+   * coefficient bounds with early termination (see
+   * `get_bounds_from_dense_tensor`). When the number of variables does
+   * not exceed `LinearAlgebra::Fixed::MAX_FIXED_DIMENSION`, the function
+   * is instantiated on it: degrees, shifts, and multi-indices live on
+   * the stack and the tensor is reduced in place, so that no memory is
+   * allocated for coefficients of fundamental types.
+   *
+   * @param num_of_variables is the number of variables
+   * @return the dense tensor bound function for `num_of_variables`
+   *         variables
+   */
+  static DenseTensorBounds
+  get_dense_tensor_bounds_function(const size_t num_of_variables)
+  {
+    return LinearAlgebra::Fixed::dispatch_on_dimension<
+        DenseTensorBoundsInstance>(num_of_variables);
+  }
+
   /**
    * @brief Compute the Bernstein coefficients of a polynomial
    *
@@ -632,6 +950,135 @@ public:
 
     return coeff;
   }
+
+  /**
+   * @brief Get the dense coefficient tensor of a polynomial
+   *
+   * This method computes the numeric coefficients of a polynomial
+   * and stores them in a dense tensor in row-major order: the
+   * coefficient of the monomial \f$\prod_i \textrm{vars}_i^{j_i}\f$
+   * is placed in position \f$\sum_i j_i \prod_{h>i} (d_h+1)\f$ where
+   * \f$d_h\f$ is `degrees[h]`.
+   *
+   * @param[in] vars is the vector of the variables
+   * @param[in] polynomial is a polynomial whose coefficients are
+   *            constants
+   * @param[in] degrees is the vector of the tensor variable degrees
+   * @return the dense coefficient tensor of `polynomial`
+   */
+  static std::vector<C>
+  get_dense_coefficients(const std::vector<SymbolicAlgebra::Symbol<C>> &vars,
+                         const SymbolicAlgebra::Expression<C> &polynomial,
+                         const std::vector<unsigned int> &degrees)
+  {
+    if (!polynomial.is_a_polynomial()) {
+      SAPO_ERROR("the parameter is not a polynomial", std::domain_error);
+    }
+
+    if (vars.size() != degrees.size()) {
+      SAPO_ERROR("the variable and the degree vectors must have "
+                 "the same size",
+                 std::domain_error);
+    }
+
+    return SymbolicAlgebra::Polynomial<C>(polynomial, vars)
+        .get_dense_coefficients(degrees);
+  }
+
+  /**
+   * @brief Reduce a dense coefficient tensor to the polynomial degrees
+   *
+   * A dense tensor may represent a polynomial whose degrees are smaller
+   * than the tensor ones, e.g., when it is obtained as a linear
+   * combination of tensors. This method computes the actual polynomial
+   * degrees and rearranges the tensor accordingly so that the
+   * Bernstein coefficients are not evaluated on elevated degrees.
+   *
+   * @param[in, out] degrees is the vector of the variable degrees
+   * @param[in, out] coeffs is the dense coefficient tensor
+   */
+  static void reduce_dense_tensor(std::vector<unsigned int> &degrees,
+                                  std::vector<C> &coeffs)
+  {
+    const auto shifts = get_shifts(degrees);
+
+    std::vector<unsigned int> poly_degrees(degrees.size(), 0);
+    for (size_t pos = 0; pos < coeffs.size(); ++pos) {
+      if (coeffs[pos] != 0) {
+        const auto multi_index = pos2multi_index(degrees, shifts, pos);
+        for (size_t i = 0; i < multi_index.size(); ++i) {
+          poly_degrees[i] = std::max(poly_degrees[i], multi_index[i]);
+        }
+      }
+    }
+
+    if (poly_degrees == degrees) {
+      return;
+    }
+
+    const auto poly_shifts = get_shifts(poly_degrees);
+    std::vector<C> poly_coeffs(poly_shifts[0], 0);
+    for (size_t pos = 0; pos < coeffs.size(); ++pos) {
+      if (coeffs[pos] != 0) {
+        const auto multi_index = pos2multi_index(degrees, shifts, pos);
+
+        size_t poly_pos = multi_index.back();
+        for (size_t i = 0; i + 1 < multi_index.size(); ++i) {
+          poly_pos += multi_index[i] * poly_shifts[i + 1];
+        }
+        poly_coeffs[poly_pos] = coeffs[pos];
+      }
+    }
+
+    std::swap(degrees, poly_degrees);
+    std::swap(coeffs, poly_coeffs);
+  }
+
+  /**
+   * @brief Compute the Bernstein coefficient bounds of a dense tensor
+   *
+   * @param[in] degrees is the vector of the variable degrees
+   * @param[in] coeffs is the dense tensor of the monomial coefficients
+   * @return the pair minimum-maximum among the Bernstein coefficients
+   *         of the polynomial represented by `coeffs`
+   */
+  static std::pair<C, C>
+  get_bounds_from_dense_tensor(const std::vector<unsigned int> &degrees,
+                               std::vector<C> coeffs)
+  {
+    return compute_bounds_from_dense_tensor(degrees, get_shifts(degrees),
+                                            coeffs, false, 0, 0);
+  }
+
+  /**
+   * @brief Compute the Bernstein coefficient bounds of a dense tensor
+   *
+   * This method computes the minimum and the maximum Bernstein
+   * coefficients, but it stops as soon as the minimum and the
+   * maximum found so far are lesser than or equal to
+   * `lower_threshold` and greater than or equal to
+   * `upper_threshold`, respectively. In such a case, the returned
+   * values are not the Bernstein coefficient bounds, yet they are
+   * dominated by the thresholds.
+   *
+   * @param[in] degrees is the vector of the variable degrees
+   * @param[in] coeffs is the dense tensor of the monomial coefficients
+   * @param[in] lower_threshold is the lower threshold
+   * @param[in] upper_threshold is the upper threshold
+   * @return the pair minimum-maximum among the Bernstein coefficients
+   *         of the polynomial represented by `coeffs` or a pair
+   *         dominated by the thresholds
+   */
+  static std::pair<C, C>
+  get_bounds_from_dense_tensor(const std::vector<unsigned int> &degrees,
+                               std::vector<C> coeffs,
+                               const C &lower_threshold,
+                               const C &upper_threshold)
+  {
+    return compute_bounds_from_dense_tensor(degrees, get_shifts(degrees),
+                                            coeffs, true, lower_threshold,
+                                            upper_threshold);
+  }
 };
 
 /**
@@ -666,4 +1113,59 @@ get_Bernstein_coefficients(const std::vector<SymbolicAlgebra::Symbol<C>> &vars,
 {
   return Bernstein<C>::get_coefficients(vars, f);
 }
+
+/**
+ * @brief Compute the Bernstein coefficient bounds of a dense tensor
+ *
+ * This function computes the minimum and the maximum Bernstein
+ * coefficients of a polynomial without building any symbolic
+ * expression. The polynomial is represented by the dense tensor of
+ * its monomial coefficients (see
+ * `Bernstein<C>::get_dense_coefficients`) and its Bernstein
+ * coefficients are computed in place in
+ * \f$O(n \cdot \prod_i (d_i+1) \cdot \max_i d_i)\f$.
+ *
+ * @tparam C is the type of constants
+ * @param[in] degrees is the vector of the variable degrees
+ * @param[in] coeffs is the dense tensor of the monomial coefficients
+ * @return the pair minimum-maximum among the Bernstein coefficients
+ */
+template<typename C>
+inline std::pair<C, C>
+get_Bernstein_bounds(const std::vector<unsigned int> &degrees,
+                     std::vector<C> coeffs)
+{
+  return Bernstein<C>::get_bounds_from_dense_tensor(degrees,
+                                                    std::move(coeffs));
+}
+
+/**
+ * @brief Compute the Bernstein coefficient bounds of a dense tensor
+ *
+ * This function computes the minimum and the maximum Bernstein
+ * coefficients of a polynomial represented by the dense tensor of its
+ * monomial coefficients, but it stops as soon as both the
+ * bounds are dominated by the thresholds. In such a case, the
+ * minimum is lesser than or equal to `lower_threshold`, the
+ * maximum is greater than or equal to `upper_threshold`, but
+ * they may differ from the actual Bernstein coefficient bounds.
+ *
+ * @tparam C is the type of constants
+ * @param[in] degrees is the vector of the variable degrees
+ * @param[in] coeffs is the dense tensor of the monomial coefficients
+ * @param[in] lower_threshold is the lower threshold
+ * @param[in] upper_threshold is the upper threshold
+ * @return the pair minimum-maximum among the Bernstein coefficients
+ *         or a pair dominated by the thresholds
+ */
+template<typename C>
+inline std::pair<C, C>
+get_Bernstein_bounds(const std::vector<unsigned int> &degrees,
+                     std::vector<C> coeffs, const C &lower_threshold,
+                     const C &upper_threshold)
+{
+  return Bernstein<C>::get_bounds_from_dense_tensor(
+      degrees, std::move(coeffs), lower_threshold, upper_threshold);
+}
+
 #endif // BERNSTEIN_H_
@@ -0,0 +1,303 @@
+/**
+ * @file BinaryFlowpipe.h
+ * @author Alberto Casagrande <acasagrande@units.it>
+ * @brief Write and read flowpipes in a compact binary format
+ * @version 0.1
+ * @date 2023-03-08
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef BINARY_FLOWPIPE_H_
+#define BINARY_FLOWPIPE_H_
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Flowpipe.h"
+#include "Polytope.h"
+#include "SetsUnion.h"
+
+/**
+ * @brief The magic number of binary flowpipe files
+ */
+#define BINARY_FLOWPIPE_MAGIC 0x45504950574f4c46
+
+/**
+ * @brief The version of the binary flowpipe file format
+ */
+#define BINARY_FLOWPIPE_VERSION 1
+
+/**
+ * @brief A flowpipe writer producing binary flowpipe files
+ *
+ * The file is a sequence of 64-bit words: unsigned integers and doubles
+ * in little-endian byte order. It begins with the magic number and the
+ * format version. Then, the epochs follow in order and each of them
+ * stores the number of polytopes \f$n\f$, the \f$n\f$ template
+ * identifiers, the \f$n\f$ offsets of the polytope bounds in the epoch
+ * bound array, and, finally, the bound array itself. The polytope
+ * direction matrices, i.e., the templates, are stored once after
+ * the last epoch together with the epoch offset index. A footer made
+ * of the system dimension, the template section offset, the epoch
+ * index offset, the number of epochs, and the magic number closes the
+ * file.
+ *
+ * Since the template section and the index are written at the end, the
+ * file can be produced in a single pass also on non-seekable streams.
+ */
+class BinaryFlowpipeWriter : public FlowpipeWriter
+{
+  std::ostream &_os; //!< the output stream
+  uint64_t _offset;  //!< the number of bytes written so far
+
+  uint64_t _dim; //!< the dimension of the written polytopes
+
+  std::map<std::vector<LinearAlgebra::Vector<double>>, uint64_t>
+      _template_ids; //!< the identifiers of the written templates
+  std::vector<const std::vector<LinearAlgebra::Vector<double>> *>
+      _templates; //!< the written templates sorted by identifier
+
+  std::vector<uint64_t> _epoch_offsets; //!< the offsets of the epochs
+
+  /**
+   * @brief Write a 64-bit word
+   *
+   * @tparam T is the type of the value to be written
+   * @param value is the value to be written
+   */
+  template<typename T>
+  void write_word(const T value);
+
+  /**
+   * @brief Get the identifier of a template
+   *
+   * If the template has not been written yet, a new identifier is
+   * associated to it.
+   *
+   * @param A is a polytope direction matrix
+   * @return the identifier of the template `A`
+   */
+  uint64_t
+  get_template_id(const std::vector<LinearAlgebra::Vector<double>> &A);
+
+public:
+  /**
+   * @brief A constructor
+   *
+   * @param os is the binary output stream
+   */
+  BinaryFlowpipeWriter(std::ostream &os);
+
+  /**
+   * @brief Write the next flowpipe step
+   *
+   * @param[in] step is the polytopes union reached in the next epoch
+   */
+  void write(SetsUnion<Polytope> &&step) override;
+
+  /**
+   * @brief Write the templates, the epoch index, and the footer
+   *
+   * This method must be called exactly once, after the last step
+   * has been written.
+   */
+  void close();
+};
+
+/**
+ * @brief Write a flowpipe in binary format
+ *
+ * @param os is the binary output stream
+ * @param flowpipe is the flowpipe to be written
+ */
+void write_binary(std::ostream &os, const Flowpipe &flowpipe);
+
+/**
+ * @brief A memory mapped binary flowpipe file
+ *
+ * The file content is validated when the file is opened and it is
+ * accessed in place, i.e., the bounds and the direction matrices
+ * are not copied until a `Polytope` is explicitly built. On
+ * big-endian hosts, the file words are converted into a private
+ * copy in the host byte order, which is accessed in place.
+ */
+class BinaryFlowpipeReader
+{
+  const uint64_t *_data; //!< the mapped file content
+  size_t _size;          //!< the mapped file size in bytes
+
+  std::vector<uint64_t> _host_words; //!< the file words in host byte order
+
+  uint64_t _dim; //!< the dimension of the polytopes
+
+  const uint64_t *_templates; //!< the template offsets
+  uint64_t _num_of_templates; //!< the number of templates
+
+  const uint64_t *_epochs; //!< the epoch offsets
+  uint64_t _num_of_epochs; //!< the number of epochs
+
+  /**
+   * @brief Get the words at a byte offset
+   *
+   * @param offset is a byte offset in the file
+   * @return a pointer to the word at byte offset `offset`
+   */
+  inline const uint64_t *at(const uint64_t offset) const
+  {
+    return _data + offset / sizeof(uint64_t);
+  }
+
+  /**
+   * @brief Validate the file content
+   *
+   * @throw std::runtime_error if the file is not a valid binary flowpipe
+   */
+  void validate() const;
+
+public:
+  /**
+   * @brief Open and map a binary flowpipe file
+   *
+   * @param filename is the name of the file
+   * @throw std::runtime_error if the file cannot be mapped or it is not
+   *        a valid binary flowpipe
+   */
+  BinaryFlowpipeReader(const std::string &filename);
+
+  BinaryFlowpipeReader(const BinaryFlowpipeReader &) = delete;
+
+  BinaryFlowpipeReader &operator=(const BinaryFlowpipeReader &) = delete;
+
+  /**
+   * @brief Get the number of epochs in the flowpipe
+   *
+   * @return the number of epochs in the flowpipe
+   */
+  inline size_t size() const
+  {
+    return _num_of_epochs;
+  }
+
+  /**
+   * @brief Get the dimension of the polytopes
+   *
+   * @return the dimension of the polytopes
+   */
+  inline size_t dim() const
+  {
+    return _dim;
+  }
+
+  /**
+   * @brief Get the number of templates
+   *
+   * @return the number of distinct direction matrices in the flowpipe
+   */
+  inline size_t num_of_templates() const
+  {
+    return _num_of_templates;
+  }
+
+  /**
+   * @brief Get the number of directions in a template
+   *
+   * @param template_id is a template identifier
+   * @return the number of rows of the template direction matrix
+   */
+  inline size_t num_of_directions(const size_t template_id) const
+  {
+    return *at(_templates[template_id]);
+  }
+
+  /**
+   * @brief Get the direction matrix of a template
+   *
+   * @param template_id is a template identifier
+   * @return a pointer to the row-major direction matrix of the template
+   */
+  inline const double *directions(const size_t template_id) const
+  {
+    return reinterpret_cast<const double *>(at(_templates[template_id])
+                                            + 1);
+  }
+
+  /**
+   * @brief Get the number of polytopes reached in an epoch
+   *
+   * @param epoch is an epoch
+   * @return the number of polytopes reached in `epoch`
+   */
+  inline size_t num_of_polytopes(const size_t epoch) const
+  {
+    return *at(_epochs[epoch]);
+  }
+
+  /**
+   * @brief Get the template of a polytope
+   *
+   * @param epoch is an epoch
+   * @param index is the polytope index in the epoch
+   * @return the template identifier of the polytope
+   */
+  inline size_t template_of(const size_t epoch, const size_t index) const
+  {
+    return at(_epochs[epoch])[1 + index];
+  }
+
+  /**
+   * @brief Get the bounds of a polytope
+   *
+   * @param epoch is an epoch
+   * @param index is the polytope index in the epoch
+   * @return a pointer to the bound vector of the polytope
+   */
+  inline const double *bounds(const size_t epoch, const size_t index) const
+  {
+    const uint64_t *epoch_data = at(_epochs[epoch]);
+    const uint64_t num_of_polytopes = epoch_data[0];
+
+    return reinterpret_cast<const double *>(epoch_data + 1
+                                            + 2 * num_of_polytopes)
+           + epoch_data[1 + num_of_polytopes + index];
+  }
+
+  /**
+   * @brief Build a polytope stored in the file
+   *
+   * @param epoch is an epoch
+   * @param index is the polytope index in the epoch
+   * @return the polytope
+   */
+  Polytope polytope(const size_t epoch, const size_t index) const;
+
+  /**
+   * @brief Build the polytopes union reached in an epoch
+   *
+   * The polytopes are appended to the union in file order and
+   * exactly as they were written, i.e., neither emptiness nor
+   * inclusion is tested again.
+   *
+   * @param epoch is an epoch
+   * @return the polytopes union reached in `epoch`
+   * @throw std::domain_error if `epoch` is not smaller than `size()`
+   */
+  SetsUnion<Polytope> get(const size_t epoch) const;
+
+  /**
+   * @brief Build the whole flowpipe
+   *
+   * @return the flowpipe stored in the file
+   */
+  Flowpipe flowpipe() const;
+
+  /**
+   * @brief Unmap the file
+   */
+  ~BinaryFlowpipeReader();
+};
+
+#endif // BINARY_FLOWPIPE_H_
@@ -0,0 +1,176 @@
+/**
+ * @file BinaryIO.h
+ * @author Alberto Casagrande <acasagrande@units.it>
+ * @brief Read and write values in binary streams
+ * @version 0.1
+ * @date 2023-03-01
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef BINARY_IO_H_
+#define BINARY_IO_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "ErrorHandling.h"
+
+/**
+ * @brief Binary stream input and output
+ *
+ * The values are stored in little-endian byte order, whatever the
+ * host byte order is, and all the integers are stored as 64-bit words.
+ * The values are read and written one by one through standard streams.
+ */
+namespace BinaryIO
+{
+
+/**
+ * @brief Test whether the host uses the big-endian byte order
+ *
+ * @return `true` if and only if the most significant byte of the
+ *         host words comes first
+ */
+inline bool host_is_big_endian()
+{
+  const uint16_t word = 1;
+  unsigned char first_byte;
+  std::memcpy(&first_byte, &word, 1);
+
+  return first_byte == 0;
+}
+
+/**
+ * @brief Convert a value between the host and the little-endian byte order
+ *
+ * The conversion is an involution: it both converts host values into
+ * little-endian ones and little-endian values into host ones.
+ *
+ * @tparam T is the type of the value; it must be arithmetic
+ * @param value is the value to be converted
+ * @return `value` in the other byte order
+ */
+template<typename T>
+inline T little_endian(const T value)
+{
+  static_assert(std::is_arithmetic<T>::value,
+                "Only arithmetic values have a byte order");
+
+  if (!host_is_big_endian()) {
+    return value;
+  }
+
+  unsigned char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  std::reverse(bytes, bytes + sizeof(T));
+
+  T converted;
+  std::memcpy(&converted, bytes, sizeof(T));
+
+  return converted;
+}
+
+/**
+ * @brief Write a value in a binary stream
+ *
+ * @tparam T is the type of the value; it must be arithmetic
+ * @param os is the output stream
+ * @param value is the value to be written
+ */
+template<typename T>
+inline void write(std::ostream &os, const T &value)
+{
+  const T stored = little_endian(value);
+
+  os.write(reinterpret_cast<const char *>(&stored), sizeof(T));
+}
+
+/**
+ * @brief Write a vector in a binary stream
+ *
+ * The vector size is written before the vector values.
+ *
+ * @tparam T is the type of the vector values
+ * @param os is the output stream
+ * @param values is the vector to be written
+ */
+template<typename T>
+void write(std::ostream &os, const std::vector<T> &values)
+{
+  write(os, static_cast<uint64_t>(values.size()));
+  for (const T &value: values) {
+    write(os, value);
+  }
+}
+
+/**
+ * @brief Read a value from a binary stream
+ *
+ * @tparam T is the type of the value; it must be arithmetic
+ * @param is is the input stream
+ * @return the read value
+ * @throw std::runtime_error if the stream does not contain enough data
+ */
+template<typename T>
+T read(std::istream &is)
+{
+  T stored;
+  if (!is.read(reinterpret_cast<char *>(&stored), sizeof(T))) {
+    SAPO_ERROR("unexpected end of binary stream", std::runtime_error);
+  }
+
+  return little_endian(stored);
+}
+
+/**
+ * @brief Read a vector from a binary stream
+ *
+ * @tparam T is the type of the vector values
+ * @param is is the input stream
+ * @return the read vector
+ * @throw std::runtime_error if the stream does not contain enough data
+ */
+template<typename T>
+std::vector<T> read_vector(std::istream &is)
+{
+  const uint64_t size = read<uint64_t>(is);
+
+  // the size may be corrupted: grow the vector while reading
+  std::vector<T> values;
+  values.reserve(std::min(size, static_cast<uint64_t>(1) << 16));
+  for (uint64_t i = 0; i < size; ++i) {
+    values.push_back(read<T>(is));
+  }
+
+  return values;
+}
+
+/**
+ * @brief Compute the 64-bit FNV-1a hash of a string
+ *
+ * Differently from `std::hash`, this hash does not depend on the
+ * standard library implementation and can be stored in files.
+ *
+ * @param str is the string to be hashed
+ * @return the FNV-1a hash of `str`
+ */
+inline uint64_t hash(const std::string &str)
+{
+  uint64_t value = 0xcbf29ce484222325;
+  for (const char &c: str) {
+    value = (value ^ static_cast<unsigned char>(c)) * 0x100000001b3;
+  }
+
+  return value;
+}
+
+} // namespace BinaryIO
+
+#endif // BINARY_IO_H_
@@ -0,0 +1,275 @@
+/**
+ * @file BoundingBox.h
+ * @author Alberto Casagrande <acasagrande@units.it>
+ * @brief Represent axis-aligned boxes including closed sets
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef BOUNDINGBOX_H_
+#define BOUNDINGBOX_H_
+
+#include <cmath>
+#include <limits>
+
+#include "LinearAlgebra.h"
+#include "ErrorHandling.h"
+
+/**
+ * @brief Axis-aligned boxes
+ *
+ * This class represents the axis-aligned box
+ * \f$\{x \mid l \leq x \leq u\}\f$. Boxes are cheap
+ * over-approximations of closed sets that let conservative
+ * tests reject, or accept, inclusion and disjointness
+ * queries without solving any linear problem.
+ */
+class BoundingBox
+{
+  LinearAlgebra::Vector<double> _lower; //!< the box lower corner
+  LinearAlgebra::Vector<double> _upper; //!< the box upper corner
+
+  /**
+   * @brief Get an upper bound for the rounding error of a sum of products
+   *
+   * @param magnitude is the sum of the absolute values of at most
+   *        `dim()` products, each of them rounded to `double`
+   * @return an upper bound for the difference between the exact
+   *         sum of the products and its floating-point evaluation
+   */
+  inline double rounding_error(const double magnitude) const
+  {
+    const double eps = std::numeric_limits<double>::epsilon();
+
+    return 2 * (dim() + 1) * eps * magnitude
+           + dim() * std::numeric_limits<double>::denorm_min();
+  }
+
+public:
+  /**
+   * @brief Build the box including the whole space
+   *
+   * @param dim is the dimension of the box
+   */
+  explicit BoundingBox(const size_t dim = 0):
+      _lower(dim, -std::numeric_limits<double>::infinity()),
+      _upper(dim, std::numeric_limits<double>::infinity())
+  {
+  }
+
+  /**
+   * @brief Build a box
+   *
+   * @param lower is the lower corner of the box
+   * @param upper is the upper corner of the box
+   */
+  BoundingBox(const LinearAlgebra::Vector<double> &lower,
+              const LinearAlgebra::Vector<double> &upper):
+      _lower(lower),
+      _upper(upper)
+  {
+    if (lower.size() != upper.size()) {
+      SAPO_ERROR("the two corners differ in dimension", std::domain_error);
+    }
+  }
+
+  /**
+   * @brief Get the box dimension
+   *
+   * @return the box dimension
+   */
+  inline size_t dim() const
+  {
+    return _lower.size();
+  }
+
+  /**
+   * @brief Get the box lower corner
+   *
+   * @return a reference to the box lower corner
+   */
+  inline const LinearAlgebra::Vector<double> &lower_corner() const
+  {
+    return _lower;
+  }
+
+  /**
+   * @brief Get the box upper corner
+   *
+   * @return a reference to the box upper corner
+   */
+  inline const LinearAlgebra::Vector<double> &upper_corner() const
+  {
+    return _upper;
+  }
+
+  /**
+   * @brief Test whether the box is empty
+   *
+   * @return `true` if and only if the box is empty
+   */
+  bool is_empty() const
+  {
+    for (size_t i = 0; i < dim(); ++i) {
+      if (_lower[i] > _upper[i]) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  /**
+   * @brief Intersect the box with another box
+   *
+   * @param box is the intersecting box
+   * @return a reference to the updated object
+   */
+  BoundingBox &intersect_with(const BoundingBox &box)
+  {
+    if (dim() != box.dim()) {
+      SAPO_ERROR("the two boxes differ in dimension", std::domain_error);
+    }
+
+    for (size_t i = 0; i < dim(); ++i) {
+      _lower[i] = std::max(_lower[i], box._lower[i]);
+      _upper[i] = std::min(_upper[i], box._upper[i]);
+    }
+
+    return *this;
+  }
+
+  /**
+   * @brief Enlarge the box to include another box
+   *
+   * @param box is the box to be included
+   * @return a reference to the updated object
+   */
+  BoundingBox &join_with(const BoundingBox &box)
+  {
+    if (dim() != box.dim()) {
+      SAPO_ERROR("the two boxes differ in dimension", std::domain_error);
+    }
+
+    for (size_t i = 0; i < dim(); ++i) {
+      _lower[i] = std::min(_lower[i], box._lower[i]);
+      _upper[i] = std::max(_upper[i], box._upper[i]);
+    }
+
+    return *this;
+  }
+
+  /**
+   * @brief Test whether the box includes another box
+   *
+   * @param box is the box whose inclusion is tested
+   * @return `true` if and only if `box` is a subset of the box
+   */
+  bool includes(const BoundingBox &box) const
+  {
+    if (dim() != box.dim()) {
+      SAPO_ERROR("the two boxes differ in dimension", std::domain_error);
+    }
+
+    for (size_t i = 0; i < dim(); ++i) {
+      if (box._lower[i] < _lower[i] || _upper[i] < box._upper[i]) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief Get an upper bound for the maximum of a linear function
+   *
+   * The floating-point evaluation is enlarged by a bound for its
+   * rounding error, so that the result bounds the exact maximum.
+   *
+   * @param direction is the coefficient vector of the linear function
+   * @return an upper bound for
+   *         \f$\max_{x \in \texttt{box}} \texttt{direction} \cdot x\f$
+   */
+  double max_of(const LinearAlgebra::Vector<double> &direction) const
+  {
+    double value = 0, magnitude = 0;
+    for (size_t i = 0; i < dim(); ++i) {
+      double term = 0;
+      if (direction[i] > 0) {
+        term = direction[i] * _upper[i];
+      } else if (direction[i] < 0) {
+        term = direction[i] * _lower[i];
+      }
+      value += term;
+      magnitude += std::abs(term);
+    }
+
+    if (!std::isfinite(value)) {
+      return value;
+    }
+
+    // round the result outward
+    return std::nextafter(value + rounding_error(magnitude),
+                          std::numeric_limits<double>::infinity());
+  }
+
+  /**
+   * @brief Get a lower bound for the minimum of a linear function
+   *
+   * The floating-point evaluation is enlarged by a bound for its
+   * rounding error, so that the result bounds the exact minimum.
+   *
+   * @param direction is the coefficient vector of the linear function
+   * @return a lower bound for
+   *         \f$\min_{x \in \texttt{box}} \texttt{direction} \cdot x\f$
+   */
+  double min_of(const LinearAlgebra::Vector<double> &direction) const
+  {
+    double value = 0, magnitude = 0;
+    for (size_t i = 0; i < dim(); ++i) {
+      double term = 0;
+      if (direction[i] > 0) {
+        term = direction[i] * _lower[i];
+      } else if (direction[i] < 0) {
+        term = direction[i] * _upper[i];
+      }
+      value += term;
+      magnitude += std::abs(term);
+    }
+
+    if (!std::isfinite(value)) {
+      return value;
+    }
+
+    // round the result outward
+    return std::nextafter(value - rounding_error(magnitude),
+                          -std::numeric_limits<double>::infinity());
+  }
+};
+
+/**
+ * @brief Test whether two boxes are disjoint
+ *
+ * @param A is a box
+ * @param B is a box
+ * @return `true` if and only if `A` and `B` are disjoint
+ */
+inline bool are_disjoint(const BoundingBox &A, const BoundingBox &B)
+{
+  if (A.dim() != B.dim()) {
+    SAPO_ERROR("the two boxes differ in dimension", std::domain_error);
+  }
+
+  for (size_t i = 0; i < A.dim(); ++i) {
+    if (A.upper_corner()[i] < B.lower_corner()[i]
+        || B.upper_corner()[i] < A.lower_corner()[i]) {
+      return true;
+    }
+  }
+
+  return A.is_empty() || B.is_empty();
+}
+
+#endif // BOUNDINGBOX_H_
@@ -0,0 +1,516 @@
+/**
+ * @file BoxTree.h
+ * @author Alberto Casagrande <acasagrande@units.it>
+ * @brief Index objects by their bounding boxes
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef BOXTREE_H_
+#define BOXTREE_H_
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "BoundingBox.h"
+#include "ErrorHandling.h"
+
+/**
+ * @brief R-trees over bounding boxes
+ *
+ * This template indexes a collection of keys by the
+ * bounding boxes of the objects they refer to. Every
+ * node of the tree stores the smallest box including
+ * the boxes of its subtree, so that the keys whose
+ * boxes overlap a given box can be collected by visiting
+ * exclusively the subtrees that overlap it. Overfull
+ * nodes are split by sorting their children along the
+ * axis on which the lower corners are the most spread,
+ * while underfull nodes produced by removals are
+ * dissolved and their keys re-inserted.
+ *
+ * @tparam KEY is the type of the indexed keys
+ */
+template<typename KEY>
+class BoxTree
+{
+  /**
+   * @brief The maximum number of children of a node
+   */
+  static constexpr size_t max_children = 8;
+
+  /**
+   * @brief The minimum number of children of a non-root node
+   */
+  static constexpr size_t min_children = 3;
+
+  /**
+   * @brief Tree nodes
+   */
+  struct Node {
+    BoundingBox box;                             //!< the node box
+    Node *parent;                                //!< the parent node
+    std::vector<std::unique_ptr<Node>> children; //!< the children
+    std::vector<std::pair<BoundingBox, KEY>> entries; //!< the leaf entries
+    bool is_leaf;                                     //!< a leaf flag
+
+    /**
+     * @brief Build an empty node
+     *
+     * @param dim is the dimension of the node box
+     * @param is_leaf is a Boolean flag for leaves
+     */
+    Node(const size_t dim, const bool is_leaf):
+        box(empty_box(dim)), parent(nullptr), is_leaf(is_leaf)
+    {
+    }
+
+    /**
+     * @brief Get the number of children or entries of the node
+     *
+     * @return the number of children or entries of the node
+     */
+    inline size_t size() const
+    {
+      return (is_leaf ? entries.size() : children.size());
+    }
+
+    /**
+     * @brief Recompute the node box from its children or entries
+     */
+    void update_box()
+    {
+      box = empty_box(box.dim());
+      if (is_leaf) {
+        for (const auto &entry: entries) {
+          box.join_with(entry.first);
+        }
+      } else {
+        for (const auto &child: children) {
+          box.join_with(child->box);
+        }
+      }
+    }
+  };
+
+  std::unique_ptr<Node> _root; //!< the tree root
+  size_t _size;                //!< the number of indexed keys
+
+  /**
+   * @brief Build an empty box
+   *
+   * @param dim is the box dimension
+   * @return a box whose lower corner is above its upper corner
+   */
+  static BoundingBox empty_box(const size_t dim)
+  {
+    return BoundingBox(
+        LinearAlgebra::Vector<double>(dim,
+                                      std::numeric_limits<double>::infinity()),
+        LinearAlgebra::Vector<double>(
+            dim, -std::numeric_limits<double>::infinity()));
+  }
+
+  /**
+   * @brief Measure how much a box must grow to include another box
+   *
+   * @param box is the box to be enlarged
+   * @param added is the box to be included
+   * @return the sum of the side growths of `box`
+   */
+  static double enlargement(const BoundingBox &box, const BoundingBox &added)
+  {
+    double growth = 0;
+    for (size_t i = 0; i < box.dim(); ++i) {
+      if (added.lower_corner()[i] < box.lower_corner()[i]) {
+        growth += box.lower_corner()[i] - added.lower_corner()[i];
+      }
+      if (added.upper_corner()[i] > box.upper_corner()[i]) {
+        growth += added.upper_corner()[i] - box.upper_corner()[i];
+      }
+    }
+
+    return growth;
+  }
+
+  /**
+   * @brief Get the box of a child or entry
+   *
+   * @param child is a child node
+   * @return the box of `child`
+   */
+  static inline const BoundingBox &box_of(const std::unique_ptr<Node> &child)
+  {
+    return child->box;
+  }
+
+  /**
+   * @brief Get the box of a child or entry
+   *
+   * @param entry is a leaf entry
+   * @return the box of `entry`
+   */
+  static inline const BoundingBox &
+  box_of(const std::pair<BoundingBox, KEY> &entry)
+  {
+    return entry.first;
+  }
+
+  /**
+   * @brief Split the children or the entries of a node in two halves
+   *
+   * @tparam ELEMENT is the type of the children or entries
+   * @param elements are the children or entries to be split
+   * @return the second half of `elements`, which is removed
+   *         from `elements`
+   */
+  template<typename ELEMENT>
+  static std::vector<ELEMENT> split(std::vector<ELEMENT> &elements)
+  {
+    const size_t dim = box_of(elements.front()).dim();
+
+    // select the axis on which the lower corners are the most spread
+    size_t axis = 0;
+    double max_spread = -1;
+    for (size_t i = 0; i < dim; ++i) {
+      double min_value = std::numeric_limits<double>::infinity();
+      double max_value = -std::numeric_limits<double>::infinity();
+      for (const auto &element: elements) {
+        const double value = box_of(element).lower_corner()[i];
+        if (std::abs(value) != std::numeric_limits<double>::infinity()) {
+          min_value = std::min(min_value, value);
+          max_value = std::max(max_value, value);
+        }
+      }
+      if (min_value <= max_value && max_value - min_value > max_spread) {
+        max_spread = max_value - min_value;
+        axis = i;
+      }
+    }
+
+    std::sort(std::begin(elements), std::end(elements),
+              [axis](const ELEMENT &a, const ELEMENT &b) {
+                return box_of(a).lower_corner()[axis]
+                       < box_of(b).lower_corner()[axis];
+              });
+
+    const size_t half = elements.size() / 2;
+
+    std::vector<ELEMENT> second_half;
+    second_half.reserve(elements.size() - half);
+    for (auto it = std::begin(elements) + half; it != std::end(elements);
+         ++it) {
+      second_half.push_back(std::move(*it));
+    }
+    elements.erase(std::begin(elements) + half, std::end(elements));
+
+    return second_half;
+  }
+
+  /**
+   * @brief Select the leaf in which a box must be inserted
+   *
+   * @param box is the box to be inserted
+   * @return the leaf whose box needs the least enlargement
+   *         to include `box`
+   */
+  Node *choose_leaf(const BoundingBox &box) const
+  {
+    Node *node = _root.get();
+    while (!node->is_leaf) {
+      Node *selected = nullptr;
+      double min_growth = std::numeric_limits<double>::infinity();
+      for (const auto &child: node->children) {
+        const double growth = enlargement(child->box, box);
+        if (selected == nullptr || growth < min_growth) {
+          selected = child.get();
+          min_growth = growth;
+        }
+      }
+      node = selected;
+    }
+
+    return node;
+  }
+
+  /**
+   * @brief Split the overfull nodes from a node up to the root
+   *
+   * @param node is the first node to be checked
+   */
+  void split_overfull(Node *node)
+  {
+    while (node != nullptr && node->size() > max_children) {
+      const size_t dim = node->box.dim();
+      auto sibling = std::make_unique<Node>(dim, node->is_leaf);
+
+      if (node->is_leaf) {
+        sibling->entries = split(node->entries);
+      } else {
+        sibling->children = split(node->children);
+        for (auto &child: sibling->children) {
+          child->parent = sibling.get();
+        }
+      }
+      node->update_box();
+      sibling->update_box();
+
+      Node *parent = node->parent;
+      if (parent == nullptr) {
+        // the root has been split: grow the tree
+        auto new_root = std::make_unique<Node>(dim, false);
+
+        _root->parent = new_root.get();
+        sibling->parent = new_root.get();
+        new_root->children.push_back(std::move(_root));
+        new_root->children.push_back(std::move(sibling));
+        new_root->update_box();
+
+        _root = std::move(new_root);
+      } else {
+        sibling->parent = parent;
+        parent->children.push_back(std::move(sibling));
+      }
+      node = parent;
+    }
+  }
+
+  /**
+   * @brief Update the boxes from a node up to the root
+   *
+   * @param node is the first node to be updated
+   */
+  static void update_boxes(Node *node)
+  {
+    for (; node != nullptr; node = node->parent) {
+      node->update_box();
+    }
+  }
+
+  /**
+   * @brief Find the leaf storing an entry
+   *
+   * @param node is the root of the searched subtree
+   * @param box is the box of the entry
+   * @param key is the key of the entry
+   * @return a pointer to the leaf storing the entry
+   *         `(box, key)` or `nullptr` if no leaf in the
+   *         subtree stores it
+   */
+  static Node *find_leaf(Node *node, const BoundingBox &box, const KEY &key)
+  {
+    if (!node->box.includes(box)) {
+      return nullptr;
+    }
+
+    if (node->is_leaf) {
+      for (const auto &entry: node->entries) {
+        if (entry.second == key) {
+          return node;
+        }
+      }
+
+      return nullptr;
+    }
+
+    for (auto &child: node->children) {
+      Node *leaf = find_leaf(child.get(), box, key);
+      if (leaf != nullptr) {
+        return leaf;
+      }
+    }
+
+    return nullptr;
+  }
+
+  /**
+   * @brief Collect all the entries of a subtree
+   *
+   * @param node is the root of the subtree
+   * @param entries is the vector in which entries are collected
+   */
+  static void collect_entries(Node *node,
+                              std::vector<std::pair<BoundingBox, KEY>> &entries)
+  {
+    if (node->is_leaf) {
+      for (auto &entry: node->entries) {
+        entries.push_back(std::move(entry));
+      }
+    } else {
+      for (auto &child: node->children) {
+        collect_entries(child.get(), entries);
+      }
+    }
+  }
+
+  /**
+   * @brief Visit the entries overlapping a box
+   *
+   * @tparam FUNCTION is the type of the visiting function
+   * @param node is the root of the visited subtree
+   * @param box is the query box
+   * @param visit is the function called on the key of each
+   *        entry whose box overlaps `box`
+   */
+  template<typename FUNCTION>
+  static void visit_overlapping(const Node *node, const BoundingBox &box,
+                                FUNCTION &visit)
+  {
+    if (are_disjoint(node->box, box)) {
+      return;
+    }
+
+    if (node->is_leaf) {
+      for (const auto &entry: node->entries) {
+        if (!are_disjoint(entry.first, box)) {
+          visit(entry.second);
+        }
+      }
+    } else {
+      for (const auto &child: node->children) {
+        visit_overlapping(child.get(), box, visit);
+      }
+    }
+  }
+
+public:
+  /**
+   * @brief Build an empty tree
+   */
+  BoxTree(): _root(nullptr), _size(0) {}
+
+  /**
+   * @brief Get the number of indexed keys
+   *
+   * @return the number of indexed keys
+   */
+  inline size_t size() const
+  {
+    return _size;
+  }
+
+  /**
+   * @brief Remove all the keys from the tree
+   */
+  inline void clear()
+  {
+    _root.reset();
+    _size = 0;
+  }
+
+  /**
+   * @brief Index a key
+   *
+   * @param box is the bounding box of the object referred by `key`
+   * @param key is the key to be indexed
+   */
+  void insert(const BoundingBox &box, const KEY &key)
+  {
+    if (_root == nullptr) {
+      _root = std::make_unique<Node>(box.dim(), true);
+    }
+
+    if (_root->box.dim() != box.dim()) {
+      SAPO_ERROR("the box and the tree differ in dimension",
+                 std::domain_error);
+    }
+
+    Node *leaf = choose_leaf(box);
+    leaf->entries.emplace_back(box, key);
+    update_boxes(leaf);
+    split_overfull(leaf);
+
+    ++_size;
+  }
+
+  /**
+   * @brief Remove a key from the tree
+   *
+   * @param box is the box with which `key` was indexed
+   * @param key is the key to be removed
+   * @return `true` if and only if `key` was indexed by `box`
+   */
+  bool erase(const BoundingBox &box, const KEY &key)
+  {
+    if (_root == nullptr) {
+      return false;
+    }
+
+    Node *node = find_leaf(_root.get(), box, key);
+    if (node == nullptr) {
+      return false;
+    }
+
+    auto &entries = node->entries;
+    for (auto it = std::begin(entries); it != std::end(entries); ++it) {
+      if (it->second == key) {
+        entries.erase(it);
+        break;
+      }
+    }
+    --_size;
+
+    // dissolve the underfull nodes and collect their entries
+    std::vector<std::pair<BoundingBox, KEY>> orphans;
+    while (node->parent != nullptr) {
+      Node *parent = node->parent;
+      if (node->size() < min_children) {
+        collect_entries(node, orphans);
+
+        auto &siblings = parent->children;
+        for (auto it = std::begin(siblings); it != std::end(siblings); ++it) {
+          if (it->get() == node) {
+            siblings.erase(it);
+            break;
+          }
+        }
+      } else {
+        node->update_box();
+      }
+      node = parent;
+    }
+    _root->update_box();
+
+    // shrink the tree while the root has a single child
+    while (!_root->is_leaf && _root->children.size() == 1) {
+      std::unique_ptr<Node> child = std::move(_root->children.front());
+      child->parent = nullptr;
+      _root = std::move(child);
+    }
+
+    if (!_root->is_leaf && _root->children.empty()) {
+      _root = std::make_unique<Node>(box.dim(), true);
+    }
+
+    // re-insert the orphan entries
+    _size -= orphans.size();
+    for (const auto &orphan: orphans) {
+      insert(orphan.first, orphan.second);
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief Call a function on the keys whose boxes overlap a box
+   *
+   * @tparam FUNCTION is the type of the function
+   * @param box is the query box
+   * @param visit is the function called on each key indexed by a
+   *        box that is not disjoint from `box`
+   */
+  template<typename FUNCTION>
+  void for_each_overlapping(const BoundingBox &box, FUNCTION visit) const
+  {
+    if (_root != nullptr && _size > 0) {
+      visit_overlapping(_root.get(), box, visit);
+    }
+  }
+};
+
+#endif // BOXTREE_H_
@@ -15,6 +15,8 @@
 #include <set>
 
 #include "LinearAlgebra.h"
+#include "BoundingBox.h"
+#include "MemoizedProperties.h"
 #include "Bernstein.h"
 #include "Polytope.h"
 #include "Parallelotope.h"
@@ -190,6 +192,8 @@ class Bundle
   LinearAlgebra::Vector<double> _upper_bounds; //!< direction lower bounds
   std::set<BundleTemplate> _templates;         //!< bundle templates
 
+  mutable MemoizedProperties _memo; //!< the memoized bundle properties
+
   /**
    * @brief A draft horse function to split a bundle
    *
@@ -504,12 +508,44 @@ public:
   /**
    * @brief Test whether the bundle is empty
    *
+   * When Sapo is compiled with `WITH_CERTIFIED_PREDICATES`, the
+   * answers of this method and of the inclusion and disjointness
+   * tests are certified by exact rational arithmetic.
+   * The answer is memoized together with a point of the bundle,
+   * so that the following emptiness tests cost nothing and the
+   * inclusion and disjointness tests may be decided by that point.
+   *
    * @return `true` if and only if the bundle is empty
    */
-  inline bool is_empty() const
-  {
-    return static_cast<Polytope>(*this).is_empty();
-  }
+  bool is_empty() const;
+
+  /**
+   * @brief Get an axis-aligned box including the bundle
+   *
+   * The box is the intersection of the boxes including the bundle
+   * template parallelotopes. In certified builds, these boxes are
+   * computed in exact arithmetic and rounded outward; otherwise,
+   * they are enlarged by a bound for the error of the floating-point
+   * template inverses. Thus, the box includes the bundle and it can
+   * be used by conservative tests without solving any linear problem.
+   * The box is memoized.
+   *
+   * @return an axis-aligned box including the bundle
+   */
+  BoundingBox bounding_box() const;
+
+  /**
+   * @brief Get an optimizer for many objectives over the bundle
+   *
+   * The returned optimizer handles every bundle direction as a single
+   * ranged row and starts the dual simplex method from the directions
+   * of one of the bundle templates.
+   *
+   * @param obj_funs is the vector of the objective functions
+   * @return an optimizer for the objective functions over the bundle
+   */
+  BoundedDualSimplexOptimizer<double>
+  optimizer(const std::vector<LinearAlgebra::Vector<double>> &obj_funs) const;
 
   /**
    * @brief Test whether the bundle interior is empty
@@ -607,7 +643,7 @@ public:
    *
    * Get the canonical form for this bundle by minimizing the
    * difference between lower and upper bounds over all the
-   * directions.
+   * directions. See `canonize()` for the certified builds.
    *
    * @returns canonized bundle
    */
@@ -618,7 +654,10 @@ public:
    *
    * Turn this bundle in canonical form by minimizing the
    * difference between lower and upper bounds over all the
-   * directions.
+   * directions. Bundles known to be canonical or empty are
+   * not changed. When Sapo is compiled with
+   * `WITH_CERTIFIED_PREDICATES`, the new bounds are exact optima
+   * rounded outward, so that canonization never loses points.
    *
    * @returns a reference to the canonized bundle
    */
@@ -703,6 +742,8 @@ public:
 
   friend Bundle over_approximate_union(const Bundle &b1, const Bundle &b2);
 
+  friend bool are_disjoint(const Bundle &A, const Bundle &B);
+
   friend SetsUnion<Bundle> subtract_and_close(const Bundle &b1,
                                               const Bundle &b2);
 
@@ -0,0 +1,464 @@
+/**
+ * @file CompiledExpression.h
+ * @author Alberto Casagrande <acasagrande@units.it>
+ * @brief Compile symbolic expressions into straight-line programs
+ * @version 0.1
+ * @date 2022-11-07
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef COMPILED_EXPRESSION_H_
+#define COMPILED_EXPRESSION_H_
+
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include "SymbolicAlgebra.h"
+#include "ErrorHandling.h"
+#include "BinaryIO.h"
+
+namespace SymbolicAlgebra
+{
+
+/**
+ * @brief Vectors of expressions compiled into a straight-line program
+ *
+ * The objects of this class represent a vector of rational expressions
+ * as a flat sequence of arithmetic instructions over a register file.
+ * The first registers are the slots, i.e., the registers that store
+ * the values of the compiled expression symbols. Each of the remaining
+ * registers either stores a constant or the result of an instruction.
+ * The expression numerators and denominators are compiled in Horner
+ * form according to the slot order and equal sub-expressions are
+ * computed only once. Evaluating all the compiled expressions requires
+ * a single pass on the instruction sequence and avoids the tree walks
+ * and the symbol lookups of `Expression<C>::apply`.
+ *
+ * @tparam C is the type of numeric constants
+ */
+template<typename C = double>
+class CompiledExpressions
+{
+public:
+  using RegisterIndex = unsigned int; //!< Register index type
+
+private:
+  /**
+   * @brief Instruction operation codes
+   */
+  typedef enum {
+    ADD, // Addition
+    MUL, // Multiplication
+    DIV  // Division
+  } OpCode;
+
+  /**
+   * @brief Instructions of the straight-line program
+   */
+  struct Instruction {
+    OpCode op;            //!< the instruction operation
+    RegisterIndex result; //!< the result register
+    RegisterIndex lhs;    //!< the left operand register
+    RegisterIndex rhs;    //!< the right operand register
+  };
+
+  size_t _num_of_slots; //!< the number of slots
+
+  std::vector<C> _registers; //!< the initial register file
+  std::vector<bool>
+      _is_constant; //!< a flag per register to mark the constant ones
+
+  std::vector<Instruction> _program; //!< the instruction sequence
+  std::vector<RegisterIndex>
+      _outputs; //!< the registers storing the expression values
+
+  std::map<C, RegisterIndex>
+      _constants; //!< the registers storing each constant value
+  std::map<std::tuple<OpCode, RegisterIndex, RegisterIndex>, RegisterIndex>
+      _value_numbers; //!< the registers storing each instruction result
+  std::vector<std::vector<RegisterIndex>>
+      _powers; //!< the registers storing the powers of each slot
+
+  /**
+   * @brief Get the register storing a constant
+   *
+   * @param value is the aimed constant value
+   * @return the index of a register storing `value`
+   */
+  RegisterIndex constant(const C &value)
+  {
+    auto found = _constants.find(value);
+    if (found != std::end(_constants)) {
+      return found->second;
+    }
+
+    const RegisterIndex index = _registers.size();
+
+    _registers.push_back(value);
+    _is_constant.push_back(true);
+    _constants[value] = index;
+
+    return index;
+  }
+
+  /**
+   * @brief Test whether a register stores a specific constant
+   *
+   * @param index is the index of the register
+   * @param value is a constant value
+   * @return `true` if and only if the register `index` is a
+   *         constant register storing `value`
+   */
+  inline bool is_constant(const RegisterIndex &index, const C &value) const
+  {
+    return _is_constant[index] && _registers[index] == value;
+  }
+
+  /**
+   * @brief Get the register storing the result of an operation
+   *
+   * This method returns a register storing the result of
+   * an operation. A new instruction is appended to the program
+   * if and only if the operation cannot be simplified nor folded
+   * and it has not been already compiled.
+   *
+   * @param op is the operation code
+   * @param lhs is the left operand register
+   * @param rhs is the right operand register
+   * @return the index of a register storing the operation result
+   */
+  RegisterIndex operation(const OpCode op, RegisterIndex lhs,
+                          RegisterIndex rhs)
+  {
+    if (_is_constant[lhs] && _is_constant[rhs]) {
+      switch (op) {
+      case ADD:
+        return constant(_registers[lhs] + _registers[rhs]);
+      case MUL:
+        return constant(_registers[lhs] * _registers[rhs]);
+      case DIV:
+        return constant(_registers[lhs] / _registers[rhs]);
+      }
+    }
+
+    switch (op) {
+    case ADD:
+      if (is_constant(lhs, 0)) {
+        return rhs;
+      }
+      if (is_constant(rhs, 0)) {
+        return lhs;
+      }
+      break;
+    case MUL:
+      if (is_constant(lhs, 0) || is_constant(rhs, 1)) {
+        return lhs;
+      }
+      if (is_constant(rhs, 0) || is_constant(lhs, 1)) {
+        return rhs;
+      }
+      break;
+    case DIV:
+      if (is_constant(rhs, 1)) {
+        return lhs;
+      }
+      break;
+    }
+
+    // addition and multiplication commute
+    if (op != DIV && rhs < lhs) {
+      std::swap(lhs, rhs);
+    }
+
+    const auto key = std::make_tuple(op, lhs, rhs);
+    auto found = _value_numbers.find(key);
+    if (found != std::end(_value_numbers)) {
+      return found->second;
+    }
+
+    const RegisterIndex index = _registers.size();
+
+    _registers.push_back(0);
+    _is_constant.push_back(false);
+    _program.push_back(Instruction{op, index, lhs, rhs});
+    _value_numbers[key] = index;
+
+    return index;
+  }
+
+  /**
+   * @brief Get the register storing the power of a slot
+   *
+   * @param slot is the slot index
+   * @param degree is the exponent
+   * @return the index of a register storing the `degree`-th
+   *         power of the `slot`-th slot
+   */
+  RegisterIndex power(const size_t slot, const unsigned int degree)
+  {
+    std::vector<RegisterIndex> &powers = _powers[slot];
+
+    if (powers.size() == 0) {
+      powers.push_back(constant(1));
+      powers.push_back(slot);
+    }
+
+    while (powers.size() <= degree) {
+      const size_t next_degree = powers.size();
+
+      powers.push_back(operation(MUL, powers[next_degree / 2],
+                                 powers[next_degree - next_degree / 2]));
+    }
+
+    return powers[degree];
+  }
+
+  /**
+   * @brief Compile a polynomial in Horner form
+   *
+   * @param polynomial is the polynomial to be compiled
+   * @param slots is the vector of the slot symbols
+   * @param first_slot is the index of the first slot that may
+   *        occur in `polynomial`
+   * @return the index of the register storing the polynomial value
+   */
+  RegisterIndex compile_polynomial(const Expression<C> &polynomial,
+                                   const std::vector<Symbol<C>> &slots,
+                                   size_t first_slot)
+  {
+    if (!polynomial.has_symbols()) {
+      return constant(polynomial.evaluate());
+    }
+
+    while (first_slot < slots.size()
+           && polynomial.degree(slots[first_slot]) == 0) {
+      ++first_slot;
+    }
+
+    // the polynomial contains a symbol that is not a slot
+    if (first_slot == slots.size()) {
+      throw symbol_evaluation_error(*(polynomial.get_symbols(1).begin()));
+    }
+
+    const auto coeffs = polynomial.get_coeffs(slots[first_slot]);
+
+    auto coeff_it = coeffs.rbegin();
+    RegisterIndex result
+        = compile_polynomial(coeff_it->second, slots, first_slot + 1);
+    int degree = coeff_it->first;
+
+    for (++coeff_it; coeff_it != coeffs.rend(); ++coeff_it) {
+      result = operation(MUL, result,
+                         power(first_slot, degree - coeff_it->first));
+      result = operation(
+          ADD, result,
+          compile_polynomial(coeff_it->second, slots, first_slot + 1));
+
+      degree = coeff_it->first;
+    }
+
+    return operation(MUL, result, power(first_slot, degree));
+  }
+
+public:
+  /**
+   * @brief The empty constructor
+   */
+  CompiledExpressions():
+      _num_of_slots(0), _registers(), _is_constant(), _program(),
+      _outputs(), _constants(), _value_numbers(), _powers()
+  {
+  }
+
+  /**
+   * @brief Compile a vector of expressions
+   *
+   * @param expressions is the vector of the expressions to be compiled
+   * @param slots is the vector of the symbols in `expressions`. The
+   *        values of these symbols must be passed to `evaluate` in
+   *        the same order
+   * @throw symbol_evaluation_error if one of the expressions contains
+   *        a symbol not in `slots`
+   */
+  CompiledExpressions(const std::vector<Expression<C>> &expressions,
+                      const std::vector<Symbol<C>> &slots):
+      _num_of_slots(slots.size()),
+      _registers(slots.size(), 0), _is_constant(slots.size(), false),
+      _program(), _outputs(), _constants(), _value_numbers(),
+      _powers(slots.size())
+  {
+    _outputs.reserve(expressions.size());
+    for (const auto &expression: expressions) {
+      const auto rational_form = expression.get_rational_form();
+
+      auto numerator
+          = compile_polynomial(rational_form.get_numerator(), slots, 0);
+      auto denominator
+          = compile_polynomial(rational_form.get_denominator(), slots, 0);
+
+      _outputs.push_back(operation(DIV, numerator, denominator));
+    }
+
+    // the compilation tables are useless from now on
+    _constants.clear();
+    _value_numbers.clear();
+    _powers.clear();
+  }
+
+  /**
+   * @brief Write the compiled expressions in a binary stream
+   *
+   * @param os is the output stream
+   */
+  void write(std::ostream &os) const
+  {
+    BinaryIO::write(os, static_cast<uint64_t>(_num_of_slots));
+    BinaryIO::write(os, _registers);
+
+    BinaryIO::write(os, static_cast<uint64_t>(_program.size()));
+    for (const Instruction &instruction: _program) {
+      BinaryIO::write(os, static_cast<uint64_t>(instruction.op));
+      BinaryIO::write(os, static_cast<uint64_t>(instruction.result));
+      BinaryIO::write(os, static_cast<uint64_t>(instruction.lhs));
+      BinaryIO::write(os, static_cast<uint64_t>(instruction.rhs));
+    }
+
+    BinaryIO::write(os, std::vector<uint64_t>(std::begin(_outputs),
+                                              std::end(_outputs)));
+  }
+
+  /**
+   * @brief Read compiled expressions from a binary stream
+   *
+   * @param is is the input stream
+   * @return the compiled expressions stored in `is` by `write`
+   * @throw std::runtime_error if `is` does not contain valid
+   *        compiled expressions
+   */
+  static CompiledExpressions<C> read(std::istream &is)
+  {
+    CompiledExpressions<C> compiled;
+
+    compiled._num_of_slots = BinaryIO::read<uint64_t>(is);
+    compiled._registers = BinaryIO::read_vector<C>(is);
+
+    const size_t num_of_registers = compiled._registers.size();
+    if (compiled._num_of_slots > num_of_registers) {
+      SAPO_ERROR("wrong number of slots", std::runtime_error);
+    }
+
+    // the registers that are neither slots nor instruction
+    // results store constants
+    compiled._is_constant = std::vector<bool>(num_of_registers, true);
+    std::fill(std::begin(compiled._is_constant),
+              std::begin(compiled._is_constant) + compiled._num_of_slots,
+              false);
+
+    const uint64_t program_size = BinaryIO::read<uint64_t>(is);
+    for (uint64_t i = 0; i < program_size; ++i) {
+      const uint64_t op = BinaryIO::read<uint64_t>(is);
+      const uint64_t result = BinaryIO::read<uint64_t>(is);
+      const uint64_t lhs = BinaryIO::read<uint64_t>(is);
+      const uint64_t rhs = BinaryIO::read<uint64_t>(is);
+
+      if (op > DIV || result >= num_of_registers || lhs >= num_of_registers
+          || rhs >= num_of_registers) {
+        SAPO_ERROR("wrong instruction", std::runtime_error);
+      }
+
+      compiled._program.push_back(Instruction{
+          static_cast<OpCode>(op), static_cast<RegisterIndex>(result),
+          static_cast<RegisterIndex>(lhs), static_cast<RegisterIndex>(rhs)});
+      compiled._is_constant[result] = false;
+    }
+
+    for (const uint64_t &output: BinaryIO::read_vector<uint64_t>(is)) {
+      if (output >= num_of_registers) {
+        SAPO_ERROR("wrong output register", std::runtime_error);
+      }
+      compiled._outputs.push_back(output);
+    }
+
+    return compiled;
+  }
+
+  /**
+   * @brief Get the number of slots
+   *
+   * @return the number of slots of the compiled expressions
+   */
+  inline const size_t &num_of_slots() const
+  {
+    return _num_of_slots;
+  }
+
+  /**
+   * @brief Get the number of compiled expressions
+   *
+   * @return the number of compiled expressions
+   */
+  inline size_t size() const
+  {
+    return _outputs.size();
+  }
+
+  /**
+   * @brief Get the number of instructions
+   *
+   * @return the number of instructions in the compiled program
+   */
+  inline size_t num_of_instructions() const
+  {
+    return _program.size();
+  }
+
+  /**
+   * @brief Evaluate the compiled expressions
+   *
+   * @param slot_values is the vector of the slot values
+   * @return the vector of the expression values when the slot
+   *         symbols are interpreted as in `slot_values`
+   */
+  std::vector<C> evaluate(const std::vector<C> &slot_values) const
+  {
+    if (slot_values.size() != _num_of_slots) {
+      SAPO_ERROR("the number of values differs from the number of slots",
+                 std::domain_error);
+    }
+
+    std::vector<C> registers(_registers);
+    std::copy(std::begin(slot_values), std::end(slot_values),
+              std::begin(registers));
+
+    for (const Instruction &instruction: _program) {
+      const C &lhs = registers[instruction.lhs];
+      const C &rhs = registers[instruction.rhs];
+
+      switch (instruction.op) {
+      case ADD:
+        registers[instruction.result] = lhs + rhs;
+        break;
+      case MUL:
+        registers[instruction.result] = lhs * rhs;
+        break;
+      case DIV:
+        registers[instruction.result] = lhs / rhs;
+        break;
+      }
+    }
+
+    std::vector<C> values;
+    values.reserve(_outputs.size());
+    for (const RegisterIndex &output: _outputs) {
+      values.push_back(registers[output]);
+    }
+
+    return values;
+  }
+};
+
+} // namespace SymbolicAlgebra
+
+#endif // COMPILED_EXPRESSION_H_
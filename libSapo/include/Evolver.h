@@ -11,21 +11,55 @@
 #ifndef EVOLVER_H_
 #define EVOLVER_H_
 
-#ifdef WITH_THREADS
-#include <shared_mutex>
-#endif // WITH_THREADS
+#include <atomic>
+#include <cstdio> // rename
+#include <fstream>
+#include <functional> // hash
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <tuple>
 
 #include "DiscreteSystem.h"
 
 #include "Bundle.h"
 #include "Polytope.h"
 #include "SetsUnion.h"
+#include "CompiledExpression.h"
+#include "ExpressionDAG.h"
+#include "BinaryIO.h"
 
 #include "STL/Atom.h"
 
 // define the maximum admissible length for a parallelotope edge
 #define EDGE_MAX_LENGTH 1e18
 
+// define the default number of directions refined by a thread pool task
+#define DEFAULT_DIRECTIONS_PER_TASK 4
+
+// define the default number of buckets in the Bernstein coefficient caches
+#define DEFAULT_BERNSTEIN_CACHE_BUCKETS 4096
+
+// define the Bernstein cache file magic number ("SAPOBERN") and version
+#define BERNSTEIN_CACHE_FILE_MAGIC 0x4e5245424f504153
+#define BERNSTEIN_CACHE_FILE_VERSION 1
+
+/**
+ * @brief A cache for the Bernstein coefficients
+ *
+ * This class stores the symbolic and the compiled Bernstein coefficients
+ * of non-adaptive parallelotopes. Entries are indexed by a hash of the
+ * parallelotope generators and of the direction. The generator hash can
+ * be computed once per parallelotope and passed to the look-up methods.
+ *
+ * Each cache is an insert-only hash table whose buckets are lock-free
+ * lists of immutable entries: look-ups never lock and only compete with
+ * insertions in the same bucket. Once stored, an entry is neither
+ * overwritten nor removed until the cache is destroyed, so the
+ * references returned by the cache methods remain valid.
+ *
+ * @tparam T is the type of expression value domain
+ */
 template<typename T>
 class BernsteinCache
 {
@@ -40,145 +74,489 @@ class BernsteinCache
   using coefficients_type = std::vector<SymbolicAlgebra::Expression<T>>;
 
   /**
-   * @brief Parallelotope generators type
+   * @brief Compiled Bernstein coefficient vector type
    */
-  using generators_type = std::vector<LinearAlgebra::Vector<T>>;
+  using compiled_coefficients_type = SymbolicAlgebra::CompiledExpressions<T>;
 
   /**
-   * @brief Maps that associate directions to Bernstein coefficients
+   * @brief Parallelotope generators type
    */
-  using direction2coefficient_type
-      = std::map<direction_type, coefficients_type>;
+  using generators_type = std::vector<LinearAlgebra::Vector<T>>;
 
   /**
-   * @brief Maps that associate generators to direction to Bernstein
-   * coefficient map
+   * @brief Insert-only lock-free hash tables
+   *
+   * @tparam V is the type of the stored values
    */
-  using cache_type = std::map<generators_type, direction2coefficient_type>;
+  template<typename V>
+  class HashTable
+  {
+    /**
+     * @brief Hash table entries
+     */
+    struct Entry {
+      const size_t hash;                //!< the entry key hash
+      const generators_type generators; //!< the parallelotope generators
+      const direction_type direction;   //!< the direction
+      const V value;                    //!< the stored value
+      Entry *next;                      //!< the next entry in the bucket
+
+      /**
+       * @brief A constructor
+       *
+       * @param hash is the key hash
+       * @param generators is the parallelotope generators
+       * @param direction is the direction
+       * @param value is the value to be stored
+       */
+      Entry(const size_t hash, const generators_type &generators,
+            const direction_type &direction, V &&value):
+          hash(hash), generators(generators), direction(direction),
+          value(std::move(value)), next(nullptr)
+      {
+      }
+
+      /**
+       * @brief Test whether the entry has a key
+       *
+       * @param hash is the key hash
+       * @param generators is the parallelotope generators
+       * @param direction is the direction
+       * @return `true` if and only if the entry key is the pair
+       *         `generators`-`direction`
+       */
+      inline bool has_key(const size_t hash, const generators_type &generators,
+                          const direction_type &direction) const
+      {
+        return this->hash == hash && this->direction == direction
+               && this->generators == generators;
+      }
+    };
+
+    size_t _num_of_buckets; //!< the number of buckets
+    std::unique_ptr<std::atomic<Entry *>[]> _buckets; //!< the bucket lists
+
+    /**
+     * @brief Get the bucket of a hash
+     *
+     * @param hash is a key hash
+     * @return the bucket of the keys whose hash is `hash`
+     */
+    inline std::atomic<Entry *> &bucket(const size_t hash) const
+    {
+      return _buckets[hash % _num_of_buckets];
+    }
+
+    /**
+     * @brief Search for an entry in a bucket list
+     *
+     * @param entry is the first entry of the list
+     * @param hash is the key hash
+     * @param generators is the parallelotope generators
+     * @param direction is the direction
+     * @return a pointer to the entry whose key is the pair
+     *         `generators`-`direction` or `nullptr` if it
+     *         is not in the list
+     */
+    static const Entry *find_in_list(const Entry *entry, const size_t hash,
+                                     const generators_type &generators,
+                                     const direction_type &direction)
+    {
+      for (; entry != nullptr; entry = entry->next) {
+        if (entry->has_key(hash, generators, direction)) {
+          return entry;
+        }
+      }
 
-  cache_type _cache;
+      return nullptr;
+    }
 
-#ifdef WITH_THREADS
+  public:
+    /**
+     * @brief A constructor
+     *
+     * @param num_of_buckets is the number of buckets
+     */
+    HashTable(const size_t num_of_buckets):
+        _num_of_buckets(std::max(num_of_buckets, static_cast<size_t>(1))),
+        _buckets(new std::atomic<Entry *>[_num_of_buckets])
+    {
+      for (size_t i = 0; i < _num_of_buckets; ++i) {
+        _buckets[i].store(nullptr, std::memory_order_relaxed);
+      }
+    }
 
-  mutable std::shared_timed_mutex _mutex; //!< Cache mutex
+    /**
+     * @brief The copy constructor
+     *
+     * @param orig is the original instance of the object
+     */
+    HashTable(const HashTable &orig): HashTable(orig._num_of_buckets)
+    {
+      for (size_t i = 0; i < _num_of_buckets; ++i) {
+        const Entry *entry = orig._buckets[i].load(std::memory_order_acquire);
+        for (; entry != nullptr; entry = entry->next) {
+          insert(entry->hash, entry->generators, entry->direction,
+                 V(entry->value));
+        }
+      }
+    }
 
-#endif // WITH_THREADS
+    /**
+     * @brief Search for a value
+     *
+     * @param hash is the key hash
+     * @param generators is the parallelotope generators
+     * @param direction is the direction
+     * @return a pointer to the value associated to the pair
+     *         `generators`-`direction` or `nullptr` if the
+     *         table does not contain it
+     */
+    const V *find(const size_t hash, const generators_type &generators,
+                  const direction_type &direction) const
+    {
+      const Entry *entry
+          = find_in_list(bucket(hash).load(std::memory_order_acquire), hash,
+                         generators, direction);
+
+      return (entry == nullptr ? nullptr : &(entry->value));
+    }
+
+    /**
+     * @brief Insert a value unless its key is already in the table
+     *
+     * @param hash is the key hash
+     * @param generators is the parallelotope generators
+     * @param direction is the direction
+     * @param value is the value to be inserted
+     * @return a reference to the value associated to the pair
+     *         `generators`-`direction` in the table
+     */
+    const V &insert(const size_t hash, const generators_type &generators,
+                    const direction_type &direction, V &&value)
+    {
+      std::atomic<Entry *> &head = bucket(hash);
+
+      Entry *new_entry
+          = new Entry(hash, generators, direction, std::move(value));
+
+      Entry *first = head.load(std::memory_order_acquire);
+      do {
+        // another thread may have already stored and be using
+        // a value for the same key: never overwrite it
+        const Entry *found
+            = find_in_list(first, hash, generators, direction);
+        if (found != nullptr) {
+          delete new_entry;
+
+          return found->value;
+        }
+
+        new_entry->next = first;
+      } while (!head.compare_exchange_weak(first, new_entry,
+                                           std::memory_order_acq_rel,
+                                           std::memory_order_acquire));
+
+      return new_entry->value;
+    }
+
+    /**
+     * @brief Apply a function to all the table entries
+     *
+     * @tparam FUNCTION is the type of the function
+     * @param function is a function whose parameters are the
+     *        generators, the direction, and the value of an entry
+     */
+    template<typename FUNCTION>
+    void for_each(FUNCTION function) const
+    {
+      for (size_t i = 0; i < _num_of_buckets; ++i) {
+        const Entry *entry = _buckets[i].load(std::memory_order_acquire);
+        for (; entry != nullptr; entry = entry->next) {
+          function(entry->generators, entry->direction, entry->value);
+        }
+      }
+    }
+
+    /**
+     * @brief Destroyer
+     */
+    ~HashTable()
+    {
+      for (size_t i = 0; i < _num_of_buckets; ++i) {
+        Entry *entry = _buckets[i].load(std::memory_order_relaxed);
+        while (entry != nullptr) {
+          Entry *next = entry->next;
+
+          delete entry;
+
+          entry = next;
+        }
+      }
+    }
+  };
+
+  /**
+   * @brief Combine a hash value into another one
+   *
+   * @param seed is the hash value to be updated
+   * @param value is the value whose hash must be combined into `seed`
+   */
+  static inline void hash_combine(size_t &seed, const T &value)
+  {
+    seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  }
+
+  HashTable<coefficients_type> _cache; //!< the symbolic coefficient cache
+  HashTable<compiled_coefficients_type>
+      _compiled_cache; //!< the compiled coefficient cache
 
 public:
   /**
    * @brief The empty constructor
+   *
+   * @param num_of_buckets is the number of buckets in each cache table
    */
-  BernsteinCache(): _cache() {}
+  BernsteinCache(
+      const size_t num_of_buckets = DEFAULT_BERNSTEIN_CACHE_BUCKETS):
+      _cache(num_of_buckets), _compiled_cache(num_of_buckets)
+  {
+  }
 
   /**
    * @brief The copy constructor
    *
    * @param orig is the original instance of the object
    */
-  BernsteinCache(const BernsteinCache &orig): _cache(orig._cache) {}
+  BernsteinCache(const BernsteinCache &orig):
+      _cache(orig._cache), _compiled_cache(orig._compiled_cache)
+  {
+  }
 
   /**
-   * @brief Check whether the Bernstein coefficients are cached
-   *
-   * This method checks whether the symbolic Bernstein coefficients
-   * for a parallelotope and a direction are stored in the cache.
+   * @brief Compute the hash of parallelotope generators
    *
-   * @param P is a parallelotope
-   * @param direction is a direction
-   * @return `true` if and only if the coefficients for `P` and
-   *         `direction` are cached
+   * @param generators is the vector of parallelotope generators
+   * @return the hash of `generators`
    */
-  bool coefficients_in_cache(const Parallelotope &P,
-                             const LinearAlgebra::Vector<T> &direction) const
+  static size_t hash(const generators_type &generators)
   {
-#ifdef WITH_THREADS
-    std::shared_lock<std::shared_timed_mutex> readlock(_mutex);
-#endif // WITH_THREADS
+    size_t seed = generators.size();
+    for (const auto &generator: generators) {
+      for (const auto &value: generator) {
+        hash_combine(seed, value);
+      }
+    }
 
-    auto P_found = _cache.find(P.generators());
+    return seed;
+  }
 
-    if (P_found == std::end(_cache)) {
-      return false;
+  /**
+   * @brief Compute the hash of a cache key
+   *
+   * @param generators_hash is the hash of the parallelotope generators
+   * @param direction is a direction
+   * @return the hash of the key made of the generators and `direction`
+   */
+  static size_t hash(const size_t generators_hash,
+                     const direction_type &direction)
+  {
+    size_t seed = generators_hash;
+    for (const auto &value: direction) {
+      hash_combine(seed, value);
     }
 
-    auto dir_found = P_found->second.find(direction);
-
-    return dir_found != std::end(P_found->second);
+    return seed;
   }
 
   /**
-   * @brief Get the cached Bernstein coefficients
-   *
-   * This method returns a reference to the cached symbolic
-   * Bernstein coefficients for a parallelotope and a
-   * direction.
+   * @brief Search for the cached Bernstein coefficients
    *
+   * @param generators_hash is the hash of the generators of `P`
    * @param P is a parallelotope
    * @param direction is a direction
-   * @return the cached symbolic Bernstein coefficients for `P`,
-   *         `direction`, and the current evolver
+   * @return a pointer to the cached symbolic Bernstein coefficients
+   *         for `P` and `direction` or `nullptr` if they are not cached
    */
-  const std::vector<SymbolicAlgebra::Expression<T>> &
-  get_coefficients(const Parallelotope &P,
-                   const LinearAlgebra::Vector<T> &direction) const
+  const coefficients_type *
+  find_coefficients(const size_t generators_hash, const Parallelotope &P,
+                    const direction_type &direction) const
   {
-#ifdef WITH_THREADS
-    std::shared_lock<std::shared_timed_mutex> readlock(_mutex);
-#endif // WITH_THREADS
-
-    return _cache.at(P.generators()).at(direction);
+    return _cache.find(hash(generators_hash, direction), P.generators(),
+                       direction);
   }
 
-public:
   /**
    * @brief Store the Bernstein coefficients
    *
-   * This method stores the Bernstein coefficients
-   * of a parallelotope and a direction in the cache.
+   * This method stores the Bernstein coefficients of a parallelotope
+   * and a direction in the cache, unless they have been already stored.
+   * Coefficients allocated in an expression arena are copied into
+   * long-lived storage, so that the cache outlives the arena.
    *
+   * @param[in] generators_hash is the hash of the generators of `P`
    * @param[in] P is a parallelotope
    * @param[in] direction is a direction
    * @param[in] coefficients is the vector of Bernstein coefficients
+   * @return a reference to the cached Bernstein coefficients
    */
-  const std::vector<SymbolicAlgebra::Expression<T>> &save_coefficients(
-      const Parallelotope &P, const LinearAlgebra::Vector<T> &direction,
-      const std::vector<SymbolicAlgebra::Expression<T>> &coefficients)
+  const coefficients_type &
+  save_coefficients(const size_t generators_hash, const Parallelotope &P,
+                    const direction_type &direction,
+                    coefficients_type &&coefficients)
   {
-#ifdef WITH_THREADS
-    std::unique_lock<std::shared_timed_mutex> writelock(_mutex);
-#endif // WITH_THREADS
+    if (SymbolicAlgebra::ExpressionArena::in_arena()) {
+      SymbolicAlgebra::ExpressionArena::Scope heap_scope(nullptr);
 
-    auto &cached_coefficients = _cache[P.generators()][direction];
+      coefficients_type promoted(coefficients);
 
-    cached_coefficients = coefficients;
+      return _cache.insert(hash(generators_hash, direction), P.generators(),
+                           direction, std::move(promoted));
+    }
 
-    return cached_coefficients;
+    return _cache.insert(hash(generators_hash, direction), P.generators(),
+                         direction, std::move(coefficients));
   }
 
   /**
-   * @brief Store the Bernstein coefficients
+   * @brief Search for the cached compiled Bernstein coefficients
+   *
+   * @param generators_hash is the hash of the generators of `P`
+   * @param P is a parallelotope
+   * @param direction is a direction
+   * @return a pointer to the cached compiled Bernstein coefficients
+   *         for `P` and `direction` or `nullptr` if they are not cached
+   */
+  const compiled_coefficients_type *
+  find_compiled_coefficients(const size_t generators_hash,
+                             const Parallelotope &P,
+                             const direction_type &direction) const
+  {
+    return _compiled_cache.find(hash(generators_hash, direction),
+                                P.generators(), direction);
+  }
+
+  /**
+   * @brief Store the compiled Bernstein coefficients
    *
-   * This method stores the Bernstein coefficients
-   * of a parallelotope and a direction in the cache.
+   * This method stores the compiled Bernstein coefficients
+   * of a parallelotope and a direction in the cache, unless
+   * they have been already stored.
    *
+   * @param[in] generators_hash is the hash of the generators of `P`
    * @param[in] P is a parallelotope
    * @param[in] direction is a direction
-   * @param[in] coefficients is the vector of Bernstein coefficients
+   * @param[in] coefficients is the compiled Bernstein coefficients
+   * @return a reference to the cached compiled Bernstein coefficients
    */
-  const std::vector<SymbolicAlgebra::Expression<T>> &
-  save_coefficients(const Parallelotope &P,
-                    const LinearAlgebra::Vector<T> &direction,
-                    std::vector<SymbolicAlgebra::Expression<T>> &&coefficients)
+  const compiled_coefficients_type &
+  save_compiled_coefficients(const size_t generators_hash,
+                             const Parallelotope &P,
+                             const direction_type &direction,
+                             compiled_coefficients_type &&coefficients)
   {
-#ifdef WITH_THREADS
-    std::unique_lock<std::shared_timed_mutex> writelock(_mutex);
-#endif // WITH_THREADS
+    return _compiled_cache.insert(hash(generators_hash, direction),
+                                  P.generators(), direction,
+                                  std::move(coefficients));
+  }
 
-    auto &cached_coefficients = _cache[P.generators()][direction];
+  /**
+   * @brief Write the compiled Bernstein coefficients in a stream
+   *
+   * The stream is written in a versioned binary format whose header
+   * contains the hash of the dynamical system producing the cached
+   * coefficients.
+   *
+   * @param os is the output binary stream
+   * @param system_hash is the hash of the dynamical system
+   */
+  void save(std::ostream &os, const uint64_t system_hash) const
+  {
+    uint64_t num_of_entries = 0;
+    _compiled_cache.for_each(
+        [&num_of_entries](const generators_type &, const direction_type &,
+                          const compiled_coefficients_type &) {
+          ++num_of_entries;
+        });
+
+    BinaryIO::write(os, static_cast<uint64_t>(BERNSTEIN_CACHE_FILE_MAGIC));
+    BinaryIO::write(os, static_cast<uint64_t>(BERNSTEIN_CACHE_FILE_VERSION));
+    BinaryIO::write(os, static_cast<uint64_t>(sizeof(T)));
+    BinaryIO::write(os, system_hash);
+    BinaryIO::write(os, num_of_entries);
+
+    _compiled_cache.for_each([&os](const generators_type &generators,
+                                   const direction_type &direction,
+                                   const compiled_coefficients_type &value) {
+      BinaryIO::write(os, static_cast<uint64_t>(generators.size()));
+      for (const auto &generator: generators) {
+        BinaryIO::write(os, generator);
+      }
+      BinaryIO::write(os, direction);
+      value.write(os);
+    });
+  }
+
+  /**
+   * @brief Load compiled Bernstein coefficients from a stream
+   *
+   * This method adds to the cache the compiled Bernstein coefficients
+   * stored in a stream by the method `save`. The stream is ignored
+   * whenever its format version or its dynamical system hash differ
+   * from the expected ones. The whole stream is parsed and validated
+   * before adding any of its entries to the cache, so a corrupted
+   * stream leaves the cache unchanged.
+   *
+   * @param is is the input binary stream
+   * @param system_hash is the hash of the dynamical system
+   * @return `true` if and only if the stream content has been loaded
+   * @throw std::runtime_error if the stream is corrupted
+   */
+  bool load(std::istream &is, const uint64_t system_hash)
+  {
+    if (BinaryIO::read<uint64_t>(is) != BERNSTEIN_CACHE_FILE_MAGIC) {
+      SAPO_ERROR("not a Bernstein cache", std::runtime_error);
+    }
+
+    if (BinaryIO::read<uint64_t>(is) != BERNSTEIN_CACHE_FILE_VERSION
+        || BinaryIO::read<uint64_t>(is) != sizeof(T)
+        || BinaryIO::read<uint64_t>(is) != system_hash) {
+      return false;
+    }
 
-    cached_coefficients = std::move(coefficients);
+    std::vector<std::tuple<generators_type, direction_type,
+                           compiled_coefficients_type>>
+        entries;
+
+    const uint64_t num_of_entries = BinaryIO::read<uint64_t>(is);
+    for (uint64_t i = 0; i < num_of_entries; ++i) {
+      const uint64_t num_of_generators = BinaryIO::read<uint64_t>(is);
+
+      generators_type generators;
+      for (uint64_t j = 0; j < num_of_generators; ++j) {
+        generators.push_back(BinaryIO::read_vector<T>(is));
+      }
+      direction_type direction = BinaryIO::read_vector<T>(is);
+
+      entries.emplace_back(std::move(generators), std::move(direction),
+                           compiled_coefficients_type::read(is));
+    }
+
+    if (is.peek() != std::char_traits<char>::eof()) {
+      SAPO_ERROR("unexpected data at the end of the Bernstein cache",
+                 std::runtime_error);
+    }
+
+    // publish the entries only once the whole stream has been validated
+    for (auto &entry: entries) {
+      const auto &generators = std::get<0>(entry);
+      const auto &direction = std::get<1>(entry);
+
+      _compiled_cache.insert(hash(hash(generators), direction), generators,
+                             direction, std::move(std::get<2>(entry)));
+    }
 
-    return cached_coefficients;
+    return true;
   }
 };
 
@@ -199,7 +577,27 @@ class Evolver
 protected:
   DiscreteSystem<T> _ds; //!< the dynamic system
 
+  /**
+   * @brief The graph of the dynamical system dynamics
+   *
+   * It is built once, when the evolver is built, and it is shared
+   * by all the evolution and synthesis steps. The replacements of
+   * the variables by the generator functions produce expression
+   * trees (see `SymbolicAlgebra::ExpressionDAG`).
+   */
+  SymbolicAlgebra::ExpressionDAG<T> _dynamics;
+
   BernsteinCache<T> *_cache; //!< the symbolic Bernstein coefficient cache
+
+  /**
+   * @brief The dense tensor bound function of the system dimension
+   *
+   * It is selected once, when the evolver is built, among the
+   * fixed-dimension instantiations for small systems. This is the
+   * only step of the evolution that is specialized on the system
+   * dimension.
+   */
+  typename Bernstein<T>::DenseTensorBounds _dense_tensor_bounds;
 public:
   /**
    * @brief Approach to evaluate the image of a bundle
@@ -221,6 +619,29 @@ public:
 
   evolver_mode mode; //!< the mode used to compute the evolution
 
+  /**
+   * @brief The number of directions refined by a thread pool task
+   *
+   * The image bounds of a bundle are refined by processing the bundle
+   * templates one by one. When threads are available, the directions
+   * to be refined for a template are split in blocks of
+   * `directions_per_task` directions and each block is processed by
+   * a different thread pool task. When it is 0, all the directions of
+   * a template are processed by a single task.
+   */
+  size_t directions_per_task;
+
+  /**
+   * @brief Whether bundle templates are processed in expression arenas
+   *
+   * When it is `true`, the expression nodes built while processing
+   * a bundle template come from an arena that is released in bulk
+   * once the template has been processed. Only the expressions
+   * stored in the Bernstein coefficient cache are copied into
+   * long-lived storage.
+   */
+  bool use_expression_arenas;
+
   /**
    * @brief A constructor
    *
@@ -230,8 +651,13 @@ public:
   Evolver(const DiscreteSystem<T> &discrete_system,
           const bool cache_Bernstein_coefficients = true,
           const evolver_mode mode = ALL_FOR_ONE):
-      _ds(discrete_system),
-      _cache(nullptr), mode(mode)
+      _ds(discrete_system), _dynamics(_ds.dynamics()),
+      _cache(nullptr),
+      _dense_tensor_bounds(
+          Bernstein<T>::get_dense_tensor_bounds_function(_ds.dim())),
+      mode(mode),
+      directions_per_task(DEFAULT_DIRECTIONS_PER_TASK),
+      use_expression_arenas(true)
   {
     if (cache_Bernstein_coefficients) {
       _cache = new BernsteinCache<T>();
@@ -247,8 +673,13 @@ public:
   Evolver(const DiscreteSystem<T> &&discrete_system,
           const bool cache_Bernstein_coefficients = true,
           const evolver_mode mode = ALL_FOR_ONE):
-      _ds(std::move(discrete_system)),
-      _cache(nullptr), mode(mode)
+      _ds(std::move(discrete_system)), _dynamics(_ds.dynamics()),
+      _cache(nullptr),
+      _dense_tensor_bounds(
+          Bernstein<T>::get_dense_tensor_bounds_function(_ds.dim())),
+      mode(mode),
+      directions_per_task(DEFAULT_DIRECTIONS_PER_TASK),
+      use_expression_arenas(true)
   {
     if (cache_Bernstein_coefficients) {
       _cache = new BernsteinCache<T>();
@@ -265,6 +696,104 @@ public:
     return _ds;
   }
 
+  /**
+   * @brief Return the graph of the dynamical system dynamics
+   *
+   * @return the graph of the dynamics of the dynamical system
+   *         associated to the evolution
+   */
+  inline const SymbolicAlgebra::ExpressionDAG<T> &dynamics_graph() const
+  {
+    return _dynamics;
+  }
+
+  /**
+   * @brief Compute the hash of the dynamical system
+   *
+   * @return a hash of the variables, the parameters, and the
+   *         dynamic laws of the dynamical system
+   */
+  uint64_t system_hash() const
+  {
+    std::ostringstream os;
+
+    os << std::setprecision(std::numeric_limits<T>::max_digits10);
+    for (const auto &variable: _ds.variables()) {
+      os << variable << ",";
+    }
+    os << ";";
+    for (const auto &parameter: _ds.parameters()) {
+      os << parameter << ",";
+    }
+    os << ";";
+    for (const auto &dynamic: _ds.dynamics()) {
+      os << dynamic << ",";
+    }
+
+    return BinaryIO::hash(os.str());
+  }
+
+  /**
+   * @brief Load the Bernstein coefficient cache from a file
+   *
+   * This method adds to the Bernstein coefficient cache the compiled
+   * Bernstein coefficients stored in a file by the method
+   * `save_Bernstein_cache`. The file is ignored whenever it does not
+   * exist, it was produced by another version of the cache format, or
+   * it refers to a different dynamical system.
+   *
+   * @param filename is the name of the cache file
+   * @return `true` if and only if the cache file has been loaded
+   * @throw std::runtime_error if the file is corrupted
+   */
+  bool load_Bernstein_cache(const std::string &filename)
+  {
+    if (_cache == nullptr) {
+      return false;
+    }
+
+    std::ifstream is(filename, std::ios::binary);
+    if (!is) {
+      return false;
+    }
+
+    return _cache->load(is, system_hash());
+  }
+
+  /**
+   * @brief Save the Bernstein coefficient cache in a file
+   *
+   * This method saves the compiled Bernstein coefficients of the
+   * cache in a file. The file is written atomically, so that
+   * concurrent runs never read a partially written cache.
+   *
+   * @param filename is the name of the cache file
+   * @throw std::runtime_error if the file cannot be written
+   */
+  void save_Bernstein_cache(const std::string &filename) const
+  {
+    if (_cache == nullptr) {
+      return;
+    }
+
+    const std::string tmp_filename = filename + ".tmp";
+    {
+      std::ofstream os(tmp_filename, std::ios::binary | std::ios::trunc);
+
+      _cache->save(os, system_hash());
+
+      if (!os) {
+        SAPO_ERROR("cannot write \"" << tmp_filename << "\"",
+                   std::runtime_error);
+      }
+    }
+
+    if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+      SAPO_ERROR("cannot write \"" << filename << "\"",
+                 std::runtime_error);
+    }
+  }
+
   /**
    * @brief Transform a bundle according with the system dynamics
    *
@@ -0,0 +1,330 @@
+/**
+ * @file ExpressionArena.h
+ * @author Alberto Casagrande <acasagrande@units.it>
+ * @brief Arenas for the nodes of symbolic expressions
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef EXPRESSION_ARENA_H_
+#define EXPRESSION_ARENA_H_
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+#ifdef WITH_THREADS
+#include <mutex>
+
+#endif // WITH_THREADS
+
+/*!
+ *  \addtogroup SymbolicAlgebra
+ *  @{
+ */
+
+//! Symbolic algebra namespace
+namespace SymbolicAlgebra
+{
+
+/**
+ * @brief An arena for expression nodes
+ *
+ * By default, the nodes of symbolic expressions are allocated
+ * by the global `new`. When a thread opens a `Scope` on an
+ * arena, the nodes that it allocates until the scope is closed
+ * come from the arena instead. Each scope takes a region of the
+ * arena for its exclusive use: regions are bump allocators whose
+ * deleted nodes are recycled by size, so concurrent threads
+ * never contend for arena memory. Regions are handed back to the
+ * arena when scopes are closed and reused by later scopes.
+ *
+ * Deleting an arena node never returns memory to the system:
+ * all the arena memory is released in bulk when the arena is
+ * destroyed. Hence, no expression having nodes in an arena may
+ * outlive it. Expressions that must survive the arena, e.g.,
+ * cached ones, have to be copied within a scope on `nullptr`,
+ * which allocates nodes by the global `new`.
+ */
+class ExpressionArena
+{
+  /**
+   * @brief The header of the allocated nodes
+   */
+  struct Header {
+    ExpressionArena *arena; //!< the node arena or `nullptr` for heap nodes
+    size_t size_class;      //!< the size class of the node
+  };
+
+  /**
+   * @brief A node in a region free list
+   */
+  struct FreeNode {
+    FreeNode *next; //!< the next node in the free list
+  };
+
+  /**
+   * @brief The header size
+   *
+   * The header is padded to preserve the alignment of the node.
+   */
+  static constexpr size_t header_size
+      = ((sizeof(Header) + alignof(std::max_align_t) - 1)
+         / alignof(std::max_align_t))
+        * alignof(std::max_align_t);
+
+  static constexpr size_t granularity
+      = alignof(std::max_align_t); //!< the size class granularity
+  static constexpr size_t num_of_size_classes
+      = 32; //!< the number of recycled size classes
+  static constexpr size_t chunk_size
+      = 1 << 16; //!< the size of the chunks of regions
+
+  /**
+   * @brief A region of an arena
+   *
+   * A region is used by one thread at a time.
+   */
+  struct Region {
+    ExpressionArena *arena; //!< the arena of the region
+    char *next;             //!< the first free byte of the current chunk
+    char *end;              //!< the end of the current chunk
+    std::vector<std::unique_ptr<char[]>> chunks; //!< the region chunks
+    std::array<FreeNode *, num_of_size_classes>
+        free_lists; //!< the free lists indexed by size class
+
+    /**
+     * @brief Build an empty region
+     *
+     * @param arena is the arena of the region
+     */
+    Region(ExpressionArena *arena):
+        arena(arena), next(nullptr), end(nullptr), chunks()
+    {
+      free_lists.fill(nullptr);
+    }
+
+    /**
+     * @brief Allocate a block
+     *
+     * @param size_class is the size class of the block
+     * @return a pointer to a block of
+     *         `size_class * granularity` bytes
+     */
+    void *allocate(const size_t size_class)
+    {
+      if (size_class < num_of_size_classes
+          && free_lists[size_class] != nullptr) {
+        FreeNode *node = free_lists[size_class];
+        free_lists[size_class] = node->next;
+
+        return node;
+      }
+
+      const size_t size = size_class * granularity;
+      if (size > chunk_size / 4) {
+        chunks.emplace_back(new char[size]);
+
+        return chunks.back().get();
+      }
+
+      if (static_cast<size_t>(end - next) < size) {
+        chunks.emplace_back(new char[chunk_size]);
+        next = chunks.back().get();
+        end = next + chunk_size;
+      }
+
+      void *block = next;
+      next += size;
+
+      return block;
+    }
+
+    /**
+     * @brief Recycle a block
+     *
+     * @param block is a block allocated by `allocate`
+     * @param size_class is the size class of the block
+     */
+    void recycle(void *block, const size_t size_class)
+    {
+      if (size_class < num_of_size_classes) {
+        FreeNode *node = static_cast<FreeNode *>(block);
+        node->next = free_lists[size_class];
+        free_lists[size_class] = node;
+      }
+    }
+  };
+
+  std::vector<std::unique_ptr<Region>> _regions; //!< the arena regions
+  std::vector<Region *> _idle_regions; //!< the regions not used by a scope
+
+#ifdef WITH_THREADS
+  std::mutex _mutex; //!< the mutex of the region lists
+#endif // WITH_THREADS
+
+  static inline thread_local Region *_current
+      = nullptr; //!< the region of the innermost scope of the thread
+
+  /**
+   * @brief Take a region for the exclusive use of a scope
+   *
+   * @return an idle region of the arena
+   */
+  Region *acquire_region()
+  {
+#ifdef WITH_THREADS
+    std::unique_lock<std::mutex> lock(_mutex);
+#endif // WITH_THREADS
+
+    if (_idle_regions.empty()) {
+      _regions.emplace_back(new Region(this));
+
+      return _regions.back().get();
+    }
+
+    Region *region = _idle_regions.back();
+    _idle_regions.pop_back();
+
+    return region;
+  }
+
+  /**
+   * @brief Hand a region back to the arena
+   *
+   * @param region is a region taken by `acquire_region`
+   */
+  void release_region(Region *region)
+  {
+#ifdef WITH_THREADS
+    std::unique_lock<std::mutex> lock(_mutex);
+#endif // WITH_THREADS
+
+    _idle_regions.push_back(region);
+  }
+
+public:
+  /**
+   * @brief A thread allocation scope
+   *
+   * While a scope is open, the expression nodes allocated by
+   * the thread that opened it come from the scope arena or,
+   * if the scope arena is `nullptr`, from the global `new`.
+   * Scopes nest: closing a scope restores the previous one.
+   */
+  class Scope
+  {
+    Region *_region;   //!< the region taken by the scope
+    Region *_previous; //!< the region of the enclosing scope
+
+  public:
+    /**
+     * @brief Open a scope
+     *
+     * @param arena is the arena of the scope or `nullptr` to
+     *        allocate by the global `new`
+     */
+    explicit Scope(ExpressionArena *arena):
+        _region(arena == nullptr ? nullptr : arena->acquire_region()),
+        _previous(_current)
+    {
+      _current = _region;
+    }
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+    /**
+     * @brief Close the scope
+     */
+    ~Scope()
+    {
+      _current = _previous;
+
+      if (_region != nullptr) {
+        _region->arena->release_region(_region);
+      }
+    }
+  };
+
+  /**
+   * @brief Build an empty arena
+   */
+  ExpressionArena(): _regions(), _idle_regions() {}
+
+  ExpressionArena(const ExpressionArena &) = delete;
+  ExpressionArena &operator=(const ExpressionArena &) = delete;
+
+  /**
+   * @brief Allocate an expression node
+   *
+   * @param size is the size of the node in bytes
+   * @return a pointer to the node memory
+   */
+  static void *allocate(const size_t size)
+  {
+    const size_t size_class
+        = (header_size + size + granularity - 1) / granularity;
+
+    Header *header;
+    if (_current == nullptr) {
+      header = static_cast<Header *>(::operator new(size_class * granularity));
+      header->arena = nullptr;
+    } else {
+      header = static_cast<Header *>(_current->allocate(size_class));
+      header->arena = _current->arena;
+    }
+    header->size_class = size_class;
+
+    return reinterpret_cast<char *>(header) + header_size;
+  }
+
+  /**
+   * @brief Deallocate an expression node
+   *
+   * Heap nodes are returned to the global `delete`. Arena nodes
+   * are recycled when the current scope of the thread is on their
+   * arena; otherwise, they are released with the arena.
+   *
+   * @param ptr is a pointer returned by `allocate`
+   */
+  static void deallocate(void *ptr) noexcept
+  {
+    if (ptr == nullptr) {
+      return;
+    }
+
+    Header *header
+        = reinterpret_cast<Header *>(static_cast<char *>(ptr) - header_size);
+    if (header->arena == nullptr) {
+      ::operator delete(header);
+
+      return;
+    }
+
+    if (_current != nullptr && _current->arena == header->arena) {
+      _current->recycle(header, header->size_class);
+    }
+  }
+
+  /**
+   * @brief Test whether the thread allocates nodes in an arena
+   *
+   * @return `true` if and only if the innermost scope of the
+   *         thread is on an arena
+   */
+  static inline bool in_arena()
+  {
+    return _current != nullptr;
+  }
+};
+
+}
+
+/*! @} End of SymbolicAlgebra group */
+
+#endif // EXPRESSION_ARENA_H_
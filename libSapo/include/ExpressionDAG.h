@@ -0,0 +1,871 @@
+/**
+ * @file ExpressionDAG.h
+ * @author Alberto Casagrande <acasagrande@units.it>
+ * @brief Hash-consed directed acyclic graphs of symbolic expressions
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef EXPRESSION_DAG_H_
+#define EXPRESSION_DAG_H_
+
+#include <functional>
+#include <list>
+#include <map>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "SymbolicAlgebra.h"
+
+namespace SymbolicAlgebra
+{
+
+/**
+ * @brief Hash-consed graphs of symbolic expressions
+ *
+ * The objects of this class store symbolic expressions as the nodes of
+ * an immutable directed acyclic graph. Nodes are interned: equal
+ * sub-expressions are stored once, whatever the number of their
+ * occurrences, and two nodes represent the same expression tree if and
+ * only if they have the same identifier.
+ *
+ * Replacements, expansions, interpretations, and evaluations visit
+ * each node once per call and reuse the result on all the node
+ * occurrences. They mirror the corresponding `Expression<C>` methods
+ * node by node, so that their results are exactly the ones of the
+ * tree representation. The constant methods do not change the graph
+ * and they can be concurrently called by many threads.
+ *
+ * The memoization is limited to a single call: replacements,
+ * expansions, and interpretations return `Expression<C>` trees,
+ * rather than graph nodes, and nothing is cached across calls.
+ * Hence, the expressions produced by these methods lose the
+ * structural sharing of the graph and any further manipulation
+ * of them, e.g., the expansion of the replaced dynamics, works
+ * on trees.
+ *
+ * @tparam C is the type of numeric constants
+ */
+template<typename C = double>
+class ExpressionDAG
+{
+public:
+  typedef unsigned int NodeId; //!< The type of node identifiers
+  typedef typename Symbol<C>::SymbolIdType SymbolIdType; //!< Symbol id type
+  typedef typename Expression<C>::replacement_type
+      replacement_type; //!< Replacement type
+  typedef typename Expression<C>::interpretation_type
+      interpretation_type; //!< Symbol interpretation type
+
+private:
+  typedef low_level::base_expression_type<C> base_type; //!< Tree node type
+
+  /**
+   * @brief Graph nodes
+   */
+  struct Node {
+    ExpressionType type; //!< the node type
+    C value;             //!< the value of constants or the sum/product constant
+    SymbolIdType symbol; //!< the id of symbols
+    std::vector<NodeId> operands; //!< the sum terms or the product numerator
+    std::vector<NodeId> denominator; //!< the product denominator
+    size_t hash;                     //!< the node hash
+
+    /**
+     * @brief Test whether two nodes represent the same expression tree
+     *
+     * @param node is a node
+     * @return `true` if and only if this node and `node` represent
+     *         the same expression tree
+     */
+    bool operator==(const Node &node) const
+    {
+      return type == node.type && value == node.value
+             && symbol == node.symbol && operands == node.operands
+             && denominator == node.denominator;
+    }
+  };
+
+  /**
+   * @brief The state of a graph visit
+   *
+   * The state stores the results of the visited nodes and the number
+   * of their pending uses. The last use of a result takes it, while
+   * the other ones copy it.
+   */
+  struct VisitState {
+    std::unordered_map<NodeId, Expression<C>>
+        results;                                //!< the node results
+    std::unordered_map<NodeId, size_t> uses;    //!< the pending uses
+
+    /**
+     * @brief Use the result of a visited node
+     *
+     * @param id is a visited node
+     * @return the result of `id`, if this is its last use, or a
+     *         copy of it, otherwise
+     */
+    base_type *take(const NodeId id)
+    {
+      auto found = results.find(id);
+
+      auto pending = uses.find(id);
+      if (pending != std::end(uses) && --(pending->second) == 0) {
+        base_type *result = found->second._ex;
+        found->second._ex = nullptr;
+        results.erase(found);
+
+        return result;
+      }
+
+      return found->second._ex->clone();
+    }
+  };
+
+  /// @private
+  template<typename T, typename = void>
+  struct is_hashable : std::false_type {
+  };
+
+  /// @private
+  template<typename T>
+  struct is_hashable<T, std::void_t<decltype(std::hash<T>()(
+                            std::declval<const T &>()))>> : std::true_type {
+  };
+
+  std::vector<Node> _nodes; //!< The graph nodes
+  std::unordered_multimap<size_t, NodeId>
+      _index;                 //!< Map from hashes to nodes
+  std::vector<NodeId> _roots; //!< The nodes of the constructor expressions
+
+  /**
+   * @brief Combine a hash and a value
+   *
+   * Constants whose type has no `std::hash` specialization do not
+   * contribute to the hash and they are told apart by comparison.
+   *
+   * @tparam T is the type of the value
+   * @param seed is the hash to be updated
+   * @param value is the value to be combined with `seed`
+   */
+  template<typename T>
+  static inline void hash_combine(size_t &seed, const T &value)
+  {
+    if constexpr (is_hashable<T>::value) {
+      seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+  }
+
+  /**
+   * @brief Compute the hash of a node
+   *
+   * @param node is a node
+   * @return the hash of `node`
+   */
+  static size_t hash(const Node &node)
+  {
+    size_t seed = static_cast<size_t>(node.type);
+    hash_combine(seed, node.value);
+    hash_combine(seed, node.symbol);
+    for (const auto &operand: node.operands) {
+      hash_combine(seed, operand);
+    }
+    hash_combine(seed, node.denominator.size());
+    for (const auto &operand: node.denominator) {
+      hash_combine(seed, operand);
+    }
+
+    return seed;
+  }
+
+  /**
+   * @brief Get the identifier of a node, storing the node if needed
+   *
+   * @param node is a node
+   * @return the identifier of the graph node equal to `node`
+   */
+  NodeId intern(Node &&node)
+  {
+    node.hash = hash(node);
+
+    auto range = _index.equal_range(node.hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (_nodes[it->second] == node) {
+        return it->second;
+      }
+    }
+
+    const NodeId id = static_cast<NodeId>(_nodes.size());
+    _index.emplace(node.hash, id);
+    _nodes.push_back(std::move(node));
+
+    return id;
+  }
+
+  /**
+   * @brief Get the node of an expression tree
+   *
+   * @param ex is an expression tree
+   * @return the node representing `ex`
+   */
+  NodeId intern(const base_type *ex)
+  {
+    using namespace low_level;
+
+    Node node{CONSTANT, 0, 0, {}, {}, 0};
+
+    if (ex == nullptr) {
+      return intern(std::move(node));
+    }
+
+    node.type = ex->type();
+    switch (node.type) {
+    case CONSTANT:
+      node.value = static_cast<const constant_type<C> *>(ex)->get_value();
+      break;
+    case SYMBOL:
+      node.symbol = static_cast<const symbol_type<C> *>(ex)->get_id();
+      break;
+    case FINITE_SUM:
+    {
+      auto sum = static_cast<const finite_sum_type<C> *>(ex);
+
+      node.value = sum->_constant;
+      for (const auto &term: sum->_sum) {
+        node.operands.push_back(intern(term));
+      }
+      break;
+    }
+    case FINITE_PROD:
+    {
+      auto prod = static_cast<const finite_prod_type<C> *>(ex);
+
+      node.value = prod->_constant;
+      for (const auto &factor: prod->_numerator) {
+        node.operands.push_back(intern(factor));
+      }
+      for (const auto &factor: prod->_denominator) {
+        node.denominator.push_back(intern(factor));
+      }
+      break;
+    }
+    default:
+      SAPO_ERROR("unsupported expression type", std::domain_error);
+    }
+
+    return intern(std::move(node));
+  }
+
+  /**
+   * @brief Count the uses of the nodes reachable from a node
+   *
+   * @param id is a node
+   * @param uses is the map of the node uses to be updated
+   */
+  void count_uses(const NodeId id,
+                  std::unordered_map<NodeId, size_t> &uses) const
+  {
+    if (uses[id]++ > 0) {
+      return;
+    }
+
+    const Node &node = _nodes[id];
+    for (const auto &operand: node.operands) {
+      count_uses(operand, uses);
+    }
+    for (const auto &operand: node.denominator) {
+      count_uses(operand, uses);
+    }
+  }
+
+  /**
+   * @brief Visit a node after its operands
+   *
+   * This method computes the result of a node by combining the results
+   * of its operands. Each node is combined at most once per visit
+   * state.
+   *
+   * @tparam COMBINE is the type of the combining function
+   * @param id is a node
+   * @param state is the visit state
+   * @param combine builds the result of a node, given the results of
+   *        its operands
+   */
+  template<typename COMBINE>
+  void visit(const NodeId id, VisitState &state, COMBINE &combine) const
+  {
+    if (state.results.count(id) > 0) {
+      return;
+    }
+
+    const Node &node = _nodes[id];
+    for (const auto &operand: node.operands) {
+      visit(operand, state, combine);
+    }
+    for (const auto &operand: node.denominator) {
+      visit(operand, state, combine);
+    }
+
+    state.results.emplace(id, Expression<C>(combine(node)));
+  }
+
+  /**
+   * @brief Visit a vector of nodes
+   *
+   * @tparam COMBINE is the type of the combining function
+   * @param ids is a vector of nodes
+   * @param state is the visit state
+   * @param combine builds the result of a node, given the results of
+   *        its operands
+   * @return the vector of the results of `ids`
+   */
+  template<typename COMBINE>
+  std::vector<Expression<C>> visit(const std::vector<NodeId> &ids,
+                                   VisitState &state, COMBINE &combine) const
+  {
+    for (const auto &id: ids) {
+      count_uses(id, state.uses);
+    }
+
+    std::vector<Expression<C>> res;
+    res.reserve(ids.size());
+    for (const auto &id: ids) {
+      visit(id, state, combine);
+      res.push_back(Expression<C>(state.take(id)));
+    }
+
+    return res;
+  }
+
+  /**
+   * @brief Build the tree of a node from the trees of its operands
+   *
+   * @param node is a node
+   * @param state is the visit state
+   * @return the expression tree of `node`
+   */
+  static base_type *build_tree(const Node &node, VisitState &state)
+  {
+    using namespace low_level;
+
+    switch (node.type) {
+    case CONSTANT:
+      return new constant_type<C>(node.value);
+    case SYMBOL:
+      return new symbol_type<C>(node.symbol);
+    case FINITE_SUM:
+    {
+      auto sum = new finite_sum_type<C>();
+
+      sum->_constant = node.value;
+      for (const auto &operand: node.operands) {
+        sum->_sum.push_back(state.take(operand));
+      }
+
+      return sum;
+    }
+    default:
+    {
+      auto prod = new finite_prod_type<C>(node.value);
+
+      for (const auto &operand: node.operands) {
+        prod->_numerator.push_back(state.take(operand));
+      }
+      for (const auto &operand: node.denominator) {
+        prod->_denominator.push_back(state.take(operand));
+      }
+
+      return prod;
+    }
+    }
+  }
+
+  /**
+   * @brief Replace symbols in a node
+   *
+   * This method mirrors the `replace` methods of the expression trees.
+   *
+   * @param node is a node
+   * @param state is the visit state
+   * @param replacements associates symbol ids to their replacements
+   * @return the expression tree obtained by replacing the symbols
+   *         in `node`
+   */
+  base_type *
+  replace(const Node &node, VisitState &state,
+          const std::map<SymbolIdType, const base_type *> &replacements) const
+  {
+    using namespace low_level;
+
+    switch (node.type) {
+    case SYMBOL:
+    {
+      auto found = replacements.find(node.symbol);
+      if (found != std::end(replacements)) {
+        return found->second->clone();
+      }
+
+      return new symbol_type<C>(node.symbol);
+    }
+    case FINITE_SUM:
+    {
+      C constant = node.value;
+      std::list<base_type *> new_sum;
+      for (const auto &operand: node.operands) {
+        base_type *r_it = state.take(operand);
+        switch (r_it->type()) {
+        case FINITE_SUM:
+        {
+          auto r_it_sum = static_cast<finite_sum_type<C> *>(r_it);
+          constant += r_it_sum->_constant;
+          new_sum.splice(std::end(new_sum), r_it_sum->_sum);
+
+          delete r_it;
+          break;
+        }
+        case CONSTANT:
+          constant += static_cast<constant_type<C> *>(r_it)->get_value();
+
+          delete r_it;
+          break;
+        default:
+          new_sum.push_back(r_it);
+        }
+      }
+
+      if (new_sum.size() > 1 || (new_sum.size() == 1 && constant != 0)) {
+        auto sum = new finite_sum_type<C>(new_sum);
+        sum->_constant = constant;
+
+        return sum;
+      }
+
+      if (new_sum.size() == 1) {
+        return new_sum.front();
+      }
+
+      return new constant_type<C>(constant);
+    }
+    case FINITE_PROD:
+    {
+      base_type *result = new constant_type<C>(node.value);
+      for (const auto &operand: node.operands) {
+        if (!is_zero(operand)) {
+          result = result->multiply(state.take(operand));
+        }
+      }
+      for (const auto &operand: node.denominator) {
+        if (!is_zero(operand)) {
+          result = result->divided_by(state.take(operand));
+        }
+      }
+
+      return result;
+    }
+    default:
+      return build_tree(node, state);
+    }
+  }
+
+  /**
+   * @brief Expand a node
+   *
+   * This method mirrors the `expand` methods of the expression trees.
+   *
+   * @param node is a node
+   * @param state is the visit state
+   * @param trees is the visit state of the denominator trees
+   * @return the expansion of `node`
+   */
+  base_type *expand(const Node &node, VisitState &state,
+                    VisitState &trees) const
+  {
+    using namespace low_level;
+
+    auto build = [&trees](const Node &node) {
+      return build_tree(node, trees);
+    };
+
+    switch (node.type) {
+    case FINITE_SUM:
+    {
+      auto new_obj = new finite_sum_type<C>();
+      new_obj->_constant = node.value;
+      for (const auto &operand: node.operands) {
+        base_type *ex_it = state.take(operand);
+
+        switch (ex_it->type()) {
+        case FINITE_SUM:
+        {
+          auto ex_it_sum = static_cast<finite_sum_type<C> *>(ex_it);
+          for (auto &e_it: ex_it_sum->_sum) {
+            if (e_it->type() == CONSTANT) {
+              new_obj->_constant
+                  += static_cast<constant_type<C> *>(e_it)->get_value();
+
+              delete e_it;
+            } else {
+              new_obj->_sum.push_back(e_it);
+            }
+          }
+          ex_it_sum->_sum.clear();
+
+          delete ex_it_sum;
+          break;
+        }
+        case CONSTANT:
+          new_obj->_constant
+              += static_cast<constant_type<C> *>(ex_it)->get_value();
+
+          delete ex_it;
+          break;
+        default:
+          new_obj->_sum.push_back(ex_it);
+        }
+      }
+
+      return new_obj;
+    }
+    case FINITE_PROD:
+    {
+      // the denominators are not expanded
+      base_type *base = new finite_prod_type<C>(node.value);
+      for (const auto &operand: node.denominator) {
+        visit(operand, trees, build);
+        base = base->divided_by(trees.take(operand));
+      }
+
+      std::list<base_type *> result{base};
+      for (const auto &operand: node.operands) {
+        base_type *new_it = state.take(operand);
+
+        result = new_it->multiply(result);
+
+        delete new_it;
+      }
+
+      return new finite_sum_type<C>(result);
+    }
+    default:
+      return build_tree(node, state);
+    }
+  }
+
+  /**
+   * @brief Apply an interpretation to a node
+   *
+   * This method mirrors the `apply` methods of the expression trees.
+   *
+   * @param node is a node
+   * @param state is the visit state
+   * @param interpretation associates symbol ids to their values
+   * @return the expression obtained by applying `interpretation`
+   *         to `node`
+   */
+  static base_type *apply(const Node &node, VisitState &state,
+                          const std::map<SymbolIdType, C> &interpretation)
+  {
+    using namespace low_level;
+
+    switch (node.type) {
+    case SYMBOL:
+    {
+      auto found = interpretation.find(node.symbol);
+      if (found != std::end(interpretation)) {
+        return new constant_type<C>(found->second);
+      }
+
+      return new symbol_type<C>(node.symbol);
+    }
+    case FINITE_SUM:
+    {
+      base_type *total = new constant_type<C>(node.value);
+      for (const auto &operand: node.operands) {
+        total = total->add(state.take(operand));
+      }
+
+      return total;
+    }
+    case FINITE_PROD:
+    {
+      base_type *prod = new constant_type<C>(node.value);
+      for (const auto &operand: node.operands) {
+        prod = prod->multiply(state.take(operand));
+      }
+      for (const auto &operand: node.denominator) {
+        prod = prod->divided_by(state.take(operand));
+      }
+
+      return prod;
+    }
+    default:
+      return build_tree(node, state);
+    }
+  }
+
+  /**
+   * @brief Numerically evaluate a node
+   *
+   * This method mirrors the `evaluate` methods of the expression trees.
+   *
+   * @param id is a node
+   * @param interpretation associates symbol ids to their values
+   * @param values is the map of the values of the visited nodes
+   * @return the value of `id`
+   * @throw symbol_evaluation_error if a symbol in `id` is not in
+   *        the domain of `interpretation`
+   */
+  C evaluate(const NodeId id, const std::map<SymbolIdType, C> &interpretation,
+             std::unordered_map<NodeId, C> &values) const
+  {
+    auto found = values.find(id);
+    if (found != std::end(values)) {
+      return found->second;
+    }
+
+    const Node &node = _nodes[id];
+
+    C value = node.value;
+    switch (node.type) {
+    case SYMBOL:
+    {
+      auto symbol_value = interpretation.find(node.symbol);
+      if (symbol_value == std::end(interpretation)) {
+        throw symbol_evaluation_error(low_level::symbol_type<C>(node.symbol));
+      }
+      value = symbol_value->second;
+      break;
+    }
+    case FINITE_SUM:
+      for (const auto &operand: node.operands) {
+        value += evaluate(operand, interpretation, values);
+      }
+      break;
+    case FINITE_PROD:
+      for (const auto &operand: node.operands) {
+        value *= evaluate(operand, interpretation, values);
+      }
+      for (const auto &operand: node.denominator) {
+        value /= evaluate(operand, interpretation, values);
+      }
+      break;
+    default:
+      break;
+    }
+
+    values.emplace(id, value);
+
+    return value;
+  }
+
+  /**
+   * @brief Test whether a node is the constant 0
+   *
+   * @param id is a node
+   * @return `true` if and only if `id` is the constant 0
+   */
+  inline bool is_zero(const NodeId id) const
+  {
+    return _nodes[id].type == CONSTANT && _nodes[id].value == 0;
+  }
+
+  /**
+   * @brief Get the symbol ids of an interpretation
+   *
+   * @param interpretation is a symbol interpretation
+   * @return the map from the symbol ids to their values
+   */
+  static std::map<SymbolIdType, C>
+  get_id_interpretation(const interpretation_type &interpretation)
+  {
+    std::map<SymbolIdType, C> id_interpretation;
+    for (const auto &value: interpretation) {
+      id_interpretation[value.first.get_id()] = value.second;
+    }
+
+    return id_interpretation;
+  }
+
+public:
+  /**
+   * @brief Build an empty graph
+   */
+  ExpressionDAG(): _nodes(), _index(), _roots() {}
+
+  /**
+   * @brief Build the graph of a vector of expressions
+   *
+   * @param expressions is a vector of expressions
+   */
+  explicit ExpressionDAG(const std::vector<Expression<C>> &expressions):
+      _nodes(), _index(), _roots()
+  {
+    _roots = intern(expressions);
+  }
+
+  /**
+   * @brief Get the nodes of the constructor expressions
+   *
+   * @return the vector of the nodes of the expressions passed to
+   *         the constructor
+   */
+  inline const std::vector<NodeId> &roots() const
+  {
+    return _roots;
+  }
+
+  /**
+   * @brief Get the number of nodes in the graph
+   *
+   * @return the number of nodes in the graph
+   */
+  inline size_t size() const
+  {
+    return _nodes.size();
+  }
+
+  /**
+   * @brief Get the node of an expression
+   *
+   * @param expression is an expression
+   * @return the node representing `expression`
+   */
+  inline NodeId intern(const Expression<C> &expression)
+  {
+    return intern(expression._ex);
+  }
+
+  /**
+   * @brief Get the nodes of a vector of expressions
+   *
+   * @param expressions is a vector of expressions
+   * @return the vector of the nodes representing `expressions`
+   */
+  std::vector<NodeId> intern(const std::vector<Expression<C>> &expressions)
+  {
+    std::vector<NodeId> ids;
+    ids.reserve(expressions.size());
+    for (const auto &expression: expressions) {
+      ids.push_back(intern(expression._ex));
+    }
+
+    return ids;
+  }
+
+  /**
+   * @brief Build the expressions of a vector of nodes
+   *
+   * @param ids is a vector of nodes
+   * @return the vector of the expressions represented by `ids`
+   */
+  std::vector<Expression<C>>
+  to_expressions(const std::vector<NodeId> &ids) const
+  {
+    VisitState state;
+    auto combine = [&state](const Node &node) {
+      return build_tree(node, state);
+    };
+
+    return visit(ids, state, combine);
+  }
+
+  /**
+   * @brief Replace symbol occurrences by using expressions
+   *
+   * @param ids is a vector of nodes
+   * @param replacements associates symbols to their replacements
+   * @return the vector of the expressions obtained by replacing in
+   *         `ids` any occurrence of the symbols in the domain of
+   *         `replacements` with the corresponding expressions
+   */
+  std::vector<Expression<C>>
+  replace(const std::vector<NodeId> &ids,
+          const replacement_type &replacements) const
+  {
+    std::map<SymbolIdType, const base_type *> base_replacements;
+    for (const auto &replacement: replacements) {
+      base_replacements[replacement.first.get_id()]
+          = replacement.second._ex;
+    }
+
+    VisitState state;
+    auto combine = [this, &state, &base_replacements](const Node &node) {
+      return replace(node, state, base_replacements);
+    };
+
+    return visit(ids, state, combine);
+  }
+
+  /**
+   * @brief Turn a vector of nodes into sums of products
+   *
+   * @param ids is a vector of nodes
+   * @return the vector of the sums of products that are algebraically
+   *         equivalent to the expressions of `ids`
+   */
+  std::vector<Expression<C>> expand(const std::vector<NodeId> &ids) const
+  {
+    VisitState state, trees;
+    auto combine = [this, &state, &trees](const Node &node) {
+      return expand(node, state, trees);
+    };
+
+    return visit(ids, state, combine);
+  }
+
+  /**
+   * @brief Apply a symbol interpretation to a vector of nodes
+   *
+   * @param ids is a vector of nodes
+   * @param interpretation is a symbol interpretation
+   * @return the vector of the expressions obtained by replacing in
+   *         `ids` any occurrence of the symbols in the domain of
+   *         `interpretation` with their values
+   */
+  std::vector<Expression<C>>
+  apply(const std::vector<NodeId> &ids,
+        const interpretation_type &interpretation) const
+  {
+    const auto id_interpretation = get_id_interpretation(interpretation);
+
+    VisitState state;
+    auto combine = [&state, &id_interpretation](const Node &node) {
+      return apply(node, state, id_interpretation);
+    };
+
+    return visit(ids, state, combine);
+  }
+
+  /**
+   * @brief Numerically evaluate a vector of nodes
+   *
+   * @param ids is a vector of nodes
+   * @param interpretation is a symbol interpretation
+   * @return the vector of the values of `ids` on `interpretation`
+   * @throw symbol_evaluation_error if a symbol in `ids` is not in
+   *        the domain of `interpretation`
+   */
+  std::vector<C> evaluate(const std::vector<NodeId> &ids,
+                          const interpretation_type &interpretation) const
+  {
+    const auto id_interpretation = get_id_interpretation(interpretation);
+
+    std::unordered_map<NodeId, C> values;
+
+    std::vector<C> res;
+    res.reserve(ids.size());
+    for (const auto &id: ids) {
+      res.push_back(evaluate(id, id_interpretation, values));
+    }
+
+    return res;
+  }
+};
+
+}
+
+#endif // EXPRESSION_DAG_H_
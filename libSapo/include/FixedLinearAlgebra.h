@@ -0,0 +1,133 @@
+/**
+ * @file FixedLinearAlgebra.h
+ * @author Alberto Casagrande <acasagrande@units.it>
+ * @brief Vectors of fixed dimension and dimension dispatch
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef FIXED_LINEAR_ALGEBRA_H
+#define FIXED_LINEAR_ALGEBRA_H
+
+#include <array>
+#include <utility>
+
+#include "LinearAlgebra.h"
+#include "ErrorHandling.h"
+
+namespace LinearAlgebra
+{
+
+/**
+ * @brief Vectors of fixed dimension
+ *
+ * The vectors of this namespace have a dimension known at
+ * compile-time and they live on the stack. They are meant for
+ * the inner loops of small models, whose dimension is
+ * dispatched once on a set of instantiations (see
+ * `MAX_FIXED_DIMENSION` and `dispatch_on_dimension`).
+ *
+ * Currently, the only fixed-dimension path is the bound computation
+ * of the Bernstein dense tensors (see `Bernstein::DenseTensorBounds`).
+ * `LinearAlgebra::Vector`, `Dense::Matrix`, `Parallelotope` and the
+ * remaining evolver loops, e.g., those of the parametric and of the
+ * non-adaptive computations, are still sized at run-time and they
+ * allocate on the heap.
+ */
+namespace Fixed
+{
+
+/**
+ * @brief The greatest dimension having a fixed-dimension instantiation
+ */
+constexpr size_t MAX_FIXED_DIMENSION = 8;
+
+/**
+ * @brief An alias for fixed-dimension vector type
+ *
+ * @tparam T is the scalar value type
+ * @tparam N is the vector dimension
+ */
+template<typename T, size_t N>
+using Vector = std::array<T, N>;
+
+/**
+ * @brief Build a fixed-dimension vector from a vector
+ *
+ * @tparam N is the vector dimension
+ * @tparam T is the scalar value type
+ * @param v is a vector whose dimension is `N`
+ * @return the fixed-dimension copy of `v`
+ */
+template<size_t N, typename T>
+Vector<T, N> to_fixed(const LinearAlgebra::Vector<T> &v)
+{
+  if (v.size() != N) {
+    SAPO_ERROR("the vector dimension differs from the fixed one",
+               std::domain_error);
+  }
+
+  Vector<T, N> res{};
+  std::copy(std::begin(v), std::end(v), std::begin(res));
+
+  return res;
+}
+
+/**
+ * @brief Build a vector from a fixed-dimension vector
+ *
+ * @tparam T is the scalar value type
+ * @tparam N is the vector dimension
+ * @param v is a fixed-dimension vector
+ * @return the copy of `v`
+ */
+template<typename T, size_t N>
+LinearAlgebra::Vector<T> to_dynamic(const Vector<T, N> &v)
+{
+  return LinearAlgebra::Vector<T>(std::begin(v), std::end(v));
+}
+
+/// @private
+template<template<size_t> class INSTANCE, size_t... N>
+inline auto dispatch_on_dimension(const size_t dim,
+                                  std::index_sequence<N...>)
+{
+  using result_type = decltype(INSTANCE<1>::get());
+
+  result_type result = INSTANCE<0>::get();
+
+  ((dim == N + 1 ? (result = INSTANCE<N + 1>::get(), true) : false) || ...);
+
+  return result;
+}
+
+/**
+ * @brief Select the instantiation of a dimension
+ *
+ * This function is the run-time dispatch of the fixed-dimension
+ * code. `INSTANCE<N>::get()` must return the same type, e.g., a
+ * function pointer, for all the `N` in \f$[0,\texttt{MAX\_FIXED\_DIMENSION}]\f$
+ * and `INSTANCE<0>` stands for the generic, i.e., run-time dimension,
+ * code.
+ *
+ * @tparam INSTANCE is the class template whose instantiations are
+ *         selected
+ * @param dim is a dimension
+ * @return `INSTANCE<dim>::get()` if
+ *         \f$1 \leq \texttt{dim} \leq \texttt{MAX\_FIXED\_DIMENSION}\f$
+ *         and `INSTANCE<0>::get()` otherwise
+ */
+template<template<size_t> class INSTANCE>
+inline auto dispatch_on_dimension(const size_t dim)
+{
+  return dispatch_on_dimension<INSTANCE>(
+      dim, std::make_index_sequence<MAX_FIXED_DIMENSION>());
+}
+
+} // namespace Fixed
+
+} // namespace LinearAlgebra
+
+#endif // FIXED_LINEAR_ALGEBRA_H
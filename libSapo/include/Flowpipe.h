@@ -17,6 +17,31 @@
 #include "Bundle.h"
 #include "SetsUnion.h"
 
+/**
+ * @brief A flowpipe sink
+ *
+ * Flowpipe writers receive the flowpipe steps in epoch order as soon
+ * as they are computed. This allows to process, e.g., to print, and
+ * release the steps without storing the whole flowpipe. The steps are
+ * never written concurrently, but they may be written by a thread
+ * different from the one that started the computation.
+ */
+class FlowpipeWriter
+{
+public:
+  /**
+   * @brief Write the next flowpipe step
+   *
+   * @param[in] step is the polytopes union reached in the next epoch
+   */
+  virtual void write(SetsUnion<Polytope> &&step) = 0;
+
+  /**
+   * @brief Destroy the flowpipe writer
+   */
+  virtual ~FlowpipeWriter() {}
+};
+
 /**
  * @brief A representation for reachability flowpipe
  *
@@ -24,7 +49,8 @@
  * a sequence of polytope union.
  * @todo reimplement this class as a list of `SetsUnion`
  */
-class Flowpipe : public std::vector<SetsUnion<Polytope>>
+class Flowpipe : public std::vector<SetsUnion<Polytope>>,
+                 public FlowpipeWriter
 {
 
 public:
@@ -62,6 +88,16 @@ public:
     return *this;
   }
 
+  /**
+   * @brief Append a flowpipe step
+   *
+   * @param[in] step is the polytopes union to be appended
+   */
+  inline void write(SetsUnion<Polytope> &&step) override
+  {
+    push_back(std::move(step));
+  }
+
   /**
    * Append a bundles union to the flowpipe
    *
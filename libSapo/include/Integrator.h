@@ -11,9 +11,13 @@
 #ifndef _INTEGRATOR_H_
 #define _INTEGRATOR_H_
 
+#include <map>
+#include <string>
+
 #include "DifferentialSystem.h"
 #include "ContinuousSystem.h"
 #include "DiscreteSystem.h"
+#include "Polynomial.h"
 
 class ODEIntegrator
 {
@@ -145,6 +149,537 @@ public:
   DiscreteSystem<T> operator()(const ODE<T> &ode, const T &time_step) const;
 };
 
+/**
+ * @brief A base class for polynomial integrators
+ *
+ * Polynomial integrators apply their schemes to sparse polynomials
+ * rather than to expression trees. Every stage is expanded once, so
+ * the dynamics of the integrated system are flat sums of monomials.
+ *
+ * Moreover, when the integrator has a maximum degree, the monomials
+ * whose total degree exceeds it are dropped whenever they are produced.
+ * The range of the dropped monomials over a box domain is accumulated
+ * into an interval remainder, as in Taylor models. The variables of
+ * the box are the ODE variables, its parameters, its time variable,
+ * when the ODE is time dependent, and the symbolic time step, if any.
+ * Each non-null remainder becomes a new parameter of the integrated
+ * system and its bounds are returned to the caller, who must include
+ * them in the parameter set. The remainders bound the truncation
+ * error exclusively inside the box domain: they do not account
+ * for the integration scheme error.
+ *
+ * The remainder ranges are computed by outward-rounded interval
+ * arithmetic, but the polynomial coefficients are computed in the
+ * arithmetic of the ODE constant type. Hence, when this type is a
+ * floating-point one, the rounding errors of the coefficients are
+ * not included in the remainders and the integrated dynamics are
+ * not rigorous enclosures of the truncated scheme. Exact constant
+ * types, e.g., `mpq_class`, do not have this limitation.
+ */
+class PolynomialODEIntegrator : public ODEIntegrator
+{
+public:
+  /**
+   * @brief The type of box domains
+   *
+   * @tparam T is the ODE constant type
+   */
+  template<typename T>
+  using domain_type = std::map<SymbolicAlgebra::Symbol<T>,
+                               SymbolicAlgebra::Interval<T>>;
+
+protected:
+  /**
+   * @brief Polynomials with an interval remainder
+   *
+   * @tparam T is the ODE constant type
+   */
+  template<typename T>
+  struct TaylorModel {
+    SymbolicAlgebra::Polynomial<T> polynomial; //!< the polynomial part
+    SymbolicAlgebra::Interval<T> remainder;    //!< the remainder interval
+  };
+
+  /**
+   * @brief The polynomial space of an integration
+   *
+   * This class binds the polynomial variables to the ODE symbols
+   * and performs the Taylor model arithmetic.
+   *
+   * @tparam T is the ODE constant type
+   */
+  template<typename T>
+  class Workspace
+  {
+    std::vector<SymbolicAlgebra::Symbol<T>>
+        _symbols; //!< the symbols of the polynomial variables
+    std::vector<SymbolicAlgebra::Interval<T>>
+        _domain;              //!< the box domain of the polynomial variables
+    unsigned int _max_degree; //!< the maximum total degree or 0
+
+  public:
+    /**
+     * @brief A constructor
+     *
+     * @param ode is the ODE to be integrated
+     * @param time_step is the symbolic time step or `nullptr`
+     * @param max_degree is the maximum total degree of the monomials
+     *        or 0 to avoid truncation
+     * @param domain is the box domain of the symbols
+     * @throw std::domain_error if `max_degree` is not 0 and `domain`
+     *        misses one of the symbols
+     */
+    Workspace(const ODE<T> &ode, const SymbolicAlgebra::Symbol<T> *time_step,
+              const unsigned int max_degree, const domain_type<T> &domain);
+
+    /**
+     * @brief Get the number of polynomial variables
+     *
+     * @return the number of polynomial variables
+     */
+    inline size_t num_of_variables() const
+    {
+      return _symbols.size();
+    }
+
+    /**
+     * @brief Get the Taylor model of a polynomial variable
+     *
+     * @param variable is the index of a polynomial variable
+     * @return the Taylor model of the `variable`-th variable
+     */
+    inline TaylorModel<T> variable(const size_t variable) const
+    {
+      return {SymbolicAlgebra::Polynomial<T>::variable(_symbols.size(),
+                                                        variable),
+              T(0)};
+    }
+
+    /**
+     * @brief Get the Taylor model of a time step
+     *
+     * @param time_step is a numeric time step
+     * @return the Taylor model of `time_step`
+     */
+    inline TaylorModel<T> time_step_model(const T &time_step) const
+    {
+      return {SymbolicAlgebra::Polynomial<T>(_symbols.size(), time_step),
+              T(0)};
+    }
+
+    /**
+     * @brief Get the Taylor model of a time step
+     *
+     * @param time_step is a symbolic time step
+     * @return the Taylor model of `time_step`
+     */
+    inline TaylorModel<T>
+    time_step_model(const SymbolicAlgebra::Symbol<T> &time_step) const
+    {
+      (void)time_step;
+
+      // the symbolic time step is the last polynomial variable
+      return variable(_symbols.size() - 1);
+    }
+
+    /**
+     * @brief Get the polynomial of an expression
+     *
+     * @param expression is a polynomial expression over the symbols
+     * @return the polynomial of `expression`
+     * @throw std::domain_error if `expression` is not a polynomial
+     */
+    inline SymbolicAlgebra::Polynomial<T>
+    polynomial(const SymbolicAlgebra::Expression<T> &expression) const
+    {
+      return SymbolicAlgebra::Polynomial<T>(expression, _symbols);
+    }
+
+    /**
+     * @brief Truncate a Taylor model
+     *
+     * @param model is the Taylor model to be truncated
+     */
+    void truncate(TaylorModel<T> &model) const;
+
+    /**
+     * @brief Multiply two Taylor models
+     *
+     * @param a is a Taylor model
+     * @param b is a Taylor model
+     * @return a truncated Taylor model of \f$a*b\f$
+     */
+    TaylorModel<T> multiply(const TaylorModel<T> &a,
+                            const TaylorModel<T> &b) const;
+
+    /**
+     * @brief Compose a polynomial with Taylor models
+     *
+     * @param polynomial is a polynomial
+     * @param models is the vector of the Taylor models replacing
+     *        the polynomial variables
+     * @return a truncated Taylor model of the composition
+     */
+    TaylorModel<T>
+    compose(const SymbolicAlgebra::Polynomial<T> &polynomial,
+            const std::vector<TaylorModel<T>> &models) const;
+
+    /**
+     * @brief Get the expression of a polynomial
+     *
+     * @param polynomial is a polynomial
+     * @return the expression of `polynomial` over the symbols
+     */
+    inline SymbolicAlgebra::Expression<T>
+    expression(const SymbolicAlgebra::Polynomial<T> &polynomial) const
+    {
+      return polynomial.to_expression(_symbols);
+    }
+  };
+
+  unsigned int _max_degree; //!< the maximum total degree or 0
+
+  /**
+   * @brief Get the symbol of a time step
+   *
+   * @tparam T is the ODE constant type
+   * @param time_step is a numeric time step
+   * @return `nullptr`
+   */
+  template<typename T>
+  static inline const SymbolicAlgebra::Symbol<T> *
+  time_step_symbol(const T &time_step)
+  {
+    (void)time_step;
+
+    return nullptr;
+  }
+
+  /**
+   * @brief Get the symbol of a time step
+   *
+   * @tparam T is the ODE constant type
+   * @param time_step is a symbolic time step
+   * @return a pointer to `time_step`
+   */
+  template<typename T>
+  static inline const SymbolicAlgebra::Symbol<T> *
+  time_step_symbol(const SymbolicAlgebra::Symbol<T> &time_step)
+  {
+    return &time_step;
+  }
+
+  /**
+   * @brief Add a Taylor model to another one
+   *
+   * @tparam T is the ODE constant type
+   * @param a is the Taylor model to be updated
+   * @param b is a Taylor model
+   */
+  template<typename T>
+  static inline void add(TaylorModel<T> &a, const TaylorModel<T> &b)
+  {
+    a.polynomial += b.polynomial;
+    a.remainder += b.remainder;
+  }
+
+  /**
+   * @brief Multiply a Taylor model by a scalar
+   *
+   * @tparam T is the ODE constant type
+   * @param a is the Taylor model to be updated
+   * @param value is a scalar value
+   */
+  template<typename T>
+  static inline void scale(TaylorModel<T> &a, const T &value)
+  {
+    a.polynomial *= value;
+    if (!a.remainder.is_zero()) {
+      a.remainder *= SymbolicAlgebra::Interval<T>(value);
+    }
+  }
+
+    /**
+   * @brief Build the dynamics of integrated Taylor models
+   *
+   * @tparam T is the ODE constant type
+   * @tparam DELTA_TYPE is the type of the delta step
+   * @param workspace is the integration workspace
+   * @param ode is the integrated ODE
+   * @param models are the Taylor models of the integrated variables
+   * @param time_step is the integration time step
+   * @param remainders is the map in which the remainder bounds
+   *        are stored
+   * @return the pair variables-parameters of the integrated system.
+   *         The dynamics of the variables are appended to `dynamics`
+   */
+  template<typename T, typename DELTA_TYPE>
+  static std::pair<std::vector<SymbolicAlgebra::Symbol<T>>,
+                   std::vector<SymbolicAlgebra::Symbol<T>>>
+  build_system(const Workspace<T> &workspace, const ODE<T> &ode,
+               const std::vector<TaylorModel<T>> &models,
+               const DELTA_TYPE &time_step, domain_type<T> &remainders,
+               std::vector<SymbolicAlgebra::Expression<T>> &dynamics);
+
+public:
+  /**
+   * @brief A constructor
+   *
+   * @param max_degree is the maximum total degree of the monomials
+   *        in the integrated dynamics or 0 to avoid truncation
+   */
+  PolynomialODEIntegrator(const unsigned int max_degree = 0):
+      ODEIntegrator(), _max_degree(max_degree)
+  {
+  }
+
+  /**
+   * @brief Get the maximum total degree
+   *
+   * @return the maximum total degree of the monomials in the
+   *         integrated dynamics or 0 if there is no truncation
+   */
+  inline const unsigned int &max_degree() const
+  {
+    return _max_degree;
+  }
+};
+
+/**
+ * @brief A polynomial 4th order Runge-Kutta integrator for ODE
+ *
+ * This integrator applies the 4th order Runge-Kutta method to
+ * polynomial ODEs by using sparse polynomials. Without truncation,
+ * the integrated dynamics equal those of `RungeKutta4Integrator`
+ * up to rounding.
+ */
+class PolynomialRungeKutta4Integrator : public PolynomialODEIntegrator
+{
+  /**
+   * @brief Integrate an ODE by using the 4th degree Runge-Kutta method
+   *
+   * @tparam T is the ODE constant type
+   * @tparam DELTA_TYPE is the type of the delta step
+   * @param ode is the ODE to be integrated
+   * @param time_step is the integration time step
+   * @param domain is the box domain of the truncation
+   * @param remainders is the map in which the remainder bounds
+   *        are stored
+   * @param variables is the vector of the integrated system variables
+   * @param parameters is the vector of the integrated system parameters
+   * @return the integrated dynamics
+   */
+  template<typename T, typename DELTA_TYPE>
+  std::vector<SymbolicAlgebra::Expression<T>> runge_kutta4(
+      const ODE<T> &ode, const DELTA_TYPE &time_step,
+      const domain_type<T> &domain, domain_type<T> &remainders,
+      std::vector<SymbolicAlgebra::Symbol<T>> &variables,
+      std::vector<SymbolicAlgebra::Symbol<T>> &parameters) const;
+
+public:
+  /**
+   * @brief A constructor
+   *
+   * @param max_degree is the maximum total degree of the monomials
+   *        in the integrated dynamics or 0 to avoid truncation
+   */
+  PolynomialRungeKutta4Integrator(const unsigned int max_degree = 0):
+      PolynomialODEIntegrator(max_degree)
+  {
+  }
+
+  /**
+   * @brief Integrate an ODE with a symbolic time step
+   *
+   * @tparam T is the ODE constant type
+   * @param ode is the polynomial ODE to be integrated
+   * @param time_step is the time step variable
+   * @param domain is the box domain of the truncation
+   * @param remainders is the map in which the bounds of the
+   *        remainder parameters are stored
+   * @return the continuous system associated to the ODE
+   * @throw std::domain_error if the ODE is not polynomial or
+   *        the integrator truncates and `domain` misses a symbol
+   */
+  template<typename T>
+  ContinuousSystem<T> operator()(const ODE<T> &ode,
+                                 const SymbolicAlgebra::Symbol<T> &time_step,
+                                 const domain_type<T> &domain,
+                                 domain_type<T> &remainders) const;
+
+  /**
+   * @brief Integrate an ODE with a numeric time step
+   *
+   * @tparam T is the ODE constant type
+   * @param ode is the polynomial ODE to be integrated
+   * @param time_step is the time step
+   * @param domain is the box domain of the truncation
+   * @param remainders is the map in which the bounds of the
+   *        remainder parameters are stored
+   * @return the discrete system associated to the ODE
+   * @throw std::domain_error if the ODE is not polynomial or
+   *        the integrator truncates and `domain` misses a symbol
+   */
+  template<typename T>
+  DiscreteSystem<T> operator()(const ODE<T> &ode, const T &time_step,
+                               const domain_type<T> &domain,
+                               domain_type<T> &remainders) const;
+
+  /**
+   * @brief Integrate an ODE with a symbolic time step without truncation
+   *
+   * @tparam T is the ODE constant type
+   * @param ode is the polynomial ODE to be integrated
+   * @param time_step is the time step variable
+   * @return the continuous system associated to the ODE
+   * @throw std::domain_error if the ODE is not polynomial or
+   *        the integrator truncates
+   */
+  template<typename T>
+  ContinuousSystem<T>
+  operator()(const ODE<T> &ode,
+             const SymbolicAlgebra::Symbol<T> &time_step) const;
+
+  /**
+   * @brief Integrate an ODE with a numeric time step without truncation
+   *
+   * @tparam T is the ODE constant type
+   * @param ode is the polynomial ODE to be integrated
+   * @param time_step is the time step
+   * @return the discrete system associated to the ODE
+   * @throw std::domain_error if the ODE is not polynomial or
+   *        the integrator truncates
+   */
+  template<typename T>
+  DiscreteSystem<T> operator()(const ODE<T> &ode, const T &time_step) const;
+};
+
+/**
+ * @brief A Taylor series integrator for polynomial ODE
+ *
+ * This integrator approximates the flow of a polynomial ODE
+ * by its Taylor series up to a given order, i.e., by
+ * \f$x + \sum_{j=1}^{k} \frac{h^j}{j!} \mathcal{L}^j_f(x)\f$ where
+ * \f$\mathcal{L}_f\f$ is the Lie derivative along the ODE
+ * dynamics \f$f\f$. The Lie derivatives are computed on sparse
+ * polynomials.
+ */
+class TaylorIntegrator : public PolynomialODEIntegrator
+{
+  unsigned int _order; //!< the order of the Taylor series
+
+  /**
+   * @brief Integrate an ODE by using the Taylor series
+   *
+   * @tparam T is the ODE constant type
+   * @tparam DELTA_TYPE is the type of the delta step
+   * @param ode is the ODE to be integrated
+   * @param time_step is the integration time step
+   * @param domain is the box domain of the truncation
+   * @param remainders is the map in which the remainder bounds
+   *        are stored
+   * @param variables is the vector of the integrated system variables
+   * @param parameters is the vector of the integrated system parameters
+   * @return the integrated dynamics
+   */
+  template<typename T, typename DELTA_TYPE>
+  std::vector<SymbolicAlgebra::Expression<T>>
+  taylor(const ODE<T> &ode, const DELTA_TYPE &time_step,
+         const domain_type<T> &domain, domain_type<T> &remainders,
+         std::vector<SymbolicAlgebra::Symbol<T>> &variables,
+         std::vector<SymbolicAlgebra::Symbol<T>> &parameters) const;
+
+public:
+  /**
+   * @brief A constructor
+   *
+   * @param order is the order of the Taylor series
+   * @param max_degree is the maximum total degree of the monomials
+   *        in the integrated dynamics or 0 to avoid truncation
+   */
+  TaylorIntegrator(const unsigned int order = 4,
+                   const unsigned int max_degree = 0):
+      PolynomialODEIntegrator(max_degree),
+      _order(order)
+  {
+  }
+
+  /**
+   * @brief Get the order of the Taylor series
+   *
+   * @return the order of the Taylor series
+   */
+  inline const unsigned int &order() const
+  {
+    return _order;
+  }
+
+  /**
+   * @brief Integrate an ODE with a symbolic time step
+   *
+   * @tparam T is the ODE constant type
+   * @param ode is the polynomial ODE to be integrated
+   * @param time_step is the time step variable
+   * @param domain is the box domain of the truncation
+   * @param remainders is the map in which the bounds of the
+   *        remainder parameters are stored
+   * @return the continuous system associated to the ODE
+   * @throw std::domain_error if the ODE is not polynomial or
+   *        the integrator truncates and `domain` misses a symbol
+   */
+  template<typename T>
+  ContinuousSystem<T> operator()(const ODE<T> &ode,
+                                 const SymbolicAlgebra::Symbol<T> &time_step,
+                                 const domain_type<T> &domain,
+                                 domain_type<T> &remainders) const;
+
+  /**
+   * @brief Integrate an ODE with a numeric time step
+   *
+   * @tparam T is the ODE constant type
+   * @param ode is the polynomial ODE to be integrated
+   * @param time_step is the time step
+   * @param domain is the box domain of the truncation
+   * @param remainders is the map in which the bounds of the
+   *        remainder parameters are stored
+   * @return the discrete system associated to the ODE
+   * @throw std::domain_error if the ODE is not polynomial or
+   *        the integrator truncates and `domain` misses a symbol
+   */
+  template<typename T>
+  DiscreteSystem<T> operator()(const ODE<T> &ode, const T &time_step,
+                               const domain_type<T> &domain,
+                               domain_type<T> &remainders) const;
+
+  /**
+   * @brief Integrate an ODE with a symbolic time step without truncation
+   *
+   * @tparam T is the ODE constant type
+   * @param ode is the polynomial ODE to be integrated
+   * @param time_step is the time step variable
+   * @return the continuous system associated to the ODE
+   * @throw std::domain_error if the ODE is not polynomial or
+   *        the integrator truncates
+   */
+  template<typename T>
+  ContinuousSystem<T>
+  operator()(const ODE<T> &ode,
+             const SymbolicAlgebra::Symbol<T> &time_step) const;
+
+  /**
+   * @brief Integrate an ODE with a numeric time step without truncation
+   *
+   * @tparam T is the ODE constant type
+   * @param ode is the polynomial ODE to be integrated
+   * @param time_step is the time step
+   * @return the discrete system associated to the ODE
+   * @throw std::domain_error if the ODE is not polynomial or
+   *        the integrator truncates
+   */
+  template<typename T>
+  DiscreteSystem<T> operator()(const ODE<T> &ode, const T &time_step) const;
+};
+
 template<typename T>
 void ODEIntegrator::validate_time_step_variable(
     const ODE<T> &ode, const SymbolicAlgebra::Symbol<T> &time_step)
@@ -323,4 +858,402 @@ DiscreteSystem<T> RungeKutta4Integrator::operator()(const ODE<T> &ode,
   return {std::move(variables), std::move(parameters), std::move(dynamics)};
 }
 
+template<typename T>
+PolynomialODEIntegrator::Workspace<T>::Workspace(
+    const ODE<T> &ode, const SymbolicAlgebra::Symbol<T> *time_step,
+    const unsigned int max_degree, const domain_type<T> &domain):
+    _symbols(ode.variables()),
+    _domain(), _max_degree(max_degree)
+{
+  const auto &parameters = ode.parameters();
+  _symbols.insert(std::end(_symbols), std::begin(parameters),
+                  std::end(parameters));
+  if (!ode.is_time_independent()) {
+    _symbols.push_back(ode.time_variable());
+  }
+  if (time_step != nullptr) {
+    _symbols.push_back(*time_step);
+  }
+
+  if (_max_degree == 0) {
+    return;
+  }
+
+  _domain.reserve(_symbols.size());
+  for (const auto &symbol: _symbols) {
+    auto found = domain.find(symbol);
+    if (found == std::end(domain)) {
+      SAPO_ERROR("the truncation domain does not bound \""
+                     << symbol << "\"",
+                 std::domain_error);
+    }
+    _domain.push_back(found->second);
+  }
+}
+
+template<typename T>
+void PolynomialODEIntegrator::Workspace<T>::truncate(
+    TaylorModel<T> &model) const
+{
+  if (_max_degree == 0) {
+    return;
+  }
+
+  const auto removed = model.polynomial.truncate(_max_degree);
+  if (!removed.is_zero()) {
+    model.remainder += removed.range(_domain);
+  }
+}
+
+template<typename T>
+PolynomialODEIntegrator::TaylorModel<T>
+PolynomialODEIntegrator::Workspace<T>::multiply(const TaylorModel<T> &a,
+                                                const TaylorModel<T> &b) const
+{
+  // (p_a + r_a)(p_b + r_b) = p_a*p_b + p_b*r_a + p_a*r_b + r_a*r_b
+  TaylorModel<T> result{a.polynomial * b.polynomial, T(0)};
+  if (!a.remainder.is_zero()) {
+    result.remainder += b.polynomial.range(_domain) * a.remainder;
+  }
+  if (!b.remainder.is_zero()) {
+    result.remainder += a.polynomial.range(_domain) * b.remainder;
+    if (!a.remainder.is_zero()) {
+      result.remainder += a.remainder * b.remainder;
+    }
+  }
+
+  truncate(result);
+
+  return result;
+}
+
+template<typename T>
+PolynomialODEIntegrator::TaylorModel<T>
+PolynomialODEIntegrator::Workspace<T>::compose(
+    const SymbolicAlgebra::Polynomial<T> &polynomial,
+    const std::vector<TaylorModel<T>> &models) const
+{
+  using namespace SymbolicAlgebra;
+
+  const size_t num_of_variables = _symbols.size();
+
+  // the powers of the models are computed on demand
+  std::vector<std::vector<TaylorModel<T>>> powers(num_of_variables);
+
+  TaylorModel<T> result{Polynomial<T>(num_of_variables), T(0)};
+  for (size_t i = 0; i < polynomial.size(); ++i) {
+    const auto exponents = polynomial.exponents(i);
+
+    TaylorModel<T> term{
+        Polynomial<T>(num_of_variables, polynomial.coefficient(i)), T(0)};
+    for (size_t k = 0; k < num_of_variables; ++k) {
+      if (exponents[k] > 0) {
+        auto &k_powers = powers[k];
+        if (k_powers.empty()) {
+          k_powers.push_back(models[k]);
+        }
+        while (k_powers.size() < exponents[k]) {
+          k_powers.push_back(multiply(k_powers.back(), models[k]));
+        }
+        term = multiply(term, k_powers[exponents[k] - 1]);
+      }
+    }
+    add(result, term);
+  }
+
+  truncate(result);
+
+  return result;
+}
+
+template<typename T, typename DELTA_TYPE>
+std::pair<std::vector<SymbolicAlgebra::Symbol<T>>,
+          std::vector<SymbolicAlgebra::Symbol<T>>>
+PolynomialODEIntegrator::build_system(
+    const Workspace<T> &workspace, const ODE<T> &ode,
+    const std::vector<TaylorModel<T>> &models, const DELTA_TYPE &time_step,
+    domain_type<T> &remainders,
+    std::vector<SymbolicAlgebra::Expression<T>> &dynamics)
+{
+  using namespace SymbolicAlgebra;
+
+  std::vector<Symbol<T>> variables(ode.variables());
+  std::vector<Symbol<T>> parameters(ode.parameters());
+
+  for (size_t i = 0; i < models.size(); ++i) {
+    dynamics.push_back(workspace.expression(models[i].polynomial));
+
+    if (!models[i].remainder.is_zero()) {
+      Symbol<T> remainder("remainder_" + variables[i].get_name());
+
+      dynamics.back() += remainder;
+      parameters.push_back(remainder);
+      remainders.insert_or_assign(remainder, models[i].remainder);
+    }
+  }
+
+  if (!ode.is_time_independent()) {
+    variables.push_back(ode.time_variable());
+    dynamics.push_back(ode.time_variable() + time_step);
+  }
+
+  return {std::move(variables), std::move(parameters)};
+}
+
+template<typename T, typename DELTA_TYPE>
+std::vector<SymbolicAlgebra::Expression<T>>
+PolynomialRungeKutta4Integrator::runge_kutta4(
+    const ODE<T> &ode, const DELTA_TYPE &time_step,
+    const domain_type<T> &domain, domain_type<T> &remainders,
+    std::vector<SymbolicAlgebra::Symbol<T>> &variables,
+    std::vector<SymbolicAlgebra::Symbol<T>> &parameters) const
+{
+  using namespace SymbolicAlgebra;
+
+  const Workspace<T> workspace(ode, time_step_symbol(time_step), _max_degree,
+                               domain);
+
+  const size_t dim = ode.variables().size();
+
+  std::vector<Polynomial<T>> f;
+  f.reserve(dim);
+  for (const auto &expression: ode.dynamics()) {
+    f.push_back(workspace.polynomial(expression));
+  }
+
+  std::vector<TaylorModel<T>> X;
+  X.reserve(workspace.num_of_variables());
+  for (size_t k = 0; k < workspace.num_of_variables(); ++k) {
+    X.push_back(workspace.variable(k));
+  }
+  const TaylorModel<T> h = workspace.time_step_model(time_step);
+
+  // the time variable follows the variables and the parameters
+  const bool time_dependent = !ode.is_time_independent();
+  const size_t time_index = dim + ode.parameters().size();
+
+  auto evaluate_f = [&f, &workspace](const std::vector<TaylorModel<T>> &x) {
+    std::vector<TaylorModel<T>> k;
+    k.reserve(f.size());
+    for (const auto &f_i: f) {
+      k.push_back(workspace.compose(f_i, x));
+    }
+
+    return k;
+  };
+
+  // get X + c * h * k
+  auto shift = [&](const std::vector<TaylorModel<T>> &k, const T &c) {
+    std::vector<TaylorModel<T>> x = X;
+    for (size_t i = 0; i < dim; ++i) {
+      TaylorModel<T> delta = workspace.multiply(h, k[i]);
+      scale<T>(delta, c);
+      add(x[i], delta);
+    }
+    if (time_dependent) {
+      TaylorModel<T> delta = h;
+      scale<T>(delta, c);
+      add(x[time_index], delta);
+    }
+
+    return x;
+  };
+
+  const auto k1 = evaluate_f(X);
+  const auto k2 = evaluate_f(shift(k1, T(1) / 2));
+  const auto k3 = evaluate_f(shift(k2, T(1) / 2));
+  const auto k4 = evaluate_f(shift(k3, T(1)));
+
+  std::vector<TaylorModel<T>> rk_models;
+  rk_models.reserve(dim);
+  for (size_t i = 0; i < dim; ++i) {
+    TaylorModel<T> sum = k1[i];
+    for (const auto *k: {&k2, &k3}) {
+      TaylorModel<T> term = (*k)[i];
+      scale<T>(term, T(2));
+      add(sum, term);
+    }
+    add(sum, k4[i]);
+
+    TaylorModel<T> rk_model = workspace.multiply(h, sum);
+    scale<T>(rk_model, T(1) / 6);
+    add(rk_model, X[i]);
+
+    rk_models.push_back(std::move(rk_model));
+  }
+
+  std::vector<Expression<T>> dynamics;
+  std::tie(variables, parameters) = build_system(workspace, ode, rk_models,
+                                                 time_step, remainders,
+                                                 dynamics);
+
+  return dynamics;
+}
+
+template<typename T>
+ContinuousSystem<T> PolynomialRungeKutta4Integrator::operator()(
+    const ODE<T> &ode, const SymbolicAlgebra::Symbol<T> &time_step,
+    const domain_type<T> &domain, domain_type<T> &remainders) const
+{
+  using namespace SymbolicAlgebra;
+
+  validate_time_step_variable(ode, time_step);
+
+  std::vector<Symbol<T>> variables, parameters;
+  auto dynamics = runge_kutta4(ode, time_step, domain, remainders, variables,
+                               parameters);
+
+  return {std::move(variables), std::move(parameters), std::move(dynamics),
+          time_step};
+}
+
+template<typename T>
+DiscreteSystem<T> PolynomialRungeKutta4Integrator::operator()(
+    const ODE<T> &ode, const T &time_step, const domain_type<T> &domain,
+    domain_type<T> &remainders) const
+{
+  using namespace SymbolicAlgebra;
+
+  std::vector<Symbol<T>> variables, parameters;
+  auto dynamics = runge_kutta4(ode, time_step, domain, remainders, variables,
+                               parameters);
+
+  return {std::move(variables), std::move(parameters), std::move(dynamics)};
+}
+
+template<typename T>
+ContinuousSystem<T> PolynomialRungeKutta4Integrator::operator()(
+    const ODE<T> &ode, const SymbolicAlgebra::Symbol<T> &time_step) const
+{
+  domain_type<T> remainders;
+
+  return (*this)(ode, time_step, domain_type<T>(), remainders);
+}
+
+template<typename T>
+DiscreteSystem<T>
+PolynomialRungeKutta4Integrator::operator()(const ODE<T> &ode,
+                                            const T &time_step) const
+{
+  domain_type<T> remainders;
+
+  return (*this)(ode, time_step, domain_type<T>(), remainders);
+}
+
+template<typename T, typename DELTA_TYPE>
+std::vector<SymbolicAlgebra::Expression<T>> TaylorIntegrator::taylor(
+    const ODE<T> &ode, const DELTA_TYPE &time_step,
+    const domain_type<T> &domain, domain_type<T> &remainders,
+    std::vector<SymbolicAlgebra::Symbol<T>> &variables,
+    std::vector<SymbolicAlgebra::Symbol<T>> &parameters) const
+{
+  using namespace SymbolicAlgebra;
+
+  const Workspace<T> workspace(ode, time_step_symbol(time_step), _max_degree,
+                               domain);
+
+  const size_t dim = ode.variables().size();
+
+  std::vector<Polynomial<T>> f;
+  f.reserve(dim);
+  for (const auto &expression: ode.dynamics()) {
+    f.push_back(workspace.polynomial(expression));
+  }
+
+  // the time variable follows the variables and the parameters
+  const bool time_dependent = !ode.is_time_independent();
+  const size_t time_index = dim + ode.parameters().size();
+
+  // the Lie derivative of p along f
+  auto lie_derivative = [&](const Polynomial<T> &p) {
+    Polynomial<T> result(workspace.num_of_variables());
+    for (size_t i = 0; i < dim; ++i) {
+      result += f[i] * p.derivative(i);
+    }
+    if (time_dependent) {
+      result += p.derivative(time_index);
+    }
+
+    return result;
+  };
+
+  // the powers of the time step divided by their factorials
+  const TaylorModel<T> h = workspace.time_step_model(time_step);
+  std::vector<TaylorModel<T>> h_terms{h};
+  for (unsigned int j = 2; j <= _order; ++j) {
+    h_terms.push_back(workspace.multiply(h_terms.back(), h));
+    scale<T>(h_terms.back(), T(1) / j);
+  }
+
+  std::vector<TaylorModel<T>> taylor_models;
+  taylor_models.reserve(dim);
+  for (size_t i = 0; i < dim; ++i) {
+    TaylorModel<T> taylor_model = workspace.variable(i);
+
+    Polynomial<T> lie = taylor_model.polynomial;
+    for (unsigned int j = 1; j <= _order; ++j) {
+      lie = lie_derivative(lie);
+
+      add(taylor_model, workspace.multiply(h_terms[j - 1], {lie, T(0)}));
+    }
+
+    taylor_models.push_back(std::move(taylor_model));
+  }
+
+  std::vector<Expression<T>> dynamics;
+  std::tie(variables, parameters) = build_system(
+      workspace, ode, taylor_models, time_step, remainders, dynamics);
+
+  return dynamics;
+}
+
+template<typename T>
+ContinuousSystem<T> TaylorIntegrator::operator()(
+    const ODE<T> &ode, const SymbolicAlgebra::Symbol<T> &time_step,
+    const domain_type<T> &domain, domain_type<T> &remainders) const
+{
+  using namespace SymbolicAlgebra;
+
+  validate_time_step_variable(ode, time_step);
+
+  std::vector<Symbol<T>> variables, parameters;
+  auto dynamics
+      = taylor(ode, time_step, domain, remainders, variables, parameters);
+
+  return {std::move(variables), std::move(parameters), std::move(dynamics),
+          time_step};
+}
+
+template<typename T>
+DiscreteSystem<T> TaylorIntegrator::operator()(
+    const ODE<T> &ode, const T &time_step, const domain_type<T> &domain,
+    domain_type<T> &remainders) const
+{
+  using namespace SymbolicAlgebra;
+
+  std::vector<Symbol<T>> variables, parameters;
+  auto dynamics
+      = taylor(ode, time_step, domain, remainders, variables, parameters);
+
+  return {std::move(variables), std::move(parameters), std::move(dynamics)};
+}
+
+template<typename T>
+ContinuousSystem<T> TaylorIntegrator::operator()(
+    const ODE<T> &ode, const SymbolicAlgebra::Symbol<T> &time_step) const
+{
+  domain_type<T> remainders;
+
+  return (*this)(ode, time_step, domain_type<T>(), remainders);
+}
+
+template<typename T>
+DiscreteSystem<T> TaylorIntegrator::operator()(const ODE<T> &ode,
+                                               const T &time_step) const
+{
+  domain_type<T> remainders;
+
+  return (*this)(ode, time_step, domain_type<T>(), remainders);
+}
+
 #endif // _INTEGRATOR_H_
\ No newline at end of file
@@ -21,8 +21,10 @@
 #include <cmath>     // due to floor
 #include <limits>    // due to numeric_limits
 #include <algorithm> // due to transform
+#include <type_traits>
 
 #include "ErrorHandling.h"
+#include "LinearAlgebraKernels.h"
 
 namespace LinearAlgebra
 {
@@ -45,6 +47,10 @@ using Vector = std::vector<T>;
 template<typename T>
 T norm_2(const Vector<T> &v)
 {
+  if constexpr (std::is_same_v<T, double>) {
+    return sqrt(Kernels::dot(v.data(), v.data(), v.size()));
+  }
+
   T norm = 0;
 
   for (const auto &elem: v) {
@@ -422,6 +428,10 @@ T operator*(const Vector<T> &v1, const Vector<T> &v2)
     SAPO_ERROR("the two vectors differ in dimension", std::domain_error);
   }
 
+  if constexpr (std::is_same_v<T, double>) {
+    return Kernels::dot(v1.data(), v2.data(), v1.size());
+  }
+
   T res = 0;
   auto it2 = std::begin(v2);
   for (auto it1 = std::begin(v1); it1 != std::end(v1); ++it1) {
@@ -653,8 +663,7 @@ public:
    */
   Permutation &operator=(const Permutation &P)
   {
-    static_cast<std::map<size_t, size_t>>(*this)
-        = static_cast<std::map<size_t, size_t>>(P);
+    std::map<size_t, size_t>::operator=(P);
 
     return *this;
   }
@@ -872,6 +881,14 @@ Vector<T> operator*(const Dense::Matrix<T> &A, const Vector<T> &v)
 
   Vector<T> res(A.size(), 0);
 
+  if constexpr (std::is_same_v<T, double>) {
+    for (size_t i = 0; i < A.size(); ++i) {
+      res[i] = Kernels::dot(A[i].data(), v.data(), v.size());
+    }
+
+    return res;
+  }
+
   auto res_it = std::begin(res);
   for (auto A_row_it = std::begin(A); A_row_it != std::end(A);
        ++A_row_it, ++res_it) {
@@ -1154,8 +1171,13 @@ public:
           Vector<T> &row_k = _LU[k];
           if (row_k[j] != 0) {
             const T ratio = -row_k[j] / v;
-            for (size_t i = j + 1; i < row_j.size(); ++i) {
-              row_k[i] += ratio * row_j[i];
+            if constexpr (std::is_same_v<T, double>) {
+              Kernels::axpy(ratio, row_j.data() + j + 1,
+                            row_k.data() + j + 1, row_j.size() - j - 1);
+            } else {
+              for (size_t i = j + 1; i < row_j.size(); ++i) {
+                row_k[i] += ratio * row_j[i];
+              }
             }
             row_k[j] = -ratio;
           }
@@ -1194,6 +1216,66 @@ public:
     return solveU(Pb);
   }
 
+  /**
+   * @brief Compute the solution of \f$(P^{-1}\cdot L\cdot U)^T\cdot x=b\f$
+   *
+   * Since \f$(P^{-1}\cdot L\cdot U)^T = U^T\cdot L^T\cdot P\f$, this
+   * method solves the lower-triangular system \f$U^T\cdot z=b\f$ first,
+   * then, the upper-triangular system \f$L^T\cdot w=z\f$ and, finally,
+   * it applies the inverse permutation to \f$w\f$.
+   *
+   * @param b is the known term of the linear system
+   * @return the vector \f$x = (P^{-1}\cdot L\cdot U)^{-T} \cdot b\f$
+   */
+  Vector<T> solve_transposed(const Vector<T> &b) const
+  {
+    if (b.size() != _LU.size()) {
+      SAPO_ERROR("the number of rows of the LU factorization "
+                 "and the size of b differ",
+                 std::domain_error);
+    }
+
+    if (_LU.size() != _LU.front().size()) {
+      SAPO_ERROR("the factorization is not square and the linear "
+                 "system cannot be solved",
+                 std::domain_error);
+    }
+
+    // Forward substitution for U^T
+    Vector<T> z = b;
+    for (size_t j = 0; j < _LU.size(); ++j) {
+      const Vector<T> &row = _LU[j];
+      if (row[j] == 0) {
+        SAPO_ERROR("the linear system is undetermined", std::domain_error);
+      }
+      z[j] /= row[j];
+      if (z[j] != 0) {
+        for (size_t i = j + 1; i < row.size(); ++i) {
+          z[i] -= row[i] * z[j];
+        }
+      }
+    }
+
+    // Backward substitution for L^T
+    for (size_t rj = 0; rj < _LU.size(); ++rj) {
+      const size_t j = _LU.size() - rj - 1;
+      const Vector<T> &row = _LU[j];
+      if (z[j] != 0) {
+        for (size_t i = 0; i < j; ++i) {
+          z[i] -= row[i] * z[j];
+        }
+      }
+    }
+
+    // Inverse permutation
+    Vector<T> x = z;
+    for (auto it = std::begin(_P); it != std::end(_P); ++it) {
+      x[it->second] = z[it->first];
+    }
+
+    return x;
+  }
+
   /**
    * @brief Copy a LUP_Factorization object
    *
@@ -0,0 +1,253 @@
+/**
+ * @file LinearAlgebraKernels.h
+ * @author Alberto Casagrande <acasagrande@units.it>
+ * @brief Vectorized kernels for `double` linear algebra
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef LINEAR_ALGEBRA_KERNELS_H
+#define LINEAR_ALGEBRA_KERNELS_H
+
+#include <cstddef>
+
+namespace LinearAlgebra
+{
+
+/**
+ * @brief Vectorized kernels on arrays of `double`
+ *
+ * The kernels of this namespace are implemented for the AVX2 and the
+ * AVX-512 instruction sets and in plain C++. The implementation is
+ * selected at run-time according to the instruction sets supported
+ * by the CPU. All the implementations perform the very same
+ * floating-point operations in the very same order, without fusing
+ * multiplications and additions, so that their results do not depend
+ * on the selected instruction set. In particular, the dot product
+ * accumulates the element products in four partial sums, one per
+ * element index modulo 4, and it adds them as
+ * \f$(s_0+s_2)+(s_1+s_3)\f$ before adding the products of the last
+ * \f$n \bmod 4\f$ elements. For the same reason, the kernel
+ * translation unit is compiled with `-ffp-contract=off`.
+ */
+namespace Kernels
+{
+
+/**
+ * @brief The instruction sets of the kernel implementations
+ */
+enum class InstructionSet {
+  SCALAR, //!< plain C++
+  AVX2,   //!< Intel Advanced Vector Extensions 2
+  AVX512  //!< Intel Advanced Vector Extensions 512 (Foundation)
+};
+
+/**
+ * @brief Test whether the CPU supports an instruction set
+ *
+ * @param instruction_set is an instruction set
+ * @return `true` if and only if the kernels can be executed
+ *         by using `instruction_set`
+ */
+bool is_supported(const InstructionSet instruction_set);
+
+/**
+ * @brief Get the instruction set of the selected kernels
+ *
+ * @return the instruction set of the kernels in use
+ */
+InstructionSet instruction_set();
+
+/**
+ * @brief Select the kernel implementation
+ *
+ * By default, the kernels use the most recent instruction set
+ * supported by the CPU. This function is meant for validation and
+ * benchmarking.
+ *
+ * @param instruction_set is the instruction set to be used
+ * @return `true` if and only if `instruction_set` is supported
+ *         and it has been selected
+ */
+bool select(const InstructionSet instruction_set);
+
+/**
+ * @brief The minimum size of the arrays processed by the vectorized kernels
+ *
+ * Shorter arrays are processed by inlined scalar code, since the
+ * dispatch overhead exceeds the gain of vector instructions.
+ */
+constexpr size_t dispatch_threshold = 8;
+
+/**
+ * @brief Compute the dot product of two arrays by using scalar code
+ *
+ * @param a is an array
+ * @param b is an array
+ * @param size is the size of the arrays
+ * @return the dot product \f$\sum_i a[i] * b[i]\f$
+ */
+inline double scalar_dot(const double *a, const double *b, const size_t size)
+{
+  double sums[4] = {0, 0, 0, 0};
+
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    for (size_t k = 0; k < 4; ++k) {
+      sums[k] += a[i + k] * b[i + k];
+    }
+  }
+
+  double res = (sums[0] + sums[2]) + (sums[1] + sums[3]);
+  for (; i < size; ++i) {
+    res += a[i] * b[i];
+  }
+
+  return res;
+}
+
+/**
+ * @brief Add a scaled array to another array by using scalar code
+ *
+ * @param alpha is the scaling factor
+ * @param x is the array to be scaled
+ * @param y is the array to be updated
+ * @param size is the size of the arrays
+ */
+inline void scalar_axpy(const double alpha, const double *x, double *y,
+                        const size_t size)
+{
+  for (size_t i = 0; i < size; ++i) {
+    y[i] += alpha * x[i];
+  }
+}
+
+/**
+ * @brief Eliminate a column from a row by using scalar code
+ *
+ * @param row is the row to be updated
+ * @param pivot_row is the pivot row
+ * @param coeff is the coefficient of the pivot column in `row`
+ * @param pivot_value is the pivot value
+ * @param size is the size of the rows
+ */
+inline void scalar_eliminate(double *row, const double *pivot_row,
+                             const double coeff, const double pivot_value,
+                             const size_t size)
+{
+  for (size_t i = 0; i < size; ++i) {
+    const double term = coeff * pivot_row[i];
+    if (row[i] * pivot_value == term) {
+      row[i] = 0;
+    } else {
+      row[i] -= term / pivot_value;
+    }
+  }
+}
+
+/**
+ * @brief Compute the dot product of two arrays by using the selected kernel
+ *
+ * @param a is an array
+ * @param b is an array
+ * @param size is the size of the arrays
+ * @return the dot product \f$\sum_i a[i] * b[i]\f$
+ */
+double dispatched_dot(const double *a, const double *b, const size_t size);
+
+/**
+ * @brief Add a scaled array to another array by using the selected kernel
+ *
+ * @param alpha is the scaling factor
+ * @param x is the array to be scaled
+ * @param y is the array to be updated
+ * @param size is the size of the arrays
+ */
+void dispatched_axpy(const double alpha, const double *x, double *y,
+                     const size_t size);
+
+/**
+ * @brief Eliminate a column from a row by using the selected kernel
+ *
+ * @param row is the row to be updated
+ * @param pivot_row is the pivot row
+ * @param coeff is the coefficient of the pivot column in `row`
+ * @param pivot_value is the pivot value
+ * @param size is the size of the rows
+ */
+void dispatched_eliminate(double *row, const double *pivot_row,
+                          const double coeff, const double pivot_value,
+                          const size_t size);
+
+/**
+ * @brief Compute the dot product of two arrays
+ *
+ * @param a is an array
+ * @param b is an array
+ * @param size is the size of the arrays
+ * @return the dot product \f$\sum_i a[i] * b[i]\f$
+ */
+inline double dot(const double *a, const double *b, const size_t size)
+{
+  if (size < dispatch_threshold) {
+    return scalar_dot(a, b, size);
+  }
+
+  return dispatched_dot(a, b, size);
+}
+
+/**
+ * @brief Add a scaled array to another array
+ *
+ * This function computes \f$y[i] = y[i] + \alpha * x[i]\f$ for
+ * all the indices \f$i\f$.
+ *
+ * @param alpha is the scaling factor
+ * @param x is the array to be scaled
+ * @param y is the array to be updated
+ * @param size is the size of the arrays
+ */
+inline void axpy(const double alpha, const double *x, double *y,
+                 const size_t size)
+{
+  if (size < dispatch_threshold) {
+    scalar_axpy(alpha, x, y, size);
+  } else {
+    dispatched_axpy(alpha, x, y, size);
+  }
+}
+
+/**
+ * @brief Eliminate a column from a row by using a pivot row
+ *
+ * This function computes
+ * \f$row[i] = row[i] - coeff * pivot\_row[i] / pivot\_value\f$
+ * for all the indices \f$i\f$. If \f$row[i] * pivot\_value\f$ equals
+ * \f$coeff * pivot\_row[i]\f$, then \f$row[i]\f$ is set to 0 to
+ * avoid rounding residuals. This is the row operation of the
+ * simplex method pivots.
+ *
+ * @param row is the row to be updated
+ * @param pivot_row is the pivot row
+ * @param coeff is the coefficient of the pivot column in `row`
+ * @param pivot_value is the pivot value
+ * @param size is the size of the rows
+ */
+inline void eliminate(double *row, const double *pivot_row,
+                      const double coeff, const double pivot_value,
+                      const size_t size)
+{
+  if (size < dispatch_threshold) {
+    scalar_eliminate(row, pivot_row, coeff, pivot_value, size);
+  } else {
+    dispatched_eliminate(row, pivot_row, coeff, pivot_value, size);
+  }
+}
+
+} // namespace Kernels
+
+} // namespace LinearAlgebra
+
+#endif // LINEAR_ALGEBRA_KERNELS_H
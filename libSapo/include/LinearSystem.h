@@ -71,6 +71,28 @@ protected:
    */
   bool constraint_is_redundant(const unsigned int i) const;
 
+  /**
+   * @brief Remove the rows implied by a parallel row
+   *
+   * This method removes, without solving any linear problem,
+   * the rows \f$A_i \cdot x \leq b_i\f$ such that
+   * \f$A_i = c \cdot A_j\f$ and \f$b_i \geq c \cdot b_j\f$
+   * for some other row \f$A_j \cdot x \leq b_j\f$ and some
+   * \f$c > 0\f$, together with the null rows
+   * \f$0 \leq b_i\f$ where \f$b_i \geq 0\f$. Parallel rows
+   * are detected by hashing their normalized directions.
+   */
+  void remove_implied_parallel_rows();
+
+  /**
+   * @brief Remove some rows from the system
+   *
+   * @param[in] removed is a Boolean vector whose `i`-th value
+   *            is `true` if and only if the `i`-th row must be
+   *            removed
+   */
+  void remove_rows(const std::vector<bool> &removed);
+
 public:
   /**
    * Constructor that instantiates an empty linear system
@@ -231,6 +253,23 @@ public:
   OptimizationResult<double>
   maximize(const LinearAlgebra::Vector<double> &obj_fun) const;
 
+  /**
+   * @brief Get an optimizer for many objectives over the linear system
+   *
+   * The returned optimizer establishes the feasibility of the system
+   * once for all the objectives. It is meant for batches of
+   * optimizations on the same system.
+   *
+   * @param[in] obj_funs are the objective functions
+   * @return an optimizer for the objective functions over the linear
+   *         system
+   */
+  inline SimplexMethodOptimizer::BatchOptimizer<double>
+  optimizer(const std::vector<LinearAlgebra::Vector<double>> &obj_funs) const
+  {
+    return SimplexMethodOptimizer::BatchOptimizer<double>(_A, _b, obj_funs);
+  }
+
   /**
    * Minimize the linear system
    *
@@ -0,0 +1,165 @@
+/**
+ * @file MemoizedProperties.h
+ * @author Alberto Casagrande <acasagrande@units.it>
+ * @brief Memoize the properties of closed sets
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef MEMOIZEDPROPERTIES_H_
+#define MEMOIZEDPROPERTIES_H_
+
+#include <memory>
+
+#include "BoundingBox.h"
+#include "LinearAlgebra.h"
+
+/**
+ * @brief Memoized properties of closed sets
+ *
+ * This class stores what has already been established about
+ * a closed set: whether it is empty, a point belonging to it,
+ * whether its representation is canonical, and a box including
+ * it. The properties are immutable and they are published
+ * atomically, so that constant methods of the set can memoize
+ * them while other threads query the same set. Copies share the
+ * properties. The owner must forget them whenever it changes the
+ * set. A shrinking set may keep its box, while a growing set
+ * that keeps its emptiness properties must forget its box.
+ */
+class MemoizedProperties
+{
+public:
+  /**
+   * @brief The properties of a closed set
+   */
+  struct Properties {
+    bool is_empty;     //!< whether the set is empty
+    bool is_canonical; //!< whether the set representation is canonical
+    LinearAlgebra::Vector<double> witness; //!< a point in the set, if known
+  };
+
+private:
+  std::shared_ptr<const Properties> _properties; //!< the known properties
+  std::shared_ptr<const BoundingBox> _box; //!< a box including the set
+
+public:
+  /**
+   * @brief Build an object storing no property
+   */
+  MemoizedProperties(): _properties(), _box() {}
+
+  /**
+   * @brief Copy constructor
+   *
+   * @param orig is the original object
+   */
+  MemoizedProperties(const MemoizedProperties &orig):
+      _properties(std::atomic_load(&orig._properties)),
+      _box(std::atomic_load(&orig._box))
+  {
+  }
+
+  /**
+   * @brief Copy operator
+   *
+   * @param orig is the original object
+   * @return a reference to the updated object
+   */
+  MemoizedProperties &operator=(const MemoizedProperties &orig)
+  {
+    std::atomic_store(&_properties, std::atomic_load(&orig._properties));
+    std::atomic_store(&_box, std::atomic_load(&orig._box));
+
+    return *this;
+  }
+
+  /**
+   * @brief Get the known properties
+   *
+   * @return a pointer to the known properties or `nullptr` if
+   *         no property is known
+   */
+  inline std::shared_ptr<const Properties> get() const
+  {
+    return std::atomic_load(&_properties);
+  }
+
+  /**
+   * @brief Get the known box including the set
+   *
+   * @return a pointer to a box including the set or `nullptr` if
+   *         no box is known
+   */
+  inline std::shared_ptr<const BoundingBox> bounding_box() const
+  {
+    return std::atomic_load(&_box);
+  }
+
+  /**
+   * @brief Record a box including the set
+   *
+   * @param box is a box including the set
+   */
+  inline void set_bounding_box(BoundingBox &&box)
+  {
+    std::atomic_store(&_box,
+                      std::make_shared<const BoundingBox>(std::move(box)));
+  }
+
+  /**
+   * @brief Forget the box including the set
+   */
+  inline void forget_bounding_box()
+  {
+    std::atomic_store(&_box, std::shared_ptr<const BoundingBox>());
+  }
+
+  /**
+   * @brief Record that the set is empty
+   */
+  inline void set_empty()
+  {
+    std::atomic_store(&_properties, std::make_shared<const Properties>(
+                                        Properties{true, false, {}}));
+  }
+
+  /**
+   * @brief Record that the set is not empty
+   *
+   * @param witness is a point in the set or an empty vector
+   * @param is_canonical is a flag for canonical representations
+   */
+  inline void set_non_empty(LinearAlgebra::Vector<double> &&witness,
+                            const bool is_canonical = false)
+  {
+    std::atomic_store(&_properties,
+                      std::make_shared<const Properties>(Properties{
+                          false, is_canonical, std::move(witness)}));
+  }
+
+  /**
+   * @brief Forget all the properties
+   */
+  inline void forget()
+  {
+    std::atomic_store(&_properties, std::shared_ptr<const Properties>());
+    forget_bounding_box();
+  }
+
+  /**
+   * @brief Swap two memoized property objects
+   *
+   * @param A is a memoized property object
+   * @param B is a memoized property object
+   */
+  friend inline void swap(MemoizedProperties &A, MemoizedProperties &B)
+  {
+    std::swap(A._properties, B._properties);
+    std::swap(A._box, B._box);
+  }
+};
+
+#endif // MEMOIZEDPROPERTIES_H_
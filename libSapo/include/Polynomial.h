@@ -0,0 +1,1216 @@
+/**
+ * @file Polynomial.h
+ * @author Alberto Casagrande <acasagrande@units.it>
+ * @brief Sparse multivariate polynomials
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef POLYNOMIAL_H_
+#define POLYNOMIAL_H_
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#include "SymbolicAlgebra.h"
+#include "ErrorHandling.h"
+
+namespace SymbolicAlgebra
+{
+
+/**
+ * @brief Closed intervals
+ *
+ * Intervals enclose the ranges of polynomials over boxes. When `C`
+ * is a floating point type, every computed bound is moved one ulp
+ * outward, so that the enclosures are sound despite rounding errors.
+ * Otherwise, interval arithmetic is exact.
+ *
+ * @tparam C is the type of the bounds
+ */
+template<typename C = double>
+class Interval
+{
+  C _lower; //!< the interval lower bound
+  C _upper; //!< the interval upper bound
+
+  /**
+   * @brief Round a computed lower bound downward
+   *
+   * @param value is a computed lower bound
+   * @return a value lesser than or equal to the exact bound
+   */
+  static inline C round_down(const C &value)
+  {
+    if constexpr (std::is_floating_point_v<C>) {
+      return std::nextafter(value, -std::numeric_limits<C>::infinity());
+    } else {
+      return value;
+    }
+  }
+
+  /**
+   * @brief Round a computed upper bound upward
+   *
+   * @param value is a computed upper bound
+   * @return a value greater than or equal to the exact bound
+   */
+  static inline C round_up(const C &value)
+  {
+    if constexpr (std::is_floating_point_v<C>) {
+      return std::nextafter(value, std::numeric_limits<C>::infinity());
+    } else {
+      return value;
+    }
+  }
+
+public:
+  /**
+   * @brief Build an interval
+   *
+   * @param lower is the interval lower bound
+   * @param upper is the interval upper bound
+   */
+  Interval(const C &lower, const C &upper): _lower(lower), _upper(upper)
+  {
+    if (lower > upper) {
+      SAPO_ERROR("the lower bound exceeds the upper bound",
+                 std::domain_error);
+    }
+  }
+
+  /**
+   * @brief Build a singleton interval
+   *
+   * @param value is the only value in the interval
+   */
+  Interval(const C &value = 0): _lower(value), _upper(value) {}
+
+  /**
+   * @brief Get the interval lower bound
+   *
+   * @return the interval lower bound
+   */
+  inline const C &lower() const
+  {
+    return _lower;
+  }
+
+  /**
+   * @brief Get the interval upper bound
+   *
+   * @return the interval upper bound
+   */
+  inline const C &upper() const
+  {
+    return _upper;
+  }
+
+  /**
+   * @brief Test whether the interval is \f$[0,0]\f$
+   *
+   * @return `true` if and only if both the bounds are null
+   */
+  inline bool is_zero() const
+  {
+    return _lower == 0 && _upper == 0;
+  }
+
+  /**
+   * @brief Test whether the interval contains a value
+   *
+   * @param value is a value
+   * @return `true` if and only if `value` is in the interval
+   */
+  inline bool contains(const C &value) const
+  {
+    return _lower <= value && value <= _upper;
+  }
+
+  /**
+   * @brief Add an interval to this one
+   *
+   * @param interval is an interval
+   * @return a reference to the updated object
+   */
+  Interval<C> &operator+=(const Interval<C> &interval)
+  {
+    // adding \f$[0,0]\f$ is exact
+    if (interval.is_zero()) {
+      return *this;
+    }
+    if (is_zero()) {
+      return *this = interval;
+    }
+
+    _lower = round_down(_lower + interval._lower);
+    _upper = round_up(_upper + interval._upper);
+
+    return *this;
+  }
+
+  /**
+   * @brief Multiply this interval by another interval
+   *
+   * @param interval is an interval
+   * @return a reference to the updated object
+   */
+  Interval<C> &operator*=(const Interval<C> &interval)
+  {
+    // multiplying by \f$[0,0]\f$ is exact
+    if (is_zero() || interval.is_zero()) {
+      return *this = Interval<C>(0);
+    }
+
+    const C products[]
+        = {_lower * interval._lower, _lower * interval._upper,
+           _upper * interval._lower, _upper * interval._upper};
+
+    _lower = round_down(*std::min_element(products, products + 4));
+    _upper = round_up(*std::max_element(products, products + 4));
+
+    return *this;
+  }
+
+  /**
+   * @brief Raise the interval to a power
+   *
+   * @param exponent is the aimed exponent
+   * @return an interval including the values \f$x^e\f$ where \f$x\f$ is
+   *         in this interval and \f$e\f$ is `exponent`
+   */
+  Interval<C> power(const unsigned int exponent) const
+  {
+    if (exponent == 0) {
+      return Interval<C>(1);
+    }
+
+    if (exponent % 2 == 1 || _lower >= 0) {
+      // the power is monotonic
+      Interval<C> result(*this);
+      for (unsigned int e = 1; e < exponent; ++e) {
+        result *= *this;
+      }
+
+      return result;
+    }
+
+    // even exponents: the power of |x|
+    const C abs_lower = (_lower < 0 ? -_lower : _lower);
+    const C abs_upper = (_upper < 0 ? -_upper : _upper);
+    Interval<C> magnitude(_upper <= 0 ? abs_upper : 0,
+                          std::max(abs_lower, abs_upper));
+
+    return magnitude.power(exponent);
+  }
+};
+
+/**
+ * @brief Add two intervals
+ *
+ * @tparam C is the type of the bounds
+ * @param lhs is an interval
+ * @param rhs is an interval
+ * @return an interval including \f$lhs+rhs\f$
+ */
+template<typename C>
+inline Interval<C> operator+(Interval<C> lhs, const Interval<C> &rhs)
+{
+  return lhs += rhs;
+}
+
+/**
+ * @brief Multiply two intervals
+ *
+ * @tparam C is the type of the bounds
+ * @param lhs is an interval
+ * @param rhs is an interval
+ * @return an interval including \f$lhs*rhs\f$
+ */
+template<typename C>
+inline Interval<C> operator*(Interval<C> lhs, const Interval<C> &rhs)
+{
+  return lhs *= rhs;
+}
+
+/**
+ * @brief Sparse multivariate polynomials
+ *
+ * The objects of this class represent polynomials over a fixed
+ * number of variables having numeric coefficients. The variables
+ * are identified by their positions, i.e., by the indices
+ * \f$0, \ldots, n-1\f$, and they are bound to symbols exclusively
+ * when polynomials are built from, or converted into, expressions.
+ *
+ * The monomials are stored in lexicographic order as a flat vector
+ * of exponents, \f$n\f$ exponents per monomial, while their
+ * coefficients are stored in a contiguous vector. Null coefficients
+ * are never stored.
+ *
+ * The evolver uses polynomials exclusively to compute the Bernstein
+ * coefficient tensors of non-parametric polynomial systems on
+ * adaptive templates. The parametric and the symbolic Bernstein
+ * computations, as well as the dynamics and the generator functions,
+ * are still represented by `Expression` objects.
+ *
+ * @tparam C is the type of coefficients
+ */
+template<typename C = double>
+class Polynomial
+{
+  size_t _num_of_variables; //!< the number of variables
+  std::vector<unsigned int>
+      _exponents;               //!< the exponents of the monomials
+  std::vector<C> _coefficients; //!< the coefficients of the monomials
+
+  /**
+   * @brief Get the exponents of a monomial
+   *
+   * @param monomial is the index of a monomial
+   * @return a pointer to the exponents of the `monomial`-th monomial
+   */
+  inline const unsigned int *exponents_of(const size_t monomial) const
+  {
+    return _exponents.data() + monomial * _num_of_variables;
+  }
+
+  /**
+   * @brief Compare two exponent vectors lexicographically
+   *
+   * @param a is an exponent vector
+   * @param b is an exponent vector
+   * @param size is the size of the vectors
+   * @return a negative value, 0, or a positive value if `a` is lesser
+   *         than, equal to, or greater than `b`, respectively
+   */
+  static inline int compare(const unsigned int *a, const unsigned int *b,
+                            const size_t size)
+  {
+    for (size_t i = 0; i < size; ++i) {
+      if (a[i] != b[i]) {
+        return (a[i] < b[i] ? -1 : 1);
+      }
+    }
+
+    return 0;
+  }
+
+  /**
+   * @brief Append a monomial
+   *
+   * @param exponents is the exponent vector of the monomial
+   * @param coefficient is the coefficient of the monomial
+   */
+  inline void append(const unsigned int *exponents, const C &coefficient)
+  {
+    _exponents.insert(std::end(_exponents), exponents,
+                      exponents + _num_of_variables);
+    _coefficients.push_back(coefficient);
+  }
+
+  /**
+   * @brief Sort the monomials and merge the equal ones
+   *
+   * This method restores the class invariant on a polynomial whose
+   * monomials have been appended in any order: the monomials are
+   * sorted, the coefficients of equal monomials are added, and
+   * the null coefficients are removed.
+   */
+  void normalize()
+  {
+    std::vector<size_t> order(_coefficients.size());
+    std::iota(std::begin(order), std::end(order), 0);
+
+    std::stable_sort(std::begin(order), std::end(order),
+                     [this](const size_t a, const size_t b) {
+                       return compare(exponents_of(a), exponents_of(b),
+                                      _num_of_variables)
+                              < 0;
+                     });
+
+    Polynomial<C> result(_num_of_variables);
+    result._exponents.reserve(_exponents.size());
+    result._coefficients.reserve(_coefficients.size());
+
+    auto it = std::begin(order);
+    while (it != std::end(order)) {
+      const unsigned int *exponents = exponents_of(*it);
+
+      C coefficient = _coefficients[*it];
+      for (++it; it != std::end(order)
+                 && compare(exponents, exponents_of(*it), _num_of_variables)
+                        == 0;
+           ++it) {
+        coefficient += _coefficients[*it];
+      }
+
+      if (coefficient != 0) {
+        result.append(exponents, coefficient);
+      }
+    }
+
+    swap(*this, result);
+  }
+
+  /**
+   * @brief Raise a polynomial to a power
+   *
+   * @param powers is the vector of the already computed powers of a
+   *        polynomial, i.e., `powers[k]` is the polynomial raised to
+   *        `k`. It must contain at least the powers 0 and 1.
+   * @param exponent is the aimed exponent
+   * @return a reference to the polynomial raised to `exponent`
+   */
+  static const Polynomial<C> &power(std::vector<Polynomial<C>> &powers,
+                                    const unsigned int exponent)
+  {
+    while (powers.size() <= exponent) {
+      powers.push_back(powers.back() * powers[1]);
+    }
+
+    return powers[exponent];
+  }
+
+  /**
+   * @brief Check that two polynomials have the same variables
+   *
+   * @param polynomial is a polynomial
+   */
+  inline void
+  check_num_of_variables(const Polynomial<C> &polynomial) const
+  {
+    if (_num_of_variables != polynomial._num_of_variables) {
+      SAPO_ERROR("the polynomials must have the same number of variables",
+                 std::domain_error);
+    }
+  }
+
+  /**
+   * @brief Check that a variable belongs to the polynomial
+   *
+   * @param variable is a variable index
+   */
+  inline void check_variable(const size_t variable) const
+  {
+    if (variable >= _num_of_variables) {
+      SAPO_ERROR("the variable index exceeds the number of variables",
+                 std::domain_error);
+    }
+  }
+
+  /**
+   * @brief Build the polynomial of an expression tree
+   *
+   * @param ex is an expression tree
+   * @param num_of_variables is the number of the polynomial variables
+   * @param leaves associates the symbol ids to their polynomials
+   * @return the polynomial represented by `ex` once its symbols have
+   *         been replaced by their polynomials
+   * @throw std::domain_error if `ex` is not a polynomial or it
+   *        contains a symbol that is not in the domain of `leaves`
+   */
+  static Polynomial<C>
+  build(const low_level::base_expression_type<C> *ex,
+        const size_t num_of_variables,
+        const std::map<typename Symbol<C>::SymbolIdType, Polynomial<C>>
+            &leaves)
+  {
+    using namespace low_level;
+
+    switch (ex->type()) {
+    case CONSTANT:
+      return Polynomial<C>(num_of_variables,
+                           static_cast<const constant_type<C> *>(ex)
+                               ->get_value());
+    case SYMBOL:
+    {
+      auto found
+          = leaves.find(static_cast<const symbol_type<C> *>(ex)->get_id());
+      if (found == std::end(leaves)) {
+        SAPO_ERROR("the expression contains a symbol that is not "
+                   "a polynomial variable",
+                   std::domain_error);
+      }
+
+      return found->second;
+    }
+    case FINITE_SUM:
+    {
+      auto sum = static_cast<const finite_sum_type<C> *>(ex);
+
+      Polynomial<C> result(num_of_variables);
+      for (const auto &term: sum->_sum) {
+        result.append_all(build(term, num_of_variables, leaves));
+      }
+      result.append_all(Polynomial<C>(num_of_variables, sum->_constant));
+      result.normalize();
+
+      return result;
+    }
+    case FINITE_PROD:
+    {
+      auto prod = static_cast<const finite_prod_type<C> *>(ex);
+
+      Polynomial<C> result(num_of_variables, prod->_constant);
+      for (const auto &factor: prod->_numerator) {
+        result *= build(factor, num_of_variables, leaves);
+      }
+      for (const auto &factor: prod->_denominator) {
+        if (factor->type() != CONSTANT) {
+          SAPO_ERROR("the expression is not a polynomial",
+                     std::domain_error);
+        }
+        result /= static_cast<const constant_type<C> *>(factor)->get_value();
+      }
+
+      return result;
+    }
+    default:
+      SAPO_ERROR("unsupported expression type", std::domain_error);
+    }
+  }
+
+  /**
+   * @brief Append all the monomials of a polynomial
+   *
+   * @param polynomial is a polynomial on the same variables
+   */
+  inline void append_all(const Polynomial<C> &polynomial)
+  {
+    _exponents.insert(std::end(_exponents),
+                      std::begin(polynomial._exponents),
+                      std::end(polynomial._exponents));
+    _coefficients.insert(std::end(_coefficients),
+                         std::begin(polynomial._coefficients),
+                         std::end(polynomial._coefficients));
+  }
+
+public:
+  /**
+   * @brief Build the null polynomial
+   *
+   * @param num_of_variables is the number of variables
+   */
+  explicit Polynomial(const size_t num_of_variables = 0):
+      _num_of_variables(num_of_variables), _exponents(), _coefficients()
+  {
+  }
+
+  /**
+   * @brief Build a constant polynomial
+   *
+   * @param num_of_variables is the number of variables
+   * @param value is the value of the polynomial
+   */
+  Polynomial(const size_t num_of_variables, const C &value):
+      _num_of_variables(num_of_variables), _exponents(), _coefficients()
+  {
+    if (value != 0) {
+      _exponents.resize(num_of_variables, 0);
+      _coefficients.push_back(value);
+    }
+  }
+
+  /**
+   * @brief Build the polynomial of an expression
+   *
+   * The `i`-th variable of the built polynomial is `variables[i]`.
+   *
+   * @param expression is a polynomial expression
+   * @param variables is the vector of the polynomial variables
+   * @throw std::domain_error if `expression` is not a polynomial
+   *        or it contains a symbol that is not in `variables`
+   */
+  Polynomial(const Expression<C> &expression,
+             const std::vector<Symbol<C>> &variables):
+      _num_of_variables(variables.size()), _exponents(), _coefficients()
+  {
+    std::map<typename Symbol<C>::SymbolIdType, Polynomial<C>> leaves;
+    for (size_t i = 0; i < variables.size(); ++i) {
+      leaves.emplace(variables[i].get_id(),
+                     variable(variables.size(), i));
+    }
+
+    *this = build(expression._ex, variables.size(), leaves);
+  }
+
+  /**
+   * @brief Build a variable polynomial
+   *
+   * @param num_of_variables is the number of variables
+   * @param variable is the index of a variable
+   * @return the polynomial \f$x_{\texttt{variable}}\f$
+   */
+  static Polynomial<C> variable(const size_t num_of_variables,
+                                const size_t variable)
+  {
+    Polynomial<C> result(num_of_variables, 1);
+
+    result.check_variable(variable);
+    result._exponents[variable] = 1;
+
+    return result;
+  }
+
+  /**
+   * @brief Get the number of variables
+   *
+   * @return the number of variables
+   */
+  inline size_t num_of_variables() const
+  {
+    return _num_of_variables;
+  }
+
+  /**
+   * @brief Get the number of monomials
+   *
+   * @return the number of monomials having a non-null coefficient
+   */
+  inline size_t size() const
+  {
+    return _coefficients.size();
+  }
+
+  /**
+   * @brief Test whether the polynomial is null
+   *
+   * @return `true` if and only if all the coefficients are null
+   */
+  inline bool is_zero() const
+  {
+    return _coefficients.empty();
+  }
+
+  /**
+   * @brief Get the exponent vector of a monomial
+   *
+   * @param monomial is the index of a monomial
+   * @return the exponent vector of the `monomial`-th monomial
+   */
+  std::vector<unsigned int> exponents(const size_t monomial) const
+  {
+    const unsigned int *begin = exponents_of(monomial);
+
+    return std::vector<unsigned int>(begin, begin + _num_of_variables);
+  }
+
+  /**
+   * @brief Get the coefficient of a monomial
+   *
+   * @param monomial is the index of a monomial
+   * @return the coefficient of the `monomial`-th monomial
+   */
+  inline const C &coefficient(const size_t monomial) const
+  {
+    return _coefficients[monomial];
+  }
+
+  /**
+   * @brief Get the degree of a variable
+   *
+   * @param variable is the index of a variable
+   * @return the degree of the `variable`-th variable
+   */
+  unsigned int degree(const size_t variable) const
+  {
+    check_variable(variable);
+
+    unsigned int degree = 0;
+    for (size_t i = variable; i < _exponents.size();
+         i += _num_of_variables) {
+      degree = std::max(degree, _exponents[i]);
+    }
+
+    return degree;
+  }
+
+  /**
+   * @brief Get the degrees of all the variables
+   *
+   * @return the vector of the variable degrees
+   */
+  std::vector<unsigned int> degrees() const
+  {
+    std::vector<unsigned int> degrees(_num_of_variables, 0);
+    for (size_t i = 0; i < _exponents.size(); ++i) {
+      degrees[i % _num_of_variables]
+          = std::max(degrees[i % _num_of_variables], _exponents[i]);
+    }
+
+    return degrees;
+  }
+
+  /**
+   * @brief Get the total degree of the polynomial
+   *
+   * @return the maximum sum of the exponents of a monomial
+   */
+  unsigned int total_degree() const
+  {
+    unsigned int degree = 0;
+    for (size_t i = 0; i < size(); ++i) {
+      const unsigned int *exponents = exponents_of(i);
+
+      degree = std::max(degree, std::accumulate(exponents,
+                                                exponents + _num_of_variables,
+                                                0U));
+    }
+
+    return degree;
+  }
+
+  /**
+   * @brief Remove the monomials exceeding a total degree
+   *
+   * @param max_degree is the maximum total degree of the kept monomials
+   * @return the polynomial of the removed monomials
+   */
+  Polynomial<C> truncate(const unsigned int max_degree)
+  {
+    Polynomial<C> kept(_num_of_variables), removed(_num_of_variables);
+    for (size_t i = 0; i < size(); ++i) {
+      const unsigned int *exponents = exponents_of(i);
+
+      if (std::accumulate(exponents, exponents + _num_of_variables, 0U)
+          > max_degree) {
+        removed.append(exponents, _coefficients[i]);
+      } else {
+        kept.append(exponents, _coefficients[i]);
+      }
+    }
+
+    swap(*this, kept);
+
+    return removed;
+  }
+
+  /**
+   * @brief Get the derivative of the polynomial
+   *
+   * @param variable is the index of a variable
+   * @return the derivative of the polynomial with respect to the
+   *         `variable`-th variable
+   */
+  Polynomial<C> derivative(const size_t variable) const
+  {
+    check_variable(variable);
+
+    Polynomial<C> result(_num_of_variables);
+    std::vector<unsigned int> exponents(_num_of_variables);
+    for (size_t i = 0; i < size(); ++i) {
+      const unsigned int *i_exponents = exponents_of(i);
+      if (i_exponents[variable] > 0) {
+        std::copy(i_exponents, i_exponents + _num_of_variables,
+                  std::begin(exponents));
+        --exponents[variable];
+
+        result.append(exponents.data(),
+                      _coefficients[i] * C(i_exponents[variable]));
+      }
+    }
+
+    // the derivative preserves the monomial order
+    return result;
+  }
+
+  /**
+   * @brief Enclose the range of the polynomial over a box
+   *
+   * @param domain is the vector of the variable intervals
+   * @return an interval including the values of the polynomial
+   *         on the box `domain`
+   */
+  Interval<C> range(const std::vector<Interval<C>> &domain) const
+  {
+    if (domain.size() != _num_of_variables) {
+      SAPO_ERROR("the domain and the variables must have "
+                 "the same size",
+                 std::domain_error);
+    }
+
+    std::vector<std::vector<Interval<C>>> powers(_num_of_variables);
+    for (size_t k = 0; k < _num_of_variables; ++k) {
+      powers[k].push_back(Interval<C>(1));
+    }
+
+    Interval<C> result(0);
+    for (size_t i = 0; i < size(); ++i) {
+      const unsigned int *exponents = exponents_of(i);
+
+      Interval<C> term(_coefficients[i]);
+      for (size_t k = 0; k < _num_of_variables; ++k) {
+        if (exponents[k] > 0) {
+          while (powers[k].size() <= exponents[k]) {
+            powers[k].push_back(domain[k].power(powers[k].size()));
+          }
+          term *= powers[k][exponents[k]];
+        }
+      }
+      result += term;
+    }
+
+    return result;
+  }
+
+  /**
+   * @brief Add a polynomial to this one
+   *
+   * @param polynomial is a polynomial on the same variables
+   * @return a reference to the updated object
+   */
+  Polynomial<C> &operator+=(const Polynomial<C> &polynomial)
+  {
+    check_num_of_variables(polynomial);
+
+    Polynomial<C> result(_num_of_variables);
+    result._exponents.reserve(_exponents.size()
+                              + polynomial._exponents.size());
+    result._coefficients.reserve(size() + polynomial.size());
+
+    size_t i = 0, j = 0;
+    while (i < size() && j < polynomial.size()) {
+      const int cmp = compare(exponents_of(i), polynomial.exponents_of(j),
+                              _num_of_variables);
+      if (cmp < 0) {
+        result.append(exponents_of(i), _coefficients[i]);
+        ++i;
+      } else if (cmp > 0) {
+        result.append(polynomial.exponents_of(j),
+                      polynomial._coefficients[j]);
+        ++j;
+      } else {
+        const C coefficient = _coefficients[i] + polynomial._coefficients[j];
+        if (coefficient != 0) {
+          result.append(exponents_of(i), coefficient);
+        }
+        ++i;
+        ++j;
+      }
+    }
+    for (; i < size(); ++i) {
+      result.append(exponents_of(i), _coefficients[i]);
+    }
+    for (; j < polynomial.size(); ++j) {
+      result.append(polynomial.exponents_of(j), polynomial._coefficients[j]);
+    }
+
+    swap(*this, result);
+
+    return *this;
+  }
+
+  /**
+   * @brief Subtract a polynomial from this one
+   *
+   * @param polynomial is a polynomial on the same variables
+   * @return a reference to the updated object
+   */
+  inline Polynomial<C> &operator-=(const Polynomial<C> &polynomial)
+  {
+    return *this += -polynomial;
+  }
+
+  /**
+   * @brief Multiply this polynomial by another polynomial
+   *
+   * @param polynomial is a polynomial on the same variables
+   * @return a reference to the updated object
+   */
+  Polynomial<C> &operator*=(const Polynomial<C> &polynomial)
+  {
+    check_num_of_variables(polynomial);
+
+    Polynomial<C> result(_num_of_variables);
+    result._exponents.reserve(_exponents.size() * polynomial.size());
+    result._coefficients.reserve(size() * polynomial.size());
+
+    std::vector<unsigned int> exponents(_num_of_variables);
+    for (size_t i = 0; i < size(); ++i) {
+      const unsigned int *i_exponents = exponents_of(i);
+      for (size_t j = 0; j < polynomial.size(); ++j) {
+        const unsigned int *j_exponents = polynomial.exponents_of(j);
+        for (size_t k = 0; k < _num_of_variables; ++k) {
+          exponents[k] = i_exponents[k] + j_exponents[k];
+        }
+        result.append(exponents.data(),
+                      _coefficients[i] * polynomial._coefficients[j]);
+      }
+    }
+
+    result.normalize();
+
+    swap(*this, result);
+
+    return *this;
+  }
+
+  /**
+   * @brief Multiply this polynomial by a scalar
+   *
+   * @param value is a scalar value
+   * @return a reference to the updated object
+   */
+  Polynomial<C> &operator*=(const C &value)
+  {
+    if (value == 0) {
+      _exponents.clear();
+      _coefficients.clear();
+
+      return *this;
+    }
+
+    for (auto &coefficient: _coefficients) {
+      coefficient *= value;
+    }
+
+    return *this;
+  }
+
+  /**
+   * @brief Divide this polynomial by a scalar
+   *
+   * @param value is a non-null scalar value
+   * @return a reference to the updated object
+   */
+  Polynomial<C> &operator/=(const C &value)
+  {
+    if (value == 0) {
+      SAPO_ERROR("division by 0", std::domain_error);
+    }
+
+    for (auto &coefficient: _coefficients) {
+      coefficient /= value;
+    }
+
+    return *this;
+  }
+
+  /**
+   * @brief Get the opposite polynomial
+   *
+   * @return the polynomial \f$-p\f$ where \f$p\f$ is this polynomial
+   */
+  Polynomial<C> operator-() const
+  {
+    Polynomial<C> result(*this);
+    for (auto &coefficient: result._coefficients) {
+      coefficient = -coefficient;
+    }
+
+    return result;
+  }
+
+  /**
+   * @brief Evaluate the polynomial
+   *
+   * @param values is the vector of the variable values
+   * @return the value of the polynomial on `values`
+   */
+  C evaluate(const std::vector<C> &values) const
+  {
+    if (values.size() != _num_of_variables) {
+      SAPO_ERROR("the value vector and the variables must have "
+                 "the same size",
+                 std::domain_error);
+    }
+
+    C result = 0;
+    for (size_t i = 0; i < size(); ++i) {
+      const unsigned int *exponents = exponents_of(i);
+
+      C term = _coefficients[i];
+      for (size_t k = 0; k < _num_of_variables; ++k) {
+        for (unsigned int e = 0; e < exponents[k]; ++e) {
+          term *= values[k];
+        }
+      }
+      result += term;
+    }
+
+    return result;
+  }
+
+  /**
+   * @brief Substitute a variable by a value
+   *
+   * @param variable is the index of a variable
+   * @param value is the value of the variable
+   * @return the polynomial obtained by replacing the `variable`-th
+   *         variable by `value`. The returned polynomial has the same
+   *         variables of this one, but its degree in `variable` is 0
+   */
+  Polynomial<C> substitute(const size_t variable, const C &value) const
+  {
+    check_variable(variable);
+
+    std::vector<C> powers{1};
+
+    Polynomial<C> result(_num_of_variables);
+    result._exponents = _exponents;
+    result._coefficients.reserve(size());
+    for (size_t i = 0; i < size(); ++i) {
+      unsigned int &exponent
+          = result._exponents[i * _num_of_variables + variable];
+      while (powers.size() <= exponent) {
+        powers.push_back(powers.back() * value);
+      }
+
+      result._coefficients.push_back(_coefficients[i] * powers[exponent]);
+      exponent = 0;
+    }
+
+    result.normalize();
+
+    return result;
+  }
+
+  /**
+   * @brief Compose the polynomial with other polynomials
+   *
+   * @param polynomials is the vector of the polynomials replacing the
+   *        variables, i.e., `polynomials[i]` replaces the `i`-th
+   *        variable. All of them must have the same variables
+   * @return the polynomial \f$p(q_0, \ldots, q_{n-1})\f$ where
+   *         \f$p\f$ is this polynomial and \f$q_i\f$ is
+   *         `polynomials[i]`
+   */
+  Polynomial<C> compose(const std::vector<Polynomial<C>> &polynomials) const
+  {
+    if (polynomials.size() != _num_of_variables) {
+      SAPO_ERROR("the number of polynomials must equal the number "
+                 "of variables",
+                 std::domain_error);
+    }
+
+    const size_t num_of_variables
+        = (polynomials.size() > 0 ? polynomials[0]._num_of_variables : 0);
+
+    std::vector<std::vector<Polynomial<C>>> powers;
+    powers.reserve(polynomials.size());
+    for (const auto &polynomial: polynomials) {
+      if (polynomial._num_of_variables != num_of_variables) {
+        SAPO_ERROR("the polynomials must have the same number of variables",
+                   std::domain_error);
+      }
+      powers.push_back({Polynomial<C>(num_of_variables, 1), polynomial});
+    }
+
+    Polynomial<C> result(num_of_variables);
+    for (size_t i = 0; i < size(); ++i) {
+      const unsigned int *exponents = exponents_of(i);
+
+      Polynomial<C> term(num_of_variables, _coefficients[i]);
+      for (size_t k = 0; k < _num_of_variables; ++k) {
+        if (exponents[k] > 0) {
+          term *= power(powers[k], exponents[k]);
+        }
+      }
+      result.append_all(term);
+    }
+
+    result.normalize();
+
+    return result;
+  }
+
+  /**
+   * @brief Get the dense coefficient tensor of the polynomial
+   *
+   * This method stores the coefficients in a dense tensor in row-major
+   * order: the coefficient of the monomial \f$\prod_i x_i^{j_i}\f$ is
+   * placed in position \f$\sum_i j_i \prod_{h>i} (d_h+1)\f$ where
+   * \f$d_h\f$ is `degrees[h]`.
+   *
+   * @param degrees is the vector of the tensor variable degrees
+   * @return the dense coefficient tensor of the polynomial
+   * @throw std::domain_error if the polynomial degrees exceed `degrees`
+   */
+  std::vector<C>
+  get_dense_coefficients(const std::vector<unsigned int> &degrees) const
+  {
+    if (degrees.size() != _num_of_variables) {
+      SAPO_ERROR("the degree vector and the variables must have "
+                 "the same size",
+                 std::domain_error);
+    }
+
+    size_t tensor_size = 1;
+    for (const auto &degree: degrees) {
+      tensor_size *= degree + 1;
+    }
+
+    std::vector<C> dense_coeffs(tensor_size, 0);
+    for (size_t i = 0; i < size(); ++i) {
+      const unsigned int *exponents = exponents_of(i);
+
+      size_t position = 0;
+      for (size_t k = 0; k < _num_of_variables; ++k) {
+        if (exponents[k] > degrees[k]) {
+          SAPO_ERROR("the polynomial degrees exceed the tensor ones",
+                     std::domain_error);
+        }
+        position = position * (degrees[k] + 1) + exponents[k];
+      }
+      dense_coeffs[position] = _coefficients[i];
+    }
+
+    return dense_coeffs;
+  }
+
+  /**
+   * @brief Build the expression of the polynomial
+   *
+   * @param variables is the vector of the symbols of the variables
+   * @return the expression representing the polynomial in which the
+   *         `i`-th variable is `variables[i]`
+   */
+  Expression<C> to_expression(const std::vector<Symbol<C>> &variables) const
+  {
+    if (variables.size() != _num_of_variables) {
+      SAPO_ERROR("the symbol vector and the variables must have "
+                 "the same size",
+                 std::domain_error);
+    }
+
+    Expression<C> result = 0;
+    for (size_t i = 0; i < size(); ++i) {
+      const unsigned int *exponents = exponents_of(i);
+
+      Expression<C> term = _coefficients[i];
+      for (size_t k = 0; k < _num_of_variables; ++k) {
+        for (unsigned int e = 0; e < exponents[k]; ++e) {
+          term *= variables[k];
+        }
+      }
+      result += term;
+    }
+
+    return result;
+  }
+
+  /**
+   * @brief Test whether two polynomials are the same
+   *
+   * @param polynomial is a polynomial
+   * @return `true` if and only if this polynomial and `polynomial`
+   *         have the same variables and coefficients
+   */
+  inline bool operator==(const Polynomial<C> &polynomial) const
+  {
+    return _num_of_variables == polynomial._num_of_variables
+           && _exponents == polynomial._exponents
+           && _coefficients == polynomial._coefficients;
+  }
+
+  /**
+   * @brief Test whether two polynomials differ
+   *
+   * @param polynomial is a polynomial
+   * @return `true` if and only if this polynomial and `polynomial`
+   *         differ
+   */
+  inline bool operator!=(const Polynomial<C> &polynomial) const
+  {
+    return !(*this == polynomial);
+  }
+
+  template<typename T>
+  friend void swap(Polynomial<T> &a, Polynomial<T> &b);
+};
+
+/**
+ * @brief Swap two polynomials
+ *
+ * @tparam C is the type of coefficients
+ * @param a is a polynomial
+ * @param b is a polynomial
+ */
+template<typename C>
+inline void swap(Polynomial<C> &a, Polynomial<C> &b)
+{
+  std::swap(a._num_of_variables, b._num_of_variables);
+  std::swap(a._exponents, b._exponents);
+  std::swap(a._coefficients, b._coefficients);
+}
+
+/**
+ * @brief Add two polynomials
+ *
+ * @tparam C is the type of coefficients
+ * @param lhs is a polynomial
+ * @param rhs is a polynomial on the same variables
+ * @return the polynomial \f$lhs+rhs\f$
+ */
+template<typename C>
+inline Polynomial<C> operator+(Polynomial<C> lhs, const Polynomial<C> &rhs)
+{
+  return lhs += rhs;
+}
+
+/**
+ * @brief Subtract two polynomials
+ *
+ * @tparam C is the type of coefficients
+ * @param lhs is a polynomial
+ * @param rhs is a polynomial on the same variables
+ * @return the polynomial \f$lhs-rhs\f$
+ */
+template<typename C>
+inline Polynomial<C> operator-(Polynomial<C> lhs, const Polynomial<C> &rhs)
+{
+  return lhs -= rhs;
+}
+
+/**
+ * @brief Multiply two polynomials
+ *
+ * @tparam C is the type of coefficients
+ * @param lhs is a polynomial
+ * @param rhs is a polynomial on the same variables
+ * @return the polynomial \f$lhs*rhs\f$
+ */
+template<typename C>
+inline Polynomial<C> operator*(Polynomial<C> lhs, const Polynomial<C> &rhs)
+{
+  return lhs *= rhs;
+}
+
+/**
+ * @brief Multiply a polynomial by a scalar
+ *
+ * @tparam C is the type of coefficients
+ * @param lhs is a polynomial
+ * @param value is a scalar value
+ * @return the polynomial \f$lhs*value\f$
+ */
+template<typename C>
+inline Polynomial<C> operator*(Polynomial<C> lhs, const C &value)
+{
+  return lhs *= value;
+}
+
+/**
+ * @brief Multiply a polynomial by a scalar
+ *
+ * @tparam C is the type of coefficients
+ * @param value is a scalar value
+ * @param rhs is a polynomial
+ * @return the polynomial \f$value*rhs\f$
+ */
+template<typename C>
+inline Polynomial<C> operator*(const C &value, Polynomial<C> rhs)
+{
+  return rhs *= value;
+}
+
+} // namespace SymbolicAlgebra
+
+#endif // POLYNOMIAL_H_
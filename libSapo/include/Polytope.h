@@ -12,6 +12,8 @@
 #define POLYTOPE_H_
 
 #include "LinearSystem.h"
+#include "BoundingBox.h"
+#include "MemoizedProperties.h"
 
 /**
  * @brief Unions of closed sets
@@ -36,6 +38,28 @@ class Polytope : public LinearSystem
 {
 
 private:
+  mutable MemoizedProperties _memo; //!< the memoized polytope properties
+
+  /**
+   * @brief Establish whether the polytope is empty and memoize it
+   *
+   * @return `true` if and only if the polytope is empty
+   */
+  bool establish_emptiness() const;
+
+  /**
+   * @brief Forget the memoized properties unless the polytope is empty
+   *
+   * This method must be called whenever the polytope shrinks.
+   */
+  inline void forget_non_emptiness()
+  {
+    const auto properties = _memo.get();
+    if (!properties || !properties->is_empty) {
+      _memo.forget();
+    }
+  }
+
   std::list<Polytope>
   split(const std::vector<bool> &bvect_base, const unsigned int cidx,
         std::list<Polytope> &tmp_covering, std::vector<std::vector<double>> &A,
@@ -52,14 +76,14 @@ public:
    *
    * @param[in] orig the original polytope
    */
-  Polytope(const Polytope &orig): LinearSystem(orig) {}
+  Polytope(const Polytope &orig): LinearSystem(orig), _memo(orig._memo) {}
 
   /**
    * Swap constructor
    *
    * @param[in] orig the original polytope
    */
-  Polytope(Polytope &&orig): LinearSystem(orig) {}
+  Polytope(Polytope &&orig): LinearSystem(orig), _memo(orig._memo) {}
 
   /**
    * Constructor
@@ -107,6 +131,7 @@ public:
   Polytope &operator=(const Polytope &orig)
   {
     static_cast<LinearSystem *>(this)->operator=(orig);
+    _memo = orig._memo;
 
     return *this;
   }
@@ -120,6 +145,7 @@ public:
   Polytope &operator=(Polytope &&orig)
   {
     static_cast<LinearSystem *>(this)->operator=(orig);
+    _memo = orig._memo;
 
     return *this;
   }
@@ -133,7 +159,16 @@ public:
    */
   inline bool is_empty(const bool strict_inequality = false) const
   {
-    return !this->has_solutions(strict_inequality);
+    if (strict_inequality) {
+      return !this->has_solutions(true);
+    }
+
+    const auto properties = _memo.get();
+    if (properties) {
+      return properties->is_empty;
+    }
+
+    return establish_emptiness();
   }
 
   /**
@@ -156,10 +191,7 @@ public:
    *             object
    * @return `true` if and only if this polytope is a subset of `P`
    */
-  inline bool is_subset_of(const Polytope &P) const
-  {
-    return this->satisfies(P);
-  }
+  bool is_subset_of(const Polytope &P) const;
 
   /**
    * Check whether one polytope is a superset of another polytope
@@ -173,7 +205,7 @@ public:
    */
   inline bool includes(const Polytope &P) const
   {
-    return P.satisfies(*this);
+    return P.is_subset_of(*this);
   }
 
   /**
@@ -187,6 +219,37 @@ public:
    */
   Polytope &expand_by(const double delta);
 
+  /**
+   * @brief Add a new constraint to the polytope
+   *
+   * @param v is the vector of the variable coefficents
+   * @param b is the constant term
+   * @return a reference to the updated polytope
+   */
+  inline Polytope &add_constraint(const LinearAlgebra::Vector<double> &v,
+                                  const double &b)
+  {
+    LinearSystem::add_constraint(v, b);
+    forget_non_emptiness();
+
+    return *this;
+  }
+
+  /**
+   * @brief Add new constraints to the polytope
+   *
+   * @param linear_system is the linear system whose constraints must be
+   *      added to the polytope
+   * @return a reference to the updated polytope
+   */
+  inline Polytope &add_constraints(const LinearSystem &linear_system)
+  {
+    LinearSystem::add_constraints(linear_system);
+    forget_non_emptiness();
+
+    return *this;
+  }
+
   /**
    *  Split a polytope in a list of polytopes.
    *
@@ -232,6 +295,16 @@ public:
    */
   double bounding_box_volume() const;
 
+  /**
+   * @brief Get the bounding box of the polytope
+   *
+   * The box is computed by solving \f$2 \cdot n\f$ linear problems,
+   * where \f$n\f$ is the polytope dimension, and it is memoized.
+   *
+   * @return the smallest axis-aligned box including the polytope
+   */
+  BoundingBox bounding_box() const;
+
   /**
    * @brief Swap two polytopes
    *
@@ -244,6 +317,7 @@ public:
   {
     swap(*(static_cast<LinearSystem *>(&P1)),
          *(static_cast<LinearSystem *>(&P2)));
+    swap(P1._memo, P2._memo);
   }
 
   /**
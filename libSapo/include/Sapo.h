@@ -244,6 +244,20 @@ public:
   Flowpipe reach(Bundle init_set, unsigned int epoch_horizon,
                  ProgressAccounter *accounter = NULL);
 
+  /**
+   * Reachable set computation streaming the flowpipe
+   *
+   * The flowpipe steps are handed to the writer in epoch order, as soon
+   * as they are computed, and they are not stored by this method.
+   *
+   * @param[in] init_set is the initial set
+   * @param[in] epoch_horizon is the time horizon
+   * @param[in,out] writer is the writer of the reached flowpipe
+   * @param[in,out] accounter accounts for the computation progress
+   */
+  void reach(Bundle init_set, unsigned int epoch_horizon,
+             FlowpipeWriter &writer, ProgressAccounter *accounter = NULL);
+
   /**
    * Reachable set computation for parametric dynamical systems
    *
@@ -257,6 +271,23 @@ public:
                  unsigned int epoch_horizon,
                  ProgressAccounter *accounter = NULL);
 
+  /**
+   * Reachable set computation for parametric dynamical systems
+   * streaming the flowpipe
+   *
+   * The flowpipe steps are handed to the writer in epoch order, as soon
+   * as they are computed, and they are not stored by this method.
+   *
+   * @param[in] init_set is the initial set
+   * @param[in] pSet is the set of parameters
+   * @param[in] epoch_horizon is the epoch horizon
+   * @param[in,out] writer is the writer of the reached flowpipe
+   * @param[in,out] accounter accounts for the computation progress
+   */
+  void reach(Bundle init_set, const SetsUnion<Polytope> &pSet,
+             unsigned int epoch_horizon, FlowpipeWriter &writer,
+             ProgressAccounter *accounter = NULL);
+
   /**
    * Parameter synthesis method
    *
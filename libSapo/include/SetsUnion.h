@@ -11,8 +11,15 @@
 #ifndef SETSUNION_H_
 #define SETSUNION_H_
 
+#include <algorithm>
 #include <list>
 #include <memory>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "BoxTree.h"
 
 #ifdef WITH_THREADS
 #include <mutex>
@@ -21,6 +28,26 @@
 #include "SapoThreads.h"
 #endif // WITH_THREADS
 
+/**
+ * @brief Test whether a set type provides bounding boxes
+ *
+ * This trait is `true` if and only if the objects of type
+ * `SET_TYPE` have a constant method `bounding_box()`
+ * returning an over-approximating BoundingBox.
+ *
+ * @tparam SET_TYPE is a set type
+ */
+template<class SET_TYPE, typename = void>
+struct has_bounding_box : std::false_type {
+};
+
+template<class SET_TYPE>
+struct has_bounding_box<
+    SET_TYPE, std::void_t<decltype(std::declval<const SET_TYPE &>()
+                                       .bounding_box())>>
+    : std::true_type {
+};
+
 /**
  * @brief Unions of closed sets
  *
@@ -31,6 +58,8 @@
 template<class BASIC_SET_TYPE>
 class SetsUnion;
 
+class BinaryFlowpipeReader;
+
 /**
  * @brief Unions of closed sets
  *
@@ -44,12 +73,377 @@ class SetsUnion;
  * the list included by \f$S\f$ are removed from the
  * list and \f$S\f$ itself is appended at its end.
  *
+ * Whenever `BASIC_SET_TYPE` provides bounding boxes and
+ * the union contains at least `min_indexed_size` sets, the
+ * union also maintains an R-tree over the boxes of its
+ * sets. Inclusion and intersection queries only compare
+ * the queried set with the sets whose boxes overlap its
+ * box, as a non-empty set can neither be included in, nor
+ * intersect, a set whose box is disjoint from its own.
+ * Smaller unions are scanned linearly and compute no box.
+ * The boxes of the sets moved or copied from an indexed
+ * union are reused. The sets must not be enlarged by
+ * modifying them through the non-constant iterators;
+ * `expand_by()` updates the index by itself.
+ *
  * @tparam BASIC_SET_TYPE is the basic set type
  */
 template<class BASIC_SET_TYPE>
 class SetsUnion : private std::list<BASIC_SET_TYPE>
 {
+public:
+  /**
+   * @brief A constant iterator alias
+   */
+  using const_iterator = typename std::list<BASIC_SET_TYPE>::const_iterator;
+
+  /**
+   * @brief A iterator alias
+   */
+  using iterator = typename std::list<BASIC_SET_TYPE>::iterator;
+
+  /**
+   * @brief Whether the sets in the union are indexed by their boxes
+   */
+  static constexpr bool is_indexed = has_bounding_box<BASIC_SET_TYPE>::value;
+
+  /**
+   * @brief The minimum number of sets of an indexed union
+   */
+  static constexpr size_t min_indexed_size = 16;
+
 private:
+  /**
+   * @brief The index data of a set in the union
+   */
+  struct IndexedSet {
+    BoundingBox box; //!< the bounding box of the set
+    size_t stamp;    //!< the insertion stamp of the set
+  };
+
+  /**
+   * @brief The index keys: the insertion stamp and the list position
+   *
+   * Stamps grow along the list, so they sort the sets as the list does.
+   */
+  using IndexKey = std::pair<size_t, iterator>;
+
+  std::unordered_map<const BASIC_SET_TYPE *, IndexedSet>
+      _indexed_sets;         //!< the index data of the sets
+  BoxTree<IndexKey> _index;  //!< the R-tree over the set boxes
+  size_t _next_stamp = 0;    //!< the stamp of the next appended set
+  bool _has_index = false;   //!< whether the sets are currently indexed
+
+  /**
+   * @brief Get a bounding box for a set
+   *
+   * @tparam SET_TYPE is the type of the set
+   * @param set_obj is a set
+   * @return a box including `set_obj`. When `SET_TYPE` does not
+   *         provide bounding boxes, the whole space
+   */
+  template<class SET_TYPE>
+  static BoundingBox get_bounding_box(const SET_TYPE &set_obj)
+  {
+    if constexpr (has_bounding_box<SET_TYPE>::value) {
+      return set_obj.bounding_box();
+    } else {
+      return BoundingBox(set_obj.dim());
+    }
+  }
+
+  /**
+   * @brief Index the set in a list position
+   *
+   * @param it is the position of the set in the list
+   * @param box is a bounding box of the set
+   */
+  void index(iterator it, BoundingBox &&box)
+  {
+    if constexpr (is_indexed) {
+      if (_has_index) {
+        _index.insert(box, IndexKey(_next_stamp, it));
+        _indexed_sets.emplace(&(*it),
+                              IndexedSet{std::move(box), _next_stamp});
+      }
+    }
+    ++_next_stamp;
+  }
+
+  /**
+   * @brief Index the set in a list position
+   *
+   * The box of the set is computed only if the union is indexed.
+   *
+   * @param it is the position of the set in the list
+   */
+  void index(iterator it)
+  {
+    if (_has_index) {
+      index(it, get_bounding_box(*it));
+    } else {
+      ++_next_stamp;
+    }
+  }
+
+  /**
+   * @brief Get the indexed box of a set in the union
+   *
+   * @param set_obj is a set in the union
+   * @return a pointer to the indexed box of `set_obj` or
+   *         `nullptr` if the union is not indexed
+   */
+  const BoundingBox *get_indexed_box(const BASIC_SET_TYPE &set_obj) const
+  {
+    if (_has_index) {
+      auto found = _indexed_sets.find(&set_obj);
+      if (found != std::end(_indexed_sets)) {
+        return &(found->second.box);
+      }
+    }
+
+    return nullptr;
+  }
+
+  /**
+   * @brief Remove the set in a list position from the index
+   *
+   * @param it is the position of the set in the list
+   */
+  void unindex(iterator it)
+  {
+    if (_has_index) {
+      auto found = _indexed_sets.find(&(*it));
+      if (found != std::end(_indexed_sets)) {
+        _index.erase(found->second.box, IndexKey(found->second.stamp, it));
+        _indexed_sets.erase(found);
+      }
+    }
+  }
+
+  /**
+   * @brief Rebuild the index from scratch
+   *
+   * The sets are indexed only if the union contains at least
+   * `min_indexed_size` sets.
+   *
+   * @param boxes_from is a union storing the sets in the current
+   *        object, in the same order, or `nullptr`. The indexed
+   *        boxes of `boxes_from`, if any, are reused
+   */
+  void rebuild_index(const SetsUnion<BASIC_SET_TYPE> *boxes_from = nullptr)
+  {
+    _index.clear();
+    _indexed_sets.clear();
+    _next_stamp = 0;
+    _has_index = (is_indexed && size() >= min_indexed_size);
+
+    if (!_has_index) {
+      _next_stamp = size();
+
+      return;
+    }
+
+    if (boxes_from != nullptr && !boxes_from->_has_index) {
+      boxes_from = nullptr;
+    }
+
+    auto o_it = (boxes_from == nullptr ? const_iterator()
+                                       : boxes_from->begin());
+    for (auto it = begin(); it != end(); ++it) {
+      if (boxes_from == nullptr) {
+        index(it);
+      } else {
+        index(it, BoundingBox(boxes_from->_indexed_sets.at(&(*o_it)).box));
+        ++o_it;
+      }
+    }
+  }
+
+  /**
+   * @brief Index the union once it is large enough
+   */
+  inline void index_if_large()
+  {
+    if (is_indexed && !_has_index && size() >= min_indexed_size) {
+      rebuild_index();
+    }
+  }
+
+  /**
+   * @brief Append a set at the end of the list
+   *
+   * @param set_obj is the set to be appended
+   * @param box is a bounding box of `set_obj`
+   */
+  inline void push_back(const BASIC_SET_TYPE &set_obj, BoundingBox &&box)
+  {
+    std::list<BASIC_SET_TYPE>::push_back(set_obj);
+    index(std::prev(end()), std::move(box));
+  }
+
+  /**
+   * @brief Append a set at the end of the list
+   *
+   * @param set_obj is the set to be appended
+   * @param box is a bounding box of `set_obj`
+   */
+  inline void push_back(BASIC_SET_TYPE &&set_obj, BoundingBox &&box)
+  {
+    std::list<BASIC_SET_TYPE>::push_back(std::move(set_obj));
+    index(std::prev(end()), std::move(box));
+  }
+
+  /**
+   * @brief Append a set at the end of the list
+   *
+   * This method neither tests inclusion nor emptiness. A union
+   * that is not indexed remains so until the next addition.
+   *
+   * @param set_obj is the set to be appended
+   */
+  inline void push_back(const BASIC_SET_TYPE &set_obj)
+  {
+    std::list<BASIC_SET_TYPE>::push_back(set_obj);
+    index(std::prev(end()));
+  }
+
+  /**
+   * @brief Append a set at the end of the list
+   *
+   * This method neither tests inclusion nor emptiness. A union
+   * that is not indexed remains so until the next addition.
+   *
+   * @param set_obj is the set to be appended
+   */
+  inline void push_back(BASIC_SET_TYPE &&set_obj)
+  {
+    std::list<BASIC_SET_TYPE>::push_back(std::move(set_obj));
+    index(std::prev(end()));
+  }
+
+  /**
+   * @brief Remove a set from the list
+   *
+   * @param it is the position of the set to be removed
+   * @return the position following `it`
+   */
+  inline iterator erase(iterator it)
+  {
+    unindex(it);
+
+    return std::list<BASIC_SET_TYPE>::erase(it);
+  }
+
+  /**
+   * @brief Remove all the sets from the union
+   */
+  inline void clear()
+  {
+    std::list<BASIC_SET_TYPE>::clear();
+    rebuild_index();
+  }
+
+  /**
+   * @brief Move all the sets of another union at the end of the list
+   *
+   * This method neither tests inclusion nor emptiness.
+   *
+   * @param pos is the end of the list
+   * @param sets_union is the union whose sets are moved
+   */
+  void splice(const_iterator pos, SetsUnion<BASIC_SET_TYPE> &sets_union)
+  {
+    if (pos != end()) {
+      SAPO_ERROR("sets can be exclusively moved at the end of the list",
+                 std::domain_error);
+    }
+
+    for (auto it = sets_union.begin(); it != sets_union.end(); ++it) {
+      if (_has_index && sets_union._has_index) {
+        index(it, std::move(sets_union._indexed_sets.at(&(*it)).box));
+      } else {
+        index(it);
+      }
+    }
+    std::list<BASIC_SET_TYPE>::splice(end(), sets_union);
+
+    sets_union.rebuild_index();
+    index_if_large();
+  }
+
+  /**
+   * @brief Get the sets that may be related to a set
+   *
+   * This method collects, in list order, the sets among
+   * the first `sets_to_cmp` ones in the list whose boxes
+   * overlap the box of `set_obj`. Because of the insertion
+   * order, the sets following the first `sets_to_cmp` ones
+   * must be the last appended sets.
+   *
+   * @tparam SET_TYPE is the type of the set
+   * @param set_obj is a non-empty set
+   * @param box is a pointer to a bounding box of `set_obj` or
+   *        `nullptr`. In the latter case, the box is computed
+   *        only if the union is indexed
+   * @param sets_to_cmp is the number of sets in the head of the
+   *        list to be considered
+   * @return the positions of the sets among the first
+   *         `sets_to_cmp` ones in the list that may either
+   *         include, be included in, or intersect `set_obj`
+   */
+  template<class SET_TYPE>
+  std::vector<iterator>
+  overlapping_sets(const SET_TYPE &set_obj, const BoundingBox *box,
+                   size_t sets_to_cmp) const
+  {
+    std::vector<iterator> sets;
+
+    if constexpr (is_indexed && has_bounding_box<SET_TYPE>::value) {
+      if (_has_index) {
+        std::optional<BoundingBox> set_box;
+        if (box == nullptr) {
+          set_box = set_obj.bounding_box();
+          box = &(*set_box);
+        }
+
+        const size_t stamp_bound
+            = _next_stamp - (size() - std::min(sets_to_cmp, size()));
+
+        std::vector<IndexKey> keys;
+        auto collect = [&keys, stamp_bound](const IndexKey &key) {
+          if (key.first < stamp_bound) {
+            keys.push_back(key);
+          }
+        };
+        _index.for_each_overlapping(*box, collect);
+
+        std::sort(std::begin(keys), std::end(keys),
+                  [](const IndexKey &a, const IndexKey &b) {
+                    return a.first < b.first;
+                  });
+
+        sets.reserve(keys.size());
+        for (const auto &key: keys) {
+          sets.push_back(key.second);
+        }
+
+        return sets;
+      }
+    }
+
+    (void)set_obj;
+    (void)box;
+
+    auto *list = const_cast<SetsUnion<BASIC_SET_TYPE> *>(this);
+    for (auto it = list->begin(); it != list->end() && sets_to_cmp-- > 0;
+         ++it) {
+      sets.push_back(it);
+    }
+
+    return sets;
+  }
+
   /**
    * @brief Append a list of closed sets at the end of the current sets union
    *
@@ -57,7 +451,12 @@ private:
    */
   inline void append(std::list<BASIC_SET_TYPE> &list)
   {
-    this->splice(end(), list);
+    for (auto it = std::begin(list); it != std::end(list); ++it) {
+      index(it);
+    }
+    std::list<BASIC_SET_TYPE>::splice(end(), list);
+
+    index_if_large();
   }
 
   /**
@@ -67,7 +466,7 @@ private:
    */
   inline void append(std::list<BASIC_SET_TYPE> &&list)
   {
-    this->splice(end(), std::move(list));
+    append(list);
   }
 
   /**
@@ -88,12 +487,16 @@ private:
    * end of the sets list.
    *
    * @param[in] set_obj is the set to be added
+   * @param[in] box is a pointer to a bounding box of `set_obj` or
+   *            `nullptr`. In the latter case, the box is computed
+   *            only if the union is indexed
    * @param[in] sets_to_cmp is the number of closed sets in the list
    *            to be compared to `set_obj`
    * @return `true` if and only if the computation has added
    *         `set_obj` at the end of the sets list
    */
-  bool add(const BASIC_SET_TYPE &set_obj, size_t sets_to_cmp)
+  bool add(const BASIC_SET_TYPE &set_obj, const BoundingBox *box,
+           size_t sets_to_cmp)
   {
     if (size() != 0 && (this->front().dim() != set_obj.dim())) {
       SAPO_ERROR("adding a set to a union of closed sets "
@@ -105,9 +508,18 @@ private:
       return false;
     }
 
+    // the box of `set_obj` is exclusively needed by indexed unions
+    std::optional<BoundingBox> set_box;
+    if (box != nullptr) {
+      set_box = *box;
+    } else if (_has_index) {
+      set_box = get_bounding_box(set_obj);
+    }
+
     // for any of the first `sets_to_cmp` sets in the list
-    auto it = std::begin(*this);
-    while (it != std::end(*this) && sets_to_cmp-- > 0) {
+    // whose boxes overlap the box of `set_obj`
+    for (auto it: overlapping_sets(
+             set_obj, (set_box ? &(*set_box) : nullptr), sets_to_cmp)) {
       // if the set includes `set_obj`, then
       // `set_obj` is already included in the union
       // and the current object can be returned
@@ -119,16 +531,19 @@ private:
       // this set can be removed as `set_obj` is
       // going to be added to the list
       if (it->is_subset_of(set_obj)) {
-        it = std::list<BASIC_SET_TYPE>::erase(it);
-      } else {
-        ++it;
+        erase(it);
       }
     }
 
     // if `set_obj` is not a subset of any
     // of the sets in the head, then
     // append it to the union itself
-    this->push_back(set_obj);
+    if (set_box) {
+      this->push_back(set_obj, std::move(*set_box));
+    } else {
+      this->push_back(set_obj);
+    }
+    index_if_large();
 
     return true;
   }
@@ -151,12 +566,16 @@ private:
    * end of the sets list.
    *
    * @param[in] set_obj is the set to be added
+   * @param[in] box is a pointer to a bounding box of `set_obj` or
+   *            `nullptr`. In the latter case, the box is computed
+   *            only if the union is indexed
    * @param[in] sets_to_cmp is the number of closed sets in the list
    *            to be compared to `set_obj`
    * @return `true` if and only if `set_obj` was not already
    *         contained in the object
    */
-  bool add(BASIC_SET_TYPE &&set_obj, size_t sets_to_cmp)
+  bool add(BASIC_SET_TYPE &&set_obj, const BoundingBox *box,
+           size_t sets_to_cmp)
   {
     if (size() != 0 && (this->front().dim() != set_obj.dim())) {
       SAPO_ERROR("adding a set to a union of closed sets "
@@ -168,9 +587,18 @@ private:
       return false;
     }
 
+    // the box of `set_obj` is exclusively needed by indexed unions
+    std::optional<BoundingBox> set_box;
+    if (box != nullptr) {
+      set_box = *box;
+    } else if (_has_index) {
+      set_box = get_bounding_box(set_obj);
+    }
+
     // for any of the first `sets_to_cmp` sets in the list
-    auto it = std::begin(*this);
-    while (it != std::end(*this) && sets_to_cmp-- > 0) {
+    // whose boxes overlap the box of `set_obj`
+    for (auto it: overlapping_sets(
+             set_obj, (set_box ? &(*set_box) : nullptr), sets_to_cmp)) {
       // if the set includes `set_obj`, then
       // `set_obj` is already included in the union
       // and the current object can be returned
@@ -182,31 +610,24 @@ private:
       // this set can be removed as `set_obj` is
       // going to be added to the list
       if (it->is_subset_of(set_obj)) {
-        it = std::list<BASIC_SET_TYPE>::erase(it);
-      } else {
-        ++it;
+        erase(it);
       }
     }
 
     // if `set_obj` is not a subset of any
     // of the sets in the head, then
     // append it to the union itself
-    this->push_back(std::move(set_obj));
+    if (set_box) {
+      this->push_back(std::move(set_obj), std::move(*set_box));
+    } else {
+      this->push_back(std::move(set_obj));
+    }
+    index_if_large();
 
     return true;
   }
 
 public:
-  /**
-   * @brief A constant iterator alias
-   */
-  using const_iterator = typename std::list<BASIC_SET_TYPE>::const_iterator;
-
-  /**
-   * @brief A iterator alias
-   */
-  using iterator = typename std::list<BASIC_SET_TYPE>::iterator;
-
   /**
    * @brief Constructor
    *
@@ -243,6 +664,7 @@ public:
   SetsUnion(const SetsUnion<BASIC_SET_TYPE> &orig):
       std::list<BASIC_SET_TYPE>(orig)
   {
+    rebuild_index(&orig);
   }
 
   /**
@@ -276,8 +698,7 @@ public:
    */
   SetsUnion(SetsUnion<BASIC_SET_TYPE> &&orig)
   {
-    std::swap(*(static_cast<std::list<BASIC_SET_TYPE> *>(this)),
-              *(static_cast<std::list<BASIC_SET_TYPE> *>(&orig)));
+    swap(orig);
   }
 
   /**
@@ -287,10 +708,10 @@ public:
    */
   SetsUnion<BASIC_SET_TYPE> &operator=(const SetsUnion<BASIC_SET_TYPE> &orig)
   {
-    this->clear();
+    if (this != &orig) {
+      std::list<BASIC_SET_TYPE>::operator=(orig);
 
-    for (auto it = std::cbegin(orig); it != std::cend(orig); ++it) {
-      this->push_back(*it);
+      rebuild_index(&orig);
     }
 
     return *this;
@@ -303,12 +724,25 @@ public:
    */
   SetsUnion<BASIC_SET_TYPE> &operator=(SetsUnion<BASIC_SET_TYPE> &&orig)
   {
-    std::swap(*(static_cast<std::list<BASIC_SET_TYPE> *>(this)),
-              *(static_cast<std::list<BASIC_SET_TYPE> *>(&orig)));
+    swap(orig);
 
     return *this;
   }
 
+  /**
+   * @brief Swap two unions of closed sets
+   *
+   * @param[in] sets_union is a union of closed sets
+   */
+  void swap(SetsUnion<BASIC_SET_TYPE> &sets_union)
+  {
+    std::list<BASIC_SET_TYPE>::swap(sets_union);
+    std::swap(_indexed_sets, sets_union._indexed_sets);
+    std::swap(_index, sets_union._index);
+    std::swap(_next_stamp, sets_union._next_stamp);
+    std::swap(_has_index, sets_union._has_index);
+  }
+
   /**
    * @brief Get the first set in the union
    *
@@ -348,7 +782,7 @@ public:
    */
   inline bool add(const BASIC_SET_TYPE &set_obj)
   {
-    return add(set_obj, size());
+    return add(set_obj, nullptr, size());
   }
 
   /**
@@ -370,7 +804,7 @@ public:
    */
   inline bool add(BASIC_SET_TYPE &&set_obj)
   {
-    return add(std::move(set_obj), size());
+    return add(std::move(set_obj), nullptr, size());
   }
 
   /**
@@ -388,6 +822,7 @@ public:
    * @brief Update a sets union by joining another sets union
    *
    * This method works in-place and changes the calling object.
+   * The indexed boxes of `sets_union`, if any, are reused.
    *
    * @param[in] sets_union is a sets union
    * @return a reference to the updated object
@@ -399,7 +834,8 @@ public:
 
     for (auto it = std::cbegin(sets_union); it != std::cend(sets_union);
          ++it) {
-      if (this->add(*it, size() - from_sets_union)) {
+      if (this->add(*it, sets_union.get_indexed_box(*it),
+                    size() - from_sets_union)) {
         ++from_sets_union;
       }
     }
@@ -411,6 +847,7 @@ public:
    * @brief Update a sets union by joining another sets union
    *
    * This method works in-place and changes the calling object.
+   * The indexed boxes of `sets_union`, if any, are reused.
    *
    * @param[in] sets_union is a sets union
    * @return a reference to the updated object
@@ -420,7 +857,8 @@ public:
     unsigned int from_sets_union = 0;
 
     for (auto it = std::begin(sets_union); it != std::end(sets_union); ++it) {
-      if (this->add(std::move(*it), size() - from_sets_union)) {
+      const BoundingBox *box = sets_union.get_indexed_box(*it);
+      if (this->add(std::move(*it), box, size() - from_sets_union)) {
         ++from_sets_union;
       }
     }
@@ -464,6 +902,15 @@ public:
   template<class BASIC_SET_TYPE2>
   bool is_subset_of(const BASIC_SET_TYPE2 &set_obj) const
   {
+    if constexpr (is_indexed && has_bounding_box<BASIC_SET_TYPE2>::value) {
+      // all the sets must overlap `set_obj`
+      if (_has_index
+          && overlapping_sets(set_obj, nullptr, size()).size()
+                 != size()) {
+        return false;
+      }
+    }
+
     for (auto it = begin(); it != end(); ++it) {
       if (!it->is_subset_of(set_obj)) {
         return false;
@@ -555,6 +1002,10 @@ public:
       }
     };
 
+    // only the sets overlapping `set_obj` may include it
+    const auto candidates
+        = overlapping_sets(set_obj, nullptr, size());
+
     ThreadResult result;
 
     auto check_and_update = [&result, &set_obj](const BASIC_SET_TYPE &s) {
@@ -565,9 +1016,9 @@ public:
 
     ThreadPool::BatchId batch_id = thread_pool.create_batch();
 
-    for (auto it = std::cbegin(*this); it != std::cend(*this); ++it) {
+    for (const auto &it: candidates) {
       // submit the task to the thread pool
-      thread_pool.submit_to_batch(batch_id, check_and_update, std::ref(*it));
+      thread_pool.submit_to_batch(batch_id, check_and_update, std::cref(*it));
     }
 
     // join to the pool threads
@@ -578,7 +1029,9 @@ public:
 
     return result.get();
 #else  // WITH_THREADS
-    for (auto it = std::cbegin(*this); it != std::cend(*this); ++it) {
+    // only the sets overlapping `set_obj` may include it
+    for (const auto &it:
+         overlapping_sets(set_obj, nullptr, size())) {
       if (set_obj.is_subset_of(*it)) {
         return true;
       }
@@ -617,7 +1070,10 @@ public:
    * @brief Expand the union of closed sets
    *
    * This method expands the union so that each of its boundaries
-   * is moved by a value `delta`.
+   * is moved by a value `delta`. Since shrinking sets are still
+   * included in their boxes, the index is kept when `delta` is
+   * not positive. Otherwise, the index is dropped and it is
+   * rebuilt by the next addition.
    *
    * @param delta is the aimed expansion
    * @return a reference to the updated object
@@ -628,9 +1084,39 @@ public:
       it->expand_by(delta);
     }
 
+    if (delta > 0 && _has_index) {
+      _index.clear();
+      _indexed_sets.clear();
+      _has_index = false;
+    }
+
     return *this;
   }
 
+  /**
+   * @brief Get the sets in the union that may intersect a set
+   *
+   * This method returns, in list order, the sets in the union
+   * whose bounding boxes overlap the bounding box of `set_obj`.
+   * Whenever either the sets in the union or `set_obj` do not
+   * provide bounding boxes, all the sets in the union are
+   * returned.
+   *
+   * @tparam BASIC_SET_TYPE2 is the type of the tested set
+   * @param set_obj is a set
+   * @return the positions of the sets in the union that may
+   *         intersect `set_obj`
+   */
+  template<class BASIC_SET_TYPE2>
+  std::vector<const_iterator>
+  may_intersect(const BASIC_SET_TYPE2 &set_obj) const
+  {
+    const auto sets
+        = overlapping_sets(set_obj, nullptr, size());
+
+    return std::vector<const_iterator>(std::begin(sets), std::end(sets));
+  }
+
   /**
    * @brief The begin iterator
    *
@@ -702,6 +1188,8 @@ public:
 
   template<class BASIC_SET_TYPE2>
   friend class StickyUnion;
+
+  friend class BinaryFlowpipeReader;
 };
 
 /**
@@ -717,7 +1205,7 @@ bool are_disjoint(const SetsUnion<BASIC_SET_TYPE> &A,
                   const SetsUnion<BASIC_SET_TYPE> &B)
 {
   for (auto A_it = std::begin(A); A_it != std::end(A); ++A_it) {
-    for (auto B_it = std::begin(B); B_it != std::end(B); ++B_it) {
+    for (const auto &B_it: B.may_intersect(*A_it)) {
       if (!are_disjoint(*A_it, *B_it)) {
         return false;
       }
@@ -738,7 +1226,7 @@ bool are_disjoint(const SetsUnion<BASIC_SET_TYPE> &A,
 template<class BASIC_SET_TYPE>
 bool are_disjoint(const SetsUnion<BASIC_SET_TYPE> &A, const BASIC_SET_TYPE &B)
 {
-  for (auto A_it = std::begin(A); A_it != std::end(A); ++A_it) {
+  for (const auto &A_it: A.may_intersect(B)) {
     if (!are_disjoint(*A_it, B)) {
       return false;
     }
@@ -777,7 +1265,7 @@ SetsUnion<BASIC_SET_TYPE> intersect(const SetsUnion<BASIC_SET_TYPE> &A,
   SetsUnion<BASIC_SET_TYPE> result;
 
   for (auto A_it = std::begin(A); A_it != std::end(A); ++A_it) {
-    for (auto B_it = std::begin(B); B_it != std::end(B); ++B_it) {
+    for (const auto &B_it: B.may_intersect(*A_it)) {
       result.add(intersect(*A_it, *B_it));
     }
   }
@@ -864,6 +1352,82 @@ inline SetsUnion<BASIC_SET_TYPE> make_union(const BASIC_SET_TYPE &A,
   return result;
 }
 
+/**
+ * Compute the union of a range of sets unions
+ *
+ * This function unites the sets unions in a range of a vector by
+ * recursively halving the range. When threads are available, the two
+ * halves are united in parallel, so that the subsumption tests of
+ * large unions are distributed among the pool threads.
+ *
+ * @tparam BASIC_SET_TYPE is the basic set type
+ * @param[in,out] unions is a vector of sets unions whose range
+ *                elements are moved into the result
+ * @param[in] first is the first position of the range
+ * @param[in] last is the position following the range end
+ * @return the sets union representing the union of the sets
+ *         unions in `unions[first]`, ..., `unions[last-1]`
+ */
+template<class BASIC_SET_TYPE>
+SetsUnion<BASIC_SET_TYPE>
+make_union(std::vector<SetsUnion<BASIC_SET_TYPE>> &unions, const size_t first,
+           const size_t last)
+{
+  if (last <= first) {
+    return SetsUnion<BASIC_SET_TYPE>();
+  }
+
+  if (last - first == 1) {
+    return std::move(unions[first]);
+  }
+
+  const size_t middle = first + (last - first) / 2;
+
+#ifdef WITH_THREADS
+  SetsUnion<BASIC_SET_TYPE> result;
+
+  auto unite_first_half = [&result, &unions, first, middle]() {
+    result = make_union(unions, first, middle);
+  };
+
+  ThreadPool::BatchId batch_id = thread_pool.create_batch();
+
+  // submit the first half to the thread pool
+  thread_pool.submit_to_batch(batch_id, unite_first_half);
+
+  // unite the second half
+  SetsUnion<BASIC_SET_TYPE> second_half = make_union(unions, middle, last);
+
+  // join to the pool threads
+  thread_pool.join_threads(batch_id);
+
+  // close the batch
+  thread_pool.close_batch(batch_id);
+#else  // WITH_THREADS
+  SetsUnion<BASIC_SET_TYPE> result = make_union(unions, first, middle);
+  SetsUnion<BASIC_SET_TYPE> second_half = make_union(unions, middle, last);
+#endif // WITH_THREADS
+
+  result.update(std::move(second_half));
+
+  return result;
+}
+
+/**
+ * Compute the union of a vector of sets unions
+ *
+ * @tparam BASIC_SET_TYPE is the basic set type
+ * @param[in] unions is a vector of sets unions
+ * @return the sets union representing the union of the sets
+ *         unions in `unions`
+ */
+template<class BASIC_SET_TYPE>
+inline SetsUnion<BASIC_SET_TYPE>
+make_union(std::vector<SetsUnion<BASIC_SET_TYPE>> &&unions)
+{
+  return make_union(unions, 0, unions.size());
+}
+
 /**
  * @brief Subtract a sets union to a set and close the result
  *
@@ -11,6 +11,9 @@
 #ifndef SIMPLEX_H_
 #define SIMPLEX_H_
 
+#include <limits>
+#include <memory>
+
 #include "LinearAlgebra.h"
 
 #include "ErrorHandling.h"
@@ -227,14 +230,17 @@ class SimplexMethodOptimizer
 
     /**
      * @brief Initialize the initial basic variable vector
+     *
+     * @param num_of_constraints is the number of constraints in the
+     *        linear system
      */
-    void init_basic_variables()
+    void init_basic_variables(const size_t num_of_constraints)
     {
       const size_t slack_begin
-          = _tableau[0].size() - (_tableau.size() - 2) - 3;
+          = _tableau[0].size() - num_of_constraints - 3;
       _basic_variables.resize(0);
       std::generate_n(std::back_inserter(_basic_variables),
-                      _tableau.size() - 2,
+                      num_of_constraints,
                       [n = slack_begin]() mutable { return ++n; });
     }
 
@@ -251,22 +257,37 @@ class SimplexMethodOptimizer
     /**
      * @brief Initialize the tableau for minimization
      *
+     * One objective row is added for each of the objectives. All of
+     * them undergo the pivot operations, but only the last row of the
+     * tableau is minimized.
+     *
      * @param A is the linear system matrix
      * @param b is the linear system vector
-     * @param objective is the coefficient vector of the function to be
-     *        minimized
+     * @param objectives are the coefficient vectors of the functions to
+     *        be minimized
      */
     void init_tableau(const std::vector<LinearAlgebra::Vector<T>> &A,
                       const LinearAlgebra::Vector<T> &b,
-                      LinearAlgebra::Vector<T> &&objective)
+                      std::vector<LinearAlgebra::Vector<T>> &&objectives)
     {
       const size_t num_rows = A.size();
       const size_t num_cols = (num_rows == 0 ? 0 : A[0].size());
 
+      for (const auto &objective: objectives) {
+        if (num_cols != objective.size()) {
+          SAPO_ERROR("the objective dimension does not equal the number "
+                     "of columns in A",
+                     std::domain_error);
+        }
+      }
+
       _tableau = A;
 
-      // add objective row
-      _tableau.push_back(std::move(objective));
+      // add objective rows
+      _tableau.reserve(num_rows + objectives.size() + 1);
+      for (auto &objective: objectives) {
+        _tableau.push_back(std::move(objective));
+      }
 
       // complete tableau rows
       size_t row_idx = 0;
@@ -556,13 +577,78 @@ class SimplexMethodOptimizer
       }
 
       if (optimization_type == MAXIMIZE) {
-        init_tableau(A, b, -objective);
+        init_tableau(A, b, {-objective});
       } else {
-        init_tableau(A, b, Vector<T>(objective));
+        init_tableau(A, b, {objective});
+      }
+
+      add_omega_row();
+      init_basic_variables(num_rows);
+    }
+
+    /**
+     * @brief A constructor for many objectives
+     *
+     * This constructor build a new Tableau object having one objective
+     * row for each of the objectives to be minimized subject to the
+     * system \f$A * x <= b\f$. After the bootstrap phase, the
+     * objectives can be singly minimized by using `select_objective()`.
+     *
+     * @param A is the linear system matrix
+     * @param b is the linear system vector
+     * @param objectives are the objective coefficient vectors
+     */
+    Tableau(const std::vector<LinearAlgebra::Vector<T>> &A,
+            const LinearAlgebra::Vector<T> &b,
+            const std::vector<LinearAlgebra::Vector<T>> &objectives)
+    {
+      if (A.size() != b.size()) {
+        SAPO_ERROR("A and b differ in the number of rows", std::domain_error);
       }
 
+      init_tableau(A, b, std::vector<LinearAlgebra::Vector<T>>(objectives));
+
       add_omega_row();
-      init_basic_variables();
+      init_basic_variables(A.size());
+    }
+
+    /**
+     * @brief Copy a tableau keeping one of its objective rows
+     *
+     * This method copies the constraint rows and the basic variables of
+     * a tableau built by the many-objective constructor and completes
+     * them by one of its objective rows. Since the pivot operations
+     * treat the rows independently, the result equals the tableau of
+     * the selected objective alone.
+     *
+     * @param orig is a tableau with many objectives
+     * @param objective_index is the index of the objective to be
+     *        selected
+     * @param optimization_type is the required optimization goal, i.e.,
+     *                          MINIMIZE or MAXIMIZE
+     */
+    void select_objective(const Tableau<T> &orig,
+                          const size_t objective_index,
+                          const OptimizationGoal optimization_type)
+    {
+      const size_t num_of_constraints = orig._basic_variables.size();
+
+      _basic_variables = orig._basic_variables;
+      _tableau.resize(num_of_constraints + 1);
+      std::copy(std::begin(orig._tableau),
+                std::begin(orig._tableau) + num_of_constraints,
+                std::begin(_tableau));
+
+      // maximizing an objective is minimizing its opposite: as the
+      // pivot operations commute with the sign change, the maximization
+      // row is the opposite of the minimization one
+      auto &obj_row = objective_row();
+      obj_row = orig._tableau[num_of_constraints + objective_index];
+      if (optimization_type == MAXIMIZE) {
+        for (auto &value: obj_row) {
+          value = -value;
+        }
+      }
     }
 
     /**
@@ -586,13 +672,18 @@ class SimplexMethodOptimizer
           if (coeff != 0) {
 
             // row = row - coeff * pivot_row / pivot_value;
-            for (size_t i = 0; i < row.size(); ++i) {
-              const auto term = coeff * pivot_row[i];
-              // row[i] -= coeff * pivot_row[i] / pivot_value;
-              if (row[i] * pivot_value == term) {
-                row[i] = 0;
-              } else {
-                row[i] -= term / pivot_value;
+            if constexpr (std::is_same_v<T, double>) {
+              Kernels::eliminate(row.data(), pivot_row.data(), coeff,
+                                 pivot_value, row.size());
+            } else {
+              for (size_t i = 0; i < row.size(); ++i) {
+                const auto term = coeff * pivot_row[i];
+                // row[i] -= coeff * pivot_row[i] / pivot_value;
+                if (row[i] * pivot_value == term) {
+                  row[i] = 0;
+                } else {
+                  row[i] -= term / pivot_value;
+                }
               }
             }
           }
@@ -843,6 +934,171 @@ class SimplexMethodOptimizer
   };
 
 public:
+  /**
+   * @brief A simplex method optimizer for many objectives on one system
+   *
+   * Linear problems sharing the same system, e.g., the minimizations and
+   * maximizations along the directions of a bundle, do not need to
+   * repeat the bootstrap phase. This class performs it once, when the
+   * object is built, for all the objectives at the same time and, then,
+   * it minimizes or maximizes each objective from the resulting feasible
+   * basis. Since every objective row undergoes the very same pivot
+   * operations it would undergo alone, the results equal those of
+   * `SimplexMethodOptimizer::operator()`.
+   *
+   * @tparam T is the type of the linear system coefficients
+   */
+  template<typename T>
+  class BatchOptimizer
+  {
+    std::vector<LinearAlgebra::Vector<T>> _objectives; //!< the objectives
+    Tableau<T> _bootstrapped; //!< the tableau after the bootstrap phase
+    Tableau<T> _tableau;      //!< the tableau of the last optimization
+    bool _no_constraints;     //!< whether the system has no constraints
+    bool _feasible;           //!< whether the system has solutions
+
+    /**
+     * @brief Build the tableau of a system
+     *
+     * @param A is the linear system matrix
+     * @param b is the linear system vector
+     * @param objectives are the objective coefficient vectors
+     * @return the tableau for minimizing the objectives over
+     *         \f$A \cdot x \leq b\f$
+     */
+    static Tableau<T>
+    build_tableau(const std::vector<LinearAlgebra::Vector<T>> &A,
+                  const LinearAlgebra::Vector<T> &b,
+                  const std::vector<LinearAlgebra::Vector<T>> &objectives)
+    {
+      if (A.size() != b.size()) {
+        SAPO_ERROR("the number of rows in A and that of "
+                   "elements in b differ",
+                   std::domain_error);
+      }
+
+      // a placeholder for systems without constraints
+      if (A.size() == 0) {
+        return Tableau<T>({LinearAlgebra::Vector<T>()}, {0},
+                          std::vector<LinearAlgebra::Vector<T>>());
+      }
+
+      return Tableau<T>(A, b, objectives);
+    }
+
+  public:
+    /**
+     * @brief Build an optimizer for a linear system
+     *
+     * This constructor performs the simplex method bootstrap phase
+     * on the system \f$A \cdot x \leq b\f$.
+     *
+     * @param A is the linear system matrix
+     * @param b is the linear system vector
+     * @param objectives are the objective coefficient vectors
+     */
+    BatchOptimizer(const std::vector<LinearAlgebra::Vector<T>> &A,
+                   const LinearAlgebra::Vector<T> &b,
+                   const std::vector<LinearAlgebra::Vector<T>> &objectives):
+        _objectives(objectives),
+        _bootstrapped(build_tableau(A, b, objectives)),
+        _tableau(_bootstrapped), _no_constraints(A.size() == 0),
+        _feasible(true)
+    {
+      if (!_no_constraints) {
+        _feasible = _bootstrapped.bootstrap();
+      }
+    }
+
+    /**
+     * @brief Get the number of objectives
+     *
+     * @return the number of objectives
+     */
+    inline size_t size() const
+    {
+      return _objectives.size();
+    }
+
+    /**
+     * @brief Test whether the system has no solution
+     *
+     * @return `true` if and only if the system has no solution
+     */
+    inline bool feasible_set_is_empty() const
+    {
+      return !_feasible;
+    }
+
+    /**
+     * @brief Optimize one of the objectives over the system
+     *
+     * @param objective_index is the index of the objective
+     * @param optimization_type is the required optimization goal, i.e.,
+     *                          minimize or maximize
+     * @return the result of the optimization process
+     */
+    OptimizationResult<T>
+    operator()(const size_t objective_index,
+               const OptimizationGoal optimization_type = MINIMIZE)
+    {
+      if (objective_index >= _objectives.size()) {
+        SAPO_ERROR("the objective index must be smaller than the number "
+                   "of objectives",
+                   std::domain_error);
+      }
+
+      if (_no_constraints) {
+        return OptimizationResult<T>(OptimizationResult<T>::UNBOUNDED);
+      }
+
+      if (!_feasible) {
+        return OptimizationResult<T>(OptimizationResult<T>::INFEASIBLE);
+      }
+
+      // restart from the feasible basis
+      _tableau.select_objective(_bootstrapped, objective_index,
+                                optimization_type);
+
+      const auto status = _tableau.minimize_objective();
+      switch (status) {
+      case OptimizationResult<T>::OPTIMUM_AVAILABLE: {
+        using namespace LinearAlgebra;
+
+        auto candidate = _tableau.get_candidate_solution();
+        const T value = candidate * _objectives[objective_index];
+        return {std::move(candidate), value};
+      }
+      case OptimizationResult<T>::UNBOUNDED:
+        return OptimizationResult<T>::UNBOUNDED;
+      default:
+        SAPO_ERROR("unknown \"solve\" result", std::runtime_error);
+      }
+    }
+
+    /**
+     * @brief Minimize one of the objectives over the system
+     *
+     * @param objective_index is the index of the objective
+     * @return the result of the minimization process
+     */
+    inline OptimizationResult<T> minimize(const size_t objective_index)
+    {
+      return operator()(objective_index, MINIMIZE);
+    }
+
+    /**
+     * @brief Maximize one of the objectives over the system
+     *
+     * @param objective_index is the index of the objective
+     * @return the result of the maximization process
+     */
+    inline OptimizationResult<T> maximize(const size_t objective_index)
+    {
+      return operator()(objective_index, MAXIMIZE);
+    }
+  };
+
   /**
    * @brief An optimizer constructor
    */
@@ -908,4 +1164,1398 @@ public:
   }
 };
 
+/**
+ * @brief The inverse of a basis matrix in product form
+ *
+ * The inverse of the basis matrix \f$B\f$ is represented as
+ * \f$B^{-1} = E_k \cdot \ldots \cdot E_1 \cdot B_0^{-1}\f$, where
+ * \f$B_0\f$ is the last factorized basis matrix and every \f$E_i\f$
+ * is an eta matrix, i.e., an identity matrix except for one column.
+ * Replacing a column of \f$B\f$ appends an eta matrix rather than
+ * factorizing the new basis matrix.
+ *
+ * @tparam T is the type of the basis matrix coefficients
+ */
+template<typename T>
+class ProductFormBasis
+{
+  LinearAlgebra::Dense::LUP_Factorization<T> _B0; //!< the factorization
+  std::vector<size_t> _eta_positions;             //!< the eta positions
+  std::vector<LinearAlgebra::Vector<T>> _etas;    //!< the eta columns
+
+public:
+  /**
+   * @brief An empty constructor
+   */
+  ProductFormBasis(): _B0(), _eta_positions(), _etas() {}
+
+  /**
+   * @brief Factorize a basis matrix and drop the eta matrices
+   *
+   * @param B is the basis matrix
+   */
+  void factorize(const LinearAlgebra::Dense::Matrix<T> &B)
+  {
+    _B0 = LinearAlgebra::Dense::LUP_Factorization<T>(B);
+    _eta_positions.clear();
+    _etas.clear();
+  }
+
+  /**
+   * @brief Get the number of eta matrices
+   *
+   * @return the number of updates since the last factorization
+   */
+  inline size_t num_of_updates() const
+  {
+    return _etas.size();
+  }
+
+  /**
+   * @brief Solve the linear system \f$B \cdot x = v\f$
+   *
+   * @param v is the known term of the linear system
+   * @return the vector \f$B^{-1} \cdot v\f$
+   */
+  LinearAlgebra::Vector<T> solve(const LinearAlgebra::Vector<T> &v) const
+  {
+    LinearAlgebra::Vector<T> x = _B0.solve(v);
+
+    for (size_t k = 0; k < _etas.size(); ++k) {
+      const size_t pos = _eta_positions[k];
+      const T x_pos = x[pos];
+
+      if (x_pos != 0) {
+        const LinearAlgebra::Vector<T> &eta = _etas[k];
+        for (size_t i = 0; i < x.size(); ++i) {
+          if (i == pos) {
+            x[i] = eta[i] * x_pos;
+          } else if (eta[i] != 0) {
+            x[i] += eta[i] * x_pos;
+          }
+        }
+      }
+    }
+
+    return x;
+  }
+
+  /**
+   * @brief Solve the linear system \f$B^T \cdot x = v\f$
+   *
+   * @param v is the known term of the linear system
+   * @return the vector \f$B^{-T} \cdot v\f$
+   */
+  LinearAlgebra::Vector<T>
+  solve_transposed(LinearAlgebra::Vector<T> v) const
+  {
+    for (size_t rk = 0; rk < _etas.size(); ++rk) {
+      const size_t k = _etas.size() - rk - 1;
+      const LinearAlgebra::Vector<T> &eta = _etas[k];
+
+      T value = 0;
+      for (size_t i = 0; i < v.size(); ++i) {
+        if (eta[i] != 0) {
+          value += eta[i] * v[i];
+        }
+      }
+      v[_eta_positions[k]] = value;
+    }
+
+    return _B0.solve_transposed(v);
+  }
+
+  /**
+   * @brief Replace a basis column
+   *
+   * @param position is the position of the replaced column
+   * @param d is the new column premultiplied by \f$B^{-1}\f$
+   */
+  void update(const size_t position, const LinearAlgebra::Vector<T> &d)
+  {
+    const T &pivot = d[position];
+
+    LinearAlgebra::Vector<T> eta(d.size(), 0);
+    for (size_t i = 0; i < d.size(); ++i) {
+      if (i == position) {
+        eta[i] = 1 / pivot;
+      } else if (d[i] != 0) {
+        eta[i] = -d[i] / pivot;
+      }
+    }
+
+    _eta_positions.push_back(position);
+    _etas.push_back(std::move(eta));
+  }
+};
+
+/**
+ * @brief A linear optimizer that implements the revised simplex method
+ *
+ * `SimplexMethodOptimizer` updates the whole tableau, i.e., all the
+ * constraint, slack, and artificial columns, at every pivot operation.
+ * This optimizer, instead, never modifies the system matrix, which is
+ * stored in a contiguous row-major array, and it represents the inverse
+ * of the basis matrix by the LUP factorization of a previous basis and
+ * the product of the eta matrices of the following pivot operations.
+ * Each iteration prices the non-basic columns by solving one linear
+ * system on the transposed basis and computes the entering column by
+ * solving one linear system on the basis.
+ *
+ * The optimizer adopts the same standard form, variable order, and
+ * pivot rules of `SimplexMethodOptimizer`, which is kept for validation.
+ * When Sapo is compiled with `WITH_REVISED_SIMPLEX`, the single linear
+ * problems of `LinearSystem`, e.g., `LinearSystem::optimize`, are
+ * solved by this optimizer.
+ */
+class RevisedSimplexMethodOptimizer
+{
+  /**
+   * @brief The revised simplex method state for a linear system
+   *
+   * The linear system \f$A \cdot x \leq b\f$ is turned into the standard
+   * form of `SimplexMethodOptimizer`: the variables are ordered as
+   * - indices in [0, num_cols(A)-1]: positive values for system variables
+   * - indices in [num_cols(A), 2*num_cols(A)-1]: negative values for system
+   *   variables
+   * - indices in [2*num_cols(A), 2*num_cols(A)+num_rows(A)-1]: slack
+   *   variables
+   * - index 2*num_cols(A)+num_rows(A): the artificial variable
+   *
+   * and the columns of all of them, but the first num_cols(A) ones, are
+   * computed on demand.
+   *
+   * @tparam T is the type of the linear system coefficients
+   */
+  template<typename T>
+  class RevisedSimplex
+  {
+    /**
+     * @brief The number of pivot operations between two factorizations
+     */
+    static constexpr size_t refactorization_period = 64;
+
+    size_t _num_rows;   //!< the number of constraints
+    size_t _num_cols;   //!< the number of system variables
+    std::vector<T> _A;  //!< the system matrix in row-major order
+    LinearAlgebra::Vector<T> _b;          //!< the system constant vector
+    LinearAlgebra::Vector<T> _artificial; //!< the artificial column
+
+    std::vector<size_t> _basic_variables; //!< basic variable vector
+    std::vector<bool> _is_basic;          //!< basic variable flags
+    LinearAlgebra::Vector<T> _basic_values; //!< basic variable values
+    ProductFormBasis<T> _basis;             //!< the basis inverse
+    bool _artificial_may_enter; //!< can the artificial variable enter?
+
+    /**
+     * @brief Get the values that are considered to be null
+     *
+     * Exact types do not need any tolerance. For inexact types,
+     * reduced costs and pivot candidates whose absolute values
+     * do not exceed the returned value are considered to be null.
+     *
+     * @return the null value tolerance
+     */
+    static inline T zero_tolerance()
+    {
+      return std::numeric_limits<T>::epsilon() * 1024;
+    }
+
+    /**
+     * @brief Get the number of variables in the standard form
+     *
+     * @return the number of variables in the standard form
+     */
+    inline size_t num_of_variables() const
+    {
+      return 2 * _num_cols + _num_rows + 1;
+    }
+
+    /**
+     * @brief Get the index of the artificial variable
+     *
+     * @return the index of the artificial variable
+     */
+    inline size_t artificial_index() const
+    {
+      return 2 * _num_cols + _num_rows;
+    }
+
+    /**
+     * @brief Get the column of a variable
+     *
+     * @param variable is the index of a variable
+     * @return the column of `variable` in the standard form
+     */
+    LinearAlgebra::Vector<T> column(const size_t variable) const
+    {
+      if (variable == artificial_index()) {
+        return _artificial;
+      }
+
+      LinearAlgebra::Vector<T> col(_num_rows, 0);
+      if (variable < 2 * _num_cols) {
+        const size_t j = variable % _num_cols;
+        const bool negative = variable >= _num_cols;
+        for (size_t i = 0; i < _num_rows; ++i) {
+          const T &value = _A[i * _num_cols + j];
+          col[i] = (negative ? -value : value);
+        }
+      } else {
+        col[variable - 2 * _num_cols] = 1;
+      }
+
+      return col;
+    }
+
+    /**
+     * @brief Multiply a row vector by the system matrix
+     *
+     * @param y is a row vector
+     * @return the vector \f$y^T \cdot A\f$
+     */
+    LinearAlgebra::Vector<T>
+    multiply_A(const LinearAlgebra::Vector<T> &y) const
+    {
+      LinearAlgebra::Vector<T> yA(_num_cols, 0);
+
+      auto row_it = std::begin(_A);
+      for (size_t i = 0; i < _num_rows; ++i, row_it += _num_cols) {
+        const T &y_i = y[i];
+        if (y_i != 0) {
+          for (size_t j = 0; j < _num_cols; ++j) {
+            yA[j] += y_i * *(row_it + j);
+          }
+        }
+      }
+
+      return yA;
+    }
+
+    /**
+     * @brief Compute the product between a row vector and a column
+     *
+     * @param y is a row vector
+     * @param yA is the vector \f$y^T \cdot A\f$
+     * @param variable is the index of a variable
+     * @return the product between `y` and the column of `variable`
+     */
+    T column_product(const LinearAlgebra::Vector<T> &y,
+                     const LinearAlgebra::Vector<T> &yA,
+                     const size_t variable) const
+    {
+      if (variable < _num_cols) {
+        return yA[variable];
+      }
+      if (variable < 2 * _num_cols) {
+        return -yA[variable - _num_cols];
+      }
+      if (variable < artificial_index()) {
+        return y[variable - 2 * _num_cols];
+      }
+
+      using namespace LinearAlgebra;
+
+      return y * _artificial;
+    }
+
+    /**
+     * @brief Factorize the current basis and recompute its values
+     */
+    void refactorize()
+    {
+      LinearAlgebra::Dense::Matrix<T> B(_num_rows,
+                                        LinearAlgebra::Vector<T>(_num_rows));
+      for (size_t k = 0; k < _num_rows; ++k) {
+        const LinearAlgebra::Vector<T> col = column(_basic_variables[k]);
+        for (size_t i = 0; i < _num_rows; ++i) {
+          B[i][k] = col[i];
+        }
+      }
+
+      _basis.factorize(B);
+      _basic_values = _basis.solve(_b);
+    }
+
+    /**
+     * @brief Replace a basic variable by a non-basic one
+     *
+     * @param leaving is the position of the leaving variable in the
+     *                basic variable vector
+     * @param entering is the index of the entering variable
+     * @param d is the column of `entering` premultiplied by \f$B^{-1}\f$
+     */
+    void pivot_operation(const size_t leaving, const size_t entering,
+                         const LinearAlgebra::Vector<T> &d)
+    {
+      _is_basic[_basic_variables[leaving]] = false;
+      _is_basic[entering] = true;
+      _basic_variables[leaving] = entering;
+
+      if (_basis.num_of_updates() >= refactorization_period) {
+        refactorize();
+
+        return;
+      }
+
+      const T &pivot_value = d[leaving];
+      const T &leaving_value = _basic_values[leaving];
+      for (size_t i = 0; i < _num_rows; ++i) {
+        if (i != leaving && d[i] != 0) {
+          const T term = d[i] * leaving_value;
+          if (_basic_values[i] * pivot_value == term) {
+            _basic_values[i] = 0;
+          } else {
+            _basic_values[i] -= term / pivot_value;
+          }
+        }
+      }
+      _basic_values[leaving] /= pivot_value;
+
+      _basis.update(leaving, d);
+    }
+
+    /**
+     * @brief Find the first non-basic variable with negative reduced cost
+     *
+     * This function implements the "Bland's rule".
+     *
+     * @param costs is the cost vector
+     * @return if there exists a non-basic variable having a negative
+     *    reduced cost, the index of the first of them. The number of
+     *    variables, otherwise.
+     */
+    size_t
+    choose_entering_variable(const LinearAlgebra::Vector<T> &costs) const
+    {
+      LinearAlgebra::Vector<T> basic_costs(_num_rows);
+      for (size_t k = 0; k < _num_rows; ++k) {
+        basic_costs[k] = costs[_basic_variables[k]];
+      }
+
+      const auto y = _basis.solve_transposed(basic_costs);
+      const auto yA = multiply_A(y);
+
+      const size_t candidates
+          = (_artificial_may_enter ? num_of_variables() : artificial_index());
+      for (size_t j = 0; j < candidates; ++j) {
+        if (!_is_basic[j]
+            && costs[j] - column_product(y, yA, j) < -zero_tolerance()) {
+          return j;
+        }
+      }
+
+      return num_of_variables();
+    }
+
+    /**
+     * @brief Choose the leaving variable
+     *
+     * The minimum ratio ties are broken by choosing the basic variable
+     * having the minimum index. Whenever the artificial variable cannot
+     * enter the basis anymore, but it is still basic, its value must
+     * be kept null. Thus, it leaves the basis as soon as the entering
+     * variable affects it.
+     *
+     * @param d is the entering column premultiplied by \f$B^{-1}\f$
+     * @return the position in the basic variable vector of the leaving
+     *         variable, if any. The number of constraints, otherwise.
+     */
+    size_t choose_leaving_variable(const LinearAlgebra::Vector<T> &d) const
+    {
+      const T tolerance = zero_tolerance();
+
+      size_t leaving = _num_rows;
+      T min_ratio = 0;
+      for (size_t i = 0; i < _num_rows; ++i) {
+        if (!_artificial_may_enter
+            && _basic_variables[i] == artificial_index()
+            && (d[i] > tolerance || d[i] < -tolerance)) {
+          return i;
+        }
+
+        if (d[i] > tolerance) {
+          const T ratio = _basic_values[i] / d[i];
+
+          if (leaving == _num_rows || ratio < min_ratio
+              || (ratio == min_ratio
+                  && _basic_variables[i] < _basic_variables[leaving])) {
+            min_ratio = ratio;
+            leaving = i;
+          }
+        }
+      }
+
+      return leaving;
+    }
+
+    /**
+     * @brief Let a null basic artificial variable be non-basic
+     *
+     * If the artificial variable is basic and null after the bootstrap
+     * phase, it is replaced by any non-basic variable having a non-null
+     * coefficient in its row of \f$B^{-1} \cdot A\f$ (see the tableau
+     * method `let_artificial_variables_in_null_constraints_be_non_basic()`
+     * of `SimplexMethodOptimizer`).
+     */
+    void let_artificial_variable_be_non_basic()
+    {
+      const T tolerance = zero_tolerance();
+
+      for (size_t k = 0; k < _num_rows; ++k) {
+        if (_basic_variables[k] == artificial_index()
+            && _basic_values[k] <= tolerance) {
+
+          // the k-th row of B^{-1} * A
+          LinearAlgebra::Vector<T> e_k(_num_rows, 0);
+          e_k[k] = 1;
+          const auto rho = _basis.solve_transposed(e_k);
+          const auto rhoA = multiply_A(rho);
+
+          for (size_t j = 0; j < artificial_index(); ++j) {
+            if (!_is_basic[j]) {
+              const T alpha = column_product(rho, rhoA, j);
+              if (alpha > tolerance || alpha < -tolerance) {
+                pivot_operation(k, j, _basis.solve(column(j)));
+
+                return;
+              }
+            }
+          }
+
+          return;
+        }
+      }
+    }
+
+  public:
+    /**
+     * @brief A constructor
+     *
+     * @param A is the linear system matrix
+     * @param b is the linear system vector
+     */
+    RevisedSimplex(const std::vector<LinearAlgebra::Vector<T>> &A,
+                   const LinearAlgebra::Vector<T> &b):
+        _num_rows(A.size()),
+        _num_cols(A.size() == 0 ? 0 : A[0].size()), _A(), _b(b),
+        _artificial(A.size(), 0), _basic_variables(A.size()),
+        _is_basic(2 * _num_cols + A.size() + 1, false), _basic_values(),
+        _basis(), _artificial_may_enter(true)
+    {
+      if (A.size() != b.size()) {
+        SAPO_ERROR("A and b differ in the number of rows", std::domain_error);
+      }
+
+      _A.reserve(_num_rows * _num_cols);
+      for (const auto &row: A) {
+        if (row.size() != _num_cols) {
+          SAPO_ERROR("the rows of A must have the same size",
+                     std::domain_error);
+        }
+        std::copy(std::begin(row), std::end(row), std::back_inserter(_A));
+      }
+
+      for (size_t i = 0; i < _num_rows; ++i) {
+        if (_b[i] < 0) {
+          _artificial[i] = -1;
+        }
+      }
+    }
+
+    /**
+     * @brief Simplex method boostrap phase
+     *
+     * The slack variables form the initial basis. If some of the constant
+     * coefficients are negative, the artificial variable replaces the
+     * slack variable of the most negative one and, then, it is minimized.
+     * See `SimplexMethodOptimizer::Tableau::bootstrap()`.
+     *
+     * @return `true` if and only if the problem solution is not empty
+     */
+    bool bootstrap()
+    {
+      for (size_t k = 0; k < _num_rows; ++k) {
+        _basic_variables[k] = 2 * _num_cols + k;
+        _is_basic[2 * _num_cols + k] = true;
+      }
+      refactorize();
+
+      const size_t leaving = std::distance(
+          std::begin(_b), std::min_element(std::begin(_b), std::end(_b)));
+
+      if (_b[leaving] < 0) {
+        pivot_operation(leaving, artificial_index(),
+                        _basis.solve(_artificial));
+
+        LinearAlgebra::Vector<T> omega(num_of_variables(), 0);
+        omega[artificial_index()] = 1;
+        minimize(omega);
+
+        let_artificial_variable_be_non_basic();
+      }
+
+      _artificial_may_enter = false;
+
+      for (size_t k = 0; k < _num_rows; ++k) {
+        if (_basic_variables[k] == artificial_index()
+            && _basic_values[k] > zero_tolerance()) {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    /**
+     * @brief Minimize a cost vector
+     *
+     * @param costs is the cost vector of the standard form variables
+     * @return either `OptimizationResult<T>::OPTIMUM_AVAILABLE`
+     *      or `OptimizationResult<T>::UNBOUNDED`
+     */
+    typename OptimizationResult<T>::Status
+    minimize(const LinearAlgebra::Vector<T> &costs)
+    {
+      while (true) {
+        const size_t entering = choose_entering_variable(costs);
+
+        if (entering >= num_of_variables()) {
+          return OptimizationResult<T>::OPTIMUM_AVAILABLE;
+        }
+
+        const auto d = _basis.solve(column(entering));
+        const size_t leaving = choose_leaving_variable(d);
+
+        if (leaving >= _num_rows) {
+          return OptimizationResult<T>::UNBOUNDED;
+        }
+
+        pivot_operation(leaving, entering, d);
+      }
+    }
+
+    /**
+     * @brief Optimize an objective function
+     *
+     * This method must be called after `bootstrap()` and only if the
+     * latter succeeded.
+     *
+     * @param objective is the objective coefficient vector
+     * @param optimization_type is the required optimization goal, i.e.,
+     *                          MINIMIZE or MAXIMIZE
+     * @return the result of the optimization process
+     */
+    OptimizationResult<T>
+    optimize(const LinearAlgebra::Vector<T> &objective,
+             const OptimizationGoal optimization_type)
+    {
+      LinearAlgebra::Vector<T> costs(num_of_variables(), 0);
+      for (size_t j = 0; j < _num_cols; ++j) {
+        costs[j] = (optimization_type == MAXIMIZE ? -objective[j]
+                                                  : objective[j]);
+        costs[j + _num_cols] = -costs[j];
+      }
+
+      if (minimize(costs) == OptimizationResult<T>::UNBOUNDED) {
+        return OptimizationResult<T>::UNBOUNDED;
+      }
+
+      using namespace LinearAlgebra;
+
+      Vector<T> candidate(_num_cols, 0);
+      for (size_t k = 0; k < _num_rows; ++k) {
+        const size_t variable = _basic_variables[k];
+        if (variable < 2 * _num_cols) {
+          candidate[variable % _num_cols]
+              = (variable >= _num_cols ? -_basic_values[k]
+                                       : _basic_values[k]);
+        }
+      }
+
+      const T value = candidate * objective;
+      return {std::move(candidate), value};
+    }
+  };
+
+public:
+  /**
+   * @brief Optimize a linear problem
+   *
+   * @tparam T is the type of the linear system coefficients
+   * @param A is the linear system matrix
+   * @param b is the linear system vector
+   * @param objective is the objective coefficient vector
+   * @param optimization_type is the required optimization goal, i.e.,
+   *                          minimize or maximize
+   * @return the result of the optimization process
+   */
+  template<typename T>
+  OptimizationResult<T>
+  operator()(const std::vector<LinearAlgebra::Vector<T>> &A,
+             const LinearAlgebra::Vector<T> &b,
+             const LinearAlgebra::Vector<T> &objective,
+             OptimizationGoal optimization_type = MINIMIZE)
+  {
+    if (A.size() != b.size()) {
+      SAPO_ERROR("the number of rows in A and that of "
+                 "elements in b differ",
+                 std::domain_error);
+    }
+
+    if ((A.size() == 0 && objective.size())
+        || (A.size() != 0 && A[0].size() != objective.size())) {
+      SAPO_ERROR("objective size does not equal the number "
+                 "of columns in A: they must be the same",
+                 std::domain_error);
+    }
+
+    if (optimization_type != MAXIMIZE && optimization_type != MINIMIZE) {
+      SAPO_ERROR("unknown optimization type", std::runtime_error);
+    }
+
+    if (A.size() == 0) {
+      return OptimizationResult<T>(OptimizationResult<T>::UNBOUNDED);
+    }
+
+    RevisedSimplex<T> simplex(A, b);
+
+    if (!simplex.bootstrap()) {
+      return OptimizationResult<T>(OptimizationResult<T>::INFEASIBLE);
+    }
+
+    return simplex.optimize(objective, optimization_type);
+  }
+};
+
+/**
+ * @brief A bounded-variable dual simplex optimizer for ranged rows
+ *
+ * This class optimizes many objectives over a system of ranged rows
+ * \f$l \leq D \cdot x \leq u\f$, e.g., the constraints of a bundle.
+ * Rather than splitting every row in two inequalities and adding slack
+ * and artificial variables, it represents a basis as a set of
+ * \f$\texttt{dim}\f$ linearly independent rows of \f$D\f$, each of them
+ * active either at its lower or at its upper bound. Since every row is
+ * bounded on both sides, any basis can be made dual feasible by
+ * choosing the active bound of each basic row according to the sign of
+ * its multiplier. Hence, the dual simplex method can start from a
+ * known non-singular set of rows, e.g., a bundle template, and, once
+ * the feasibility of the system has been established, every objective
+ * is optimized from the last optimal basis.
+ *
+ * Whenever no dual feasible basis can be obtained in this way, e.g.,
+ * because some of the bounds are infinite, or the method does not
+ * converge, the optimizer falls back on
+ * `SimplexMethodOptimizer::BatchOptimizer` over the split system.
+ *
+ * @tparam T is the type of the linear system coefficients
+ */
+template<typename T>
+class BoundedDualSimplexOptimizer
+{
+  std::vector<LinearAlgebra::Vector<T>> _D; //!< the row matrix
+  LinearAlgebra::Vector<T> _lower;          //!< the row lower bounds
+  LinearAlgebra::Vector<T> _upper;          //!< the row upper bounds
+  std::vector<bool> _has_lower; //!< whether the row lower bounds are finite
+  std::vector<bool> _has_upper; //!< whether the row upper bounds are finite
+  std::vector<LinearAlgebra::Vector<T>> _objectives; //!< the objectives
+
+  std::vector<size_t> _basis;  //!< the rows in the basis
+  std::vector<bool> _at_upper; //!< whether basic rows are at upper bounds
+  std::vector<bool> _is_basic; //!< basic row flags
+  LinearAlgebra::Vector<T> _x; //!< the vertex of the last basis
+  LinearAlgebra::Vector<T> _feasible_point; //!< a solution, if known
+  T _cost;                                  //!< the cost of the last basis
+
+  bool _feasible; //!< whether the system has solutions
+
+  //! the tableau optimizer used whenever the dual simplex cannot be used
+  std::unique_ptr<SimplexMethodOptimizer::BatchOptimizer<T>> _fallback;
+
+  /**
+   * @brief The number of pivot operations between two factorizations
+   */
+  static constexpr size_t refactorization_period = 64;
+
+  /**
+   * @brief Get the values that are considered to be null
+   *
+   * @return the null value tolerance
+   */
+  static inline T zero_tolerance()
+  {
+    return std::numeric_limits<T>::epsilon() * 1024;
+  }
+
+  /**
+   * @brief Get the absolute value of a number
+   *
+   * @param value is a number
+   * @return the absolute value of `value`
+   */
+  static inline T magnitude(const T &value)
+  {
+    return (value < 0 ? -value : value);
+  }
+
+  /**
+   * @brief Test whether a bound is finite
+   *
+   * @param bound is a bound
+   * @return `true` if and only if `bound` is finite
+   */
+  static inline bool is_finite(const T &bound)
+  {
+    if constexpr (std::numeric_limits<T>::has_infinity) {
+      return bound != std::numeric_limits<T>::infinity()
+             && bound != -std::numeric_limits<T>::infinity();
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief Get the maximum number of iterations of one optimization
+   *
+   * @return the maximum number of dual simplex iterations before
+   *         falling back on the tableau method
+   */
+  inline size_t max_iterations() const
+  {
+    return 50 * (_D.size() + 1);
+  }
+
+  /**
+   * @brief Build the tableau optimizer over the split system
+   */
+  void build_fallback()
+  {
+    if (_fallback != nullptr) {
+      return;
+    }
+
+    using namespace LinearAlgebra;
+
+    std::vector<Vector<T>> A;
+    Vector<T> b;
+    for (size_t i = 0; i < _D.size(); ++i) {
+      if (_has_upper[i]) {
+        A.push_back(_D[i]);
+        b.push_back(_upper[i]);
+      }
+      if (_has_lower[i]) {
+        A.push_back(-_D[i]);
+        b.push_back(-_lower[i]);
+      }
+    }
+
+    _fallback = std::make_unique<SimplexMethodOptimizer::BatchOptimizer<T>>(
+        A, b, _objectives);
+  }
+
+  /**
+   * @brief Get the transposed basis matrix
+   *
+   * @return the matrix whose columns are the rows in the basis
+   */
+  LinearAlgebra::Dense::Matrix<T> transposed_basis() const
+  {
+    const size_t dim = _basis.size();
+
+    LinearAlgebra::Dense::Matrix<T> M(dim, LinearAlgebra::Vector<T>(dim));
+    for (size_t j = 0; j < dim; ++j) {
+      const LinearAlgebra::Vector<T> &row = _D[_basis[j]];
+      for (size_t i = 0; i < dim; ++i) {
+        M[i][j] = row[i];
+      }
+    }
+
+    return M;
+  }
+
+  /**
+   * @brief Run the dual simplex method from the current basis
+   *
+   * This method minimizes \f$c \cdot x\f$ subject to the ranged rows.
+   * At every iteration, the active bound of each basic row is chosen
+   * according to the sign of its multiplier, the first row violated
+   * by the basis vertex enters the basis at the violated bound, and
+   * the leaving row is selected by the dual ratio test. Ties are
+   * broken by the "Bland's rule". The inverse of the transposed basis
+   * matrix is kept in product form: it is factorized once at the
+   * beginning and, then, every \f$\texttt{refactorization_period}\f$
+   * pivot operations.
+   *
+   * When the dual ratio test finds no leaving row, the entering row is
+   * a certificate of infeasibility. The pivot candidates are compared
+   * with a tolerance scaled by the magnitude of the entering row in the
+   * basis coordinates, which accounts for both the row norm and the
+   * conditioning of the basis. If some candidate is not null, but it is
+   * indistinguishable from rounding errors, the infeasibility is not
+   * reliable and the method gives up, so that the caller falls back on
+   * the tableau method.
+   *
+   * @param c is the cost vector
+   * @return `OptimizationResult<T>::OPTIMUM_AVAILABLE` if an optimal
+   *      basis has been reached, `OptimizationResult<T>::INFEASIBLE` if
+   *      the system has no solution, and
+   *      `OptimizationResult<T>::UNBOUNDED` if the method could not
+   *      proceed, i.e., no dual feasible basis is available from the
+   *      current one, the infeasibility cannot be reliably established,
+   *      or the method does not converge
+   */
+  typename OptimizationResult<T>::Status
+  run(const LinearAlgebra::Vector<T> &c)
+  {
+    using namespace LinearAlgebra;
+
+    const T tolerance = zero_tolerance();
+    const size_t dim = _basis.size();
+
+    ProductFormBasis<T> basis_inverse;
+    basis_inverse.factorize(transposed_basis());
+
+    for (size_t iteration = 0; iteration < max_iterations(); ++iteration) {
+      if (basis_inverse.num_of_updates() >= refactorization_period) {
+        basis_inverse.factorize(transposed_basis());
+      }
+
+      const Vector<T> lambda = basis_inverse.solve(c);
+
+      // make the basis dual feasible
+      Vector<T> beta(dim);
+      for (size_t i = 0; i < dim; ++i) {
+        const size_t &row = _basis[i];
+        if (lambda[i] > tolerance) {
+          _at_upper[i] = false;
+        } else if (lambda[i] < -tolerance) {
+          _at_upper[i] = true;
+        } else if (!(_at_upper[i] ? _has_upper[row] : _has_lower[row])) {
+          _at_upper[i] = !_at_upper[i];
+        }
+
+        if (!(_at_upper[i] ? _has_upper[row] : _has_lower[row])) {
+          return OptimizationResult<T>::UNBOUNDED;
+        }
+        beta[i] = (_at_upper[i] ? _upper[row] : _lower[row]);
+      }
+
+      _x = basis_inverse.solve_transposed(beta);
+
+      // search for the first violated row
+      size_t entering = _D.size();
+      bool below = false;
+      for (size_t row = 0; row < _D.size() && entering == _D.size();
+           ++row) {
+        if (!_is_basic[row]) {
+          const T value = _D[row] * _x;
+
+          if (_has_lower[row]
+              && _lower[row] - value
+                     > tolerance * (1 + magnitude(_lower[row]))) {
+            entering = row;
+            below = true;
+          } else if (_has_upper[row]
+                     && value - _upper[row]
+                            > tolerance * (1 + magnitude(_upper[row]))) {
+            entering = row;
+          }
+        }
+      }
+
+      if (entering == _D.size()) {
+        // the dual objective value equals the active bound whenever
+        // the cost vector is a basic row
+        _cost = lambda * beta;
+
+        return OptimizationResult<T>::OPTIMUM_AVAILABLE;
+      }
+
+      // the entering row in the basis coordinates
+      const Vector<T> alpha = basis_inverse.solve(_D[entering]);
+
+      T alpha_norm = 0;
+      for (const T &value: alpha) {
+        if (magnitude(value) > alpha_norm) {
+          alpha_norm = magnitude(value);
+        }
+      }
+      const T pivot_tolerance = tolerance * (1 + alpha_norm);
+
+      // dual ratio test
+      size_t leaving = dim;
+      bool negligible_pivots = false;
+      T min_ratio = 0;
+      for (size_t i = 0; i < dim; ++i) {
+        T gamma = (below == _at_upper[i] ? -alpha[i] : alpha[i]);
+        if (gamma > pivot_tolerance) {
+          T mu = (_at_upper[i] ? -lambda[i] : lambda[i]);
+          const T ratio = (mu > 0 ? mu / gamma : T(0));
+
+          if (leaving == dim || ratio < min_ratio
+              || (ratio == min_ratio && _basis[i] < _basis[leaving])) {
+            min_ratio = ratio;
+            leaving = i;
+          }
+        } else if (gamma != 0 && magnitude(gamma) <= pivot_tolerance) {
+          negligible_pivots = true;
+        }
+      }
+
+      if (leaving == dim) {
+        return (negligible_pivots ? OptimizationResult<T>::UNBOUNDED
+                                  : OptimizationResult<T>::INFEASIBLE);
+      }
+
+      basis_inverse.update(leaving, alpha);
+
+      _is_basic[_basis[leaving]] = false;
+      _is_basic[entering] = true;
+      _basis[leaving] = entering;
+      _at_upper[leaving] = !below;
+    }
+
+    return OptimizationResult<T>::UNBOUNDED;
+  }
+
+  /**
+   * @brief Establish whether the system has solutions
+   *
+   * This method runs the dual simplex method with a null cost vector
+   * from the current basis or, if there is no basis, it relies on
+   * the tableau method.
+   */
+  void establish_feasibility()
+  {
+    for (size_t row = 0; row < _D.size(); ++row) {
+      if (_has_lower[row] && _has_upper[row] && _lower[row] > _upper[row]) {
+        _feasible = false;
+
+        return;
+      }
+    }
+
+    const size_t dim = _D.front().size();
+    if (_basis.size() == 0 || dim == 0) {
+      build_fallback();
+      _feasible = !_fallback->feasible_set_is_empty();
+
+      return;
+    }
+
+    switch (run(LinearAlgebra::Vector<T>(dim, 0))) {
+    case OptimizationResult<T>::OPTIMUM_AVAILABLE:
+      _feasible_point = _x;
+      break;
+    case OptimizationResult<T>::INFEASIBLE:
+      _feasible = false;
+      break;
+    default:
+      build_fallback();
+      _feasible = !_fallback->feasible_set_is_empty();
+    }
+  }
+
+  template<typename S>
+  friend class BoundedDualSimplexOptimizer;
+
+public:
+  /**
+   * @brief Build an optimizer for a system of ranged rows
+   *
+   * This constructor establishes the feasibility of the system
+   * \f$l \leq D \cdot x \leq u\f$ by running the dual simplex method
+   * from the rows in `basis`.
+   *
+   * @param D is the row matrix
+   * @param lower is the vector of the row lower bounds
+   * @param upper is the vector of the row upper bounds
+   * @param basis is a vector of the indices of `D.front().size()`
+   *              linearly independent rows of `D`. If it is empty,
+   *              the optimizer uses the tableau method
+   * @param objectives are the objective coefficient vectors
+   */
+  BoundedDualSimplexOptimizer(
+      const std::vector<LinearAlgebra::Vector<T>> &D,
+      const LinearAlgebra::Vector<T> &lower,
+      const LinearAlgebra::Vector<T> &upper, const std::vector<size_t> &basis,
+      const std::vector<LinearAlgebra::Vector<T>> &objectives):
+      _D(D),
+      _lower(lower), _upper(upper), _has_lower(lower.size()),
+      _has_upper(upper.size()), _objectives(objectives), _basis(basis),
+      _at_upper(basis.size(), false), _is_basic(D.size(), false), _x(),
+      _feasible_point(), _cost(0), _feasible(true), _fallback()
+  {
+    if (D.size() != lower.size() || D.size() != upper.size()) {
+      SAPO_ERROR("the number of rows in D and that of "
+                 "elements in the bound vectors differ",
+                 std::domain_error);
+    }
+
+    if (D.size() == 0) {
+      return;
+    }
+
+    const size_t dim = D.front().size();
+    if (basis.size() != 0 && basis.size() != dim) {
+      SAPO_ERROR("the basis size differs from the number of "
+                 "columns in D",
+                 std::domain_error);
+    }
+
+    for (const size_t &row: basis) {
+      if (row >= D.size()) {
+        SAPO_ERROR("the basis refers to a row that does not exist",
+                   std::domain_error);
+      }
+      _is_basic[row] = true;
+    }
+
+    for (size_t row = 0; row < D.size(); ++row) {
+      _has_lower[row] = is_finite(_lower[row]);
+      _has_upper[row] = is_finite(_upper[row]);
+    }
+
+    establish_feasibility();
+  }
+
+  /**
+   * @brief Build an optimizer from an optimizer on another type
+   *
+   * This constructor converts the system, the objectives, and the
+   * current basis of `orig` into the type `T`. Then, it establishes
+   * the feasibility of the system from that basis. When `T` is an
+   * exact type, this certifies, and if necessary repairs, the answer
+   * of an inexact optimizer at the cost of few exact pivots.
+   *
+   * @tparam S is the type of the original optimizer coefficients
+   * @param orig is the original optimizer
+   */
+  template<typename S>
+  explicit BoundedDualSimplexOptimizer(
+      const BoundedDualSimplexOptimizer<S> &orig):
+      _D(),
+      _lower(orig._lower.size(), 0), _upper(orig._upper.size(), 0),
+      _has_lower(orig._has_lower), _has_upper(orig._has_upper),
+      _objectives(), _basis(orig._basis), _at_upper(orig._at_upper),
+      _is_basic(orig._is_basic), _x(), _feasible_point(), _cost(0),
+      _feasible(true), _fallback()
+  {
+    auto convert = [](const LinearAlgebra::Vector<S> &v) {
+      return LinearAlgebra::Vector<T>(std::begin(v), std::end(v));
+    };
+
+    _D.reserve(orig._D.size());
+    for (const auto &row: orig._D) {
+      _D.push_back(convert(row));
+    }
+
+    _objectives.reserve(orig._objectives.size());
+    for (const auto &objective: orig._objectives) {
+      _objectives.push_back(convert(objective));
+    }
+
+    for (size_t row = 0; row < _D.size(); ++row) {
+      if (_has_lower[row]) {
+        _lower[row] = orig._lower[row];
+      }
+      if (_has_upper[row]) {
+        _upper[row] = orig._upper[row];
+      }
+    }
+
+    if (_D.size() != 0) {
+      establish_feasibility();
+    }
+  }
+
+  /**
+   * @brief Get the current basis
+   *
+   * @return the indices of the rows in the current basis, i.e., the
+   *         last optimal basis. The returned vector is empty whenever
+   *         the optimizer has no basis
+   */
+  inline const std::vector<size_t> &basis() const
+  {
+    return _basis;
+  }
+
+  /**
+   * @brief Restart the following optimizations from a basis
+   *
+   * This method has no effect if the optimizer relies on the tableau
+   * method.
+   *
+   * @param basis is a vector of the indices of `D.front().size()`
+   *              linearly independent rows of `D`
+   */
+  void warm_start(const std::vector<size_t> &basis)
+  {
+    if (_fallback != nullptr || _basis.size() == 0) {
+      return;
+    }
+
+    if (basis.size() != _basis.size()) {
+      SAPO_ERROR("the basis size differs from the number of "
+                 "columns in D",
+                 std::domain_error);
+    }
+
+    for (const size_t &row: basis) {
+      if (row >= _D.size()) {
+        SAPO_ERROR("the basis refers to a row that does not exist",
+                   std::domain_error);
+      }
+    }
+
+    for (const size_t &row: _basis) {
+      _is_basic[row] = false;
+    }
+    for (const size_t &row: basis) {
+      _is_basic[row] = true;
+    }
+    _basis = basis;
+  }
+
+  /**
+   * @brief Get the number of objectives
+   *
+   * @return the number of objectives
+   */
+  inline size_t size() const
+  {
+    return _objectives.size();
+  }
+
+  /**
+   * @brief Test whether the system has no solution
+   *
+   * @return `true` if and only if the system has no solution
+   */
+  inline bool feasible_set_is_empty() const
+  {
+    return !_feasible;
+  }
+
+  /**
+   * @brief Get a solution of the system
+   *
+   * @return a solution of the system found while establishing
+   *         its feasibility or an empty vector if either the
+   *         system has no solution or the search for solutions
+   *         was delegated to the tableau method
+   */
+  inline const LinearAlgebra::Vector<T> &feasible_point() const
+  {
+    return _feasible_point;
+  }
+
+  /**
+   * @brief Optimize one of the objectives over the system
+   *
+   * @param objective_index is the index of the objective
+   * @param optimization_type is the required optimization goal, i.e.,
+   *                          minimize or maximize
+   * @return the result of the optimization process
+   */
+  OptimizationResult<T>
+  operator()(const size_t objective_index,
+             const OptimizationGoal optimization_type = MINIMIZE)
+  {
+    if (objective_index >= _objectives.size()) {
+      SAPO_ERROR("the objective index must be smaller than the number "
+                 "of objectives",
+                 std::domain_error);
+    }
+
+    if (_D.size() == 0) {
+      return OptimizationResult<T>(OptimizationResult<T>::UNBOUNDED);
+    }
+
+    if (!_feasible) {
+      return OptimizationResult<T>(OptimizationResult<T>::INFEASIBLE);
+    }
+
+    if (_fallback == nullptr) {
+      using namespace LinearAlgebra;
+
+      const auto &objective = _objectives[objective_index];
+
+      // restart from the last optimal basis
+      const auto basis = _basis;
+      const auto at_upper = _at_upper;
+      const auto status
+          = run(optimization_type == MAXIMIZE ? -objective : objective);
+
+      if (status == OptimizationResult<T>::OPTIMUM_AVAILABLE) {
+        const T value = (optimization_type == MAXIMIZE ? -_cost : _cost);
+        return {_x, value};
+      }
+
+      for (const size_t &row: _basis) {
+        _is_basic[row] = false;
+      }
+      for (const size_t &row: basis) {
+        _is_basic[row] = true;
+      }
+      _basis = basis;
+      _at_upper = at_upper;
+
+      build_fallback();
+    }
+
+    return (*_fallback)(objective_index, optimization_type);
+  }
+
+  /**
+   * @brief Minimize one of the objectives over the system
+   *
+   * @param objective_index is the index of the objective
+   * @return the result of the minimization process
+   */
+  inline OptimizationResult<T> minimize(const size_t objective_index)
+  {
+    return operator()(objective_index, MINIMIZE);
+  }
+
+  /**
+   * @brief Maximize one of the objectives over the system
+   *
+   * @param objective_index is the index of the objective
+   * @return the result of the maximization process
+   */
+  inline OptimizationResult<T> maximize(const size_t objective_index)
+  {
+    return operator()(objective_index, MAXIMIZE);
+  }
+};
+
+/**
+ * @brief A hybrid optimizer certifying inexact answers on exact types
+ *
+ * This class optimizes objectives over the ranged rows
+ * \f$l \leq D \cdot x \leq u\f$ by using a
+ * `BoundedDualSimplexOptimizer` on the inexact type `T` first and, then,
+ * by warm-starting a `BoundedDualSimplexOptimizer` on the exact type
+ * `EXACT` from the final inexact basis. The exact optimizer verifies
+ * the primal and dual feasibility of that basis and, whenever the
+ * floating-point rounding led to a wrong basis, it repairs it by
+ * performing the missing pivots. Since the inexact basis is almost
+ * always optimal, each answer costs few exact factorizations of
+ * \f$\texttt{dim} \times \texttt{dim}\f$ matrices, rather than a full
+ * exact solve.
+ *
+ * @tparam T is the inexact type of the linear system coefficients
+ * @tparam EXACT is the exact type used to certify the answers
+ */
+template<typename T, typename EXACT>
+class HybridBoundedDualSimplexOptimizer
+{
+  BoundedDualSimplexOptimizer<T> _approx;    //!< the inexact optimizer
+  BoundedDualSimplexOptimizer<EXACT> _exact; //!< the exact optimizer
+
+public:
+  /**
+   * @brief Build an optimizer for a system of ranged rows
+   *
+   * This constructor certifies the feasibility of the system
+   * \f$l \leq D \cdot x \leq u\f$.
+   *
+   * @param D is the row matrix
+   * @param lower is the vector of the row lower bounds
+   * @param upper is the vector of the row upper bounds
+   * @param basis is a vector of the indices of `D.front().size()`
+   *              linearly independent rows of `D`. If it is empty,
+   *              the optimizers use the tableau method
+   * @param objectives are the objective coefficient vectors
+   */
+  HybridBoundedDualSimplexOptimizer(
+      const std::vector<LinearAlgebra::Vector<T>> &D,
+      const LinearAlgebra::Vector<T> &lower,
+      const LinearAlgebra::Vector<T> &upper, const std::vector<size_t> &basis,
+      const std::vector<LinearAlgebra::Vector<T>> &objectives):
+      _approx(D, lower, upper, basis, objectives),
+      _exact(_approx)
+  {
+  }
+
+  /**
+   * @brief Get the number of objectives
+   *
+   * @return the number of objectives
+   */
+  inline size_t size() const
+  {
+    return _approx.size();
+  }
+
+  /**
+   * @brief Test whether the system has no solution
+   *
+   * @return `true` if and only if the system has no solution
+   */
+  inline bool feasible_set_is_empty() const
+  {
+    return _exact.feasible_set_is_empty();
+  }
+
+  /**
+   * @brief Get a solution of the system
+   *
+   * @return an exact solution of the system or an empty vector
+   *         if none is known
+   */
+  inline const LinearAlgebra::Vector<EXACT> &feasible_point() const
+  {
+    return _exact.feasible_point();
+  }
+
+  /**
+   * @brief Optimize one of the objectives over the system
+   *
+   * @param objective_index is the index of the objective
+   * @param optimization_type is the required optimization goal, i.e.,
+   *                          minimize or maximize
+   * @return the exact result of the optimization process
+   */
+  OptimizationResult<EXACT>
+  operator()(const size_t objective_index,
+             const OptimizationGoal optimization_type = MINIMIZE)
+  {
+    if (!_exact.feasible_set_is_empty()) {
+      const auto result = _approx(objective_index, optimization_type);
+
+      if (result.status() == OptimizationResult<T>::OPTIMUM_AVAILABLE) {
+        _exact.warm_start(_approx.basis());
+      }
+    }
+
+    return _exact(objective_index, optimization_type);
+  }
+
+  /**
+   * @brief Minimize one of the objectives over the system
+   *
+   * @param objective_index is the index of the objective
+   * @return the exact result of the minimization process
+   */
+  inline OptimizationResult<EXACT> minimize(const size_t objective_index)
+  {
+    return operator()(objective_index, MINIMIZE);
+  }
+
+  /**
+   * @brief Maximize one of the objectives over the system
+   *
+   * @param objective_index is the index of the objective
+   * @return the exact result of the maximization process
+   */
+  inline OptimizationResult<EXACT> maximize(const size_t objective_index)
+  {
+    return operator()(objective_index, MAXIMIZE);
+  }
+};
+
 #endif // SIMPLEX_H_
\ No newline at end of file
@@ -0,0 +1,437 @@
+/**
+ * @file SymbolTable.h
+ * @author Alberto Casagrande <acasagrande@units.it>
+ * @brief Concurrent interning tables for symbol names
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef SYMBOL_TABLE_H_
+#define SYMBOL_TABLE_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef WITH_THREADS
+#include <mutex>
+
+#endif // WITH_THREADS
+
+#include "ErrorHandling.h"
+
+/*!
+ *  \addtogroup SymbolicAlgebra
+ *  @{
+ */
+
+//! Symbolic algebra namespace
+namespace SymbolicAlgebra
+{
+
+/**
+ * @brief A concurrent interning table for symbol names
+ *
+ * This class uniquely associates symbol names to consecutive
+ * identifiers. Names and blocks are never removed, so the table
+ * is insert-only: look-ups, both by name and by identifier, never
+ * lock and only follow atomic pointers to immutable entries.
+ * Only the declaration of a new name takes a mutex, which
+ * serializes writers.
+ *
+ * Symbol blocks are the vectors of the symbols `basename0`,
+ * `basename1`, ... Once a block has been declared, further
+ * requests for at most the same number of symbols are served
+ * by a single look-up.
+ *
+ * @tparam ID is the type of the identifiers
+ */
+template<typename ID>
+class SymbolTable
+{
+  /**
+   * @brief A declared name
+   */
+  struct NameEntry {
+    const std::string name; //!< the symbol name
+    const size_t hash;      //!< the name hash
+    const ID id;            //!< the symbol identifier
+    NameEntry *next;        //!< the next entry in the bucket
+
+    /**
+     * @brief A constructor
+     *
+     * @param name is the symbol name
+     * @param hash is the name hash
+     * @param id is the symbol identifier
+     */
+    NameEntry(const std::string &name, const size_t hash, const ID id):
+        name(name), hash(hash), id(id), next(nullptr)
+    {
+    }
+  };
+
+  /**
+   * @brief A declared symbol block
+   */
+  struct BlockEntry {
+    const std::string basename; //!< the block basename
+    const size_t hash;          //!< the basename hash
+    const std::vector<ID> ids;  //!< the identifiers of the block symbols
+    BlockEntry *next;           //!< the next entry in the bucket
+
+    /**
+     * @brief A constructor
+     *
+     * @param basename is the block basename
+     * @param hash is the basename hash
+     * @param ids are the identifiers of the block symbols
+     */
+    BlockEntry(const std::string &basename, const size_t hash,
+               std::vector<ID> &&ids):
+        basename(basename), hash(hash), ids(std::move(ids)), next(nullptr)
+    {
+    }
+  };
+
+  static constexpr size_t num_of_buckets
+      = 1 << 10; //!< the number of name buckets
+  static constexpr size_t num_of_block_buckets
+      = 1 << 6; //!< the number of block buckets
+  static constexpr size_t first_segment_bits
+      = 6; //!< the logarithm of the first segment size
+  static constexpr size_t num_of_segments
+      = 8 * sizeof(ID) - first_segment_bits
+        + 1; //!< the maximum number of segments
+
+  std::unique_ptr<std::atomic<NameEntry *>[]>
+      _buckets; //!< the name bucket lists
+  std::unique_ptr<std::atomic<BlockEntry *>[]>
+      _block_buckets; //!< the block bucket lists
+
+  /**
+   * @brief The identifier-to-entry segments
+   *
+   * The `i`-th segment has size \f$2^{b}\f$ for `i` equal to 0 and
+   * \f$2^{b+i-1}\f$ otherwise, where \f$b\f$ is `first_segment_bits`.
+   * Segments are allocated on demand and never moved, so that
+   * readers can access them while the table grows.
+   */
+  std::unique_ptr<std::atomic<std::atomic<const NameEntry *> *>[]>
+      _segments;
+
+  std::atomic<size_t> _size; //!< the number of declared names
+
+#ifdef WITH_THREADS
+  std::mutex _mutex; //!< the mutex of the writers
+#endif // WITH_THREADS
+
+  /**
+   * @brief Get the position of an identifier in the segments
+   *
+   * @param id is a symbol identifier
+   * @return the pair segment index-offset of `id`
+   */
+  static inline std::pair<size_t, size_t> position(const size_t id)
+  {
+    const size_t shifted = id >> first_segment_bits;
+    if (shifted == 0) {
+      return {0, id};
+    }
+
+    size_t segment = 0;
+    for (size_t value = shifted; value != 0; value >>= 1) {
+      ++segment;
+    }
+
+    return {segment, id - (static_cast<size_t>(1)
+                           << (first_segment_bits + segment - 1))};
+  }
+
+  /**
+   * @brief Get the size of a segment
+   *
+   * @param segment is a segment index
+   * @return the number of identifiers in the segment
+   */
+  static inline size_t segment_size(const size_t segment)
+  {
+    return static_cast<size_t>(1)
+           << (first_segment_bits + (segment == 0 ? 0 : segment - 1));
+  }
+
+  /**
+   * @brief Search for a name entry
+   *
+   * @param name is a symbol name
+   * @param hash is the hash of `name`
+   * @return a pointer to the entry of `name` or `nullptr`
+   *         if `name` has not been declared yet
+   */
+  const NameEntry *find_entry(const std::string &name, const size_t hash) const
+  {
+    const NameEntry *entry
+        = _buckets[hash % num_of_buckets].load(std::memory_order_acquire);
+    for (; entry != nullptr; entry = entry->next) {
+      if (entry->hash == hash && entry->name == name) {
+        return entry;
+      }
+    }
+
+    return nullptr;
+  }
+
+  /**
+   * @brief Search for the largest block of a basename
+   *
+   * Larger blocks of the same basename are prepended to the
+   * bucket lists, so the first found block is the largest one.
+   *
+   * @param basename is a block basename
+   * @param hash is the hash of `basename`
+   * @return a pointer to the largest block of `basename` or
+   *         `nullptr` if no block of `basename` has been declared
+   */
+  const BlockEntry *find_block(const std::string &basename,
+                               const size_t hash) const
+  {
+    const BlockEntry *entry
+        = _block_buckets[hash % num_of_block_buckets].load(
+            std::memory_order_acquire);
+    for (; entry != nullptr; entry = entry->next) {
+      if (entry->hash == hash && entry->basename == basename) {
+        return entry;
+      }
+    }
+
+    return nullptr;
+  }
+
+  /**
+   * @brief Declare a name
+   *
+   * The caller must hold the writer mutex.
+   *
+   * @param name is a symbol name
+   * @param hash is the hash of `name`
+   * @return the identifier of `name`
+   */
+  ID declare(const std::string &name, const size_t hash)
+  {
+    const NameEntry *found = find_entry(name, hash);
+    if (found != nullptr) {
+      return found->id;
+    }
+
+    const size_t id = _size.load(std::memory_order_relaxed);
+    const auto pos = position(id);
+    if (pos.first >= num_of_segments) {
+      SAPO_ERROR("too many symbols", std::length_error);
+    }
+
+    std::atomic<const NameEntry *> *segment
+        = _segments[pos.first].load(std::memory_order_relaxed);
+    if (segment == nullptr) {
+      const size_t size = segment_size(pos.first);
+      segment = new std::atomic<const NameEntry *>[size];
+      for (size_t i = 0; i < size; ++i) {
+        segment[i].store(nullptr, std::memory_order_relaxed);
+      }
+      _segments[pos.first].store(segment, std::memory_order_release);
+    }
+
+    NameEntry *entry = new NameEntry(name, hash, static_cast<ID>(id));
+    segment[pos.second].store(entry, std::memory_order_release);
+
+    std::atomic<NameEntry *> &head = _buckets[hash % num_of_buckets];
+    entry->next = head.load(std::memory_order_relaxed);
+    head.store(entry, std::memory_order_release);
+
+    _size.store(id + 1, std::memory_order_release);
+
+    return entry->id;
+  }
+
+  /**
+   * @brief Get the name of a block symbol
+   *
+   * @param basename is the block basename
+   * @param index is the symbol index in the block
+   * @return the name of the `index`-th symbol in the block
+   */
+  static std::string block_name(const std::string &basename,
+                                const size_t index)
+  {
+    std::ostringstream oss;
+    oss << basename << index;
+
+    return oss.str();
+  }
+
+public:
+  /**
+   * @brief Build an empty table
+   */
+  SymbolTable():
+      _buckets(new std::atomic<NameEntry *>[num_of_buckets]),
+      _block_buckets(new std::atomic<BlockEntry *>[num_of_block_buckets]),
+      _segments(new std::atomic<std::atomic<const NameEntry *> *>[
+          num_of_segments]),
+      _size(0)
+  {
+    for (size_t i = 0; i < num_of_buckets; ++i) {
+      _buckets[i].store(nullptr, std::memory_order_relaxed);
+    }
+    for (size_t i = 0; i < num_of_block_buckets; ++i) {
+      _block_buckets[i].store(nullptr, std::memory_order_relaxed);
+    }
+    for (size_t i = 0; i < num_of_segments; ++i) {
+      _segments[i].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  SymbolTable(const SymbolTable &) = delete;
+  SymbolTable &operator=(const SymbolTable &) = delete;
+
+  /**
+   * @brief Get the identifier of a name
+   *
+   * If the name has never been used, then this method reserves
+   * a new identifier for it.
+   *
+   * @param name is a symbol name
+   * @return the identifier of `name`
+   */
+  ID get_id(const std::string &name)
+  {
+    const size_t hash = std::hash<std::string>()(name);
+
+    const NameEntry *found = find_entry(name, hash);
+    if (found != nullptr) {
+      return found->id;
+    }
+
+#ifdef WITH_THREADS
+    std::unique_lock<std::mutex> lock(_mutex);
+#endif // WITH_THREADS
+
+    return declare(name, hash);
+  }
+
+  /**
+   * @brief Get the identifiers of a symbol block
+   *
+   * If the block has never been declared with at least `size`
+   * symbols, then this method declares it with `size` symbols.
+   *
+   * @param basename is the block basename
+   * @param size is the number of requested symbols
+   * @return a vector whose `i`-th element is the identifier
+   *         of the name `basename` followed by `i`. The vector
+   *         may have more than `size` elements
+   */
+  const std::vector<ID> &get_block(const std::string &basename,
+                                   const size_t size)
+  {
+    const size_t hash = std::hash<std::string>()(basename);
+
+    const BlockEntry *found = find_block(basename, hash);
+    if (found != nullptr && found->ids.size() >= size) {
+      return found->ids;
+    }
+
+#ifdef WITH_THREADS
+    std::unique_lock<std::mutex> lock(_mutex);
+#endif // WITH_THREADS
+
+    found = find_block(basename, hash);
+    if (found != nullptr && found->ids.size() >= size) {
+      return found->ids;
+    }
+
+    std::vector<ID> ids;
+    ids.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+      const std::string name = block_name(basename, i);
+
+      ids.push_back(declare(name, std::hash<std::string>()(name)));
+    }
+
+    BlockEntry *entry = new BlockEntry(basename, hash, std::move(ids));
+
+    std::atomic<BlockEntry *> &head
+        = _block_buckets[hash % num_of_block_buckets];
+    entry->next = head.load(std::memory_order_relaxed);
+    head.store(entry, std::memory_order_release);
+
+    return entry->ids;
+  }
+
+  /**
+   * @brief Get the name of an identifier
+   *
+   * @param id is a declared symbol identifier
+   * @return the name whose identifier is `id`
+   */
+  const std::string &get_name(const ID &id) const
+  {
+    if (static_cast<size_t>(id) >= _size.load(std::memory_order_acquire)) {
+      SAPO_ERROR("the symbol identifier has not been declared",
+                 std::domain_error);
+    }
+
+    const auto pos = position(id);
+
+    return _segments[pos.first]
+        .load(std::memory_order_acquire)[pos.second]
+        .load(std::memory_order_acquire)
+        ->name;
+  }
+
+  /**
+   * @brief Get the number of declared names
+   *
+   * @return the number of declared names
+   */
+  inline size_t size() const
+  {
+    return _size.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Destroyer
+   */
+  ~SymbolTable()
+  {
+    for (size_t i = 0; i < num_of_buckets; ++i) {
+      NameEntry *entry = _buckets[i].load(std::memory_order_relaxed);
+      while (entry != nullptr) {
+        NameEntry *next = entry->next;
+        delete entry;
+        entry = next;
+      }
+    }
+    for (size_t i = 0; i < num_of_block_buckets; ++i) {
+      BlockEntry *entry = _block_buckets[i].load(std::memory_order_relaxed);
+      while (entry != nullptr) {
+        BlockEntry *next = entry->next;
+        delete entry;
+        entry = next;
+      }
+    }
+    for (size_t i = 0; i < num_of_segments; ++i) {
+      delete[] _segments[i].load(std::memory_order_relaxed);
+    }
+  }
+};
+
+}
+
+/*! @} End of SymbolicAlgebra group */
+
+#endif // SYMBOL_TABLE_H_
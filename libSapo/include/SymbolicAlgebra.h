@@ -19,12 +19,9 @@
 #include <iterator>
 #include <type_traits>
 
-#ifdef WITH_THREADS
-#include <mutex>
-
-#endif // WITH_THREADS
-
 #include "ErrorHandling.h"
+#include "ExpressionArena.h"
+#include "SymbolTable.h"
 
 /*!
  *  \addtogroup SymbolicAlgebra
@@ -66,6 +63,12 @@ class base_expression_type;
 template<typename C>
 class Expression;
 
+template<typename C>
+class ExpressionDAG;
+
+template<typename C>
+class Polynomial;
+
 /**
  * @brief A class to represent algebraic symbols
  *
@@ -80,17 +83,16 @@ class Symbol : public Expression<C>
 public:
   typedef unsigned int SymbolIdType; //!< The type of symbol identificators
 
-#ifdef WITH_THREADS
-
-  static std::mutex _mutex;
-
-#endif // WITH_THREADS
-
 protected:
-  static std::map<std::string, SymbolIdType>
-      _declared_symbols; //!< Name to symbol identificator map
-  static std::vector<std::string>
-      _symbol_names; //!< Identificator to symbol name map
+  static SymbolTable<SymbolIdType>
+      _symbol_table; //!< Name to symbol identificator table
+
+  /**
+   * @brief Build the symbol of an identificator
+   *
+   * @param id is a declared symbol identificator
+   */
+  explicit Symbol(const SymbolIdType id);
 
 public:
   /**
@@ -186,8 +188,23 @@ public:
    */
   static const std::string &get_symbol_name(const SymbolIdType &id)
   {
-    return _symbol_names[id];
+    return _symbol_table.get_name(id);
   }
+
+  /**
+   * @brief Get a block of symbols
+   *
+   * This method builds a vector of symbols whose names have
+   * the form `basename_{vector_index}`. The block names are
+   * declared once: later requests for at most the same number
+   * of symbols do not format nor look up any name.
+   *
+   * @param basename is the name prefix of the symbols
+   * @param size is the size of the output vector
+   * @return a vector of `size` symbols
+   */
+  static std::vector<Symbol<C>> get_symbol_block(const std::string &basename,
+                                                 const size_t size);
 };
 
 /**
@@ -256,16 +273,8 @@ struct std::less<SymbolicAlgebra::Symbol<C>> {
 namespace SymbolicAlgebra
 {
 
-#ifdef WITH_THREADS
-template<typename C>
-std::mutex Symbol<C>::_mutex;
-#endif // WITH_THREADS
-
-template<typename C>
-std::map<std::string, typename Symbol<C>::SymbolIdType>
-    Symbol<C>::_declared_symbols;
 template<typename C>
-std::vector<std::string> Symbol<C>::_symbol_names;
+SymbolTable<typename Symbol<C>::SymbolIdType> Symbol<C>::_symbol_table;
 
 /**
  * @brief A class to represent algebraic symbolic expressions
@@ -334,6 +343,13 @@ public:
    */
   Expression(const Expression<C> &orig);
 
+  /**
+   * @brief Move constructor
+   *
+   * @param orig is the model for the new object
+   */
+  Expression(Expression<C> &&orig);
+
   /**
    * @brief Replace symbol occurrences by using expressions
    *
@@ -1132,6 +1148,12 @@ public:
   template<typename T>
   friend Expression<T> operator/(Expression<T> &&lhs, Expression<T> &&rhs);
 
+  template<typename T>
+  friend class ExpressionDAG;
+
+  template<typename T>
+  friend class Polynomial;
+
   /**
    * @brief Swap two expressions
    *
@@ -1173,6 +1195,30 @@ public:
    */
   base_expression_type() {}
 
+  /**
+   * @brief Allocate an expression node
+   *
+   * Nodes come from the arena of the innermost `ExpressionArena::Scope`
+   * of the calling thread, if any, or from the global `new`.
+   *
+   * @param size is the size of the node in bytes
+   * @return a pointer to the node memory
+   */
+  static void *operator new(size_t size)
+  {
+    return ExpressionArena::allocate(size);
+  }
+
+  /**
+   * @brief Deallocate an expression node
+   *
+   * @param ptr is a pointer to the node memory
+   */
+  static void operator delete(void *ptr) noexcept
+  {
+    ExpressionArena::deallocate(ptr);
+  }
+
   /**
    * @brief Get the expression type
    *
@@ -2813,6 +2859,12 @@ public:
   template<typename T>
   friend class base_expression_type;
 
+  template<typename T>
+  friend class SymbolicAlgebra::ExpressionDAG;
+
+  template<typename T>
+  friend class SymbolicAlgebra::Polynomial;
+
   template<typename T>
   friend struct less;
 };
@@ -3652,6 +3704,12 @@ public:
   template<typename T>
   friend class finite_sum_type;
 
+  template<typename T>
+  friend class SymbolicAlgebra::ExpressionDAG;
+
+  template<typename T>
+  friend class SymbolicAlgebra::Polynomial;
+
   template<typename T>
   friend struct less;
 };
@@ -4045,6 +4103,12 @@ Expression<C>::Expression(const Expression<C> &orig):
 {
 }
 
+template<typename C>
+Expression<C>::Expression(Expression<C> &&orig): _ex(orig._ex)
+{
+  orig._ex = nullptr;
+}
+
 template<typename C>
 Expression<C> &
 Expression<C>::replace(const Expression<C>::replacement_type &replacement)
@@ -4851,24 +4915,32 @@ Symbol<C>::Symbol(const char *name): Symbol<C>(std::string(name))
 template<typename C>
 Symbol<C>::Symbol(const std::string &name): Expression<C>(nullptr)
 {
-#ifdef WITH_THREADS
-  std::unique_lock<std::mutex> lock(_mutex);
-#endif // WITH_THREADS
-
   if (name.size() == 0) {
     SAPO_ERROR("the name must be non-empty", std::domain_error);
   }
 
-  auto found_symbol = _declared_symbols.find(name);
+  this->_ex = new low_level::symbol_type<C>(_symbol_table.get_id(name));
+}
+
+template<typename C>
+Symbol<C>::Symbol(const SymbolIdType id):
+    Expression<C>(new low_level::symbol_type<C>(id))
+{
+}
+
+template<typename C>
+std::vector<Symbol<C>> Symbol<C>::get_symbol_block(const std::string &basename,
+                                                   const size_t size)
+{
+  const auto &ids = _symbol_table.get_block(basename, size);
 
-  if (found_symbol == std::end(_declared_symbols)) {
-    SymbolIdType symbol_id = _symbol_names.size();
-    _symbol_names.push_back(name);
-    _declared_symbols[name] = symbol_id;
-    this->_ex = new low_level::symbol_type<C>(symbol_id);
-  } else {
-    this->_ex = new low_level::symbol_type<C>(found_symbol->second);
+  std::vector<Symbol<C>> symbols;
+  symbols.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    symbols.push_back(Symbol<C>(ids[i]));
   }
+
+  return symbols;
 }
 
 template<typename C>
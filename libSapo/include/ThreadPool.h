@@ -11,109 +11,289 @@
 #ifndef THREADPOOL_H
 #define THREADPOOL_H
 
+#include <atomic>
 #include <functional>
-#include <map>
 #include <mutex>
-#include <queue>
-#include <set>
+#include <deque>
 #include <thread>
 #include <vector>
 #include <condition_variable>
-#include <memory> // shared_ptr
+#include <exception> // exception_ptr
+#include <memory>    // unique_ptr
 
 /**
- * @brief A thread pool to which task can be submitted
+ * @brief A work-stealing thread pool to which task can be submitted
+ *
+ * Every pool thread owns a double-ended task queue. The tasks submitted
+ * by a pool thread, e.g., the tasks submitted by another task, are pushed
+ * on the bottom of the submitter queue, while the tasks submitted by
+ * any other thread are pushed into a shared injection queue. Each pool
+ * thread pops tasks from the bottom of its own queue and, when its queue
+ * is empty, it steals tasks from the top of the other thread queues or
+ * from the injection queue. The threads joining a batch do not block:
+ * they execute the available tasks until the batch is concluded.
+ *
+ * An exception thrown by a task does not leave the thread running
+ * it: the first exception of a batch is stored in the batch and it
+ * is rethrown by `join_threads` once all the batch tasks have been
+ * concluded.
  */
 class ThreadPool
 {
-public:
-  /**
-   * @brief The type of batch identifiers
-   *
-   */
-  typedef unsigned int BatchId;
-
 protected:
   /**
-   * @brief Information about batches
+   * @brief Batches of tasks
    *
-   * This class stores the number of submitted and tasks of the batch.
+   * This class stores the number of the submitted and not concluded
+   * tasks of a batch and the first exception thrown by them. Every
+   * task refers to its batch, so that the batch counter can be
+   * updated without any look-up.
    */
-  class BatchInfo
+  class Batch
   {
   public:
-    unsigned int running;  //!< The number of running tasks in the batch
-    unsigned int in_queue; //!< The number of batch tasks in the queue
+    std::atomic<size_t> unfinished; //!< The number of unfinished tasks
+    std::mutex mutex;                //!< A mutex to wait for the batch end
     std::condition_variable waiting_end; //!< Testifying the batch conclusion
+    std::exception_ptr exception; //!< The first exception thrown by a task
 
     /**
      * @brief Constructor
      */
-    BatchInfo(): running(0), in_queue(0) {}
+    Batch(): unfinished(0), mutex(), waiting_end(), exception() {}
 
     /**
-     * @brief Copy constructor
+     * @brief Store an exception thrown by a batch task
+     *
+     * Only the first stored exception is kept.
      *
-     * @param[in] orig is the model for the new object
+     * @param[in] thrown is the exception thrown by a batch task
      */
-    BatchInfo(const BatchInfo &orig):
-        running(orig.running), in_queue(orig.in_queue)
-    {
-    }
+    void store_exception(std::exception_ptr thrown);
 
     /**
-     * @brief Return the number of unfinished tasks
+     * @brief Extract the stored exception
      *
-     * This method returns the number of unfinished tasks, i.e., the enqueue
-     * tasks that have not been finished yet.
+     * @return the stored exception, if any, or a null pointer. The
+     *         batch does not store any exception after the call
+     */
+    std::exception_ptr take_exception();
+
+    /**
+     * @brief Decrease the number of unfinished tasks
+     *
+     * This method decreases the number of unfinished tasks and,
+     * when the batch has been concluded, it notifies the batch
+     * end to the waiting threads.
+     */
+    void conclude_task();
+  };
+
+public:
+  /**
+   * @brief The type of batch identifiers
+   *
+   * The null identifier denotes the default batch.
+   */
+  typedef Batch *BatchId;
+
+protected:
+  /**
+   * @brief The task type
+   *
+   * Every task is a function associated to a batch.
+   */
+  struct Task {
+    std::function<void()> routine; //!< The task routine
+    Batch *batch;                  //!< The task batch
+
+    /**
+     * @brief Constructor
      *
-     * @return the number of unfinished tasks
+     * @param[in] routine is the task routine
+     * @param[in] batch is the task batch
      */
-    inline unsigned unfinished_tasks() const
+    Task(std::function<void()> &&routine, Batch *batch):
+        routine(std::move(routine)), batch(batch)
     {
-      return running + in_queue;
     }
   };
 
   /**
-   * @brief The task type
+   * @brief Chase-Lev double-ended task queues
    *
-   * Every task is a function associated to a batch
-   * identifier.
+   * The owner of the queue pushes and pops tasks from the queue bottom,
+   * while any other thread can steal tasks from the queue top. Neither
+   * operation locks the queue. The circular buffers replaced by
+   * a grow operation are released only by the queue destructor because
+   * a thief may still be reading them.
    */
-  typedef std::pair<std::function<void()>, BatchId> Task;
+  class TaskDeque
+  {
+    /**
+     * @brief Circular buffers of tasks
+     */
+    struct Buffer {
+      const size_t mask;                 //!< The buffer size minus one
+      std::unique_ptr<std::atomic<Task *>[]> tasks; //!< The buffer
+
+      /**
+       * @brief Constructor
+       *
+       * @param[in] capacity is the buffer size; it must be a power of 2
+       */
+      Buffer(const size_t capacity):
+          mask(capacity - 1), tasks(new std::atomic<Task *>[capacity])
+      {
+      }
+
+      /**
+       * @brief Get the task in a position
+       *
+       * @param[in] index is a position in the queue
+       * @return the task in the `index`-th position
+       */
+      inline Task *get(const int64_t index) const
+      {
+        return tasks[index & mask].load(std::memory_order_relaxed);
+      }
+
+      /**
+       * @brief Set the task in a position
+       *
+       * @param[in] index is a position in the queue
+       * @param[in] task is the task to be stored
+       */
+      inline void put(const int64_t index, Task *task)
+      {
+        tasks[index & mask].store(task, std::memory_order_relaxed);
+      }
+    };
+
+    std::atomic<int64_t> _top;     //!< The index of the queue top
+    std::atomic<int64_t> _bottom;  //!< The index of the queue bottom
+    std::atomic<Buffer *> _buffer; //!< The current buffer
+    std::vector<std::unique_ptr<Buffer>> _buffers; //!< All the buffers
+
+    /**
+     * @brief Double the buffer size
+     *
+     * @param[in] top is the index of the queue top
+     * @param[in] bottom is the index of the queue bottom
+     * @return the new buffer
+     */
+    Buffer *grow(const int64_t top, const int64_t bottom);
+
+  public:
+    /**
+     * @brief Constructor
+     */
+    TaskDeque();
+
+    /**
+     * @brief Push a task on the queue bottom
+     *
+     * This method must be called exclusively by the queue owner.
+     *
+     * @param[in] task is the task to be pushed
+     */
+    void push(Task *task);
+
+    /**
+     * @brief Pop a task from the queue bottom
+     *
+     * This method must be called exclusively by the queue owner.
+     *
+     * @return the popped task or `nullptr` if the queue is empty
+     */
+    Task *pop();
 
-  std::vector<std::thread> _threads;                      //!< The thread list
-  std::queue<Task> _queue;                                //!< The task queue
-  std::map<BatchId, std::shared_ptr<BatchInfo>> _batches; //!< Batch info
-  std::set<BatchId> _unused_batch_ids; //!< Not used batch ids
+    /**
+     * @brief Steal a task from the queue top
+     *
+     * @return the stolen task or `nullptr` if the queue is empty or
+     *         a concurrent operation took the top task
+     */
+    Task *steal();
+  };
+
+  std::vector<std::thread> _threads; //!< The thread list
+  std::vector<std::unique_ptr<TaskDeque>> _deques; //!< Per-thread queues
+  std::deque<Task *> _injection_queue; //!< Tasks submitted from outside
+  std::mutex _injection_mutex;         //!< Guards the injection queue
+  Batch _default_batch;                //!< The default batch
+  std::atomic<size_t> _queued_tasks;   //!< The number of queued tasks
+  std::atomic<size_t> _sleeping;       //!< The number of sleeping threads
   std::mutex _mutex; //!< A mutex for mutual exclusive operations
   std::condition_variable _waiting_task; //!< Testify that a task is waiting
-  bool _terminating;                     //!< The pool is to be destroyed
+  std::atomic<bool> _terminating;        //!< The pool is to be destroyed
+
+  /**
+   * @brief Get the batch associated to an identifier
+   *
+   * @param[in] batch_id is a batch identifier
+   * @return the batch identified by `batch_id`
+   */
+  inline Batch *get_batch(const BatchId batch_id)
+  {
+    return (batch_id == nullptr ? &_default_batch : batch_id);
+  }
+
+  /**
+   * @brief Get the queue of the calling thread
+   *
+   * @return a pointer to the queue of the calling thread, if it
+   *         is a pool thread, or `nullptr`, otherwise
+   */
+  TaskDeque *local_deque();
+
+  /**
+   * @brief Enqueue a task
+   *
+   * @param[in] task is the task to be enqueued
+   */
+  void enqueue(Task *task);
+
+  /**
+   * @brief Extract a task from the pool queues
+   *
+   * This method pops a task from the queue of the calling thread,
+   * if any, and, when it is empty, it steals a task from the other
+   * queues.
+   *
+   * @param[in] local is the queue of the calling thread or `nullptr`
+   * @return an extracted task or `nullptr` if no task was found
+   */
+  Task *extract_next_task(TaskDeque *local);
 
   /**
-   * @brief Get information about a batch
+   * @brief Extract a task of a batch submitted by the calling thread
+   *
+   * This method extracts the last task submitted by the calling thread,
+   * provided that it belongs to a specified batch and it is still
+   * queued.
    *
-   * @param[in] batch_id is the searched batch id
-   * @return a reference to the batch information
+   * @param[in] local is the queue of the calling thread or `nullptr`
+   * @param[in] batch is the batch of the aimed task
+   * @return an extracted task or `nullptr` if no task was found
    */
-  std::shared_ptr<BatchInfo> get_batch_info(const BatchId batch_id);
+  Task *extract_own_task(TaskDeque *local, const Batch *batch);
 
   /**
-   * @brief Extract next task from the queue
+   * @brief Run a task and update its batch
+   *
+   * An exception thrown by the task is stored in the task batch.
    *
-   * @return The next task to be executed
+   * @param[in] task is the task to be executed
    */
+  void run(Task *task);
 
   /**
-   * @brief Extract next task from the queue
+   * @brief Execute the queued tasks until a batch is concluded
    *
-   * @param[out] next is the parameter to be assigned with the next task
-   * @param[in] lock is the the lock used to extract the next task
-   * @return `true` if and only if `next` has been reassigned
+   * @param[in] batch is the batch that must be concluded
    */
-  bool extract_next_task(ThreadPool::Task &next,
-                         std::unique_lock<std::mutex> &lock);
+  void complete(Batch *batch);
 
   /**
    * @brief The main thread loop
@@ -123,11 +303,19 @@ protected:
   void consumer_loop(unsigned int thread_id);
 
   /**
-   * @brief Re-initialize the pool
+   * @brief Stop the pool threads
+   *
+   * This method waits for the end of the running tasks and stops the
+   * pool threads. The queued tasks are moved to the injection queue.
+   */
+  void stop_threads();
+
+  /**
+   * @brief Start the pool threads
    *
    * @param[in] num_of_threads is the new number of threads
    */
-  void reinit(const unsigned int &num_of_thread);
+  void start_threads(const unsigned int num_of_threads);
 
 public:
   /**
@@ -152,6 +340,12 @@ public:
   /**
    * @brief Close the batch and remove it from the pool
    *
+   * This method concludes the batch, if it has not been concluded
+   * yet, and deletes it. It must also be called when `join_threads`
+   * has thrown an exception. The exceptions of the batch tasks that
+   * have not been rethrown by `join_threads` are rethrown once the
+   * batch has been deleted.
+   *
    * @param[in] batch_id is the id of the batch to be closed
    */
   void close_batch(const ThreadPool::BatchId batch_id);
@@ -167,7 +361,7 @@ public:
   template<typename T, typename... Ts>
   inline void submit(T &&routine, Ts &&...params)
   {
-    submit_to_batch(0, routine, params...);
+    submit_to_batch(nullptr, routine, params...);
   }
 
   /**
@@ -183,28 +377,31 @@ public:
   void submit_to_batch(const ThreadPool::BatchId batch_id, T &&routine,
                        Ts &&...params)
   {
-    {
-      std::unique_lock<std::mutex> lock(_mutex);
+    Batch *batch = get_batch(batch_id);
 
-      // increase the number of tasks in the batch
-      ++(get_batch_info(batch_id)->in_queue);
+    // increase the number of tasks in the batch
+    batch->unfinished.fetch_add(1, std::memory_order_relaxed);
 
-      // enqueue the task together with its batch id
-      _queue.emplace(
-          std::bind(std::forward<T>(routine), std::forward<Ts>(params)...),
-          batch_id);
-    }
-
-    // notify that some task are present in the queue
-    _waiting_task.notify_one();
+    enqueue(new Task(
+        std::bind(std::forward<T>(routine), std::forward<Ts>(params)...),
+        batch));
   }
 
   /**
    * @brief Join the thread pool and complete the batch
    *
+   * The calling thread executes the queued tasks until the
+   * batch has been concluded. When the calling thread is itself
+   * running a task, it only executes the tasks of the batch that
+   * it submitted: executing unrelated tasks could nest joins
+   * without bound. If some of the batch tasks have thrown an
+   * exception, the first of them is rethrown once the batch has
+   * been concluded, so that no task of the batch is still queued
+   * or running when the exception leaves this method.
+   *
    * @param[in] batch_id is the id of the batch that must be completed
    */
-  void join_threads(const ThreadPool::BatchId batch_id = 0);
+  void join_threads(const ThreadPool::BatchId batch_id = nullptr);
 
   /**
    * @brief Terminate the pool
@@ -244,9 +441,7 @@ public:
    */
   inline size_t num_of_tasks()
   {
-    std::unique_lock<std::mutex> lock(_mutex);
-
-    return _queue.size();
+    return _queued_tasks.load();
   }
 
   /**
@@ -13,7 +13,6 @@
 #define VARSGENERATOR_H_
 
 #include <string>
-#include <sstream>
 
 #include "SymbolicAlgebra.h"
 
@@ -32,18 +31,7 @@ template<typename T>
 std::vector<SymbolicAlgebra::Symbol<T>>
 get_symbol_vector(const std::string &basename, const size_t size)
 {
-  using namespace SymbolicAlgebra;
-
-  std::vector<Symbol<T>> symbol_vector;
-  symbol_vector.reserve(size);
-  for (unsigned int i = 0; i < size; ++i) {
-    std::ostringstream oss;
-    oss << basename << i;
-
-    symbol_vector.push_back(Symbol<T>(oss.str()));
-  }
-
-  return symbol_vector;
+  return SymbolicAlgebra::Symbol<T>::get_symbol_block(basename, size);
 }
 
 /**
@@ -0,0 +1,363 @@
+/**
+ * @file BinaryFlowpipe.cpp
+ * @author Alberto Casagrande <acasagrande@units.it>
+ * @brief Write and read flowpipes in a compact binary format
+ * @version 0.1
+ * @date 2023-03-08
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#include "BinaryFlowpipe.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "BinaryIO.h"
+#include "ErrorHandling.h"
+
+/**
+ * @brief The number of words in the header of binary flowpipe files
+ */
+#define BINARY_FLOWPIPE_HEADER_WORDS 2
+
+/**
+ * @brief The number of words in the footer of binary flowpipe files
+ */
+#define BINARY_FLOWPIPE_FOOTER_WORDS 5
+
+template<typename T>
+void BinaryFlowpipeWriter::write_word(const T value)
+{
+  static_assert(sizeof(T) == sizeof(uint64_t),
+                "Binary flowpipes are made of 64-bit words");
+
+  BinaryIO::write(_os, value);
+  _offset += sizeof(T);
+}
+
+uint64_t BinaryFlowpipeWriter::get_template_id(
+    const std::vector<LinearAlgebra::Vector<double>> &A)
+{
+  auto found = _template_ids.find(A);
+  if (found != _template_ids.end()) {
+    return found->second;
+  }
+
+  const uint64_t template_id = _templates.size();
+  auto inserted = _template_ids.emplace(A, template_id).first;
+  _templates.push_back(&(inserted->first));
+
+  return template_id;
+}
+
+BinaryFlowpipeWriter::BinaryFlowpipeWriter(std::ostream &os):
+    _os(os), _offset(0), _dim(0), _template_ids(), _templates(),
+    _epoch_offsets()
+{
+  write_word(static_cast<uint64_t>(BINARY_FLOWPIPE_MAGIC));
+  write_word(static_cast<uint64_t>(BINARY_FLOWPIPE_VERSION));
+}
+
+void BinaryFlowpipeWriter::write(SetsUnion<Polytope> &&step)
+{
+  _epoch_offsets.push_back(_offset);
+
+  write_word(static_cast<uint64_t>(step.size()));
+
+  // template identifiers
+  for (const Polytope &P: step) {
+    if (P.size() != 0) {
+      if (_dim == 0) {
+        _dim = P.dim();
+      } else if (_dim != P.dim()) {
+        SAPO_ERROR("all the polytopes must have the same dimension",
+                   std::domain_error);
+      }
+    }
+    write_word(get_template_id(P.A()));
+  }
+
+  // bound offsets
+  uint64_t bound_offset = 0;
+  for (const Polytope &P: step) {
+    write_word(bound_offset);
+    bound_offset += P.size();
+  }
+
+  // bounds
+  for (const Polytope &P: step) {
+    for (const double &value: P.b()) {
+      write_word(value);
+    }
+  }
+}
+
+void BinaryFlowpipeWriter::close()
+{
+  const uint64_t templates_offset = _offset;
+
+  // template offsets
+  write_word(static_cast<uint64_t>(_templates.size()));
+  uint64_t template_offset
+      = _offset + _templates.size() * sizeof(uint64_t);
+  for (const auto *A: _templates) {
+    write_word(template_offset);
+    template_offset += (1 + A->size() * _dim) * sizeof(uint64_t);
+  }
+
+  // templates
+  for (const auto *A: _templates) {
+    write_word(static_cast<uint64_t>(A->size()));
+    for (const auto &row: *A) {
+      for (const double &value: row) {
+        write_word(value);
+      }
+    }
+  }
+
+  // epoch index
+  const uint64_t index_offset = _offset;
+  for (const uint64_t &offset: _epoch_offsets) {
+    write_word(offset);
+  }
+
+  // footer
+  write_word(_dim);
+  write_word(templates_offset);
+  write_word(index_offset);
+  write_word(static_cast<uint64_t>(_epoch_offsets.size()));
+  write_word(static_cast<uint64_t>(BINARY_FLOWPIPE_MAGIC));
+
+  _os.flush();
+}
+
+void write_binary(std::ostream &os, const Flowpipe &flowpipe)
+{
+  BinaryFlowpipeWriter writer(os);
+
+  for (const SetsUnion<Polytope> &step: flowpipe) {
+    writer.write(SetsUnion<Polytope>(step));
+  }
+
+  writer.close();
+}
+
+BinaryFlowpipeReader::BinaryFlowpipeReader(const std::string &filename):
+    _data(nullptr), _size(0), _host_words(), _dim(0), _templates(nullptr),
+    _num_of_templates(0), _epochs(nullptr), _num_of_epochs(0)
+{
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    SAPO_ERROR("cannot open \"" << filename << "\": " << strerror(errno),
+               std::runtime_error);
+  }
+
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) < 0) {
+    ::close(fd);
+    SAPO_ERROR("cannot stat \"" << filename << "\": " << strerror(errno),
+               std::runtime_error);
+  }
+  _size = file_stat.st_size;
+
+  if (_size < (BINARY_FLOWPIPE_HEADER_WORDS + BINARY_FLOWPIPE_FOOTER_WORDS)
+                  * sizeof(uint64_t)
+      || _size % sizeof(uint64_t) != 0) {
+    ::close(fd);
+    SAPO_ERROR("\"" << filename << "\" is not a binary flowpipe",
+               std::runtime_error);
+  }
+
+  void *data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    SAPO_ERROR("cannot map \"" << filename << "\": " << strerror(errno),
+               std::runtime_error);
+  }
+  _data = static_cast<const uint64_t *>(data);
+
+  // big-endian hosts access a converted copy of the file
+  if (BinaryIO::host_is_big_endian()) {
+    _host_words.resize(_size / sizeof(uint64_t));
+    for (size_t i = 0; i < _host_words.size(); ++i) {
+      _host_words[i] = BinaryIO::little_endian(_data[i]);
+    }
+    munmap(data, _size);
+
+    _data = _host_words.data();
+  }
+
+  const uint64_t *footer
+      = _data + _size / sizeof(uint64_t) - BINARY_FLOWPIPE_FOOTER_WORDS;
+
+  _dim = footer[0];
+  _num_of_epochs = footer[3];
+
+  try {
+    if (_data[0] != BINARY_FLOWPIPE_MAGIC
+        || footer[4] != BINARY_FLOWPIPE_MAGIC) {
+      SAPO_ERROR("\"" << filename << "\" is not a binary flowpipe",
+                 std::runtime_error);
+    }
+    if (_data[1] != BINARY_FLOWPIPE_VERSION) {
+      SAPO_ERROR("unsupported binary flowpipe version " << _data[1],
+                 std::runtime_error);
+    }
+
+    const uint64_t footer_offset = _size - BINARY_FLOWPIPE_FOOTER_WORDS
+                                               * sizeof(uint64_t);
+    const uint64_t templates_offset = footer[1];
+    const uint64_t index_offset = footer[2];
+    if (_dim > _size / sizeof(uint64_t)
+        || templates_offset % sizeof(uint64_t) != 0
+        || templates_offset < BINARY_FLOWPIPE_HEADER_WORDS * sizeof(uint64_t)
+        || index_offset % sizeof(uint64_t) != 0
+        || templates_offset >= index_offset || index_offset > footer_offset
+        || _num_of_epochs
+               != (footer_offset - index_offset) / sizeof(uint64_t)) {
+      SAPO_ERROR("corrupted binary flowpipe \"" << filename << "\"",
+                 std::runtime_error);
+    }
+
+    _num_of_templates = *at(templates_offset);
+    _templates = at(templates_offset) + 1;
+    _epochs = at(index_offset);
+
+    if (_num_of_templates
+        > (index_offset - templates_offset) / sizeof(uint64_t) - 1) {
+      SAPO_ERROR("corrupted binary flowpipe \"" << filename << "\"",
+                 std::runtime_error);
+    }
+
+    validate();
+  } catch (...) {
+    if (_host_words.empty()) {
+      munmap(data, _size);
+    }
+
+    throw;
+  }
+}
+
+void BinaryFlowpipeReader::validate() const
+{
+  const uint64_t *footer
+      = _data + _size / sizeof(uint64_t) - BINARY_FLOWPIPE_FOOTER_WORDS;
+  const uint64_t templates_offset = footer[1];
+  const uint64_t index_offset = footer[2];
+
+  // the templates lay between the template offsets and the epoch index
+  const uint64_t templates_begin
+      = templates_offset + (1 + _num_of_templates) * sizeof(uint64_t);
+  for (uint64_t t = 0; t < _num_of_templates; ++t) {
+    const uint64_t offset = _templates[t];
+    if (offset % sizeof(uint64_t) != 0 || offset < templates_begin
+        || offset >= index_offset) {
+      SAPO_ERROR("corrupted binary flowpipe template " << t,
+                 std::runtime_error);
+    }
+
+    // the direction matrix must precede the epoch index
+    const uint64_t available = (index_offset - offset) / sizeof(uint64_t);
+    if (_dim != 0 && num_of_directions(t) > (available - 1) / _dim) {
+      SAPO_ERROR("corrupted binary flowpipe template " << t,
+                 std::runtime_error);
+    }
+  }
+
+  // the epochs lay between the header and the templates
+  uint64_t epoch_begin = BINARY_FLOWPIPE_HEADER_WORDS * sizeof(uint64_t);
+  for (uint64_t epoch = 0; epoch < _num_of_epochs; ++epoch) {
+    const uint64_t epoch_end = (epoch + 1 < _num_of_epochs
+                                    ? _epochs[epoch + 1]
+                                    : templates_offset);
+    if (_epochs[epoch] != epoch_begin || epoch_end <= epoch_begin
+        || epoch_end % sizeof(uint64_t) != 0
+        || epoch_end > templates_offset) {
+      SAPO_ERROR("corrupted binary flowpipe epoch " << epoch,
+                 std::runtime_error);
+    }
+
+    const uint64_t available = (epoch_end - epoch_begin) / sizeof(uint64_t);
+    const uint64_t polytopes = num_of_polytopes(epoch);
+    if (polytopes > (available - 1) / 2) {
+      SAPO_ERROR("corrupted binary flowpipe epoch " << epoch,
+                 std::runtime_error);
+    }
+
+    // the bounds of each polytope must be in the epoch
+    const uint64_t num_of_bounds = available - 1 - 2 * polytopes;
+    for (uint64_t index = 0; index < polytopes; ++index) {
+      const uint64_t template_id = template_of(epoch, index);
+      const uint64_t bound_offset = at(_epochs[epoch])[1 + polytopes + index];
+      if (template_id >= _num_of_templates || bound_offset > num_of_bounds
+          || num_of_directions(template_id) > num_of_bounds - bound_offset) {
+        SAPO_ERROR("corrupted binary flowpipe epoch " << epoch,
+                   std::runtime_error);
+      }
+    }
+
+    epoch_begin = epoch_end;
+  }
+
+  if (epoch_begin != templates_offset) {
+    SAPO_ERROR("corrupted binary flowpipe epoch index", std::runtime_error);
+  }
+}
+
+Polytope BinaryFlowpipeReader::polytope(const size_t epoch,
+                                        const size_t index) const
+{
+  const size_t template_id = template_of(epoch, index);
+  const size_t rows = num_of_directions(template_id);
+  const double *A_data = directions(template_id);
+  const double *b_data = bounds(epoch, index);
+
+  std::vector<LinearAlgebra::Vector<double>> A(rows);
+  for (size_t i = 0; i < rows; ++i) {
+    A[i] = LinearAlgebra::Vector<double>(A_data + i * _dim,
+                                         A_data + (i + 1) * _dim);
+  }
+
+  return Polytope(std::move(A),
+                  LinearAlgebra::Vector<double>(b_data, b_data + rows));
+}
+
+SetsUnion<Polytope> BinaryFlowpipeReader::get(const size_t epoch) const
+{
+  if (epoch >= _num_of_epochs) {
+    SAPO_ERROR("epoch must be smaller than the flowpipe size",
+               std::domain_error);
+  }
+
+  // the stored polytopes already form a union: append them as they are
+  SetsUnion<Polytope> step;
+  for (size_t index = 0; index < num_of_polytopes(epoch); ++index) {
+    step.push_back(polytope(epoch, index));
+  }
+
+  return step;
+}
+
+Flowpipe BinaryFlowpipeReader::flowpipe() const
+{
+  Flowpipe flowpipe;
+  for (size_t epoch = 0; epoch < _num_of_epochs; ++epoch) {
+    flowpipe.push_back(get(epoch));
+  }
+
+  return flowpipe;
+}
+
+BinaryFlowpipeReader::~BinaryFlowpipeReader()
+{
+  if (_host_words.empty()) {
+    munmap(const_cast<uint64_t *>(_data), _size);
+  }
+}
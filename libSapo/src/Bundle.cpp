@@ -35,6 +35,25 @@
 
 #include "ErrorHandling.h"
 
+#ifdef WITH_CERTIFIED_PREDICATES
+#include <gmpxx.h>
+
+/**
+ * @brief The optimizer of the bundle predicates
+ *
+ * The linear problems of emptiness, inclusion, and disjointness tests
+ * are solved in `double` and their answers are certified in
+ * `mpq_class`.
+ */
+typedef HybridBoundedDualSimplexOptimizer<double, mpq_class>
+    PredicateOptimizer;
+#else
+/**
+ * @brief The optimizer of the bundle predicates
+ */
+typedef BoundedDualSimplexOptimizer<double> PredicateOptimizer;
+#endif // WITH_CERTIFIED_PREDICATES
+
 /**
  * @brief Avoid \f$-0\f$
  *
@@ -118,7 +137,7 @@ Bundle::Bundle(const Bundle &orig):
     _directions(orig._directions),
     _adaptive_directions(orig._adaptive_directions),
     _lower_bounds(orig._lower_bounds), _upper_bounds(orig._upper_bounds),
-    _templates(orig._templates)
+    _templates(orig._templates), _memo(orig._memo)
 {
 }
 
@@ -134,6 +153,7 @@ void swap(Bundle &A, Bundle &B)
   std::swap(A._upper_bounds, B._upper_bounds);
   std::swap(A._lower_bounds, B._lower_bounds);
   std::swap(A._templates, B._templates);
+  swap(A._memo, B._memo);
 }
 
 /**
@@ -774,6 +794,7 @@ Bundle::Bundle(const Polytope &P)
 
   std::vector<size_t> double_row(P.size(), false);
 
+  auto optimizer = P.optimizer(P.A());
   for (size_t i = 0; i < P.size(); ++i) {
     if (!double_row[i]) {
       const auto &Ai = P.A(i);
@@ -784,8 +805,8 @@ Bundle::Bundle(const Polytope &P)
         }
       }
       _directions.push_back(P.A(i));
-      _upper_bounds.push_back(P.maximize(P.A(i)).objective_value());
-      _lower_bounds.push_back(P.minimize(P.A(i)).objective_value());
+      _upper_bounds.push_back(optimizer.maximize(i).objective_value());
+      _lower_bounds.push_back(optimizer.minimize(i).objective_value());
     }
   }
 
@@ -812,6 +833,8 @@ Bundle &Bundle::operator=(const Bundle &orig)
   this->_upper_bounds = orig._upper_bounds;
   this->_lower_bounds = orig._lower_bounds;
 
+  this->_memo = orig._memo;
+
   return *this;
 }
 
@@ -828,6 +851,551 @@ Bundle &Bundle::operator=(Bundle &&orig)
   return *this;
 }
 
+/**
+ * @brief Get the direction indices of one of the bundle templates
+ *
+ * @param bundle is a bundle
+ * @return the direction indices of the first template of `bundle`, if
+ *         any. An empty vector, otherwise
+ */
+std::vector<size_t> get_a_template_basis(const Bundle &bundle)
+{
+  if (bundle.num_of_templates() == 0) {
+    return std::vector<size_t>();
+  }
+
+  const auto &dir_indices
+      = std::begin(bundle.templates())->direction_indices();
+
+  return std::vector<size_t>(std::begin(dir_indices), std::end(dir_indices));
+}
+
+/**
+ * @brief Get an optimizer for the predicates over a bundle
+ *
+ * @param bundle is a bundle
+ * @param obj_funs is the vector of the objective functions
+ * @return a predicate optimizer for the objective functions over
+ *         `bundle`
+ */
+inline PredicateOptimizer get_predicate_optimizer(
+    const Bundle &bundle,
+    const std::vector<LinearAlgebra::Vector<double>> &obj_funs)
+{
+  return PredicateOptimizer(bundle.directions(), bundle.lower_bounds(),
+                            bundle.upper_bounds(),
+                            get_a_template_basis(bundle), obj_funs);
+}
+
+/**
+ * @brief Test whether a value is smaller than a bound
+ *
+ * @tparam T is the type of the value
+ * @param value is the value
+ * @param bound is a possibly infinite bound
+ * @return `true` if and only if `value` is smaller than `bound`
+ */
+template<typename T>
+inline bool is_below(const T &value, const double bound)
+{
+  if (std::isinf(bound)) {
+    return bound > 0;
+  }
+
+  return value < bound;
+}
+
+/**
+ * @brief Test whether a value is greater than a bound
+ *
+ * @tparam T is the type of the value
+ * @param value is the value
+ * @param bound is a possibly infinite bound
+ * @return `true` if and only if `value` is greater than `bound`
+ */
+template<typename T>
+inline bool is_above(const T &value, const double bound)
+{
+  if (std::isinf(bound)) {
+    return bound < 0;
+  }
+
+  return value > bound;
+}
+
+/**
+ * @brief Get a `double` upper approximation of a value
+ *
+ * @param value is a `double` value
+ * @return `value`
+ */
+inline double get_upper_approximation(const double &value)
+{
+  return value;
+}
+
+/**
+ * @brief Get a `double` lower approximation of a value
+ *
+ * @param value is a `double` value
+ * @return `value`
+ */
+inline double get_lower_approximation(const double &value)
+{
+  return value;
+}
+
+#ifdef WITH_CERTIFIED_PREDICATES
+/**
+ * @brief Get a `double` upper approximation of a rational value
+ *
+ * @param value is a rational value
+ * @return a `double` value greater than or equal to `value`
+ */
+inline double get_upper_approximation(const mpq_class &value)
+{
+  const double approx = value.get_d();
+
+  if (approx < value) {
+    return std::nextafter(approx, std::numeric_limits<double>::infinity());
+  }
+
+  return approx;
+}
+
+/**
+ * @brief Get a `double` lower approximation of a rational value
+ *
+ * @param value is a rational value
+ * @return a `double` value smaller than or equal to `value`
+ */
+inline double get_lower_approximation(const mpq_class &value)
+{
+  const double approx = value.get_d();
+
+  if (approx > value) {
+    return std::nextafter(approx, -std::numeric_limits<double>::infinity());
+  }
+
+  return approx;
+}
+
+/**
+ * @brief Get a `double` approximation of a rational vector
+ *
+ * @param v is a rational vector
+ * @return the vector of the `double` approximations of `v` elements
+ */
+inline LinearAlgebra::Vector<double>
+get_approximation(const LinearAlgebra::Vector<mpq_class> &v)
+{
+  LinearAlgebra::Vector<double> approx(v.size());
+  for (size_t i = 0; i < v.size(); ++i) {
+    approx[i] = v[i].get_d();
+  }
+
+  return approx;
+}
+#endif // WITH_CERTIFIED_PREDICATES
+
+/**
+ * @brief Get a `double` approximation of a vector
+ *
+ * @param v is a `double` vector
+ * @return `v`
+ */
+inline LinearAlgebra::Vector<double>
+get_approximation(const LinearAlgebra::Vector<double> &v)
+{
+  return v;
+}
+
+/**
+ * @brief Get the tolerance on the value of a linear function on a witness
+ *
+ * Witnesses are computed by floating-point linear programming and they
+ * may lie slightly outside the set they belong to.
+ *
+ * @param value is the value of a linear function on a witness
+ * @return the tolerance on `value`
+ */
+inline double witness_tolerance(const double value)
+{
+  const double margin = std::sqrt(std::numeric_limits<double>::epsilon());
+
+  return margin * (1 + std::abs(value));
+}
+
+/**
+ * @brief Test whether a witness is definitely outside a bundle
+ *
+ * @param witness is a point
+ * @param bundle is a bundle
+ * @return `true` if `witness` violates some of the bundle bounds
+ *         by more than the witness tolerance
+ */
+bool is_definitely_outside(const LinearAlgebra::Vector<double> &witness,
+                           const Bundle &bundle)
+{
+  using namespace LinearAlgebra;
+
+  for (size_t i = 0; i < bundle.size(); ++i) {
+    const double value = bundle.get_direction(i) * witness;
+    const double tolerance = witness_tolerance(value);
+
+    if (value > bundle.get_upper_bound(i) + tolerance
+        || value < bundle.get_lower_bound(i) - tolerance) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * @brief Test whether a witness definitely violates a linear system
+ *
+ * @param witness is a point
+ * @param ls is a linear system
+ * @return `true` if `witness` violates some of the rows in `ls`
+ *         by more than the witness tolerance
+ */
+bool is_definitely_outside(const LinearAlgebra::Vector<double> &witness,
+                           const LinearSystem &ls)
+{
+  using namespace LinearAlgebra;
+
+  for (size_t i = 0; i < ls.size(); ++i) {
+    const double value = ls.A(i) * witness;
+
+    if (value > ls.b(i) + witness_tolerance(value)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * @brief Test whether a witness is definitely inside a bundle
+ *
+ * @param witness is a point
+ * @param bundle is a bundle
+ * @return `true` if `witness` satisfies all the bundle bounds
+ *         with a slack greater than the witness tolerance
+ */
+bool is_definitely_inside(const LinearAlgebra::Vector<double> &witness,
+                          const Bundle &bundle)
+{
+  using namespace LinearAlgebra;
+
+  for (size_t i = 0; i < bundle.size(); ++i) {
+    const double value = bundle.get_direction(i) * witness;
+    const double tolerance = witness_tolerance(value);
+
+    if (value > bundle.get_upper_bound(i) - tolerance
+        || value < bundle.get_lower_bound(i) + tolerance) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * @brief Get a box including a parallelotope of a bundle
+ *
+ * The parallelotope \f$\{x \mid l \leq \Lambda \cdot x \leq u\}\f$
+ * is the image of the box \f$[l, u]\f$ through \f$\Lambda^{-1}\f$. In
+ * certified builds, \f$\Lambda^{-1}\f$ and the image bounds are
+ * computed exactly and rounded outward. Otherwise, they are computed by
+ * using a floating-point inverse \f$R\f$ of \f$\Lambda\f$. Since
+ * \f$x = R \cdot \Lambda \cdot x + E \cdot x\f$ for the residual
+ * \f$E = I - R \cdot \Lambda\f$, every \f$x\f$ in the parallelotope
+ * belongs to \f$R \cdot [l, u] + E \cdot x\f$ and, whenever
+ * \f$\|E\|_{\infty} < 1\f$, \f$\|x\|_{\infty}\f$ is bounded by
+ * \f$\|R \cdot [l, u]\|_{\infty}/(1-\|E\|_{\infty})\f$. All the
+ * floating-point sums are enlarged by a bound for their rounding errors.
+ * If the residual is too large, e.g., because \f$\Lambda\f$ is very
+ * ill-conditioned, the whole space is returned.
+ *
+ * @param bundle is a bundle
+ * @param bundle_template is a template of `bundle`
+ * @return a box including the parallelotope of `bundle` associated
+ *         to `bundle_template`
+ */
+BoundingBox get_template_box(const Bundle &bundle,
+                             const BundleTemplate &bundle_template)
+{
+  using namespace LinearAlgebra;
+
+  const size_t dim = bundle.dim();
+  const double inf = std::numeric_limits<double>::infinity();
+
+#ifdef WITH_CERTIFIED_PREDICATES
+  Dense::Matrix<mpq_class> Lambda;
+  for (const auto &idx: bundle_template.direction_indices()) {
+    const auto &direction = bundle.get_direction(idx);
+    Lambda.emplace_back(std::begin(direction), std::end(direction));
+  }
+
+  // the i-th row of `columns` is the i-th column of Lambda^{-1}
+  const Dense::Matrix<mpq_class> columns = transpose_inverse(Lambda);
+
+  std::vector<mpq_class> lower(dim, 0), upper(dim, 0);
+  std::vector<bool> lower_is_inf(dim, false), upper_is_inf(dim, false);
+  auto idx_it = std::begin(bundle_template.direction_indices());
+  for (const auto &column: columns) {
+    const double &l = bundle.get_lower_bound(*idx_it);
+    const double &u = bundle.get_upper_bound(*idx_it);
+    for (size_t j = 0; j < dim; ++j) {
+      if (column[j] != 0) {
+        const double &min_y = (column[j] > 0 ? l : u);
+        const double &max_y = (column[j] > 0 ? u : l);
+        if (std::isinf(min_y)) {
+          lower_is_inf[j] = true;
+        } else {
+          lower[j] += column[j] * min_y;
+        }
+        if (std::isinf(max_y)) {
+          upper_is_inf[j] = true;
+        } else {
+          upper[j] += column[j] * max_y;
+        }
+      }
+    }
+    ++idx_it;
+  }
+
+  Vector<double> box_lower(dim), box_upper(dim);
+  for (size_t j = 0; j < dim; ++j) {
+    box_lower[j] = (lower_is_inf[j] ? -inf : get_lower_approximation(lower[j]));
+    box_upper[j] = (upper_is_inf[j] ? inf : get_upper_approximation(upper[j]));
+  }
+
+  return BoundingBox(std::move(box_lower), std::move(box_upper));
+#else
+  // a bound for the relative rounding errors of the sums of at
+  // most `dim+1` products and a bound for their underflows
+  const double gamma = 2 * (dim + 2) * std::numeric_limits<double>::epsilon();
+  const double tiny = (dim + 2) * std::numeric_limits<double>::denorm_min();
+
+  Dense::Matrix<double> Lambda;
+  for (const auto &idx: bundle_template.direction_indices()) {
+    Lambda.push_back(bundle.get_direction(idx));
+  }
+
+  // the i-th row of `columns` is the i-th column of R
+  const Dense::Matrix<double> columns = transpose_inverse(Lambda);
+
+  // the sums of the absolute values of the rows of E = I - R*Lambda
+  Vector<double> residuals(dim, 0);
+  double residual_norm = 0;
+  for (size_t j = 0; j < dim; ++j) {
+    for (size_t k = 0; k < dim; ++k) {
+      double value = (j == k ? 1 : 0);
+      double magnitude = value;
+      for (size_t i = 0; i < dim; ++i) {
+        const double product = columns[i][j] * Lambda[i][k];
+        value -= product;
+        magnitude += std::abs(product);
+      }
+      residuals[j] += std::abs(value) + gamma * magnitude + tiny;
+    }
+    residuals[j] *= 1 + gamma;
+    residual_norm = std::max(residual_norm, residuals[j]);
+  }
+
+  if (!(residual_norm < 1)) {
+    return BoundingBox(dim);
+  }
+
+  // the box R*[l, u]
+  Vector<double> lower(dim, 0), upper(dim, 0), magnitudes(dim, 0);
+  auto idx_it = std::begin(bundle_template.direction_indices());
+  for (const auto &column: columns) {
+    const double &l = bundle.get_lower_bound(*idx_it);
+    const double &u = bundle.get_upper_bound(*idx_it);
+    const double max_abs = std::max(std::abs(l), std::abs(u));
+    for (size_t j = 0; j < dim; ++j) {
+      if (column[j] > 0) {
+        lower[j] += column[j] * l;
+        upper[j] += column[j] * u;
+      } else if (column[j] < 0) {
+        lower[j] += column[j] * u;
+        upper[j] += column[j] * l;
+      }
+      magnitudes[j] += std::abs(column[j]) * max_abs;
+    }
+    ++idx_it;
+  }
+
+  double image_norm = 0;
+  for (size_t j = 0; j < dim; ++j) {
+    const double error = gamma * magnitudes[j] + tiny;
+    lower[j] -= error;
+    upper[j] += error;
+    image_norm = std::max({image_norm, std::abs(lower[j]), std::abs(upper[j])});
+  }
+
+  if (!std::isfinite(image_norm)) {
+    return BoundingBox(dim);
+  }
+
+  // a bound for the infinity norm of the parallelotope points
+  const double x_norm = image_norm / (1 - residual_norm) * (1 + gamma);
+
+  for (size_t j = 0; j < dim; ++j) {
+    const double error = residuals[j] * x_norm * (1 + gamma) + tiny;
+    lower[j] = std::nextafter(lower[j] - error, -inf);
+    upper[j] = std::nextafter(upper[j] + error, inf);
+  }
+
+  return BoundingBox(std::move(lower), std::move(upper));
+#endif // WITH_CERTIFIED_PREDICATES
+}
+
+BoundingBox Bundle::bounding_box() const
+{
+  const auto memoized = _memo.bounding_box();
+  if (memoized) {
+    return *memoized;
+  }
+
+  BoundingBox box(dim());
+  for (const auto &bundle_template: _templates) {
+    box.intersect_with(get_template_box(*this, bundle_template));
+  }
+
+  _memo.set_bounding_box(BoundingBox(box));
+
+  return box;
+}
+
+/**
+ * @brief Get the bundle direction indices sorted by direction
+ *
+ * @param bundle is a bundle
+ * @return the vector of the indices of the `bundle` directions
+ *         sorted by direction
+ */
+std::vector<size_t> sort_direction_indices(const Bundle &bundle)
+{
+  std::vector<size_t> indices(bundle.size());
+  std::iota(std::begin(indices), std::end(indices), 0);
+
+  const auto &directions = bundle.directions();
+  std::sort(std::begin(indices), std::end(indices),
+            [&directions](const size_t &a, const size_t &b) {
+              return directions[a] < directions[b];
+            });
+
+  return indices;
+}
+
+/**
+ * @brief Search a direction among the sorted directions of a bundle
+ *
+ * @param bundle is a bundle
+ * @param sorted_indices are the indices of the `bundle` directions
+ *                       sorted by direction
+ * @param direction is the searched direction
+ * @return the index of `direction` in `bundle`, if `bundle` has it.
+ *         `bundle.size()`, otherwise
+ */
+size_t find_direction(const Bundle &bundle,
+                      const std::vector<size_t> &sorted_indices,
+                      const LinearAlgebra::Vector<double> &direction)
+{
+  const auto &directions = bundle.directions();
+  auto less = [&directions](const size_t &a,
+                            const LinearAlgebra::Vector<double> &v) {
+    return directions[a] < v;
+  };
+  auto it = std::lower_bound(std::begin(sorted_indices),
+                             std::end(sorted_indices), direction, less);
+
+  if (it != std::end(sorted_indices) && directions[*it] == direction) {
+    return *it;
+  }
+
+  return bundle.size();
+}
+
+/**
+ * @brief Conservatively bound a bundle along some directions
+ *
+ * This function bounds the minimum and the maximum of a bundle along
+ * each of the given directions without solving any linear problem.
+ * If the bundle has the very same direction, or its opposite, the
+ * bounds of that direction are used. Otherwise, the bounds are those
+ * of the bundle bounding box. Both the bounding box and its bounds
+ * along the directions are rigorous, so the returned bounds can also
+ * be used by certified predicates.
+ *
+ * @param bundle is a bundle
+ * @param box is the bounding box of `bundle`
+ * @param directions are the directions along which `bundle` is bounded
+ * @return a pair of vectors: a lower bound for the minimum and an upper
+ *         bound for the maximum of `bundle` along each direction
+ */
+std::pair<LinearAlgebra::Vector<double>, LinearAlgebra::Vector<double>>
+get_cheap_bounds(const Bundle &bundle, const BoundingBox &box,
+                 const std::vector<LinearAlgebra::Vector<double>> &directions)
+{
+  using namespace LinearAlgebra;
+
+  const auto sorted_indices = sort_direction_indices(bundle);
+
+  Vector<double> lower(directions.size()), upper(directions.size());
+  for (size_t i = 0; i < directions.size(); ++i) {
+    lower[i] = box.min_of(directions[i]);
+    upper[i] = box.max_of(directions[i]);
+
+    size_t idx = find_direction(bundle, sorted_indices, directions[i]);
+    if (idx < bundle.size()) {
+      lower[i] = std::max(lower[i], bundle.get_lower_bound(idx));
+      upper[i] = std::min(upper[i], bundle.get_upper_bound(idx));
+    }
+
+    idx = find_direction(bundle, sorted_indices, -directions[i]);
+    if (idx < bundle.size()) {
+      lower[i] = std::max(lower[i], -bundle.get_upper_bound(idx));
+      upper[i] = std::min(upper[i], -bundle.get_lower_bound(idx));
+    }
+  }
+
+  return {std::move(lower), std::move(upper)};
+}
+
+BoundedDualSimplexOptimizer<double> Bundle::optimizer(
+    const std::vector<LinearAlgebra::Vector<double>> &obj_funs) const
+{
+  return BoundedDualSimplexOptimizer<double>(_directions, _lower_bounds,
+                                             _upper_bounds,
+                                             get_a_template_basis(*this),
+                                             obj_funs);
+}
+
+bool Bundle::is_empty() const
+{
+  const auto properties = _memo.get();
+  if (properties) {
+    return properties->is_empty;
+  }
+
+  const auto optimizer = get_predicate_optimizer(*this, {});
+  if (optimizer.feasible_set_is_empty()) {
+    _memo.set_empty();
+
+    return true;
+  }
+
+  _memo.set_non_empty(get_approximation(optimizer.feasible_point()));
+
+  return false;
+}
+
 /**
  * Generate the polytope represented by the bundle
  *
@@ -896,17 +1464,34 @@ Bundle &Bundle::canonize()
     return *this;
   }
 
+  // if the bundle is already known to be either canonical or empty
+  const auto properties = _memo.get();
+  if (properties && (properties->is_canonical || properties->is_empty)) {
+    return *this;
+  }
+
+  // the optimizations share the same system; in certified builds,
+  // the optima are exact and they are rounded outward
+  auto optimizer = get_predicate_optimizer(*this, _directions);
+
   // if the bundle is empty
-  if (is_empty()) {
+  if (optimizer.feasible_set_is_empty()) {
+    _memo.set_empty();
+
     return *this;
   }
 
-  // get current polytope
-  Polytope bund = *this;
   for (unsigned int i = 0; i < this->size(); ++i) {
-    _lower_bounds[i] = bund.minimize(this->_directions[i]).objective_value();
-    _upper_bounds[i] = bund.maximize(this->_directions[i]).objective_value();
+    _lower_bounds[i]
+        = get_lower_approximation(optimizer.minimize(i).objective_value());
+    _upper_bounds[i]
+        = get_upper_approximation(optimizer.maximize(i).objective_value());
   }
+
+  auto witness = (properties ? properties->witness
+                             : get_approximation(optimizer.feasible_point()));
+  _memo.set_non_empty(std::move(witness), true);
+
   return *this;
 }
 
@@ -921,28 +1506,53 @@ bool are_disjoint(const Bundle &A, const Bundle &B)
     return false;
   }
 
-  using namespace LinearAlgebra;
+  // the memoized properties: empty bundles or a witness in the other bundle
+  for (const auto &[X, Y]: {std::make_pair(&A, &B), std::make_pair(&B, &A)}) {
+    const auto properties = X->_memo.get();
+    if (properties) {
+      if (properties->is_empty) {
+        return true;
+      }
 
-  Dense::Matrix<double> ls_A;
-  Vector<double> ls_b;
+      if (properties->witness.size() == X->dim()
+          && is_definitely_inside(properties->witness, *Y)) {
+        return false;
+      }
+    }
+  }
+
+  // the cheap tests: disjoint bounding boxes or disjoint bounds
+  // along the directions of B
+  const BoundingBox A_box = A.bounding_box();
+  if (are_disjoint(A_box, B.bounding_box())) {
+    return true;
+  }
 
-  auto add_bundle_constraints = [&ls_A, &ls_b](const Bundle &bundle) {
-    for (size_t i = 0; i < bundle.size(); ++i) {
-      ls_A.push_back(bundle.get_direction(i));
-      ls_b.push_back(bundle.get_upper_bound(i));
-      ls_A.push_back(-bundle.get_direction(i));
-      ls_b.push_back(-bundle.get_lower_bound(i));
+  const auto A_bounds = get_cheap_bounds(A, A_box, B.directions());
+  for (size_t i = 0; i < B.size(); ++i) {
+    if (A_bounds.second[i] < B.get_lower_bound(i)
+        || A_bounds.first[i] > B.get_upper_bound(i)) {
+      return true;
     }
-  };
+  }
+
+  using namespace LinearAlgebra;
 
-  add_bundle_constraints(A);
-  add_bundle_constraints(B);
+  // the directions of A and B as ranged rows
+  Dense::Matrix<double> D = A.directions();
+  Vector<double> lower = A.lower_bounds();
+  Vector<double> upper = A.upper_bounds();
 
-  SimplexMethodOptimizer optimizer;
+  D.insert(std::end(D), std::begin(B.directions()), std::end(B.directions()));
+  lower.insert(std::end(lower), std::begin(B.lower_bounds()),
+               std::end(B.lower_bounds()));
+  upper.insert(std::end(upper), std::begin(B.upper_bounds()),
+               std::end(B.upper_bounds()));
 
-  auto result = optimizer(ls_A, ls_b, Vector<double>(A.dim()));
+  // start from a template of A
+  PredicateOptimizer optimizer(D, lower, upper, get_a_template_basis(A), {});
 
-  return result.feasible_set_is_empty();
+  return optimizer.feasible_set_is_empty();
 }
 
 /**
@@ -957,32 +1567,84 @@ bool are_disjoint(const Bundle &A, const Bundle &B)
  */
 bool Bundle::is_subset_of(const Bundle &bundle) const
 {
+  using namespace LinearAlgebra;
+
+  // bound this object along the bundle directions without solving
+  // any linear problem and select the bounds that remain uncertain
+  const BoundingBox box = bounding_box();
+  const auto cheap_bounds = get_cheap_bounds(*this, box, bundle.directions());
+
+  std::vector<size_t> uncertain;
+  std::vector<Vector<double>> uncertain_dirs;
+  for (size_t i = 0; i < bundle.size(); ++i) {
+    if (cheap_bounds.first[i] < bundle.get_lower_bound(i)
+        || cheap_bounds.second[i] > bundle.get_upper_bound(i)) {
+      uncertain.push_back(i);
+      uncertain_dirs.push_back(bundle.get_direction(i));
+    }
+  }
+
+  // if all the bundle bounds are satisfied, this object is a subset
+  if (uncertain.size() == 0) {
+    return true;
+  }
+
+  // if this object is known to be empty, it is a subset of the bundle;
+  // if a point of this object is outside the bundle, it is not
+  const auto properties = _memo.get();
+  if (properties) {
+    if (properties->is_empty) {
+      return true;
+    }
+
+    if (properties->witness.size() == dim()
+        && is_definitely_outside(properties->witness, bundle)) {
+      return false;
+    }
+  }
+
+  // if the bounding boxes are disjoint, this object is a subset of
+  // the bundle if and only if it is empty
+  if (are_disjoint(box, bundle.bounding_box())) {
+    return is_empty();
+  }
+
+  auto optimizer = get_predicate_optimizer(*this, uncertain_dirs);
+
   // if this object is empty
-  if (this->is_empty()) {
+  if (optimizer.feasible_set_is_empty()) {
+    _memo.set_empty();
+
     return true;
   }
 
+  if (!properties) {
+    _memo.set_non_empty(get_approximation(optimizer.feasible_point()));
+  }
+
   // if the parameter is empty and this object is not,
   // return false
   if (bundle.is_empty()) {
     return false;
   }
 
-  Polytope P_this = *this;
-  // for each direction in the bundle
-  for (unsigned int dir_idx = 0; dir_idx < bundle.size(); ++dir_idx) {
+  // for each uncertain direction in the bundle
+  for (size_t i = 0; i < uncertain.size(); ++i) {
+    const size_t &dir_idx = uncertain[i];
 
     // if the minimum of this object on that direction is lesser than
     // the bundle minimum, this object is not a subset of the bundle
-    if (P_this.minimize(bundle.get_direction(dir_idx)).objective_value()
-        < bundle.get_lower_bound(dir_idx)) {
+    if (cheap_bounds.first[dir_idx] < bundle.get_lower_bound(dir_idx)
+        && is_below(optimizer.minimize(i).objective_value(),
+                    bundle.get_lower_bound(dir_idx))) {
       return false;
     }
 
     // if the maximum of this object on that direction is greater than
     // the bundle maximum, this object is not a subset of the bundle
-    if (P_this.maximize(bundle.get_direction(dir_idx)).objective_value()
-        > bundle.get_upper_bound(dir_idx)) {
+    if (cheap_bounds.second[dir_idx] > bundle.get_upper_bound(dir_idx)
+        && is_above(optimizer.maximize(i).objective_value(),
+                    bundle.get_upper_bound(dir_idx))) {
       return false;
     }
   }
@@ -1004,24 +1666,66 @@ bool Bundle::is_subset_of(const Bundle &bundle) const
  */
 bool Bundle::satisfies(const LinearSystem &ls) const
 {
+  using namespace LinearAlgebra;
+
+  // bound this object along the system rows without solving
+  // any linear problem and select the rows that remain uncertain
+  const auto cheap_bounds = get_cheap_bounds(*this, bounding_box(), ls.A());
+
+  std::vector<size_t> uncertain;
+  std::vector<Vector<double>> uncertain_rows;
+  for (size_t i = 0; i < ls.size(); ++i) {
+    if (cheap_bounds.second[i] > ls.b(i)) {
+      uncertain.push_back(i);
+      uncertain_rows.push_back(ls.A(i));
+    }
+  }
+
+  // if all the rows are satisfied, this object satisfies the system
+  if (uncertain.size() == 0) {
+    return true;
+  }
+
+  // if this object is known to be empty, it satisfies the system;
+  // if a point of this object violates the system, it does not
+  const auto properties = _memo.get();
+  if (properties) {
+    if (properties->is_empty) {
+      return true;
+    }
+
+    if (properties->witness.size() == dim()
+        && is_definitely_outside(properties->witness, ls)) {
+      return false;
+    }
+  }
+
+  auto optimizer = get_predicate_optimizer(*this, uncertain_rows);
+
   // if this object is empty
-  if (this->is_empty()) {
+  if (optimizer.feasible_set_is_empty()) {
+    _memo.set_empty();
+
     return true;
   }
 
+  if (!properties) {
+    _memo.set_non_empty(get_approximation(optimizer.feasible_point()));
+  }
+
   // if the parameter has no solutions and this object is not,
   // return false
   if (!ls.has_solutions()) {
     return false;
   }
 
-  Polytope P_this = *this;
-  // for each direction in the bundle
-  for (unsigned int dir_idx = 0; dir_idx < ls.size(); ++dir_idx) {
+  // for each uncertain row in the system
+  for (size_t i = 0; i < uncertain.size(); ++i) {
 
     // if the maximum of this object on that direction is smaller than
     // the bundle maximum, this object does not include the bundle
-    if (P_this.maximize(ls.A(dir_idx)).objective_value() > ls.b(dir_idx)) {
+    if (is_above(optimizer.maximize(i).objective_value(),
+                 ls.b(uncertain[i]))) {
       return false;
     }
   }
@@ -1284,6 +1988,16 @@ Bundle &Bundle::intersect_with(const Bundle &A)
 
   add_mapped_templates(_templates, A.templates(), new_ids);
 
+  // the intersection of an empty bundle is empty
+  const auto properties = _memo.get();
+  const auto A_properties = A._memo.get();
+  if ((properties && properties->is_empty)
+      || (A_properties && A_properties->is_empty)) {
+    _memo.set_empty();
+  } else {
+    _memo.forget();
+  }
+
   return *this;
 }
 
@@ -1356,6 +2070,12 @@ Bundle &Bundle::intersect_with(const LinearSystem &ls)
   add_missing_templates(_templates, _directions, _adaptive_directions,
                         outside_templates);
 
+  // the intersection of an empty bundle is empty
+  const auto properties = _memo.get();
+  if (!properties || !properties->is_empty) {
+    _memo.forget();
+  }
+
   return this->canonize();
 }
 
@@ -1365,6 +2085,17 @@ Bundle &Bundle::expand_by(const double delta)
     return *this;
   }
 
+  // the bundle is not empty and, if it grows, it still includes
+  // its witness, but not its bounding box
+  const auto properties = _memo.get();
+  if (delta >= 0) {
+    auto witness = properties->witness;
+    _memo.set_non_empty(std::move(witness));
+    _memo.forget_bounding_box();
+  } else {
+    _memo.forget();
+  }
+
   for (auto b_it = std::begin(_lower_bounds); b_it != std::end(_lower_bounds);
        ++b_it) {
     *b_it -= delta;
@@ -1397,22 +2128,26 @@ Bundle over_approximate_union(const Bundle &b1, const Bundle &b2)
     return b1;
   }
 
-  Polytope p2(b2);
   Bundle res(b1);
   const Matrix<double> &res_dirs = res.directions();
 
-  // Updates res boundaries to include p2
+  // `res` is going to grow: it is no more canonical
+  res._memo.forget();
+
+  // Updates res boundaries to include b2
+  auto p2_optimizer = b2.optimizer(res_dirs);
   for (unsigned int i = 0; i < res_dirs.size(); ++i) {
-    const LinearAlgebra::Vector<double> &res_dir = res_dirs[i];
-    res._lower_bounds[i] = std::min(p2.minimize(res_dir).objective_value(),
-                                    res.get_lower_bound(i));
-    res._upper_bounds[i] = std::max(p2.maximize(res_dir).objective_value(),
-                                    res.get_upper_bound(i));
+    res._lower_bounds[i]
+        = std::min(p2_optimizer.minimize(i).objective_value(),
+                   res.get_lower_bound(i));
+    res._upper_bounds[i]
+        = std::max(p2_optimizer.maximize(i).objective_value(),
+                   res.get_upper_bound(i));
   }
 
   const Matrix<double> &b2_dirs = b2.directions();
 
-  Polytope p1(b1);
+  auto p1_optimizer = b1.optimizer(b2_dirs);
   std::vector<unsigned int> new_ids(b2.size());
   // for each row in the linear system
   for (unsigned int i = 0; i < b2_dirs.size(); ++i) {
@@ -1422,10 +2157,12 @@ Bundle over_approximate_union(const Bundle &b1, const Bundle &b2)
 
     // if the direction is not present in this object
     if (new_ids[i] == res.size()) {
-      double lower_bound = std::min(p1.minimize(b2_dir).objective_value(),
-                                    b2.get_lower_bound(i));
-      double upper_bound = std::max(p1.maximize(b2_dir).objective_value(),
-                                    b2.get_upper_bound(i));
+      double lower_bound
+          = std::min(p1_optimizer.minimize(i).objective_value(),
+                     b2.get_lower_bound(i));
+      double upper_bound
+          = std::max(p1_optimizer.maximize(i).objective_value(),
+                     b2.get_upper_bound(i));
 
       // add the direction and the corresponding boundaries
       res._directions.push_back(b2_dir);
@@ -1470,24 +2207,26 @@ SetsUnion<Bundle> subtract_and_close(const Bundle &b1, const Bundle &b2)
     return su;
   }
 
-  Polytope p1 = b1;
+  auto optimizer = get_predicate_optimizer(b1, b2.directions());
 
   for (unsigned int i = 0; i < b2.size(); ++i) {
-    auto new_bound = p1.maximize(b2.get_direction(i)).objective_value();
-    if (new_bound > b2.get_upper_bound(i)) {
+    auto new_bound = optimizer.maximize(i).objective_value();
+    if (is_above(new_bound, b2.get_upper_bound(i))) {
       Bundle new_b1 = b1;
+      new_b1._memo.forget();
       new_b1._directions.push_back(b2.get_direction(i));
       new_b1._lower_bounds.push_back(b2.get_upper_bound(i));
-      new_b1._upper_bounds.push_back(new_bound);
+      new_b1._upper_bounds.push_back(get_upper_approximation(new_bound));
 
       su.add(std::move(new_b1.canonize()));
     }
 
-    new_bound = p1.minimize(b2.get_direction(i)).objective_value();
-    if (new_bound < b2.get_lower_bound(i)) {
+    new_bound = optimizer.minimize(i).objective_value();
+    if (is_below(new_bound, b2.get_lower_bound(i))) {
       Bundle new_b1 = b1;
+      new_b1._memo.forget();
       new_b1._directions.push_back(b2.get_direction(i));
-      new_b1._lower_bounds.push_back(new_bound);
+      new_b1._lower_bounds.push_back(get_lower_approximation(new_bound));
       new_b1._upper_bounds.push_back(b2.get_lower_bound(i));
 
       su.add(std::move(new_b1.canonize()));
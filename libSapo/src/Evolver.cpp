@@ -13,6 +13,8 @@
 #include <utility>
 
 #ifdef WITH_THREADS
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
 
@@ -20,6 +22,8 @@
 #endif // WITH_THREADS
 
 #include "Bernstein.h"
+#include "ExpressionDAG.h"
+#include "Polynomial.h"
 #include "VarsGenerator.h"
 #include "ErrorHandling.h"
 
@@ -76,10 +80,12 @@ replace_in_rational(
  * @brief Replace some variables in expressions by other expressions
  *
  * This function replaces all the occurrences of the variable `vars[i]`
- * in any expression in `expressions` with `subs[i]`.
+ * in any root expression of `expressions` with `subs[i]`. Equal
+ * sub-expressions, e.g., the stages of Runge-Kutta methods, are
+ * replaced once.
  *
  * @tparam T is the numeric type of the coefficients
- * @param expressions is the vector of expressions whose variable
+ * @param expressions is the graph of the expressions whose variable
  *                    occurrences must be replaced
  * @param vars is the vector variables whose occurrences must be
  *             replaced
@@ -92,7 +98,7 @@ replace_in_rational(
 
 template<typename T>
 std::vector<SymbolicAlgebra::Expression<T>>
-replace_in(const std::vector<SymbolicAlgebra::Expression<T>> &expressions,
+replace_in(const SymbolicAlgebra::ExpressionDAG<T> &expressions,
            const std::vector<SymbolicAlgebra::Symbol<T>> &vars,
            const std::vector<SymbolicAlgebra::Expression<T>> &subs)
 {
@@ -104,13 +110,7 @@ replace_in(const std::vector<SymbolicAlgebra::Expression<T>> &expressions,
     repl[vars[k]] = subs[k];
   }
 
-  std::vector<Expression<T>> results;
-  for (auto ex_it = std::begin(expressions); ex_it != std::end(expressions);
-       ++ex_it) {
-    results.push_back(Expression<T>(*ex_it).replace(repl));
-  }
-
-  return results;
+  return expressions.replace(expressions.roots(), repl);
 }
 
 /**
@@ -266,9 +266,11 @@ std::vector<SymbolicAlgebra::Expression<T>> build_symbolic_generator_functions(
  * @brief A container whose accesses are synchronized
  *
  * The objects of this class store values that can be
- * accessed in a synchronized way according to a mutex.
- * The value themselves are updated exclusively if the
- * call `COND::operator()` on the stored value and the
+ * accessed in a synchronized way. When threads are
+ * available, the value is stored in an atomic variable
+ * and it is updated by a lock-free compare-and-swap
+ * loop. The value themselves are updated exclusively if
+ * the call `COND::operator()` on the stored value and the
  * possible new value, returns `true`.
  *
  * @tparam T is the numeric type of the value
@@ -278,10 +280,10 @@ template<typename T, typename COND>
 class CondSyncUpdater
 {
 #ifdef WITH_THREADS
-  mutable std::shared_timed_mutex
-      mutex; //!< The mutex that synchronizes the accesses
+  std::atomic<T> _value; //!< the value stored in the object
+#else
+  T _value; //!< the value stored in the object
 #endif
-  T _value;  //!< the value stored in the object
   COND _cmp; //!< the condition that must be satisfied to update the value
 
 public:
@@ -304,9 +306,6 @@ public:
    */
   inline operator T() const
   {
-#ifdef WITH_THREADS
-    std::shared_lock<std::shared_timed_mutex> readlock(mutex);
-#endif
     return _value;
   }
 
@@ -321,14 +320,19 @@ public:
    */
   void update(const T &value)
   {
-
 #ifdef WITH_THREADS
-    std::unique_lock<std::shared_timed_mutex> writelock(mutex);
-#endif
+    T current = _value.load();
 
+    // if another thread changes the value in the meantime,
+    // `current` is reloaded and the condition is tested again
+    while (_cmp(value, current)
+           && !_value.compare_exchange_weak(current, value)) {
+    }
+#else
     if (_cmp(value, _value)) {
       _value = value;
     }
+#endif
   }
 };
 
@@ -363,6 +367,15 @@ public:
   virtual std::pair<T, T> operator()(
       const std::vector<SymbolicAlgebra::Expression<T>> &coefficients) const;
 
+  /**
+   * @brief Find the interval containing numeric Bernstein coefficients.
+   *
+   * @param coefficients is the vector of numeric Bernstein coefficients
+   * @return The pair minimum-maximum among all the Bernstein
+   *          coefficients in `coefficients`
+   */
+  std::pair<T, T> operator()(const std::vector<T> &coefficients) const;
+
   virtual ~MinMaxCoeffFinder() {}
 };
 
@@ -468,6 +481,28 @@ std::pair<T, T> MinMaxCoeffFinder<T>::operator()(
   return std::pair<T, T>(std::move(min_value), std::move(max_value));
 }
 
+template<typename T>
+std::pair<T, T>
+MinMaxCoeffFinder<T>::operator()(const std::vector<T> &coefficients) const
+{
+  auto b_coeff_it = coefficients.begin();
+
+  T max_value = AVOID_NEG_ZERO(*b_coeff_it);
+  T min_value = max_value;
+
+  for (++b_coeff_it; b_coeff_it != coefficients.end(); ++b_coeff_it) {
+    if (*b_coeff_it > max_value) {
+      max_value = AVOID_NEG_ZERO(*b_coeff_it);
+    }
+
+    if (*b_coeff_it < min_value) {
+      min_value = AVOID_NEG_ZERO(*b_coeff_it);
+    }
+  }
+
+  return std::pair<T, T>(std::move(min_value), std::move(max_value));
+}
+
 template<typename T>
 std::pair<T, T> ParamMinMaxCoeffFinder<T>::operator()(
     const std::vector<SymbolicAlgebra::Expression<T>> &coefficients) const
@@ -1021,6 +1056,8 @@ class BoundRefiner
 {
   const Bundle _bundle;                        //!< the considered bundle
   const DynamicalSystem<T> &_dynamical_system; //!< the dynamical system
+  const SymbolicAlgebra::ExpressionDAG<T>
+      &_dynamics; //!< the graph of the dynamical system dynamics
 
   std::vector<CondSyncUpdater<T, std::greater<T>>>
       _lower_bound; //!< the vector of identified lower bounds
@@ -1042,14 +1079,30 @@ class BoundRefiner
       *_minmax_finder; //!< an object minimize and maximize Bernstein
                        //!< coefficient in the parameter set
 
+  typename Bernstein<T>::DenseTensorBounds
+      _dense_tensor_bounds; //!< the dense tensor bound function of the
+                            //!< dynamical system dimension
+
+  bool _use_arenas; //!< a flag to process templates in expression arenas
+
   /**
    * @brief Parallelotope processor
    *
    * This class refines the bundle image bounds considering one
-   * of the bundle templates.
+   * of the bundle templates. When the refiner uses expression
+   * arenas, the expression nodes built by the processor come from
+   * its own arena, which is released when the processor is
+   * destroyed.
    */
   class ParallelotopeProcessor
   {
+    SymbolicAlgebra::ExpressionArena
+        _arena; //!< the arena of the processor expressions. It must
+                //!< be declared first to outlive them
+
+    SymbolicAlgebra::ExpressionArena
+        *_used_arena; //!< the arena in use or `nullptr`
+
     const Parallelotope
         _parallelotope; //!< the parallelotope of the considered template
 
@@ -1062,9 +1115,35 @@ class BoundRefiner
                                        //!< and beta variables for the
                                        //!< considered parallelotope
 
+    std::vector<SymbolicAlgebra::Symbol<T>>
+        _slots; //!< the base and lambda variables in compiled coefficients
+
+    std::vector<T> _slot_values; //!< the values of the base and lambda
+                                 //!< variables for the considered
+                                 //!< parallelotope
+
     BernsteinCache<T>
         *_cache; //!< a pointer to the symbolic Bernstein coefficient cache
 
+    size_t _generators_hash; //!< the cache hash of the parallelotope
+                             //!< generators
+
+    bool _parametric; //!< a flag to establish whether the dynamical system
+                      //!< has parameters
+
+    bool _numeric; //!< a flag to establish whether the Bernstein
+                   //!< coefficient bounds are computed numerically
+
+    typename Bernstein<T>::DenseTensorBounds
+        _dense_tensor_bounds; //!< the dense tensor bound function
+
+    std::vector<unsigned int>
+        _degrees; //!< the alpha variable degrees in the generator functions
+
+    std::vector<std::vector<T>>
+        _dense_generator_functions; //!< the dense coefficient tensors of
+                                    //!< the generator functions
+
     /**
      * @brief Get the symbolic Bernstein coefficients of a direction
      *
@@ -1084,17 +1163,50 @@ class BoundRefiner
         const std::vector<SymbolicAlgebra::Symbol<T>> alpha,
         const LinearAlgebra::Vector<T> &direction)
     {
-      if (_cache->coefficients_in_cache(_parallelotope,
-                                        direction)) { // Bernstein coefficients
-                                                      // have been computed
+      auto cached = _cache->find_coefficients(_generators_hash,
+                                              _parallelotope, direction);
+      if (cached != nullptr) { // Bernstein coefficients have been computed
+        return *cached;
+      }
+
+      auto coefficients = compute_Bernstein_coefficients(
+          alpha, _generator_functions, direction);
+      return _cache->save_coefficients(_generators_hash, _parallelotope,
+                                       direction, std::move(coefficients));
+    }
 
-        return _cache->get_coefficients(_parallelotope, direction);
+    /**
+     * @brief Get the compiled Bernstein coefficients of a direction
+     *
+     * This method search for the compiled Bernstein coefficients of a
+     * direction in the cache. If it does not contain them, the symbolic
+     * coefficients are computed, compiled, and stored in the cache.
+     * Finally, a reference to the stored compiled Bernstein coefficients
+     * is returned.
+     *
+     * @param alpha is the vector of alpha variables to be used
+     * @param direction is the direction whose compiled Bernstein
+     * coefficients are aimed
+     * @return a reference to the compiled Bernstein coefficients of a
+     * direction
+     */
+    const SymbolicAlgebra::CompiledExpressions<T> &
+    get_compiled_coefficients(
+        const std::vector<SymbolicAlgebra::Symbol<T>> alpha,
+        const LinearAlgebra::Vector<T> &direction)
+    {
+      auto cached = _cache->find_compiled_coefficients(
+          _generators_hash, _parallelotope, direction);
+      if (cached != nullptr) {
+        return *cached;
       }
 
       auto coefficients = compute_Bernstein_coefficients(
           alpha, _generator_functions, direction);
-      return _cache->save_coefficients(_parallelotope, direction,
-                                       std::move(coefficients));
+
+      return _cache->save_compiled_coefficients(
+          _generators_hash, _parallelotope, direction,
+          SymbolicAlgebra::CompiledExpressions<T>(coefficients, _slots));
     }
 
   public:
@@ -1109,9 +1221,14 @@ class BoundRefiner
     ParallelotopeProcessor(BoundRefiner &refiner,
                            const BundleTemplate &bundle_template,
                            BernsteinCache<T> *cache):
+        _arena(), _used_arena(refiner._use_arenas ? &_arena : nullptr),
         _parallelotope(refiner._bundle.get_parallelotope(bundle_template)),
-        _cache(bundle_template.is_adaptive() ? nullptr : cache)
+        _cache(bundle_template.is_adaptive() ? nullptr : cache),
+        _generators_hash(0), _parametric(refiner._dynamical_system.parameters().size() > 0),
+        _numeric(false), _dense_tensor_bounds(refiner._dense_tensor_bounds)
     {
+      SymbolicAlgebra::ExpressionArena::Scope scope(_used_arena);
+
       std::vector<SymbolicAlgebra::Expression<T>> genFun;
       if (_cache == nullptr) {
         genFun = build_generator_functions(refiner._alpha, _parallelotope);
@@ -1119,10 +1236,13 @@ class BoundRefiner
         genFun = build_symbolic_generator_functions(
             refiner._base, refiner._alpha, refiner._lambda,
             _parallelotope.generators());
+
+        _generators_hash
+            = BernsteinCache<T>::hash(_parallelotope.generators());
       }
 
       _generator_functions
-          = replace_in(refiner._dynamical_system.dynamics(),
+          = replace_in(refiner._dynamics,
                        refiner._dynamical_system.variables(), genFun);
 
       for (size_t i = 0; i < _parallelotope.dim(); ++i) {
@@ -1131,6 +1251,44 @@ class BoundRefiner
         _parallelotope_interpretation[refiner._lambda[i]]
             = _parallelotope.lengths()[i];
       }
+
+      // the generator functions of non-parametric systems on adaptive
+      // templates are numeric polynomials in the alpha variables: their
+      // Bernstein coefficient bounds can be computed numerically
+      _numeric = (_cache == nullptr && !_parametric);
+      for (const auto &function: _generator_functions) {
+        _numeric = _numeric && function.is_a_polynomial();
+      }
+
+      if (_numeric) {
+        std::vector<SymbolicAlgebra::Polynomial<T>> polynomials;
+        polynomials.reserve(_generator_functions.size());
+
+        _degrees = std::vector<unsigned int>(refiner._alpha.size(), 0);
+        for (const auto &function: _generator_functions) {
+          polynomials.emplace_back(function, refiner._alpha);
+
+          const auto degrees = polynomials.back().degrees();
+          for (size_t i = 0; i < degrees.size(); ++i) {
+            _degrees[i] = std::max(_degrees[i], degrees[i]);
+          }
+        }
+
+        _dense_generator_functions.reserve(polynomials.size());
+        for (const auto &polynomial: polynomials) {
+          _dense_generator_functions.push_back(
+              polynomial.get_dense_coefficients(_degrees));
+        }
+      }
+
+      _slots = refiner._base;
+      _slots.insert(std::end(_slots), std::begin(refiner._lambda),
+                    std::end(refiner._lambda));
+
+      _slot_values = _parallelotope.base_vertex();
+      _slot_values.insert(std::end(_slot_values),
+                          std::begin(_parallelotope.lengths()),
+                          std::end(_parallelotope.lengths()));
     }
 
     /**
@@ -1140,14 +1298,59 @@ class BoundRefiner
      * @param direction is the direction whose bounds are aimed
      * @param minmax_finder is the object that search among Bernstein
      * coefficients for their maximum and minimum
+     * @param lower_threshold is the greatest lower bound for the direction
+     * that has been already found
+     * @param upper_threshold is the smallest upper bound for the direction
+     * that has been already found
      * @return a pair minimum-maximum bounds for the specified direction in the
-     * image of the bundle through the dynamical system
+     * image of the bundle through the dynamical system. When both the bounds
+     * cannot improve the thresholds, the returned pair may be any pair
+     * dominated by the thresholds
      */
     std::pair<T, T>
     get_direction_bounds(const std::vector<SymbolicAlgebra::Symbol<T>> alpha,
                          const LinearAlgebra::Vector<T> &direction,
-                         MinMaxCoeffFinder<T> *minmax_finder)
+                         MinMaxCoeffFinder<T> *minmax_finder,
+                         const T &lower_threshold, const T &upper_threshold)
     {
+      SymbolicAlgebra::ExpressionArena::Scope scope(_used_arena);
+
+      if (_numeric) {
+        // the processor is shared among the tasks of a template, so the
+        // Lfog tensor lives in a thread buffer that is reused, without
+        // reallocations, by all the directions processed by the thread
+        static thread_local std::vector<T> Lfog;
+
+        Lfog.assign(_dense_generator_functions[0].size(), 0);
+        for (size_t k = 0; k < direction.size(); ++k) {
+          if (direction[k] != 0) {
+            const auto &function = _dense_generator_functions[k];
+            for (size_t j = 0; j < Lfog.size(); ++j) {
+              Lfog[j] += direction[k] * function[j];
+            }
+          }
+        }
+
+        // the symbolic approach evaluates the Bernstein coefficients
+        // on the Lfog degrees: the bound function reduces the tensor
+        // to them
+        auto bounds = (*_dense_tensor_bounds)(_degrees, Lfog,
+                                              lower_threshold,
+                                              upper_threshold);
+
+        return std::pair<T, T>(AVOID_NEG_ZERO(bounds.first),
+                               AVOID_NEG_ZERO(bounds.second));
+      }
+
+      // the coefficients of non-parametric systems are evaluated
+      // by using their compiled form
+      if (_cache != nullptr && !_parametric) {
+        auto &compiled_coefficients
+            = get_compiled_coefficients(alpha, direction);
+
+        return (*minmax_finder)(compiled_coefficients.evaluate(_slot_values));
+      }
+
       std::vector<SymbolicAlgebra::Expression<double>> coefficients;
 
       if (_cache == nullptr) {
@@ -1168,17 +1371,69 @@ class BoundRefiner
     }
   };
 
+  /**
+   * @brief Get the number of directions to be processed for a template
+   *
+   * @param bundle_template is a template of the considered bundle
+   * @param mode is the bound computation mode, i.e., one-for-one or
+   * all-for-one
+   * @return the number of directions whose bounds must be refined by
+   * using the parallelotope of `bundle_template`
+   */
+  inline size_t
+  num_of_directions(const BundleTemplate &bundle_template,
+                    const typename Evolver<T>::evolver_mode &mode) const
+  {
+    return (mode == Evolver<T>::ONE_FOR_ONE ? bundle_template.dim()
+                                            : _bundle.size());
+  }
+
+  /**
+   * @brief Refine the bounds of a block of directions
+   *
+   * @param processor is the processor of the template parallelotope
+   * @param bundle_template is a template of the considered bundle
+   * @param mode is the bound computation mode, i.e., one-for-one or
+   * all-for-one
+   * @param first is the position of the first direction in the block
+   * @param last is the position of the first direction after the block
+   */
+  void process_directions(ParallelotopeProcessor &processor,
+                          const BundleTemplate &bundle_template,
+                          const typename Evolver<T>::evolver_mode &mode,
+                          const size_t first, const size_t last)
+  {
+    for (size_t j = first; j < last; j++) {
+      auto direction_index
+          = (mode == Evolver<T>::ONE_FOR_ONE ? bundle_template[j] : j);
+
+      const auto &direction = _new_directions[direction_index];
+
+      auto coefficients = processor.get_direction_bounds(
+          _alpha, direction, _minmax_finder, _lower_bound[direction_index],
+          _upper_bound[direction_index]);
+
+      _lower_bound[direction_index].update(coefficients.first);
+      _upper_bound[direction_index].update(coefficients.second);
+    }
+  }
+
 public:
   BoundRefiner(const Bundle &bundle,
                const DynamicalSystem<T> &dynamical_system,
+               const SymbolicAlgebra::ExpressionDAG<T> &dynamics,
                const Polytope &parameter_set,
-               const std::vector<LinearAlgebra::Vector<T>> &new_directions):
+               const std::vector<LinearAlgebra::Vector<T>> &new_directions,
+               typename Bernstein<T>::DenseTensorBounds dense_tensor_bounds,
+               const bool use_arenas = false):
       _bundle(bundle),
-      _dynamical_system(dynamical_system), _lower_bound(bundle.size()),
+      _dynamical_system(dynamical_system),
+      _dynamics(dynamics), _lower_bound(bundle.size()),
       _upper_bound(bundle.size()), _new_directions(new_directions),
       _alpha(get_symbol_vector<T>("alpha", dynamical_system.dim())),
       _lambda(get_symbol_vector<T>("lambda", dynamical_system.dim())),
-      _base(get_symbol_vector<T>("base", dynamical_system.dim()))
+      _base(get_symbol_vector<T>("base", dynamical_system.dim())),
+      _dense_tensor_bounds(dense_tensor_bounds), _use_arenas(use_arenas)
   {
     if (dynamical_system.parameters().size() == 0) {
       _minmax_finder = new MinMaxCoeffFinder<T>();
@@ -1204,26 +1459,67 @@ public:
   {
     ParallelotopeProcessor processor(*this, bundle_template, cache);
 
-    // for each direction
-    const size_t num_of_directions
-        = (mode == Evolver<T>::ONE_FOR_ONE ? bundle_template.dim()
-                                           : _bundle.size());
+    process_directions(processor, bundle_template, mode, 0,
+                       num_of_directions(bundle_template, mode));
 
-    for (size_t j = 0; j < num_of_directions; j++) {
-      auto direction_index
-          = (mode == Evolver<T>::ONE_FOR_ONE ? bundle_template[j] : j);
+    return *this;
+  }
 
-      const auto &direction = _new_directions[direction_index];
+#ifdef WITH_THREADS
+  /**
+   * @brief Process a bundle template by using the thread pool
+   *
+   * This method splits the directions to be processed for a
+   * template in blocks and submits one task per block to
+   * a thread pool batch. The first block is processed by the
+   * calling thread. The template parallelotope processor is
+   * shared among the tasks and it is destroyed as soon as all
+   * of them have been completed. The caller is in charge of
+   * joining the batch before reading the bounds.
+   *
+   * @param bundle_template is a template of the considered bundle
+   * @param mode is the bound computation mode, i.e., one-for-one or
+   * all-for-one
+   * @param cache is the symbolic Bernstein coefficient cache
+   * @param batch_id is the thread pool batch of the tasks
+   * @param directions_per_task is the number of directions processed
+   * by each task. If it is 0, all the directions are processed by the
+   * calling thread
+   * @return a reference to the current object
+   */
+  BoundRefiner<T> &process_template(
+      const BundleTemplate &bundle_template,
+      const typename Evolver<T>::evolver_mode &mode, BernsteinCache<T> *cache,
+      const ThreadPool::BatchId &batch_id, const size_t directions_per_task)
+  {
+    const size_t num_of_dirs = num_of_directions(bundle_template, mode);
 
-      auto coefficients
-          = processor.get_direction_bounds(_alpha, direction, _minmax_finder);
+    if (directions_per_task == 0 || directions_per_task >= num_of_dirs) {
+      return process_template(bundle_template, mode, cache);
+    }
 
-      _lower_bound[direction_index].update(coefficients.first);
-      _upper_bound[direction_index].update(coefficients.second);
+    auto processor = std::make_shared<ParallelotopeProcessor>(
+        *this, bundle_template, cache);
+
+    auto process_block = [this, processor, &bundle_template,
+                          mode](const size_t first, const size_t last) {
+      process_directions(*processor, bundle_template, mode, first, last);
+    };
+
+    for (size_t first = directions_per_task; first < num_of_dirs;
+         first += directions_per_task) {
+      const size_t last = std::min(first + directions_per_task, num_of_dirs);
+
+      thread_pool.submit_to_batch(batch_id, process_block, first, last);
     }
 
+    // if this block throws, the submitted blocks are still drained
+    // by the batch joiner before the exception leaves the batch
+    process_block(0, directions_per_task);
+
     return *this;
   }
+#endif // WITH_THREADS
 
   /**
    * @brief Get the bundle image upper bounds
@@ -1290,36 +1586,49 @@ Bundle Evolver<double>::operator()(const Bundle &bundle,
 
   auto new_directions = compute_new_directions(bundle, _ds, parameter_set);
 
-  BoundRefiner bound_refiner(bundle, _ds, parameter_set, new_directions);
-
-  auto refine_bounds
-      = [&bound_refiner](Evolver<double> *evolver,
-                         const BundleTemplate &bundle_template) {
-          bound_refiner.process_template(bundle_template, evolver->mode,
-                                         evolver->_cache);
-        };
+  BoundRefiner bound_refiner(bundle, _ds, _dynamics, parameter_set,
+                             new_directions, _dense_tensor_bounds,
+                             use_expression_arenas);
 
   try {
 #ifdef WITH_THREADS
     ThreadPool::BatchId batch_id = thread_pool.create_batch();
 
-    for (auto t_it = std::begin(bundle.templates());
-         t_it != std::end(bundle.templates()); ++t_it) {
+    // every template task may split its directions in blocks and
+    // submit them to the same batch
+    auto refine_bounds
+        = [&bound_refiner, &batch_id](Evolver<double> *evolver,
+                                      const BundleTemplate &bundle_template) {
+            bound_refiner.process_template(bundle_template, evolver->mode,
+                                           evolver->_cache, batch_id,
+                                           evolver->directions_per_task);
+          };
+
+    try {
+      for (auto t_it = std::begin(bundle.templates());
+           t_it != std::end(bundle.templates()); ++t_it) {
+
+        // submit the task to the thread pool
+        thread_pool.submit_to_batch(batch_id, refine_bounds, this,
+                                    std::ref(*t_it));
+      }
 
-      // submit the task to the thread pool
-      thread_pool.submit_to_batch(batch_id, refine_bounds, this,
-                                  std::ref(*t_it));
-    }
+      // join to the pool threads
+      thread_pool.join_threads(batch_id);
+    } catch (...) {
+      // the batch tasks refer to this frame: the batch must be
+      // drained and closed before leaving it
+      thread_pool.close_batch(batch_id);
 
-    // join to the pool threads
-    thread_pool.join_threads(batch_id);
+      throw;
+    }
 
     // close the batch
     thread_pool.close_batch(batch_id);
 #else  // WITH_THREADS
     for (auto t_it = std::begin(bundle.templates());
          t_it != std::end(bundle.templates()); ++t_it) {
-      refine_bounds(this, std::ref(*t_it));
+      bound_refiner.process_template(*t_it, this->mode, this->_cache);
     }
 #endif // WITH_THREADS
   } catch (SymbolicAlgebra::symbol_evaluation_error &e) {
@@ -1380,6 +1689,7 @@ SetsUnion<Polytope> synthesize(const Evolver<double> &evolver,
   SetsUnion<Polytope> result = parameter_set;
 
   std::vector<Symbol<>> alpha = get_symbol_vector<double>("f", bundle.dim());
+  const ExpressionDAG<double> &dynamics = evolver.dynamics_graph();
 
   for (auto t_it = std::begin(bundle.templates());
        t_it != std::end(bundle.templates());
@@ -1388,7 +1698,7 @@ SetsUnion<Polytope> synthesize(const Evolver<double> &evolver,
     Parallelotope P = bundle.get_parallelotope(*t_it);
     std::vector<Expression<>> genFun = build_generator_functions(alpha, P);
 
-    const auto fog = replace_in(ds.dynamics(), ds.variables(), genFun);
+    const auto fog = replace_in(dynamics, ds.variables(), genFun);
 
     // compose sigma(f(gamma(x)))
     Expression<>::replacement_type repl;
@@ -0,0 +1,322 @@
+/**
+ * @file LinearAlgebraKernels.cpp
+ * @author Alberto Casagrande <acasagrande@units.it>
+ * @brief Vectorized kernels for `double` linear algebra
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#include <atomic>
+#include <initializer_list>
+
+#include "LinearAlgebraKernels.h"
+
+#if (defined(__x86_64__) || defined(__i386__))                               \
+    && (defined(__GNUC__) || defined(__clang__))
+#define SAPO_X86_KERNELS //!< This macro enables the AVX kernels
+
+#include <immintrin.h>
+#endif
+
+namespace LinearAlgebra
+{
+
+namespace Kernels
+{
+
+/**
+ * @brief A table of kernel implementations
+ */
+struct KernelTable {
+  InstructionSet instruction_set; //!< the instruction set of the kernels
+  double (*dot)(const double *, const double *, const size_t); //!< dot
+  void (*axpy)(const double, const double *, double *,
+               const size_t); //!< axpy
+  void (*eliminate)(double *, const double *, const double, const double,
+                    const size_t); //!< row elimination
+};
+
+#ifdef SAPO_X86_KERNELS
+
+/// @private
+__attribute__((target("avx2"))) static double
+dot_avx2(const double *a, const double *b, const size_t size)
+{
+  __m256d sums = _mm256_setzero_pd();
+
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    const __m256d products
+        = _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+    sums = _mm256_add_pd(sums, products);
+  }
+
+  // (s0 + s2, s1 + s3)
+  const __m128d pairs = _mm_add_pd(_mm256_castpd256_pd128(sums),
+                                   _mm256_extractf128_pd(sums, 1));
+
+  double res
+      = _mm_cvtsd_f64(_mm_add_sd(pairs, _mm_unpackhi_pd(pairs, pairs)));
+  for (; i < size; ++i) {
+    res += a[i] * b[i];
+  }
+
+  return res;
+}
+
+/// @private
+__attribute__((target("avx2"))) static void
+axpy_avx2(const double alpha, const double *x, double *y, const size_t size)
+{
+  const __m256d a = _mm256_set1_pd(alpha);
+
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    const __m256d scaled = _mm256_mul_pd(a, _mm256_loadu_pd(x + i));
+    _mm256_storeu_pd(y + i, _mm256_add_pd(_mm256_loadu_pd(y + i), scaled));
+  }
+
+  scalar_axpy(alpha, x + i, y + i, size - i);
+}
+
+/// @private
+__attribute__((target("avx2"))) static void
+eliminate_avx2(double *row, const double *pivot_row, const double coeff,
+               const double pivot_value, const size_t size)
+{
+  const __m256d c = _mm256_set1_pd(coeff);
+  const __m256d p = _mm256_set1_pd(pivot_value);
+
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    const __m256d r = _mm256_loadu_pd(row + i);
+    const __m256d term = _mm256_mul_pd(c, _mm256_loadu_pd(pivot_row + i));
+    const __m256d cancel
+        = _mm256_cmp_pd(_mm256_mul_pd(r, p), term, _CMP_EQ_OQ);
+    const __m256d res = _mm256_sub_pd(r, _mm256_div_pd(term, p));
+
+    _mm256_storeu_pd(row + i, _mm256_andnot_pd(cancel, res));
+  }
+
+  scalar_eliminate(row + i, pivot_row + i, coeff, pivot_value, size - i);
+}
+
+/// @private
+__attribute__((target("avx512f"))) static void
+axpy_avx512(const double alpha, const double *x, double *y, const size_t size)
+{
+  const __m512d a = _mm512_set1_pd(alpha);
+
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const __m512d scaled = _mm512_mul_pd(a, _mm512_loadu_pd(x + i));
+    _mm512_storeu_pd(y + i, _mm512_add_pd(_mm512_loadu_pd(y + i), scaled));
+  }
+
+  // masked loads and stores are slow on short tails
+  axpy_avx2(alpha, x + i, y + i, size - i);
+}
+
+/// @private
+__attribute__((target("avx512f"))) static void
+eliminate_avx512(double *row, const double *pivot_row, const double coeff,
+                 const double pivot_value, const size_t size)
+{
+  const __m512d c = _mm512_set1_pd(coeff);
+  const __m512d p = _mm512_set1_pd(pivot_value);
+
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const __m512d r = _mm512_loadu_pd(row + i);
+    const __m512d term = _mm512_mul_pd(c, _mm512_loadu_pd(pivot_row + i));
+    const __mmask8 cancel
+        = _mm512_cmp_pd_mask(_mm512_mul_pd(r, p), term, _CMP_EQ_OQ);
+    const __m512d res = _mm512_sub_pd(r, _mm512_div_pd(term, p));
+
+    // the cancelled lanes are set to 0
+    _mm512_storeu_pd(row + i,
+                     _mm512_maskz_mov_pd(static_cast<__mmask8>(~cancel), res));
+  }
+
+  eliminate_avx2(row + i, pivot_row + i, coeff, pivot_value, size - i);
+}
+
+#endif // SAPO_X86_KERNELS
+
+/// @private
+static const KernelTable scalar_kernels{InstructionSet::SCALAR, scalar_dot,
+                                        scalar_axpy, scalar_eliminate};
+
+#ifdef SAPO_X86_KERNELS
+/// @private
+static const KernelTable avx2_kernels{InstructionSet::AVX2, dot_avx2,
+                                      axpy_avx2, eliminate_avx2};
+
+// the AVX-512 dot product uses 256-bit registers to preserve the
+// order of the sums of the other implementations
+
+/// @private
+static const KernelTable avx512_kernels{InstructionSet::AVX512, dot_avx2,
+                                        axpy_avx512, eliminate_avx512};
+#endif // SAPO_X86_KERNELS
+
+bool is_supported(const InstructionSet instruction_set)
+{
+  switch (instruction_set) {
+  case InstructionSet::SCALAR:
+    return true;
+#ifdef SAPO_X86_KERNELS
+  case InstructionSet::AVX2:
+    return __builtin_cpu_supports("avx2");
+  case InstructionSet::AVX512:
+    return __builtin_cpu_supports("avx512f");
+#endif // SAPO_X86_KERNELS
+  default:
+    return false;
+  }
+}
+
+/**
+ * @brief Get the kernel table of an instruction set
+ *
+ * @param instruction_set is an instruction set
+ * @return the kernel table of `instruction_set`
+ */
+static const KernelTable *get_kernels(const InstructionSet instruction_set)
+{
+  switch (instruction_set) {
+#ifdef SAPO_X86_KERNELS
+  case InstructionSet::AVX2:
+    return &avx2_kernels;
+  case InstructionSet::AVX512:
+    return &avx512_kernels;
+#endif // SAPO_X86_KERNELS
+  default:
+    return &scalar_kernels;
+  }
+}
+
+/**
+ * @brief Get the kernel table of the most recent supported instruction set
+ *
+ * @return the kernel table of the most recent instruction set supported
+ *         by the CPU
+ */
+static const KernelTable *get_best_kernels()
+{
+  for (const auto &instruction_set:
+       {InstructionSet::AVX512, InstructionSet::AVX2}) {
+    if (is_supported(instruction_set)) {
+      return get_kernels(instruction_set);
+    }
+  }
+
+  return &scalar_kernels;
+}
+
+static const KernelTable *resolve();
+
+/// @private
+static double dot_resolve(const double *a, const double *b, const size_t size)
+{
+  return resolve()->dot(a, b, size);
+}
+
+/// @private
+static void axpy_resolve(const double alpha, const double *x, double *y,
+                         const size_t size)
+{
+  resolve()->axpy(alpha, x, y, size);
+}
+
+/// @private
+static void eliminate_resolve(double *row, const double *pivot_row,
+                              const double coeff, const double pivot_value,
+                              const size_t size)
+{
+  resolve()->eliminate(row, pivot_row, coeff, pivot_value, size);
+}
+
+/**
+ * @brief The kernel table selecting the implementation on the first call
+ *
+ * The kernels may be called during the dynamic initialization of
+ * other translation units. Hence, the selected table is statically
+ * initialized to this table, whose kernels resolve the best
+ * implementation, store it, and forward the call.
+ */
+static const KernelTable resolving_kernels{InstructionSet::SCALAR,
+                                           dot_resolve, axpy_resolve,
+                                           eliminate_resolve};
+
+/// @private
+static std::atomic<const KernelTable *> selected_kernels{&resolving_kernels};
+
+/**
+ * @brief Select the best kernel table, unless one has already been selected
+ *
+ * @return the selected kernel table
+ */
+static const KernelTable *resolve()
+{
+  const KernelTable *expected = &resolving_kernels;
+
+  selected_kernels.compare_exchange_strong(expected, get_best_kernels());
+
+  return selected_kernels.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Get the selected kernel table
+ *
+ * @return the selected kernel table
+ */
+static inline const KernelTable *kernels()
+{
+  return selected_kernels.load(std::memory_order_relaxed);
+}
+
+InstructionSet instruction_set()
+{
+  const KernelTable *table = kernels();
+  if (table == &resolving_kernels) {
+    table = resolve();
+  }
+
+  return table->instruction_set;
+}
+
+bool select(const InstructionSet instruction_set)
+{
+  if (!is_supported(instruction_set)) {
+    return false;
+  }
+
+  selected_kernels.store(get_kernels(instruction_set));
+
+  return true;
+}
+
+double dispatched_dot(const double *a, const double *b, const size_t size)
+{
+  return kernels()->dot(a, b, size);
+}
+
+void dispatched_axpy(const double alpha, const double *x, double *y,
+                     const size_t size)
+{
+  kernels()->axpy(alpha, x, y, size);
+}
+
+void dispatched_eliminate(double *row, const double *pivot_row,
+                          const double coeff, const double pivot_value,
+                          const size_t size)
+{
+  kernels()->eliminate(row, pivot_row, coeff, pivot_value, size);
+}
+
+} // namespace Kernels
+
+} // namespace LinearAlgebra
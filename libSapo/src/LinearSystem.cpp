@@ -13,12 +13,32 @@
 #include <limits>
 #include <cmath>
 #include <sstream>
+#include <unordered_map>
+
+#ifdef WITH_THREADS
+#include "SapoThreads.h"
+#endif // WITH_THREADS
 
 #include "LinearSystem.h"
 #include "SymbolicAlgebra.h"
 #include "LinearAlgebraIO.h"
 #include "ErrorHandling.h"
 
+#ifdef WITH_REVISED_SIMPLEX
+/**
+ * @brief The optimizer of single linear problems
+ *
+ * The revised simplex method never updates the whole tableau.
+ * `SimplexMethodOptimizer` is kept for validation.
+ */
+typedef RevisedSimplexMethodOptimizer LinearOptimizer;
+#else
+/**
+ * @brief The optimizer of single linear problems
+ */
+typedef SimplexMethodOptimizer LinearOptimizer;
+#endif // WITH_REVISED_SIMPLEX
+
 /**
  * @brief Print a linear system in a stream
  *
@@ -60,7 +80,7 @@ OptimizationResult<double>
 LinearSystem::optimize(const LinearAlgebra::Vector<double> &obj_fun,
                        const bool maximize) const
 {
-  SimplexMethodOptimizer optimizer;
+  LinearOptimizer optimizer;
 
   return optimizer(this->_A, this->_b, obj_fun,
                    (maximize ? MAXIMIZE : MINIMIZE));
@@ -135,7 +155,7 @@ bool have_disjoint_solutions(const LinearSystem &ls1, const LinearSystem &ls2)
   b.reserve(ls1.size() + ls2.size());
   std::copy(std::begin(ls2.b()), std::end(ls2.b()), std::back_inserter(b));
 
-  SimplexMethodOptimizer optimizer;
+  LinearOptimizer optimizer;
 
   auto result = optimizer(A, b, obj);
 
@@ -151,7 +171,7 @@ bool have_disjoint_solutions(const LinearSystem &ls1, const LinearSystem &ls2)
 OptimizationResult<double>
 LinearSystem::minimize(const LinearAlgebra::Vector<double> &obj_fun) const
 {
-  SimplexMethodOptimizer optimizer;
+  LinearOptimizer optimizer;
 
   return optimizer(this->_A, this->_b, obj_fun);
 }
@@ -165,7 +185,7 @@ LinearSystem::minimize(const LinearAlgebra::Vector<double> &obj_fun) const
 OptimizationResult<double>
 LinearSystem::maximize(const LinearAlgebra::Vector<double> &obj_fun) const
 {
-  SimplexMethodOptimizer optimizer;
+  LinearOptimizer optimizer;
 
   return optimizer(this->_A, this->_b, obj_fun, MAXIMIZE);
 }
@@ -419,12 +439,13 @@ bool LinearSystem::has_solutions(const bool strict_inequality) const
     return res.status() != res.INFEASIBLE;
   }
 
-  for (auto row_it = std::begin(_A); row_it != std::end(_A); ++row_it) {
-    OptimizationResult<double> res = maximize(*row_it);
+  auto optimizer = this->optimizer(_A);
+  for (size_t i = 0; i < _A.size(); ++i) {
+    OptimizationResult<double> res = optimizer.maximize(i);
     if (res.status() == res.INFEASIBLE) {
       return false;
     }
-    OptimizationResult<double> res2 = minimize(*row_it);
+    OptimizationResult<double> res2 = optimizer.minimize(i);
     if (res.status() == res.INFEASIBLE) {
       return false;
     }
@@ -540,14 +561,55 @@ bool LinearSystem::satisfies(const LinearAlgebra::Vector<double> &Ai,
   return false;
 }
 
+/**
+ * @brief Test whether a system has a row that implies a constraint
+ *
+ * @param ls is a linear system
+ * @param Ai is the constraint coefficient vector
+ * @param bi is the constraint known term
+ * @return `true` if and only if `ls` has a row \f$A_j \cdot x \leq b_j\f$
+ *         such that \f$A_j = \texttt{Ai}\f$ and \f$b_j \leq \texttt{bi}\f$
+ */
+bool has_an_implying_row(const LinearSystem &ls,
+                         const LinearAlgebra::Vector<double> &Ai,
+                         const double &bi)
+{
+  for (unsigned int j = 0; j < ls.size(); ++j) {
+    if (ls.b(j) <= bi && ls.A(j) == Ai) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 bool LinearSystem::satisfies(const LinearSystem &ls) const
 {
-  if (!this->has_solutions()) {
+  // the rows of `ls` that are not trivially implied by this system
+  std::vector<unsigned int> uncertain;
+  std::vector<LinearAlgebra::Vector<double>> uncertain_rows;
+  for (unsigned int i = 0; i < ls.size(); i++) {
+    if (!has_an_implying_row(*this, ls._A[i], ls._b[i])) {
+      uncertain.push_back(i);
+      uncertain_rows.push_back(ls._A[i]);
+    }
+  }
+
+  if (size() != 0 && uncertain.size() == 0) {
     return true;
   }
 
-  for (unsigned int i = 0; i < ls.size(); i++) {
-    if (!this->satisfies(ls._A[i], ls._b[i])) {
+  auto optimizer = this->optimizer(uncertain_rows);
+  if (size() != 0 && optimizer.feasible_set_is_empty()) {
+    return true;
+  }
+
+  // see `LinearSystem::satisfies(const LinearAlgebra::Vector<double> &,
+  // const double &)`
+  for (unsigned int i = 0; i < uncertain.size(); i++) {
+    OptimizationResult<double> res = optimizer.maximize(i);
+    if (res.status() != res.OPTIMUM_AVAILABLE
+        || res.objective_value() > ls._b[uncertain[i]]) {
       return false;
     }
   }
@@ -575,6 +637,190 @@ bool LinearSystem::constraint_is_redundant(const unsigned int i) const
   return result;
 }
 
+/**
+ * @brief Normalize the direction of a constraint
+ *
+ * This function divides the coefficients of a constraint by the
+ * maximum of their absolute values. Two rows that are one the
+ * multiple of the other by an exactly representable factor share
+ * the same normalized direction, because the correctly rounded
+ * quotients coincide.
+ *
+ * @param Ai is the constraint coefficient vector
+ * @param bi is the constraint known term
+ * @param direction is the normalized direction
+ * @param value is the normalized known term
+ * @return `false` if and only if `Ai` is the null vector
+ */
+static bool normalize_constraint(const LinearAlgebra::Vector<double> &Ai,
+                                 const double &bi,
+                                 LinearAlgebra::Vector<double> &direction,
+                                 double &value)
+{
+  const double scale = LinearAlgebra::norm_infinity(Ai);
+  if (scale == 0) {
+    return false;
+  }
+
+  direction.resize(Ai.size());
+  for (size_t j = 0; j < Ai.size(); ++j) {
+    direction[j] = Ai[j] / scale;
+  }
+  value = bi / scale;
+
+  return true;
+}
+
+/**
+ * @brief Hash a normalized direction
+ *
+ * @param direction is a normalized direction
+ * @return the hash value of `direction`
+ */
+static size_t hash_direction(const LinearAlgebra::Vector<double> &direction)
+{
+  std::hash<double> hasher;
+
+  size_t seed = direction.size();
+  for (const double &value: direction) {
+    // avoid distinguishing between 0 and -0
+    seed ^= hasher(value + 0.0) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  }
+
+  return seed;
+}
+
+void LinearSystem::remove_implied_parallel_rows()
+{
+  std::vector<bool> removed(size(), false);
+
+  // the rows having the same normalized direction are
+  // grouped by the hash value of the direction
+  std::unordered_map<size_t, std::vector<unsigned int>> groups;
+  std::vector<LinearAlgebra::Vector<double>> directions(size());
+  LinearAlgebra::Vector<double> values(size());
+
+  for (unsigned int i = 0; i < size(); ++i) {
+    if (!normalize_constraint(_A[i], _b[i], directions[i], values[i])) {
+      // the constraint `0 <= b_i` is either implied by any
+      // other constraint or it makes the system unfeasible
+      removed[i] = (_b[i] >= 0);
+
+      continue;
+    }
+
+    auto &group = groups[hash_direction(directions[i])];
+
+    // search for a row having the same normalized direction
+    auto it = std::begin(group);
+    while (it != std::end(group) && directions[*it] != directions[i]) {
+      ++it;
+    }
+
+    if (it == std::end(group)) {
+      group.push_back(i);
+    } else {
+      // keep the tightest of the two rows
+      if (values[i] < values[*it]) {
+        removed[*it] = true;
+        *it = i;
+      } else {
+        removed[i] = true;
+      }
+    }
+  }
+
+  remove_rows(removed);
+}
+
+void LinearSystem::remove_rows(const std::vector<bool> &removed)
+{
+  unsigned int last = 0;
+  for (unsigned int i = 0; i < size(); ++i) {
+    if (!removed[i]) {
+      if (last != i) {
+        std::swap(_A[last], _A[i]);
+        std::swap(_b[last], _b[i]);
+      }
+      ++last;
+    }
+  }
+
+  _A.resize(last);
+  _b.resize(last);
+}
+
+/**
+ * @brief Apply a function to all the indices in an interval
+ *
+ * When the threads are enabled, this function splits the interval
+ * in blocks, one per pool thread plus one for the calling thread,
+ * and processes them in a thread pool batch. The function must be
+ * safe to be called concurrently on different indices.
+ *
+ * @tparam FUNCTION is the type of the function
+ * @param size is the number of indices
+ * @param process_block is a function processing the indices in the
+ *        interval `[first, last)` when called as
+ *        `process_block(first, last)`
+ */
+template<typename FUNCTION>
+static void for_each_block(const size_t size, FUNCTION process_block)
+{
+#ifdef WITH_THREADS
+  const size_t num_of_blocks = std::min(thread_pool.num_of_threads() + 1,
+                                        size);
+
+  if (num_of_blocks < 2) {
+    process_block(0, size);
+
+    return;
+  }
+
+  const size_t block_size = (size + num_of_blocks - 1) / num_of_blocks;
+
+  ThreadPool::BatchId batch_id = thread_pool.create_batch();
+
+  try {
+    for (size_t first = block_size; first < size; first += block_size) {
+      const size_t last = std::min(first + block_size, size);
+
+      thread_pool.submit_to_batch(batch_id, process_block, first, last);
+    }
+
+    // the calling thread processes the first block
+    process_block(0, block_size);
+
+    thread_pool.join_threads(batch_id);
+  } catch (...) {
+    // the queued blocks refer to this frame: the batch must be
+    // drained and closed before leaving it
+    thread_pool.close_batch(batch_id);
+
+    throw;
+  }
+
+  thread_pool.close_batch(batch_id);
+#else  // WITH_THREADS
+  process_block(0, size);
+#endif // WITH_THREADS
+}
+
+/**
+ * @brief Get the margin below which a constraint is certainly not tight
+ *
+ * @param bi is the constraint known term
+ * @return a non-negative margin for the rounding errors in the
+ *         maximum of the constraint direction
+ */
+static inline double tightness_margin(const double &bi)
+{
+  static const double eps
+      = std::sqrt(std::numeric_limits<double>::epsilon());
+
+  return eps * (1 + std::abs(bi));
+}
+
 /**
  * Remove redundant constraints from a linear system
  *
@@ -582,37 +828,146 @@ bool LinearSystem::constraint_is_redundant(const unsigned int i) const
  * The order of the non-redundant constraints can be shuffled after
  * the call.
  *
+ * The method proceeds in four phases:
+ * 1. the rows that are implied by a parallel row, or that are
+ *    trivially satisfied, are removed without solving any linear
+ *    problem;
+ * 2. all the row directions are maximized over the system by
+ *    sharing a single bootstrap phase. A row whose maximum is
+ *    strictly smaller than its known term is never tight and
+ *    it can be removed together with all the other rows of the
+ *    same kind;
+ * 3. the redundancy of the remaining rows is tested one row
+ *    at a time, in parallel, against all the other rows;
+ * 4. the rows found redundant in the previous phase may depend
+ *    one on the other, e.g., when the solution set has an empty
+ *    interior. A single batch of optimizations, sharing its
+ *    bootstrap phase, verifies that the system deprived of all
+ *    of them still implies each of them. Should this not be the
+ *    case, they are tested again one after the other.
+ *
  * @return A reference to this object after removing all the
  *         redundant constraints
  */
 LinearSystem &LinearSystem::simplify()
 {
-  unsigned int i = 0;
-  unsigned int last_index = size() - 1;
+  remove_implied_parallel_rows();
+
+  if (size() < 2) {
+    return *this;
+  }
+
+  std::vector<bool> removed(size(), false);
+
+  // phase 2: maximize all the row directions from a shared bootstrap
+  const auto shared = optimizer(_A);
+  if (shared.feasible_set_is_empty()) {
+    // the redundancy of the rows in an unfeasible system depends
+    // on the order in which they are removed: test them one by one
+    for (unsigned int i = 0; i < size(); ++i) {
+      if (constraint_is_redundant(i)) {
+        removed[i] = true;
 
-  while (i < last_index) { // for every unchecked constraint
-    // if it is redundant
-    if (constraint_is_redundant(i)) {
-      // swap it with the last constraint
-      std::swap(_A[i], _A[last_index]);
-      std::swap(_b[i], _b[last_index]);
+        // the null constraint `0 <= 0` is neutral
+        _A[i] = LinearAlgebra::Vector<double>(dim(), 0);
+        _b[i] = 0;
+      }
+    }
+    remove_rows(removed);
+
+    return *this;
+  }
 
-      // remove the redundant constraint
-      _A.resize(last_index);
-      _b.resize(last_index);
+  // `std::vector<bool>` elements cannot be concurrently written
+  std::vector<char> never_tight(size(), false);
+  for_each_block(size(), [this, &shared, &never_tight](const size_t first,
+                                                       const size_t last) {
+    // every block restarts from a copy of the bootstrapped tableau
+    auto local_optimizer = shared;
+    for (size_t i = first; i < last; ++i) {
+      const auto res = local_optimizer.maximize(i);
 
-      --last_index;
-    } else { // otherwise, i.e. if it is not redundant
+      never_tight[i] = (res.status() == res.OPTIMUM_AVAILABLE
+                        && res.objective_value()
+                               < _b[i] - tightness_margin(_b[i]));
+    }
+  });
 
-      // increase the index of the next constraint to be checked
-      i++;
+  // phase 3: test the redundancy of the rows that may be tight
+  std::vector<unsigned int> uncertain;
+  for (unsigned int i = 0; i < size(); ++i) {
+    if (!never_tight[i]) {
+      uncertain.push_back(i);
     }
   }
 
-  if (constraint_is_redundant(last_index)) {
-    _A.resize(last_index);
-    _b.resize(last_index);
+  std::vector<char> redundant(uncertain.size(), false);
+  for_each_block(uncertain.size(), [this, &uncertain, &redundant](
+                                       const size_t first, const size_t last) {
+    for (size_t k = first; k < last; ++k) {
+      redundant[k] = constraint_is_redundant(uncertain[k]);
+    }
+  });
+
+  // phase 4: remove the never-tight rows and verify that
+  //          the candidates are implied by the remaining rows
+  std::vector<unsigned int> candidates;
+  for (unsigned int i = 0; i < size(); ++i) {
+    removed[i] = never_tight[i];
   }
+  for (size_t k = 0; k < uncertain.size(); ++k) {
+    if (redundant[k]) {
+      candidates.push_back(uncertain[k]);
+    }
+  }
+
+  if (candidates.size() > 0) {
+    LinearSystem reduced(*this);
+    std::vector<LinearAlgebra::Vector<double>> candidate_rows;
+    for (unsigned int i = 0; i < size(); ++i) {
+      if (never_tight[i]) {
+        reduced._A[i] = LinearAlgebra::Vector<double>(dim(), 0);
+        reduced._b[i] = 0;
+      }
+    }
+    for (const unsigned int &i: candidates) {
+      candidate_rows.push_back(_A[i]);
+      reduced._A[i] = LinearAlgebra::Vector<double>(dim(), 0);
+      reduced._b[i] = 0;
+    }
+
+    auto verifier = reduced.optimizer(candidate_rows);
+    bool all_implied = !verifier.feasible_set_is_empty();
+    for (size_t k = 0; all_implied && k < candidates.size(); ++k) {
+      const auto res = verifier.maximize(k);
+      all_implied = (res.status() == res.OPTIMUM_AVAILABLE
+                     && res.objective_value() <= _b[candidates[k]]);
+    }
+
+    if (all_implied) {
+      for (const unsigned int &i: candidates) {
+        removed[i] = true;
+      }
+    } else {
+      // remove the never-tight rows and test the candidates again
+      // one by one
+      for (unsigned int i = 0; i < size(); ++i) {
+        if (never_tight[i]) {
+          _A[i] = LinearAlgebra::Vector<double>(dim(), 0);
+          _b[i] = 0;
+        }
+      }
+      for (const unsigned int &i: candidates) {
+        if (constraint_is_redundant(i)) {
+          removed[i] = true;
+          _A[i] = LinearAlgebra::Vector<double>(dim(), 0);
+          _b[i] = 0;
+        }
+      }
+    }
+  }
+
+  remove_rows(removed);
 
   return *this;
 }
@@ -9,6 +9,11 @@
  * @copyright Copyright (c) 2021-2022
  */
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric> // iota
+
 #include "Polytope.h"
 #include "PolytopesUnion.h"
 
@@ -161,13 +166,20 @@ Polytope &Polytope::intersect_with(const Polytope &P)
                std::domain_error);
   }
 
+  bool changed = false;
   for (unsigned int i = 0; i < P.size(); i++) {
     if (!this->satisfies(P._A[i], P._b[i])) {
       (this->_A).push_back(P._A[i]);
       (this->_b).push_back(P._b[i]);
+
+      changed = true;
     }
   }
 
+  if (changed) {
+    forget_non_emptiness();
+  }
+
   return *this;
 }
 
@@ -177,9 +189,90 @@ Polytope &Polytope::expand_by(const double delta)
     _b[i] += delta * LinearAlgebra::norm_2(_A[i]);
   }
 
+  // a non-empty polytope that grows includes its witness
+  const auto properties = _memo.get();
+  if (delta >= 0 && properties && !properties->is_empty) {
+    auto witness = properties->witness;
+    _memo.set_non_empty(std::move(witness));
+    _memo.forget_bounding_box();
+  } else {
+    _memo.forget();
+  }
+
   return *this;
 }
 
+bool Polytope::establish_emptiness() const
+{
+  if (this->size() == 0) {
+    _memo.set_non_empty(LinearAlgebra::Vector<double>());
+
+    return false;
+  }
+
+  OptimizationResult<double> res = maximize(_A[0]);
+  if (res.status() == res.INFEASIBLE) {
+    _memo.set_empty();
+
+    return true;
+  }
+
+  if (res.status() == res.OPTIMUM_AVAILABLE) {
+    _memo.set_non_empty(LinearAlgebra::Vector<double>(res.optimum()));
+  } else {
+    _memo.set_non_empty(LinearAlgebra::Vector<double>());
+  }
+
+  return false;
+}
+
+bool Polytope::is_subset_of(const Polytope &P) const
+{
+  using namespace LinearAlgebra;
+
+  const auto properties = _memo.get();
+  if (properties) {
+    // empty polytopes are subsets of any polytope
+    if (properties->is_empty) {
+      return true;
+    }
+
+    // a point of this polytope is not a proof of non-inclusion
+    // because of the rounding errors of the LP solver that found it.
+    // However, the constraints of `P` that it violates are the
+    // most likely to fail: check them first
+    if (properties->witness.size() == dim()) {
+      std::vector<double> excess(P.size());
+      for (size_t i = 0; i < P.size(); ++i) {
+        excess[i] = P._A[i] * properties->witness - P._b[i];
+      }
+
+      if (std::any_of(std::begin(excess), std::end(excess),
+                      [](const double &value) { return value > 0; })) {
+        std::vector<size_t> order(P.size());
+        std::iota(std::begin(order), std::end(order), 0);
+        std::stable_sort(std::begin(order), std::end(order),
+                         [&excess](const size_t &i, const size_t &j) {
+                           return excess[i] > excess[j];
+                         });
+
+        std::vector<Vector<double>> A;
+        Vector<double> b;
+        A.reserve(P.size());
+        b.reserve(P.size());
+        for (const size_t &i: order) {
+          A.push_back(P._A[i]);
+          b.push_back(P._b[i]);
+        }
+
+        return this->satisfies(LinearSystem(std::move(A), std::move(b)));
+      }
+    }
+  }
+
+  return this->satisfies(P);
+}
+
 Polytope intersect(const Polytope &P1, const Polytope &P2)
 {
   Polytope result(P1._A, P1._b);
@@ -200,18 +293,79 @@ double Polytope::bounding_box_volume() const
   std::vector<double> zeros(this->dim(), 0);
   double vol = 1;
 
+  // the facets e_i and -e_i are stored at positions 2*i and 2*i+1
+  std::vector<std::vector<double>> facets;
+  for (unsigned int i = 0; i < this->dim(); i++) {
+    facets.push_back(zeros);
+    facets.back()[i] = 1;
+    facets.push_back(zeros);
+    facets.back()[i] = -1;
+  }
+
+  auto optimizer = this->optimizer(facets);
   for (unsigned int i = 0; i < this->dim(); i++) {
-    std::vector<double> facet = zeros;
-    facet[i] = 1;
-    const double b_plus = maximize(facet).objective_value();
-    facet[i] = -1;
-    const double b_minus = minimize(facet).objective_value();
+    const double b_plus = optimizer.maximize(2 * i).objective_value();
+    const double b_minus = optimizer.minimize(2 * i + 1).objective_value();
     vol = vol * (b_plus + b_minus);
   }
 
   return vol;
 }
 
+BoundingBox Polytope::bounding_box() const
+{
+  const auto memoized = _memo.bounding_box();
+  if (memoized) {
+    return *memoized;
+  }
+
+  // the relative enlargement that accounts for rounding errors
+  const double margin = std::sqrt(std::numeric_limits<double>::epsilon());
+
+  std::vector<LinearAlgebra::Vector<double>> axes(
+      this->dim(), LinearAlgebra::Vector<double>(this->dim(), 0));
+  for (unsigned int i = 0; i < this->dim(); i++) {
+    axes[i][i] = 1;
+  }
+
+  LinearAlgebra::Vector<double> lower(this->dim()), upper(this->dim());
+
+  auto optimizer = this->optimizer(axes);
+  for (unsigned int i = 0; i < this->dim(); i++) {
+    const auto min_res = optimizer.minimize(i);
+    const auto max_res = optimizer.maximize(i);
+
+    if (min_res.status() == OptimizationResult<double>::INFEASIBLE) {
+      // the polytope is empty
+      const double inf = std::numeric_limits<double>::infinity();
+
+      BoundingBox box(LinearAlgebra::Vector<double>(this->dim(), inf),
+                      LinearAlgebra::Vector<double>(this->dim(), -inf));
+      _memo.set_bounding_box(BoundingBox(box));
+
+      return box;
+    }
+
+    lower[i] = (min_res.status() == OptimizationResult<double>::UNBOUNDED
+                    ? -std::numeric_limits<double>::infinity()
+                    : min_res.objective_value());
+    upper[i] = (max_res.status() == OptimizationResult<double>::UNBOUNDED
+                    ? std::numeric_limits<double>::infinity()
+                    : max_res.objective_value());
+
+    // enlarge the box to account for rounding errors
+    const double delta
+        = margin * (1 + std::max(std::abs(lower[i]), std::abs(upper[i])));
+    lower[i] -= delta;
+    upper[i] += delta;
+  }
+
+  BoundingBox box(std::move(lower), std::move(upper));
+  _memo.set_bounding_box(BoundingBox(box));
+
+  return box;
+}
+
 Polytope over_approximate_union(const Polytope &P1, const Polytope &P2)
 {
   using namespace LinearAlgebra;
@@ -236,14 +390,18 @@ Polytope over_approximate_union(const Polytope &P1, const Polytope &P2)
   A.reserve(P1.size() + P2.size());
   b.reserve(P1.size() + P2.size());
 
+  auto P2_optimizer = P2.optimizer(P1._A);
   for (unsigned int i = 0; i < P1.size(); ++i) {
     A.push_back(P1._A[i]);
-    b.push_back(std::max(P2.maximize(A.back()).objective_value(), P1._b[i]));
+    b.push_back(std::max(P2_optimizer.maximize(i).objective_value(),
+                         P1._b[i]));
   }
 
+  auto P1_optimizer = P1.optimizer(P2._A);
   for (unsigned int i = 0; i < P2.size(); ++i) {
     A.push_back(P2._A[i]);
-    b.push_back(std::max(P1.maximize(A.back()).objective_value(), P2._b[i]));
+    b.push_back(std::max(P1_optimizer.maximize(i).objective_value(),
+                         P2._b[i]));
   }
 
   Polytope res(std::move(A), std::move(b));
@@ -277,8 +435,9 @@ SetsUnion<Polytope> subtract_and_close(const Polytope &P1, const Polytope &P2)
     return su;
   }
 
+  auto optimizer = P1.optimizer(P2.A());
   for (unsigned int i = 0; i < P2.size(); ++i) {
-    auto min = P1.minimize(P2.A(i)).objective_value();
+    auto min = optimizer.minimize(i).objective_value();
 
     if (min < P2.b(1)) {
       Polytope new_P1 = P1;
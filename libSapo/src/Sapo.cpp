@@ -46,36 +46,55 @@ Sapo::Sapo(const DiscreteModel &model, bool cached):
   _evolver = new Evolver<double>(ds, cached);
 }
 
+/**
+ * @brief Unite the sets reached in an epoch and write them
+ *
+ * @param writer is the flowpipe writer
+ * @param reached is the vector of the sets reached in the epoch
+ */
+static void write_reached(FlowpipeWriter &writer,
+                          std::vector<SetsUnion<Polytope>> &reached)
+{
+  writer.write(make_union(std::move(reached)));
+}
+
 Flowpipe Sapo::reach(Bundle init_set, unsigned int k,
                      ProgressAccounter *accounter)
+{
+  Flowpipe flowpipe;
+
+  reach(std::move(init_set), k, flowpipe, accounter);
+
+  return flowpipe;
+}
+
+void Sapo::reach(Bundle init_set, unsigned int k, FlowpipeWriter &writer,
+                 ProgressAccounter *accounter)
 {
   init_set.intersect_with(this->assumptions);
 
   // create current bundles list
   std::list<Bundle> cbundles = init_set.split(max_bundle_magnitude, 1.0);
 
-  // create next bundles list
-  std::list<Bundle> nbundles;
-
-  // last polytope union in flowpipe
-  SetsUnion<Polytope> last_step(init_set);
-  simplify(last_step);
-
-  // create flowpipe
-  Flowpipe flowpipe;
-  flowpipe.push_back(last_step);
+  // the bundles and the sets reached from each of the current
+  // bundles: every task writes exclusively its own positions
+  std::vector<std::list<Bundle>> nbundles;
+  std::vector<SetsUnion<Polytope>> reached;
 
-#ifdef WITH_THREADS
-  std::mutex mutex;
+  // whether the last step reached is not empty
+  bool not_empty;
+  {
+    // the first step in flowpipe
+    SetsUnion<Polytope> first_step(init_set);
+    simplify(first_step);
 
-  auto compute_next_bundles_and_add_to_last
-      = [&nbundles, &last_step, &mutex](Sapo *sapo, const Bundle &bundle)
-#else
-  auto compute_next_bundles_and_add_to_last
-      = [&nbundles, &last_step](Sapo *sapo, const Bundle &bundle)
-#endif
+    not_empty = first_step.size() != 0;
+    writer.write(std::move(first_step));
+  }
 
-  {
+  auto compute_next_bundles = [&nbundles, &reached](Sapo *sapo,
+                                                    const Bundle &bundle,
+                                                    const size_t pos) {
     using namespace LinearAlgebra;
 
     // get the transformed bundle
@@ -87,31 +106,31 @@ Flowpipe Sapo::reach(Bundle init_set, unsigned int k,
     // TODO: check whether there is any chance for a transformed bundle to
     // be empty
     if (!nbundle.is_empty()) {
-      // split if necessary the new reached bundle and add the resulting
-      // bundles to the nbundles list
-      nbundles.splice(nbundles.end(),
-                      nbundle.split(sapo->max_bundle_magnitude));
+      // split if necessary the new reached bundle
+      nbundles[pos] = nbundle.split(sapo->max_bundle_magnitude);
 
       Polytope bls = nbundle;
-      {
-#ifdef WITH_THREADS
-        std::unique_lock<std::mutex> lock(mutex);
-#endif // WITH_THREADS
-        last_step.add(bls);
-      }
+      reached[pos].add(std::move(bls));
     }
   };
 
+#ifdef WITH_THREADS
+  // the batch of the task uniting and writing the last reached sets
+  ThreadPool::BatchId write_batch = nullptr;
+  bool writing = false;
+#endif // WITH_THREADS
+
   unsigned int i = 0;
 
   // while time horizon has not been reached and last step reached is not empty
   // TODO: check whether there exists any chance for the last_step to be empty
-  while (i < k && last_step.size() != 0) {
-
-    // create a new last step reach set
-    last_step = SetsUnion<Polytope>();
+  while (i < k && not_empty) {
     i++;
 
+    nbundles = std::vector<std::list<Bundle>>(cbundles.size());
+    reached = std::vector<SetsUnion<Polytope>>(cbundles.size());
+
+    size_t pos = 0;
 #ifdef WITH_THREADS
     ThreadPool::BatchId batch_id = thread_pool.create_batch();
 
@@ -119,9 +138,8 @@ Flowpipe Sapo::reach(Bundle init_set, unsigned int k,
     for (auto b_it = std::cbegin(cbundles); b_it != std::cend(cbundles);
          ++b_it) {
       // submit the task to the thread pool
-      thread_pool.submit_to_batch(batch_id,
-                                  compute_next_bundles_and_add_to_last, this,
-                                  std::ref(*b_it));
+      thread_pool.submit_to_batch(batch_id, compute_next_bundles, this,
+                                  std::ref(*b_it), pos++);
     }
 
     // join to the pool threads
@@ -135,28 +153,63 @@ Flowpipe Sapo::reach(Bundle init_set, unsigned int k,
     for (auto b_it = std::cbegin(cbundles); b_it != std::cend(cbundles);
          ++b_it) {
 
-      compute_next_bundles_and_add_to_last(this, std::ref(*b_it));
+      compute_next_bundles(this, *b_it, pos++);
     }
 #endif // WITH_THREADS
 
-    // swap current bundles and new bundles
-    std::swap(cbundles, nbundles);
+    // merge the new bundles in the current bundle list
+    cbundles.clear();
+    for (auto &bundles: nbundles) {
+      cbundles.splice(cbundles.end(), bundles);
+    }
 
-    nbundles = std::list<Bundle>();
+    // a non-empty reached set always produces some bundles
+    not_empty = cbundles.size() != 0;
 
-    // add the last step to the flow pipe
-    flowpipe.push_back(last_step); // store result
+    // unite and write the reached sets: in multi-threading mode, this
+    // is done while the next epoch is evolving
+#ifdef WITH_THREADS
+    // the previous step must be written before the current one
+    if (writing) {
+      thread_pool.join_threads(write_batch);
+      thread_pool.close_batch(write_batch);
+    }
+
+    write_batch = thread_pool.create_batch();
+    thread_pool.submit_to_batch(write_batch, write_reached, std::ref(writer),
+                                std::move(reached));
+    writing = true;
+#else  // WITH_THREADS
+    write_reached(writer, reached);
+#endif // WITH_THREADS
 
     if (accounter != NULL) {
       accounter->increase_performed();
     }
   }
 
-  return flowpipe;
+#ifdef WITH_THREADS
+  // wait for the last step to be written
+  if (writing) {
+    thread_pool.join_threads(write_batch);
+    thread_pool.close_batch(write_batch);
+  }
+#endif // WITH_THREADS
 }
 
 Flowpipe Sapo::reach(Bundle init_set, const SetsUnion<Polytope> &pSet,
                      unsigned int k, ProgressAccounter *accounter)
+{
+  Flowpipe flowpipe;
+
+  reach(std::move(init_set), pSet, k, flowpipe, accounter);
+
+  return flowpipe;
+}
+
+void Sapo::reach(Bundle init_set, const SetsUnion<Polytope> &pSet,
+                 unsigned int k, FlowpipeWriter &writer,
+                 ProgressAccounter *accounter)
 {
   using namespace std;
   const unsigned int num_p_poly = pSet.size();
@@ -174,27 +227,23 @@ Flowpipe Sapo::reach(Bundle init_set, const SetsUnion<Polytope> &pSet,
   // create next bundles list
   std::vector<std::list<Bundle>> nbundles;
 
-  // last polytope union in flowpipe
-  SetsUnion<Polytope> last_step(init_set);
-  simplify(last_step);
+  // the sets reached by using the parameters in each polytope
+  std::vector<SetsUnion<Polytope>> reached;
 
-  // create flowpipe
-  Flowpipe flowpipe;
-  flowpipe.push_back(last_step);
-
-#ifdef WITH_THREADS
-  std::mutex add_mtx;
+  // whether the last step reached is not empty
+  bool not_empty;
+  {
+    // the first step in flowpipe
+    SetsUnion<Polytope> first_step(init_set);
+    simplify(first_step);
 
-  auto compute_next_bundles_and_add_to_last
-      = [&nbundles, &cbundles, &last_step,
-         &add_mtx](Sapo *sapo, const Polytope &pSet, const unsigned int pos)
-#else
-  auto compute_next_bundles_and_add_to_last
-      = [&nbundles, &cbundles, &last_step](Sapo *sapo, const Polytope &pSet,
-                                           const unsigned int pos)
-#endif
+    not_empty = first_step.size() != 0;
+    writer.write(std::move(first_step));
+  }
 
-  {
+  auto compute_next_bundles
+      = [&nbundles, &cbundles, &reached](Sapo *sapo, const Polytope &pSet,
+                                         const unsigned int pos) {
     // for all the parameter sets
     for (auto b_it = std::cbegin(cbundles[pos]);
          b_it != std::cend(cbundles[pos]); ++b_it) {
@@ -214,26 +263,25 @@ Flowpipe Sapo::reach(Bundle init_set, const SetsUnion<Polytope> &pSet,
         nbundles[pos].splice(nbundles[pos].end(),
                              nbundle.split(sapo->max_bundle_magnitude));
 
-        {
-#ifdef WITH_THREADS
-          std::unique_lock<std::mutex> lock(add_mtx);
-#endif
-          last_step.add(bls);
-        }
+        reached[pos].add(std::move(bls));
       }
     }
   };
 
+#ifdef WITH_THREADS
+  // the batch of the task uniting and writing the last reached sets
+  ThreadPool::BatchId write_batch = nullptr;
+  bool writing = false;
+#endif // WITH_THREADS
+
   unsigned int i = 0;
 
   // while time horizon has not been reached and last step reached is not empty
   // TODO: check whether there exists any chance for the last_step to be empty
-  while (i < k && last_step.size() != 0) {
+  while (i < k && not_empty) {
 
     nbundles = std::vector<std::list<Bundle>>(num_p_poly);
-
-    // create a new last step reach set
-    last_step = SetsUnion<Polytope>();
+    reached = std::vector<SetsUnion<Polytope>>(num_p_poly);
     i++;
 
     unsigned int pSet_idx = 0;
@@ -243,8 +291,7 @@ Flowpipe Sapo::reach(Bundle init_set, const SetsUnion<Polytope> &pSet,
     // for all the old bundles
     for (auto p_it = std::cbegin(pSet); p_it != std::cend(pSet); ++p_it) {
       // submit the task to the thread pool
-      thread_pool.submit_to_batch(batch_id,
-                                  compute_next_bundles_and_add_to_last, this,
+      thread_pool.submit_to_batch(batch_id, compute_next_bundles, this,
                                   std::ref(*p_it), pSet_idx++);
     }
 
@@ -258,26 +305,52 @@ Flowpipe Sapo::reach(Bundle init_set, const SetsUnion<Polytope> &pSet,
     // for all the old bundles
     for (auto p_it = std::cbegin(pSet); p_it != std::cend(pSet); ++p_it) {
 
-      compute_next_bundles_and_add_to_last(this, std::ref(*p_it), pSet_idx++);
+      compute_next_bundles(this, *p_it, pSet_idx++);
     }
 #endif // WITH_THREADS
 
     // move the new bundles content in the current bundles
     cbundles = std::move(nbundles);
 
-    // add the last step to the flow pipe
-    flowpipe.push_back(last_step); // store result
+    // a non-empty reached set always produces some bundles
+    not_empty = false;
+    for (const auto &bundles: cbundles) {
+      not_empty = not_empty || bundles.size() != 0;
+    }
+
+    // unite and write the reached sets: in multi-threading mode, this
+    // is done while the next epoch is evolving
+#ifdef WITH_THREADS
+    // the previous step must be written before the current one
+    if (writing) {
+      thread_pool.join_threads(write_batch);
+      thread_pool.close_batch(write_batch);
+    }
+
+    write_batch = thread_pool.create_batch();
+    thread_pool.submit_to_batch(write_batch, write_reached, std::ref(writer),
+                                std::move(reached));
+    writing = true;
+#else  // WITH_THREADS
+    write_reached(writer, reached);
+#endif // WITH_THREADS
 
     if (accounter != NULL) {
       accounter->increase_performed();
     }
   }
 
+#ifdef WITH_THREADS
+  // wait for the last step to be written
+  if (writing) {
+    thread_pool.join_threads(write_batch);
+    thread_pool.close_batch(write_batch);
+  }
+#endif // WITH_THREADS
+
   if (accounter != NULL) {
     accounter->increase_performed_to(k);
   }
-
-  return flowpipe;
 }
 
 /**
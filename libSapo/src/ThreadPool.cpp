@@ -1,339 +1,617 @@
 #include "ThreadPool.h"
 
+#include <chrono>
+
 #include "ErrorHandling.h"
 
 /**
- * @brief Get information about a batch
+ * @brief The initial size of the task queue buffers
  *
- * @param[in] batch_id is the searched batch id
- * @return a reference to the batch information
+ * This value must be a power of 2.
  */
-std::shared_ptr<ThreadPool::BatchInfo>
-ThreadPool::get_batch_info(const ThreadPool::BatchId batch_id)
-{
-  // search for the batch id in the map
-  auto found = _batches.find(batch_id);
+#define INITIAL_DEQUE_CAPACITY 64
 
-  // if not found throw an error
-  if (found == std::end(_batches)) {
-    SAPO_ERROR("unknown batch", std::runtime_error);
-  }
+/**
+ * @brief The number of failed task searches before sleeping
+ */
+#define SPINNING_ROUNDS 64
 
-  // otherwise return a reference to the batch info
-  return found->second;
-}
+/**
+ * @brief The period, in microseconds, between two task searches of a
+ * thread joining a running batch
+ */
+#define JOIN_POLLING_PERIOD 100
 
 /**
- * @brief Extract next task from the queue
+ * @brief The pool of the calling thread
  *
- * @return The next task to be executed
+ * This variable is `nullptr` unless the calling thread is a pool thread.
  */
-bool ThreadPool::extract_next_task(ThreadPool::Task &next,
-                                   std::unique_lock<std::mutex> &lock)
-{
-  bool owns_lock = lock.owns_lock();
-
-  if (!owns_lock) {
-    lock.lock();
-  }
+static thread_local const ThreadPool *local_pool = nullptr;
 
-  // if the queue is empty
-  while (_queue.empty()) {
-    // otherwise wait for new task in the queue
-    _waiting_task.wait(lock);
+/**
+ * @brief The index of the calling thread in its pool
+ */
+static thread_local unsigned int local_thread_id = 0;
 
-    // if the pool is about to be destroyed
-    if (_terminating) {
+/**
+ * @brief The index of the next queue to be robbed by the calling thread
+ */
+static thread_local unsigned int next_victim = 0;
 
-      if (!owns_lock) {
-        lock.unlock();
-      }
+/**
+ * @brief The number of tasks that the calling thread is running
+ */
+static thread_local unsigned int running_tasks = 0;
 
-      // return a fake task
-      return false;
+/**
+ * @brief Decrease the number of unfinished tasks
+ *
+ * This method decreases the number of unfinished tasks and,
+ * when the batch has been concluded, it notifies the batch
+ * end to the waiting threads.
+ */
+void ThreadPool::Batch::conclude_task()
+{
+  size_t value = unfinished.load(std::memory_order_relaxed);
+  while (value > 1) {
+    if (unfinished.compare_exchange_weak(value, value - 1,
+                                         std::memory_order_acq_rel)) {
+      return;
     }
   }
 
-  std::swap(next, _queue.front());
-  _queue.pop();
+  // the last task must be concluded in the critical region because
+  // the batch may be destroyed as soon as its end has been observed
+  std::unique_lock<std::mutex> lock(mutex);
 
-  // update the info about the number of tasks
-  // of the batch in the queue
-  --(get_batch_info(next.second)->in_queue);
-
-  if (!owns_lock) {
-    lock.unlock();
+  if (unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    waiting_end.notify_all();
   }
-  return true;
 }
 
 /**
- * @brief The main thread loop
+ * @brief Store an exception thrown by a batch task
  *
- * @param[in] thread_id is the thread id in the pool
+ * Only the first stored exception is kept.
+ *
+ * @param[in] thrown is the exception thrown by a batch task
  */
-void ThreadPool::consumer_loop(unsigned int thread_id)
+void ThreadPool::Batch::store_exception(std::exception_ptr thrown)
 {
-  (void)thread_id;
-  Task task;
+  std::unique_lock<std::mutex> lock(mutex);
 
-  std::unique_lock<std::mutex> lock(_mutex);
-
-  // forever
-  while (true) {
-    // extract the next task from the queue
-    extract_next_task(task, lock);
-
-    // if the pool is about to be destroyed
-    // exit from the loop
-    if (_terminating) {
-      lock.unlock();
-
-      _waiting_task.notify_all();
-      return;
-    }
+  if (!exception) {
+    exception = std::move(thrown);
+  }
+}
 
-    auto info = get_batch_info(task.second);
+/**
+ * @brief Extract the stored exception
+ *
+ * @return the stored exception, if any, or a null pointer. The
+ *         batch does not store any exception after the call
+ */
+std::exception_ptr ThreadPool::Batch::take_exception()
+{
+  std::unique_lock<std::mutex> lock(mutex);
 
-    // update the info about the number of
-    // running tasks in the batch
-    ++(info->running);
+  std::exception_ptr thrown;
+  std::swap(thrown, exception);
 
-    // prepare for the task run and
-    // exit from the critical region
-    lock.unlock();
+  return thrown;
+}
 
-    // Run the task
-    task.first();
+/**
+ * @brief Constructor
+ */
+ThreadPool::TaskDeque::TaskDeque():
+    _top(0), _bottom(0), _buffer(nullptr), _buffers()
+{
+  _buffers.emplace_back(new Buffer(INITIAL_DEQUE_CAPACITY));
+  _buffer.store(_buffers.back().get(), std::memory_order_relaxed);
+}
 
-    // re-enter the critical region
-    lock.lock();
+/**
+ * @brief Double the buffer size
+ *
+ * @param[in] top is the index of the queue top
+ * @param[in] bottom is the index of the queue bottom
+ * @return the new buffer
+ */
+ThreadPool::TaskDeque::Buffer *
+ThreadPool::TaskDeque::grow(const int64_t top, const int64_t bottom)
+{
+  Buffer *old_buffer = _buffer.load(std::memory_order_relaxed);
+  Buffer *new_buffer = new Buffer(2 * (old_buffer->mask + 1));
 
-    // update the running tasks in the batch and
-    // check for task end
-    if (--(info->running) == 0 && info->in_queue == 0) {
-      lock.unlock();
+  for (int64_t i = top; i < bottom; ++i) {
+    new_buffer->put(i, old_buffer->get(i));
+  }
 
-      // notify the waiting threads that
-      // this batch has been concluded
-      info->waiting_end.notify_all();
+  // the old buffer cannot be deleted: a thief may be reading it
+  _buffers.emplace_back(new_buffer);
+  _buffer.store(new_buffer, std::memory_order_release);
 
-      lock.lock();
-    }
-  }
+  return new_buffer;
 }
 
 /**
- * @brief Create a new Thread Pool object
+ * @brief Push a task on the queue bottom
  *
- * @param[in] num_of_threads is the number of thread in the pool
+ * This method must be called exclusively by the queue owner.
+ *
+ * @param[in] task is the task to be pushed
  */
-ThreadPool::ThreadPool(const unsigned num_of_threads):
-    _threads(), _queue(), _terminating(false)
+void ThreadPool::TaskDeque::push(Task *task)
 {
-  reinit(num_of_threads);
-}
+  const int64_t bottom = _bottom.load(std::memory_order_relaxed);
+  const int64_t top = _top.load(std::memory_order_acquire);
+  Buffer *buffer = _buffer.load(std::memory_order_relaxed);
 
-/**
- * @brief Create a pull of threads according to the hardware
- */
-ThreadPool::ThreadPool(): ThreadPool(std::thread::hardware_concurrency()) {}
+  if (bottom - top > static_cast<int64_t>(buffer->mask)) {
+    buffer = grow(top, bottom);
+  }
+
+  buffer->put(bottom, task);
+  std::atomic_thread_fence(std::memory_order_release);
+  _bottom.store(bottom + 1, std::memory_order_relaxed);
+}
 
 /**
- * @brief Initialize a new task batch
+ * @brief Pop a task from the queue bottom
  *
- * @return The batch id of the new batch
+ * This method must be called exclusively by the queue owner.
+ *
+ * @return the popped task or `nullptr` if the queue is empty
  */
-ThreadPool::BatchId ThreadPool::create_batch()
+ThreadPool::Task *ThreadPool::TaskDeque::pop()
 {
-  std::unique_lock<std::mutex> lock(_mutex);
-
-  BatchId batch_id;
+  const int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+  Buffer *buffer = _buffer.load(std::memory_order_relaxed);
 
-  // search for an unused batch id
-  auto first_unused = std::begin(_unused_batch_ids);
+  _bottom.store(bottom, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t top = _top.load(std::memory_order_relaxed);
 
-  // if any of them is available
-  if (first_unused != std::end(_unused_batch_ids)) {
+  // the queue was empty
+  if (top > bottom) {
+    _bottom.store(bottom + 1, std::memory_order_relaxed);
 
-    // acquire it
-    batch_id = *first_unused;
+    return nullptr;
+  }
 
-    // remove it from the set of the unused id
-    _unused_batch_ids.erase(first_unused);
-  } else { // if no unused id is available
-    // get the last used id
-    auto last_batch = _batches.rbegin();
+  Task *task = buffer->get(bottom);
 
-    // and increase it by one
-    batch_id = last_batch->first + 1;
+  // the task is the last one in the queue: race against the thieves
+  if (top == bottom) {
+    if (!_top.compare_exchange_strong(top, top + 1,
+                                      std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      task = nullptr;
+    }
+    _bottom.store(bottom + 1, std::memory_order_relaxed);
   }
 
-  // build an empty info for the new batch id
-  _batches.emplace(batch_id, std::make_shared<BatchInfo>());
-
-  return batch_id;
+  return task;
 }
 
 /**
- * @brief Close the batch and remove it from the pool
+ * @brief Steal a task from the queue top
  *
- * @param[in] batch_id is the id of the batch to be closed
+ * @return the stolen task or `nullptr` if the queue is empty or
+ *         a concurrent operation took the top task
  */
-void ThreadPool::close_batch(const unsigned int batch_id)
+ThreadPool::Task *ThreadPool::TaskDeque::steal()
 {
-  std::unique_lock<std::mutex> lock(_mutex);
+  int64_t top = _top.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const int64_t bottom = _bottom.load(std::memory_order_acquire);
 
-  // batch id 0 is reserved and cannot be closed
-  if (batch_id == 0) {
-    return;
+  if (top >= bottom) {
+    return nullptr;
   }
 
-  // get batch info
-  auto info = get_batch_info(batch_id);
+  Task *task = _buffer.load(std::memory_order_acquire)->get(top);
+  if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                    std::memory_order_relaxed)) {
+    return nullptr;
+  }
+
+  return task;
+}
 
-  // if the batch has not finished yet
-  while (info->unfinished_tasks() > 0) {
-    // wait for its end
-    info->waiting_end.wait(lock);
+/**
+ * @brief Get the queue of the calling thread
+ *
+ * @return a pointer to the queue of the calling thread, if it
+ *         is a pool thread, or `nullptr`, otherwise
+ */
+ThreadPool::TaskDeque *ThreadPool::local_deque()
+{
+  if (local_pool != this) {
+    return nullptr;
   }
 
-  _batches.erase(batch_id);
+  return _deques[local_thread_id].get();
+}
 
-  // if the pool only contains info about
-  // batch 0
-  if (_batches.size() == 1) {
-    // clear the set of unused id
-    _unused_batch_ids.clear();
+/**
+ * @brief Enqueue a task
+ *
+ * @param[in] task is the task to be enqueued
+ */
+void ThreadPool::enqueue(Task *task)
+{
+  _queued_tasks.fetch_add(1);
+
+  TaskDeque *local = local_deque();
+  if (local != nullptr) {
+    // tasks submitted by pool threads go to the submitter queue
+    local->push(task);
   } else {
-    // add the batch id to the set
-    // of the unused id
-    _unused_batch_ids.insert(batch_id);
+    std::unique_lock<std::mutex> lock(_injection_mutex);
+
+    _injection_queue.push_back(task);
+  }
+
+  // wake up a sleeping thread, if any
+  if (_sleeping.load() > 0) {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    _waiting_task.notify_one();
   }
 }
 
 /**
- * @brief Join the thread pool and complete the batch
+ * @brief Extract a task from the pool queues
  *
- * @param[in] batch_id is the id of the batch that must be completed
+ * This method pops a task from the queue of the calling thread,
+ * if any, and, when it is empty, it steals a task from the other
+ * queues.
+ *
+ * @param[in] local is the queue of the calling thread or `nullptr`
+ * @return an extracted task or `nullptr` if no task was found
  */
-void ThreadPool::join_threads(const unsigned int batch_id)
+ThreadPool::Task *ThreadPool::extract_next_task(TaskDeque *local)
 {
-  Task task;
-  std::unique_lock<std::mutex> lock(_mutex);
+  if (_queued_tasks.load(std::memory_order_relaxed) == 0) {
+    return nullptr;
+  }
 
-  // repeat forever
-  while (true) {
-    // get batch info
-    auto info = get_batch_info(batch_id);
+  Task *task = nullptr;
+  if (local != nullptr) {
+    task = local->pop();
+  }
 
-    // if finished
-    if (info->unfinished_tasks() == 0) {
+  if (task == nullptr) {
+    std::unique_lock<std::mutex> lock(_injection_mutex);
 
-      // end loop and exit
-      return;
+    if (!_injection_queue.empty()) {
+      task = _injection_queue.front();
+      _injection_queue.pop_front();
     }
+  }
 
-    // if the queue is not empty
-    if (_queue.empty()) {
-      // some tasks in the batch are still running
-      // wait for them
+  // steal from the other queues starting from the last robbed one
+  const size_t num_of_deques = _deques.size();
+  for (size_t i = 0; task == nullptr && i < num_of_deques; ++i) {
+    TaskDeque *victim = _deques[(next_victim + i) % num_of_deques].get();
 
-      while (info->unfinished_tasks() > 0) {
-        info->waiting_end.wait(lock);
+    if (victim != local) {
+      task = victim->steal();
+      if (task != nullptr) {
+        next_victim = (next_victim + i) % num_of_deques;
       }
-
-      // exit
-      return;
     }
+  }
 
-    // extract a task from the queue
-    std::swap(task, _queue.front());
-    _queue.pop();
-
-    // get info about the extracted task batch
-    auto ex_info = get_batch_info(task.second);
+  if (task != nullptr) {
+    _queued_tasks.fetch_sub(1);
+  }
 
-    // update it
-    --(ex_info->in_queue);
-    ++(ex_info->running);
+  return task;
+}
 
-    // prepare for the task run and
-    // exit from the critical region
-    lock.unlock();
+/**
+ * @brief Extract a task of a batch submitted by the calling thread
+ *
+ * This method extracts the last task submitted by the calling thread,
+ * provided that it belongs to a specified batch and it is still
+ * queued.
+ *
+ * @param[in] local is the queue of the calling thread or `nullptr`
+ * @param[in] batch is the batch of the aimed task
+ * @return an extracted task or `nullptr` if no task was found
+ */
+ThreadPool::Task *ThreadPool::extract_own_task(TaskDeque *local,
+                                               const Batch *batch)
+{
+  Task *task = nullptr;
+  if (local != nullptr) {
+    task = local->pop();
 
-    task.first();
+    // the last submitted task belongs to another batch: put it back
+    if (task != nullptr && task->batch != batch) {
+      local->push(task);
 
-    // re-enter the critical region
-    lock.lock();
+      task = nullptr;
+    }
+  } else {
+    // the tasks submitted from outside the pool are
+    // appended to the injection queue
+    std::unique_lock<std::mutex> lock(_injection_mutex);
 
-    // decrease the number of running
-    // tasks in the batch
-    --(ex_info->running);
+    if (!_injection_queue.empty() && _injection_queue.back()->batch == batch) {
+      task = _injection_queue.back();
+      _injection_queue.pop_back();
+    }
+  }
 
-    if (ex_info->unfinished_tasks() == 0) {
-      lock.unlock();
+  if (task != nullptr) {
+    _queued_tasks.fetch_sub(1);
+  }
 
-      ex_info->waiting_end.notify_all();
+  return task;
+}
 
-      lock.lock();
-    }
+/**
+ * @brief Run a task and update its batch
+ *
+ * An exception thrown by the task is stored in the task batch.
+ *
+ * @param[in] task is the task to be executed
+ */
+void ThreadPool::run(Task *task)
+{
+  std::unique_ptr<Task> owned_task(task);
+
+  ++running_tasks;
+  try {
+    owned_task->routine();
+  } catch (...) {
+    // the exception must be stored before concluding the task
+    // because the batch may be deleted as soon as it is concluded
+    owned_task->batch->store_exception(std::current_exception());
   }
+  --running_tasks;
+
+  owned_task->batch->conclude_task();
 }
 
 /**
- * @brief Terminate the pool
+ * @brief The main thread loop
+ *
+ * @param[in] thread_id is the thread id in the pool
  */
-void ThreadPool::terminate()
+void ThreadPool::consumer_loop(unsigned int thread_id)
 {
-  std::unique_lock<std::mutex> lock(_mutex);
+  local_pool = this;
+  local_thread_id = thread_id;
+  next_victim = thread_id;
+
+  TaskDeque *local = local_deque();
+  unsigned int failed_searches = 0;
+
+  // until the pool is about to be destroyed
+  while (!_terminating) {
+    Task *task = extract_next_task(local);
+
+    if (task != nullptr) {
+      run(task);
+
+      failed_searches = 0;
+    } else if (++failed_searches < SPINNING_ROUNDS) {
+      std::this_thread::yield();
+    } else {
+      std::unique_lock<std::mutex> lock(_mutex);
+
+      // the flags must be tested after announcing the sleep because
+      // a task may have been submitted in the meanwhile
+      _sleeping.fetch_add(1);
+      if (_queued_tasks.load() == 0 && !_terminating) {
+        _waiting_task.wait(lock);
+      }
+      _sleeping.fetch_sub(1);
 
-  // set the termination flag
-  _terminating = true;
-  while (!_queue.empty()) {
-    _queue.pop();
+      failed_searches = 0;
+    }
   }
+}
 
-  lock.unlock();
+/**
+ * @brief Stop the pool threads
+ *
+ * This method waits for the end of the running tasks and stops the
+ * pool threads. The queued tasks are moved to the injection queue.
+ */
+void ThreadPool::stop_threads()
+{
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
 
-  // notify the end of all the active batches
-  // to all the main threads waiting for it
-  for (auto &info: _batches) {
-    info.second->running = 0;
-    info.second->in_queue = 0;
-    info.second->waiting_end.notify_all();
+    // set the termination flag
+    _terminating = true;
   }
 
+  // notify all the threads waiting for some new tasks
+  // in the queue and wait for their termination
+  _waiting_task.notify_all();
   for (std::thread &t: _threads) {
-    // notify all the threads waiting for
-    // some new tasks in the queue and
-    // wait for their termination
-    _waiting_task.notify_all();
     if (t.joinable()) {
       t.join();
     }
   }
+
+  std::unique_lock<std::mutex> lock(_mutex);
+
+  _threads.clear();
+
+  std::unique_lock<std::mutex> injection_lock(_injection_mutex);
+  for (auto &deque: _deques) {
+    Task *task;
+    while ((task = deque->steal()) != nullptr) {
+      _injection_queue.push_back(task);
+    }
+  }
+  _deques.clear();
 }
 
 /**
- * @brief Re-initialize the pool
+ * @brief Start the pool threads
  *
  * @param[in] num_of_threads is the new number of threads
  */
-void ThreadPool::reinit(const unsigned int &num_of_threads)
+void ThreadPool::start_threads(const unsigned int num_of_threads)
 {
   std::unique_lock<std::mutex> lock(_mutex);
 
   _terminating = false;
-  _batches.clear();
-  _batches.emplace((BatchId)0, std::make_shared<BatchInfo>());
+
+  // all the queues must exist before the threads start stealing
+  _deques.clear();
+  for (unsigned int i = 0; i < num_of_threads; ++i) {
+    _deques.emplace_back(new TaskDeque());
+  }
 
   _threads = std::vector<std::thread>();
   for (unsigned int i = 0; i < num_of_threads; ++i) {
-    _threads.emplace_back(&ThreadPool::consumer_loop, this, _threads.size());
+    _threads.emplace_back(&ThreadPool::consumer_loop, this, i);
   }
 }
 
+/**
+ * @brief Create a new Thread Pool object
+ *
+ * @param[in] num_of_threads is the number of thread in the pool
+ */
+ThreadPool::ThreadPool(const unsigned num_of_threads):
+    _threads(), _deques(), _injection_queue(), _injection_mutex(),
+    _default_batch(), _queued_tasks(0), _sleeping(0), _mutex(),
+    _waiting_task(), _terminating(false)
+{
+  start_threads(num_of_threads);
+}
+
+/**
+ * @brief Create a pull of threads according to the hardware
+ */
+ThreadPool::ThreadPool(): ThreadPool(std::thread::hardware_concurrency()) {}
+
+/**
+ * @brief Initialize a new task batch
+ *
+ * @return The batch id of the new batch
+ */
+ThreadPool::BatchId ThreadPool::create_batch()
+{
+  return new Batch();
+}
+
+/**
+ * @brief Close the batch and remove it from the pool
+ *
+ * @param[in] batch_id is the id of the batch to be closed
+ */
+void ThreadPool::close_batch(const ThreadPool::BatchId batch_id)
+{
+  // the default batch is reserved and cannot be closed
+  if (batch_id == nullptr) {
+    return;
+  }
+
+  // wait for the batch end
+  complete(batch_id);
+
+  // the exceptions not rethrown by `join_threads` are rethrown
+  // after deleting the batch
+  std::exception_ptr thrown = batch_id->take_exception();
+
+  // wait for the thread that concluded the batch to leave
+  // the batch critical region
+  {
+    std::unique_lock<std::mutex> lock(batch_id->mutex);
+  }
+
+  delete batch_id;
+
+  if (thrown) {
+    std::rethrow_exception(thrown);
+  }
+}
+
+/**
+ * @brief Execute the queued tasks until a batch is concluded
+ *
+ * @param[in] batch is the batch that must be concluded
+ */
+void ThreadPool::complete(Batch *batch)
+{
+  TaskDeque *local = local_deque();
+
+  // joins nested in a task only execute their own tasks
+  const bool nested = (running_tasks > 0);
+
+  while (batch->unfinished.load(std::memory_order_acquire) > 0) {
+    Task *task = (nested ? extract_own_task(local, batch)
+                         : extract_next_task(local));
+
+    if (task != nullptr) {
+      run(task);
+    } else {
+      // some tasks in the batch are still running: wait for
+      // their end, but look for new tasks every now and then
+      std::unique_lock<std::mutex> lock(batch->mutex);
+
+      batch->waiting_end.wait_for(
+          lock, std::chrono::microseconds(JOIN_POLLING_PERIOD), [batch]() {
+            return batch->unfinished.load(std::memory_order_acquire) == 0;
+          });
+    }
+  }
+}
+
+/**
+ * @brief Join the thread pool and complete the batch
+ *
+ * The calling thread executes the queued tasks until the
+ * batch has been concluded. Then, the first exception thrown
+ * by the batch tasks, if any, is rethrown.
+ *
+ * @param[in] batch_id is the id of the batch that must be completed
+ */
+void ThreadPool::join_threads(const ThreadPool::BatchId batch_id)
+{
+  Batch *batch = get_batch(batch_id);
+
+  complete(batch);
+
+  std::exception_ptr thrown = batch->take_exception();
+  if (thrown) {
+    std::rethrow_exception(thrown);
+  }
+}
+
+/**
+ * @brief Terminate the pool
+ */
+void ThreadPool::terminate()
+{
+  stop_threads();
+
+  std::unique_lock<std::mutex> lock(_injection_mutex);
+
+  // discard the queued tasks and notify the end of their
+  // batches to all the threads waiting for it
+  for (Task *task: _injection_queue) {
+    _queued_tasks.fetch_sub(1);
+    task->batch->conclude_task();
+
+    delete task;
+  }
+  _injection_queue.clear();
+}
+
 /**
  * @brief Add some threads to the pool
  *
@@ -341,11 +619,11 @@ void ThreadPool::reinit(const unsigned int &num_of_threads)
  */
 void ThreadPool::add_new_threads(const unsigned int num_of_new_threads)
 {
-  std::unique_lock<std::mutex> lock(_mutex);
+  const unsigned int total = num_of_threads() + num_of_new_threads;
 
-  for (unsigned int i = 0; i < num_of_new_threads; ++i) {
-    _threads.emplace_back(&ThreadPool::consumer_loop, this, _threads.size());
-  }
+  // the queued tasks are preserved in the injection queue
+  stop_threads();
+  start_threads(total);
 }
 
 /**
@@ -356,7 +634,7 @@ void ThreadPool::add_new_threads(const unsigned int num_of_new_threads)
 void ThreadPool::reset(const unsigned int num_of_threads)
 {
   terminate();
-  reinit(num_of_threads);
+  start_threads(num_of_threads);
 }
 
 /**
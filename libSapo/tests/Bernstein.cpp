@@ -103,3 +103,118 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_rational_Bernstein, T, test_types)
   }
   BOOST_CHECK(coeff.size() == result.size());
 }
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_numeric_Bernstein_bounds, T, test_types)
+{
+  using namespace SymbolicAlgebra;
+
+  Symbol<T> x("x"), y("y"), z("z");
+
+  std::vector<Symbol<T>> vars{x, y, z};
+
+  std::vector<Expression<T>> polynomials{
+    2 * x*x,
+    2 * x * y * y + x + 1,
+    2*(1+3*x)*(1+3*x),
+    2*(3*x+1)*(2*y-2)*(2*y-2)+3*x+2,
+    x*y*z - 3*z*z*x + 4*y - 7,
+    5
+  };
+
+  for (const auto &polynomial: polynomials) {
+    std::vector<unsigned int> degrees, elevated;
+    for (const auto &var: vars) {
+      degrees.push_back(polynomial.degree(var));
+      elevated.push_back(degrees.back() + 1);
+    }
+
+    auto coeffs = get_Bernstein_coefficients(vars, polynomial);
+    T min_coeff = coeffs[0].evaluate(), max_coeff = min_coeff;
+    for (const auto &coeff: coeffs) {
+      min_coeff = std::min(min_coeff, T(coeff.evaluate()));
+      max_coeff = std::max(max_coeff, T(coeff.evaluate()));
+    }
+
+    auto dense = Bernstein<T>::get_dense_coefficients(vars, polynomial,
+                                                      degrees);
+    auto bounds = get_Bernstein_bounds(degrees, dense);
+
+    BOOST_CHECK(bounds.first == min_coeff);
+    BOOST_CHECK(bounds.second == max_coeff);
+
+    // degree elevation makes the bounds tighter
+    dense = Bernstein<T>::get_dense_coefficients(vars, polynomial, elevated);
+    bounds = get_Bernstein_bounds(elevated, dense);
+
+    BOOST_CHECK(bounds.first >= min_coeff);
+    BOOST_CHECK(bounds.second <= max_coeff);
+
+    bounds = get_Bernstein_bounds(elevated, dense, max_coeff, min_coeff);
+
+    BOOST_CHECK(bounds.first <= max_coeff);
+    BOOST_CHECK(bounds.second >= min_coeff);
+
+    Bernstein<T>::reduce_dense_tensor(elevated, dense);
+    BOOST_CHECK(elevated == degrees);
+
+    bounds = get_Bernstein_bounds(elevated, dense);
+
+    BOOST_CHECK(bounds.first == min_coeff);
+    BOOST_CHECK(bounds.second == max_coeff);
+  }
+
+  BOOST_REQUIRE_THROW(Bernstein<T>::get_dense_coefficients(vars, x*x*y,
+                                                           {1, 1, 1}),
+                      std::domain_error);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_fixed_dimension_Bernstein_bounds, T,
+                              test_types)
+{
+  using namespace SymbolicAlgebra;
+
+  Symbol<T> x("x"), y("y"), z("z");
+
+  std::vector<Symbol<T>> vars{x, y, z};
+
+  std::vector<Expression<T>> polynomials{
+    2 * x*x,
+    2*(3*x+1)*(2*y-2)*(2*y-2)+3*x+2,
+    x*y*z - 3*z*z*x + 4*y - 7,
+    5
+  };
+
+  auto fixed = Bernstein<T>::get_dense_tensor_bounds_function(vars.size());
+  auto generic = Bernstein<T>::get_dense_tensor_bounds_function(0);
+
+  BOOST_CHECK(fixed != generic);
+  BOOST_CHECK(Bernstein<T>::get_dense_tensor_bounds_function(
+                LinearAlgebra::Fixed::MAX_FIXED_DIMENSION+1) == generic);
+
+  for (const auto &polynomial: polynomials) {
+    std::vector<unsigned int> elevated;
+    for (const auto &var: vars) {
+      elevated.push_back(polynomial.degree(var) + 2);
+    }
+
+    auto dense = Bernstein<T>::get_dense_coefficients(vars, polynomial,
+                                                      elevated);
+    auto expected = dense;
+    auto degrees = elevated;
+    Bernstein<T>::reduce_dense_tensor(degrees, expected);
+    auto expected_bounds = get_Bernstein_bounds(degrees, expected);
+
+    auto fixed_dense = dense;
+    auto bounds = (*fixed)(elevated, fixed_dense, expected_bounds.first,
+                           expected_bounds.second);
+    BOOST_CHECK(bounds == expected_bounds);
+    BOOST_CHECK(fixed_dense.size() == expected.size());
+
+    bounds = (*generic)(elevated, dense, expected_bounds.first,
+                        expected_bounds.second);
+    BOOST_CHECK(bounds == expected_bounds);
+  }
+
+  std::vector<T> dense(8, 1);
+  BOOST_REQUIRE_THROW((*fixed)({1, 1}, dense, 0, 0), std::domain_error);
+}
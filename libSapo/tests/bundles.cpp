@@ -326,6 +326,135 @@ BOOST_AUTO_TEST_CASE(test_is_subset_of_bundle)
 }
 
 
+BOOST_AUTO_TEST_CASE(test_bounding_box_bundle)
+{
+    using namespace LinearAlgebra;
+
+    std::vector<Vector<double>> A = {
+        {1,0,0},
+        {0,1,0},
+        {0,0,1},
+        {1,1,0},
+        {0,1,1}
+    };
+
+    Bundle b1(A,{0,0,0,0,0},{5,5,5,3,7}),
+           b2(A,{-1,1,-1,-3,-3},{6,7,8,9,10}, {{0,3,4}}),
+           b3(A,{6,6,6,12,12},{7,7,7,14,14});
+
+    for (const auto& bundle: {b1, b2, b3}) {
+        const auto box = bundle.bounding_box();
+        const Polytope P = bundle;
+
+        BOOST_CHECK(box.dim() == bundle.dim());
+        for (size_t i = 0; i < box.dim(); ++i) {
+            Vector<double> axis(box.dim(), 0);
+            axis[i] = 1;
+
+            BOOST_CHECK(box.lower_corner()[i] <= P.minimize(axis).objective_value());
+            BOOST_CHECK(box.upper_corner()[i] >= P.maximize(axis).objective_value());
+        }
+    }
+
+    BOOST_CHECK(!are_disjoint(b1.bounding_box(), b2.bounding_box()));
+    BOOST_CHECK(are_disjoint(b1.bounding_box(), b3.bounding_box()));
+    BOOST_CHECK(are_disjoint(b1, b3));
+
+    // the memoized box is forgotten when the bundle grows
+    Bundle b4 = b1;
+    BOOST_CHECK(b4.bounding_box().upper_corner()[0] >= 3);
+    b4.expand_by(2);
+    BOOST_CHECK(b4.bounding_box().upper_corner()[0] >= 7);
+    BOOST_CHECK(b1.bounding_box().upper_corner()[0] < b4.bounding_box().upper_corner()[0]);
+
+    // the box includes the vertices of an ill-conditioned parallelotope
+    Bundle b5({{1,0},{1,1e-12}},{0,0},{1,1});
+    const auto box = b5.bounding_box();
+    for (const auto& vertex: std::vector<Vector<double>>{{1,-1e12},{0,1e12}}) {
+        for (size_t i = 0; i < box.dim(); ++i) {
+            BOOST_CHECK(box.lower_corner()[i] <= vertex[i]);
+            BOOST_CHECK(box.upper_corner()[i] >= vertex[i]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_memoized_properties_bundle)
+{
+    using namespace LinearAlgebra;
+
+    std::vector<Vector<double>> A = {
+        {1,0},
+        {0,1},
+        {1,1}
+    };
+
+    Bundle b1(A,{0,0,0},{2,2,5}), b2(A,{3,3,0},{4,4,10});
+
+    BOOST_CHECK(!b1.is_empty());
+    BOOST_CHECK(!b1.is_empty());
+
+    // copies carry the memoized properties, changes invalidate them
+    Bundle b3(b1);
+    b3.intersect_with(b2);
+    BOOST_CHECK(!b1.is_empty());
+    BOOST_CHECK(b3.is_empty());
+    BOOST_CHECK(b3.is_subset_of(b1));
+    BOOST_CHECK(are_disjoint(b3, b2));
+
+    Bundle b4 = b1;
+    b4.expand_by(1.5);
+    BOOST_CHECK(!are_disjoint(b4, b2));
+    BOOST_CHECK(!b4.is_subset_of(b1));
+    BOOST_CHECK(b1.is_subset_of(b4));
+
+    // canonical bundles are not canonized again
+    Bundle b5 = b1.get_canonical();
+    BOOST_CHECK(b5.get_upper_bound(2) == 4);
+    BOOST_CHECK(b5.get_canonical().upper_bounds() == b5.upper_bounds());
+    BOOST_CHECK(b5 == b1);
+
+    b5.intersect_with(LinearSystem({{1,0}}, {1}));
+    BOOST_CHECK(b5.get_upper_bound(0) == 1);
+    BOOST_CHECK(b5.get_upper_bound(2) == 3);
+    BOOST_CHECK(b5.is_subset_of(b1));
+    BOOST_CHECK(!b1.is_subset_of(b5));
+
+    Bundle b6(std::move(b5));
+    BOOST_CHECK(!b6.is_empty());
+    BOOST_CHECK(b6.satisfies(LinearSystem({{1,1}}, {3})));
+    BOOST_CHECK(!b6.satisfies(LinearSystem({{1,1}}, {2})));
+}
+
+BOOST_AUTO_TEST_CASE(test_is_subset_of_bundle_different_directions)
+{
+    using namespace LinearAlgebra;
+
+    std::vector<Vector<double>> A = {
+        {1,0},
+        {0,1}
+    };
+
+    std::vector<Vector<double>> B = {
+        {1,1},
+        {1,-1}
+    };
+
+    Bundle box(A,{0,0},{1,1}),
+           diamond(B,{0,-1},{2,1}),
+           large_diamond(B,{-1,-2},{3,2}),
+           far_box(A,{5,5},{6,6});
+
+    BOOST_CHECK(box.is_subset_of(diamond));
+    BOOST_CHECK(!diamond.is_subset_of(box));
+    BOOST_CHECK(box.is_subset_of(large_diamond));
+    BOOST_CHECK(diamond.is_subset_of(large_diamond));
+    BOOST_CHECK(!large_diamond.is_subset_of(diamond));
+    BOOST_CHECK(!far_box.is_subset_of(diamond));
+    BOOST_CHECK(!diamond.is_subset_of(far_box));
+    BOOST_CHECK(are_disjoint(far_box, large_diamond));
+    BOOST_CHECK(!are_disjoint(box, large_diamond));
+}
+
 BOOST_AUTO_TEST_CASE(test_includes_bundle)
 {
     using namespace LinearAlgebra;
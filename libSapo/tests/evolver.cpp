@@ -7,6 +7,10 @@
 
 #include "Evolver.h"
 
+#ifdef WITH_THREADS
+#include "SapoThreads.h"
+#endif
+
 #define APPROX_ERR 1e-14
 
 
@@ -95,6 +99,242 @@ BOOST_AUTO_TEST_CASE(test_parametric_transform_bundle)
     BOOST_REQUIRE_THROW(T(rSet, errParam2), std::domain_error);
 }
 
+BOOST_AUTO_TEST_CASE(test_Bernstein_cache)
+{
+    using namespace SymbolicAlgebra;
+    using namespace LinearAlgebra;
+
+    Parallelotope P({{1,0},{1,1}}, {0,0}, {1,1});
+    Parallelotope Q({{1,0},{0,1}}, {0,0}, {1,1});
+
+    BernsteinCache<double> cache(2);
+
+    const size_t P_hash = BernsteinCache<double>::hash(P.generators());
+    const size_t Q_hash = BernsteinCache<double>::hash(Q.generators());
+
+    BOOST_CHECK(cache.find_coefficients(P_hash, P, {1,0}) == nullptr);
+
+    auto &coeffs = cache.save_coefficients(P_hash, P, {1,0}, {1, 2});
+
+    BOOST_CHECK(cache.find_coefficients(P_hash, P, {1,0}) == &coeffs);
+    BOOST_CHECK(cache.find_coefficients(P_hash, P, {0,1}) == nullptr);
+    BOOST_CHECK(cache.find_coefficients(Q_hash, Q, {1,0}) == nullptr);
+
+    // cached coefficients are never overwritten
+    auto &same = cache.save_coefficients(P_hash, P, {1,0}, {3});
+
+    BOOST_CHECK(&same == &coeffs);
+    BOOST_REQUIRE(same.size() == 2);
+    BOOST_CHECK(same[0].evaluate() == 1);
+
+    for (int i = 0; i < 10; ++i) {
+        cache.save_coefficients(Q_hash, Q, {1.0*i,1}, {1.0*i});
+    }
+    for (int i = 0; i < 10; ++i) {
+        auto found = cache.find_coefficients(Q_hash, Q, {1.0*i,1});
+
+        BOOST_REQUIRE(found != nullptr);
+        BOOST_CHECK((*found)[0].evaluate() == i);
+    }
+
+    BernsteinCache<double> copy(cache);
+
+    BOOST_CHECK(copy.find_coefficients(P_hash, P, {1,0}) != nullptr);
+    BOOST_CHECK(copy.find_coefficients(P_hash, P, {1,0}) != &coeffs);
+    BOOST_CHECK(copy.find_coefficients(Q_hash, Q, {9,1}) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_cached_transform_bundle)
+{
+    using namespace SymbolicAlgebra;
+    using namespace LinearAlgebra;
+
+    Symbol<> s("s"), i("i"), r("r");
+
+    std::map<Symbol<>, Expression<>> varDyn{
+        {s, s-0.34*s*i},
+        {i, i+0.34*s*i-0.05*i},
+        {r, r+0.05*i}
+    };
+
+    Evolver<double> cached(DiscreteSystem<double>(varDyn), true);
+    Evolver<double> not_cached(DiscreteSystem<double>(varDyn), false);
+
+    Dense::Matrix<double> rA{
+        {1,0,0},
+        {0,1,0},
+        {0,0,1},
+        {1,1,0},
+        {1,0,1}
+    };
+
+    Bundle rSet(rA, {0.79,0.19,0,0.99,0.79}, {0.8,0.2,0.01,1,0.81},
+                {{0,1,2},{1,2,3},{2,3,4}});
+
+    Bundle c_next = rSet, nc_next = rSet;
+    for (unsigned int k=0; k<10; ++k) {
+        c_next = cached(c_next);
+        nc_next = not_cached(nc_next);
+
+        BOOST_CHECK(epsilon_equivalent(c_next, nc_next, APPROX_ERR));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_Bernstein_cache_file)
+{
+    using namespace SymbolicAlgebra;
+    using namespace LinearAlgebra;
+
+    Symbol<> s("s"), i("i"), r("r");
+
+    std::map<Symbol<>, Expression<>> varDyn{
+        {s, s-0.34*s*i},
+        {i, i+0.34*s*i-0.05*i},
+        {r, r+0.05*i}
+    };
+
+    Dense::Matrix<double> rA{
+        {1,0,0},
+        {0,1,0},
+        {0,0,1},
+        {1,1,0},
+        {1,0,1}
+    };
+
+    Bundle rSet(rA, {0.79,0.19,0,0.99,0.79}, {0.8,0.2,0.01,1,0.81},
+                {{0,1,2},{1,2,3},{2,3,4}});
+
+    const std::string filename = "test_Bernstein_cache.bin";
+    std::remove(filename.c_str());
+
+    DiscreteSystem<double> ds(varDyn);
+
+    Evolver<double> cold(ds);
+    BOOST_CHECK(!cold.load_Bernstein_cache(filename));
+
+    Bundle expected = rSet;
+    for (unsigned int k=0; k<5; ++k) {
+        expected = cold(expected);
+    }
+    cold.save_Bernstein_cache(filename);
+
+    Evolver<double> warm(ds);
+    BOOST_CHECK(warm.load_Bernstein_cache(filename));
+
+    Bundle next = rSet;
+    for (unsigned int k=0; k<5; ++k) {
+        next = warm(next);
+    }
+    BOOST_CHECK(next == expected);
+
+    // a truncated cache must be rejected
+    const std::string truncated_name = "test_truncated_Bernstein_cache.bin";
+    {
+        std::ifstream is(filename, std::ios::binary);
+        std::string content((std::istreambuf_iterator<char>(is)),
+                            std::istreambuf_iterator<char>());
+
+        std::ofstream os(truncated_name, std::ios::binary);
+        os.write(content.data(), content.size()/2);
+    }
+
+    Evolver<double> truncated(ds);
+    BOOST_CHECK_THROW(truncated.load_Bernstein_cache(truncated_name),
+                      std::runtime_error);
+    std::remove(truncated_name.c_str());
+
+    // the cache of a different system must be ignored
+    varDyn[r] = r+0.06*i;
+
+    Evolver<double> other(DiscreteSystem<double>(varDyn), true);
+    BOOST_CHECK(!other.load_Bernstein_cache(filename));
+
+    std::remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(test_directions_per_task)
+{
+    using namespace SymbolicAlgebra;
+    using namespace LinearAlgebra;
+
+    Symbol<> s("s"), i("i"), r("r");
+
+    std::map<Symbol<>, Expression<>> varDyn{
+        {s, s-0.34*s*i},
+        {i, i+0.34*s*i-0.05*i},
+        {r, r+0.05*i}
+    };
+
+    Dense::Matrix<double> rA{
+        {1,0,0},
+        {0,1,0},
+        {0,0,1},
+        {1,1,0},
+        {1,0,1}
+    };
+
+    Bundle rSet(rA, {0.79,0.19,0,0.99,0.79}, {0.8,0.2,0.01,1,0.81},
+                {{0,1,2},{1,2,3},{2,3,4}});
+
+#ifdef WITH_THREADS
+    thread_pool.reset(3);
+#endif
+
+    DiscreteSystem<double> ds(varDyn);
+
+    Evolver<double> per_template(ds);
+    per_template.directions_per_task = 0;
+
+    Bundle expected = rSet;
+    for (unsigned int k=0; k<5; ++k) {
+        expected = per_template(expected);
+    }
+
+    for (size_t dirs_per_task: {1, 2, 5}) {
+        Evolver<double> per_block(ds);
+        per_block.directions_per_task = dirs_per_task;
+
+        Bundle next = rSet;
+        for (unsigned int k=0; k<5; ++k) {
+            next = per_block(next);
+        }
+
+        BOOST_CHECK(next == expected);
+    }
+
+#ifdef WITH_THREADS
+    thread_pool.reset(0);
+#endif
+}
+
+#ifdef WITH_THREADS
+BOOST_AUTO_TEST_CASE(test_thread_pool_exceptions)
+{
+    thread_pool.reset(3);
+
+    std::atomic<unsigned int> executed(0);
+
+    auto batch_id = thread_pool.create_batch();
+    for (unsigned int i=0; i<20; ++i) {
+        thread_pool.submit_to_batch(batch_id, [&executed, i]() {
+            ++executed;
+            if (i%5==0) {
+                throw std::runtime_error("task failure");
+            }
+        });
+    }
+
+    BOOST_CHECK_THROW(thread_pool.join_threads(batch_id), std::runtime_error);
+
+    // the batch is drained before the exception is rethrown
+    BOOST_CHECK(executed==20);
+
+    BOOST_CHECK_NO_THROW(thread_pool.close_batch(batch_id));
+
+    thread_pool.reset(0);
+}
+#endif
+
 BOOST_AUTO_TEST_CASE(test_synthesis_bundle)
 {
     using namespace SymbolicAlgebra;
@@ -0,0 +1,99 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE flowpipe
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <fstream>
+
+#include "BinaryFlowpipe.h"
+
+bool same_polytopes(const Polytope &a, const Polytope &b)
+{
+    return a.A() == b.A() && a.b() == b.b();
+}
+
+BOOST_AUTO_TEST_CASE(test_binary_flowpipe)
+{
+    using namespace LinearAlgebra;
+    using namespace LinearAlgebra::Dense;
+
+    Matrix<double> box = {
+        {1,0},
+        {0,1},
+        {-1,0},
+        {0,-1}
+    };
+
+    Matrix<double> diamond = {
+        {1,1},
+        {1,-1},
+        {-1,1},
+        {-1,-1}
+    };
+
+    Flowpipe flowpipe;
+    flowpipe.push_back(SetsUnion<Polytope>(Polytope(box, {1,1,0,0})));
+
+    SetsUnion<Polytope> step(Polytope(box, {3,3,2,2}));
+    step.add(Polytope(diamond, {10,1,1,-8}));
+    flowpipe.push_back(step);
+    flowpipe.push_back(SetsUnion<Polytope>(Polytope(diamond, {2,1,1,0})));
+
+    const std::string filename = "test_binary_flowpipe.bin";
+    {
+        std::ofstream os(filename, std::ios::binary);
+        write_binary(os, flowpipe);
+    }
+
+    {
+        BinaryFlowpipeReader reader(filename);
+
+        BOOST_REQUIRE(reader.size() == flowpipe.size());
+        BOOST_CHECK(reader.dim() == 2);
+        BOOST_CHECK(reader.num_of_templates() == 2);
+
+        for (size_t epoch = 0; epoch < flowpipe.size(); ++epoch) {
+            const SetsUnion<Polytope> read = reader.get(epoch);
+
+            BOOST_REQUIRE(reader.num_of_polytopes(epoch)
+                          == flowpipe[epoch].size());
+            BOOST_REQUIRE(read.size() == flowpipe[epoch].size());
+
+            auto it = std::cbegin(read);
+            for (const Polytope &P: flowpipe[epoch]) {
+                BOOST_CHECK(same_polytopes(*it, P));
+
+                const size_t index = std::distance(std::cbegin(read), it);
+                const double *bounds = reader.bounds(epoch, index);
+                for (size_t i = 0; i < P.size(); ++i) {
+                    BOOST_CHECK(bounds[i] == P.b()[i]);
+                }
+                ++it;
+            }
+        }
+
+        BOOST_CHECK(reader.template_of(1, 0) == reader.template_of(0, 0));
+        BOOST_CHECK(reader.template_of(2, 0) == reader.template_of(1, 1));
+        BOOST_CHECK_THROW(reader.get(3), std::domain_error);
+    }
+
+    // a truncated file must be rejected
+    {
+        std::ifstream is(filename, std::ios::binary);
+        std::string content((std::istreambuf_iterator<char>(is)),
+                            std::istreambuf_iterator<char>());
+        is.close();
+
+        // the words are little-endian whatever the host byte order is
+        BOOST_CHECK(content.compare(0, 8, "FLOWPIPE") == 0);
+
+        std::ofstream os(filename, std::ios::binary);
+        os.write(content.data(), content.size() - 8);
+    }
+
+    BOOST_CHECK_THROW(BinaryFlowpipeReader reader(filename),
+                      std::runtime_error);
+
+    std::remove(filename.c_str());
+}
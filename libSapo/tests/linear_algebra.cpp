@@ -4,6 +4,8 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/mpl/list.hpp>
 
+#include <random>
+
 #include "LinearAlgebra.h"
 #include "LinearAlgebraIO.h"
 
@@ -706,6 +708,28 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_dense_matrix_solve, T, test_types)
     }
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_dense_matrix_solve_transposed, T, test_types)
+{
+    using namespace LinearAlgebra;
+    using namespace LinearAlgebra::Dense;
+
+    std::vector<std::pair<std::pair<Matrix<T>, Vector<T>>, Vector<T>>> tests{
+        {{{{1,0,0},{0,1,0},{0,0,1}}, {1,2,3}}, {1,2,3}},
+        {{{{0,1,0},{0,0,1},{1,0,0}}, {1,2,3}}, {3,1,2}},
+        {{{{0,3,1},{1,15,1},{7,0,0}}, {5,18,7}}, {1,1,2}},
+        {{{{0,3,1},{-21,3,1},{1,2,1}}, {9,-12,8}}, {1,2,3}},
+    };
+
+    for (auto test_it = std::begin(tests); test_it != std::end(tests); ++test_it) {
+
+        LUP_Factorization<T> fact(transpose(test_it->first.first));
+        std::vector<T> sol = fact.solve_transposed(test_it->first.second);
+        bool beval = (sol == test_it->second);
+        BOOST_REQUIRE_MESSAGE(beval, "solve_transposed(" << transpose(test_it->first.first) << "," << test_it->first.second << ") == " 
+                                          << sol << " != " << test_it->second );   
+    }
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_sparse_matrix_solve, T, test_types)
 {
     using namespace LinearAlgebra;
@@ -845,3 +869,65 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_sparse_matrix_inverse, T, test_types)
         BOOST_REQUIRE_THROW(inverse(A), std::domain_error);
     }
 }
+
+BOOST_AUTO_TEST_CASE(test_kernels_instruction_sets)
+{
+    using namespace LinearAlgebra;
+
+    const Kernels::InstructionSet default_set = Kernels::instruction_set();
+    BOOST_REQUIRE(Kernels::is_supported(default_set));
+
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> dist(-10, 10);
+
+    for (size_t size = 0; size <= 21; ++size) {
+        Vector<double> a(size), b(size), row(size), pivot_row(size);
+        for (size_t i = 0; i < size; ++i) {
+            a[i] = dist(gen);
+            b[i] = dist(gen);
+            pivot_row[i] = dist(gen);
+
+            // some entries cancel out exactly
+            row[i] = (i%3==0 ? 3*pivot_row[i] : dist(gen));
+        }
+
+        BOOST_REQUIRE(Kernels::select(Kernels::InstructionSet::SCALAR));
+        const double expected_dot = Kernels::dispatched_dot(a.data(), b.data(),
+                                                            size);
+        Vector<double> expected_axpy(b), expected_row(row);
+        Kernels::dispatched_axpy(1.5, a.data(), expected_axpy.data(), size);
+        Kernels::dispatched_eliminate(expected_row.data(), pivot_row.data(),
+                                      6, 2, size);
+
+        // the inlined scalar code must agree with the kernels
+        BOOST_CHECK(Kernels::dot(a.data(), b.data(), size)==expected_dot);
+        BOOST_CHECK(a*b==expected_dot);
+
+        for (size_t i = 0; i < size; ++i) {
+            BOOST_CHECK(i%3!=0 || expected_row[i]==0);
+        }
+
+        for (const auto &instruction_set: {Kernels::InstructionSet::AVX2,
+                                           Kernels::InstructionSet::AVX512}) {
+            if (!Kernels::select(instruction_set)) {
+                BOOST_CHECK(!Kernels::is_supported(instruction_set));
+                continue;
+            }
+            BOOST_CHECK(Kernels::instruction_set()==instruction_set);
+
+            // the results must be bitwise identical
+            BOOST_CHECK(Kernels::dispatched_dot(a.data(), b.data(),
+                                                size)==expected_dot);
+
+            Vector<double> axpy_res(b), row_res(row);
+            Kernels::dispatched_axpy(1.5, a.data(), axpy_res.data(), size);
+            Kernels::dispatched_eliminate(row_res.data(), pivot_row.data(),
+                                          6, 2, size);
+
+            BOOST_CHECK(axpy_res==expected_axpy);
+            BOOST_CHECK(row_res==expected_row);
+        }
+    }
+
+    BOOST_REQUIRE(Kernels::select(default_set));
+}
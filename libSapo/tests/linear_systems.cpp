@@ -5,6 +5,7 @@
 #include <boost/mpl/list.hpp>
 
 #include <sstream>
+#include <cmath>
 
 #include "LinearSystem.h"
 #include "LinearAlgebra.h"
@@ -247,4 +248,73 @@ BOOST_AUTO_TEST_CASE(test_simplify_linear_systems)
     BOOST_CHECK(LinearSystem(A,{1,2,3,3,2,1})==ls1);
     BOOST_CHECK(ls2==ls1);
     BOOST_CHECK(ls3==ls1);
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE(test_simplify_degenerate_linear_systems)
+{
+    using namespace LinearAlgebra;
+    using namespace LinearAlgebra::Dense;
+
+    // scaled copies of the same rows and a null row
+    Matrix<double> A = {
+        {1,0},
+        {2,0},
+        {0,1},
+        {0,0},
+        {-1,0},
+        {0,-4},
+        {0,-1}
+    };
+
+    LinearSystem ls1(A,{1,3,1,2,0,0,1});
+
+    ls1.simplify();
+    BOOST_CHECK(ls1.size()==4);
+    BOOST_CHECK(ls1==LinearSystem({{1,0},{0,1},{-1,0},{0,-1}},
+                                  {1,1,0,0}));
+
+    // the solution set is a segment: the rows `y <= 1` and
+    // `x + y <= 1` are redundant, but not both of them
+    Matrix<double> B = {
+        {1,0},
+        {-1,0},
+        {0,1},
+        {1,1},
+        {0,-1}
+    };
+
+    LinearSystem ls2(B,{0,0,1,1,0});
+
+    ls2.simplify();
+    BOOST_CHECK(ls2.size()==4);
+    BOOST_CHECK(ls2==LinearSystem(B,{0,0,1,1,0}));
+
+    // a polygon with many never-tight rows
+    Matrix<double> C;
+    Vector<double> c;
+    for (unsigned int i=0; i<16; ++i) {
+        const double angle = 2*i*3.14159265358979/16;
+        C.push_back({std::cos(angle), std::sin(angle)});
+        c.push_back(1);
+        C.push_back({std::cos(angle), std::sin(angle)});
+        c.push_back(1.5+i);
+        C.push_back({std::cos(angle)+std::sin(angle),
+                     std::sin(angle)-std::cos(angle)});
+        c.push_back(10);
+    }
+
+    LinearSystem ls3(C,c);
+
+    BOOST_CHECK(ls3.get_simplified().size()==16);
+    BOOST_CHECK(ls3.get_simplified()==ls3);
+
+    // an unfeasible system
+    LinearSystem ls4({{1,0},{-1,0},{0,1}},{0,-1,1});
+
+    ls4.simplify();
+    BOOST_CHECK(!ls4.has_solutions());
+
+    LinearSystem ls5;
+    ls5.simplify();
+    BOOST_CHECK(ls5.size()==0);
+}
@@ -85,4 +85,121 @@ BOOST_AUTO_TEST_CASE(test_transform_dynamic_bundle)
         next = T(next);
     }
     BOOST_CHECK(epsilon_equivalent(rSet, next, 3e-7));
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_polynomial_integrators, T, test_types)
+{
+    using namespace SymbolicAlgebra;
+
+    Symbol<T> x("x"), y("y"), step("time step");
+    ODE<T> ode({x,y},{-y,x}, "time");
+
+    RungeKutta4Integrator rk4;
+    PolynomialRungeKutta4Integrator poly_rk4;
+    TaylorIntegrator taylor4(4);
+
+    // on linear ODEs the 4th order Taylor series and RK4 coincide
+    const std::vector<Symbol<T>> vars{x, y, step};
+    const auto rk_system = rk4(ode, step);
+    const auto poly_system = poly_rk4(ode, step);
+    const auto taylor_system = taylor4(ode, step);
+    for (size_t i=0; i<2; ++i) {
+        Polynomial<T> expected(rk_system.dynamics()[i], vars);
+        BOOST_CHECK(Polynomial<T>(poly_system.dynamics()[i], vars)==expected);
+        BOOST_CHECK(Polynomial<T>(taylor_system.dynamics()[i], vars)==expected);
+    }
+    BOOST_CHECK(poly_system.parameters().empty());
+
+    const T step_value = T(1)/8;
+    const auto discrete_system = poly_rk4(ode, step_value);
+    for (size_t i=0; i<2; ++i) {
+        auto expected = rk_system.dynamics()[i];
+        expected.replace({{step, Expression<T>(step_value)}});
+        BOOST_CHECK(Polynomial<T>(discrete_system.dynamics()[i], {x, y})
+                    ==Polynomial<T>(expected, {x, y}));
+    }
+
+    // the Taylor order bounds the degree in the time step
+    const auto taylor2_system = TaylorIntegrator(2)(ode, step);
+    BOOST_CHECK(Polynomial<T>(taylor2_system.dynamics()[0], vars).degree(2)==2);
+
+    // time-dependent ODEs
+    Symbol<T> time("time");
+    ODE<T> time_ode({x},{time*x}, "time");
+    const auto time_system = poly_rk4(time_ode, step);
+    BOOST_REQUIRE(time_system.variables().size()==2);
+    BOOST_CHECK(time_system.dynamics()[1]-(time+step)==0);
+
+    BOOST_REQUIRE_THROW(poly_rk4(ode, x), std::domain_error);
+    BOOST_REQUIRE_THROW(PolynomialRungeKutta4Integrator(2)(ode, step_value),
+                        std::domain_error);
+    BOOST_REQUIRE_THROW(poly_rk4(ODE<T>({x, y},{x/y, x}, "time"), step_value),
+                        std::domain_error);
+}
+
+template<typename T, typename INTEGRATOR>
+void test_truncation(const INTEGRATOR &integrator,
+                     const INTEGRATOR &truncating_integrator)
+{
+    using namespace SymbolicAlgebra;
+
+    // the FitzHugh-Nagumo model
+    Symbol<T> v("v"), w("w");
+    const T a = T(7)/10, b = T(4)/5, c = T(1)/25, I = T(7)/8;
+    ODE<T> ode({v,w},{v-v*v*v/3-w+I, c*(v+a-b*w)}, "time");
+
+    const T time_step = T(1)/10;
+    const typename PolynomialODEIntegrator::domain_type<T> domain{
+        {v, Interval<T>(-2, 2)}, {w, Interval<T>(-1, 2)}};
+
+    typename PolynomialODEIntegrator::domain_type<T> remainders;
+    const auto full = integrator(ode, time_step);
+    const auto truncated = truncating_integrator(ode, time_step, domain,
+                                                 remainders);
+
+    BOOST_REQUIRE(remainders.size()==truncated.parameters().size());
+    BOOST_REQUIRE(remainders.size()==2);
+
+    std::vector<Symbol<T>> vars{v, w};
+    for (const auto &param: truncated.parameters()) {
+        vars.push_back(param);
+    }
+
+    const std::vector<T> samples{-2, -1, T(-1)/3, 0, T(1)/2, 1, 2};
+    for (size_t i=0; i<2; ++i) {
+        const Polynomial<T> p_full(full.dynamics()[i], vars);
+        const Polynomial<T> p_truncated(truncated.dynamics()[i], vars);
+
+        BOOST_CHECK(p_full.total_degree()>3);
+        BOOST_CHECK(p_truncated.total_degree()<=3);
+
+        // the remainders bound the truncation error in the domain
+        const auto &remainder = remainders.at(vars[2+i]);
+        for (const auto &v_value: samples) {
+            for (const auto &w_value: samples) {
+                if (domain.at(w).contains(w_value)) {
+                    std::vector<T> values{v_value, w_value, 0, 0};
+                    const T error = p_full.evaluate(values)
+                                    - p_truncated.evaluate(values);
+
+                    // up to the rounding errors of the evaluations
+                    BOOST_CHECK(remainder.lower()-APPROX_ERR<=error
+                                && error<=remainder.upper()+APPROX_ERR);
+                }
+            }
+        }
+    }
+
+    // the truncation domain must bound all the variables
+    BOOST_REQUIRE_THROW(truncating_integrator(ode, time_step,
+                                              {{v, Interval<T>(-2, 2)}},
+                                              remainders),
+                        std::domain_error);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_truncated_integrators, T, test_types)
+{
+    test_truncation<T>(PolynomialRungeKutta4Integrator(),
+                       PolynomialRungeKutta4Integrator(3));
+    test_truncation<T>(TaylorIntegrator(3), TaylorIntegrator(3, 3));
+}
@@ -67,6 +67,43 @@ BOOST_AUTO_TEST_CASE(test_is_empty_polytope)
     BOOST_CHECK(p.is_empty());
 }
 
+BOOST_AUTO_TEST_CASE(test_memoized_emptiness_polytope)
+{
+    using namespace LinearAlgebra;
+    using namespace LinearAlgebra::Dense;
+
+    Matrix<double> A = {
+        {1,0},
+        {0,1},
+        {-1,0},
+        {0,-1}
+    };
+
+    Polytope p1(A,{1,1,0,0}), p2(A,{3,3,-2,-2});
+
+    BOOST_CHECK(!p1.is_empty());
+    BOOST_CHECK(!p1.is_empty());
+
+    // copies carry the memoized properties, changes invalidate them
+    Polytope p3 = p1;
+    p3.intersect_with(p2);
+    BOOST_CHECK(!p1.is_empty());
+    BOOST_CHECK(p3.is_empty());
+
+    p3.expand_by(2);
+    BOOST_CHECK(!p3.is_empty());
+
+    p1.add_constraint({1,1}, -1);
+    BOOST_CHECK(p1.is_empty());
+    BOOST_CHECK(p1.is_subset_of(p2));
+    BOOST_CHECK(!p2.is_subset_of(p1));
+
+    p1 = p2;
+    BOOST_CHECK(!p1.is_empty());
+    BOOST_CHECK(p1.is_subset_of(p2));
+    BOOST_CHECK(!p1.is_subset_of(Polytope(A,{1,1,0,0})));
+}
+
 BOOST_AUTO_TEST_CASE(test_includes_polytope)
 {
     using namespace LinearAlgebra;
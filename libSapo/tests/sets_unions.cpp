@@ -3,11 +3,18 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <random>
+#include <set>
 #include <sstream>
 
 #include "Polytope.h"
 #include "Bundle.h"
 #include "SetsUnion.h"
+#include "BoxTree.h"
+
+#ifdef WITH_THREADS
+#include "SapoThreads.h"
+#endif
 
 BOOST_AUTO_TEST_CASE(test_sets_union)
 {
@@ -410,6 +417,48 @@ BOOST_AUTO_TEST_CASE(test_make_union_sets_union)
     BOOST_REQUIRE_THROW(res1.update(Pu5), std::domain_error);
 }
 
+BOOST_AUTO_TEST_CASE(test_make_union_of_unions_vector)
+{
+    using namespace LinearAlgebra;
+    using namespace LinearAlgebra::Dense;
+
+    Matrix<double> A = {
+        {1,0},
+        {0,1},
+        {-1,0},
+        {0,-1}
+    };
+
+#ifdef WITH_THREADS
+    thread_pool.reset(3);
+#endif
+
+    // boxes [i/3, i/3+1+i%4] x [0, 1+i%3]: many of them include others
+    std::vector<SetsUnion<Polytope>> unions;
+    SetsUnion<Polytope> expected;
+    for (unsigned int i = 0; i < 37; ++i) {
+        Polytope box(A, {i/3.0+1+i%4, 1.0+i%3, -(i/3.0), 0});
+
+        expected.add(box);
+        unions.emplace_back(box);
+        if (i%5 == 0) {
+            unions.emplace_back();
+        }
+    }
+
+    SetsUnion<Polytope> result = make_union(std::move(unions));
+
+    BOOST_CHECK(result.size() == expected.size());
+    BOOST_CHECK(result.includes(expected));
+    BOOST_CHECK(expected.includes(result));
+
+    BOOST_CHECK(make_union(std::vector<SetsUnion<Polytope>>()).is_empty());
+
+#ifdef WITH_THREADS
+    thread_pool.reset(0);
+#endif
+}
+
 BOOST_AUTO_TEST_CASE(test_update_sets_union)
 {
     using namespace LinearAlgebra;
@@ -758,4 +807,119 @@ BOOST_AUTO_TEST_CASE(test_includes_sets_union)
     BOOST_CHECK(bsu.includes(bsu2));
     BOOST_CHECK(!bsu2.includes(bsu));
     */
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE(test_box_tree)
+{
+    using namespace LinearAlgebra;
+
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<double> coord(0, 100), side(0, 10);
+
+    std::vector<BoundingBox> boxes;
+    for (size_t i = 0; i < 300; ++i) {
+        Vector<double> lower{coord(gen), coord(gen)};
+        boxes.emplace_back(lower, lower + Vector<double>{side(gen), side(gen)});
+    }
+
+    BoxTree<size_t> tree;
+    std::set<size_t> indexed;
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        tree.insert(boxes[i], i);
+        indexed.insert(i);
+    }
+
+    // remove one third of the boxes
+    for (size_t i = 0; i < boxes.size(); i += 3) {
+        BOOST_CHECK(tree.erase(boxes[i], i));
+        indexed.erase(i);
+    }
+    BOOST_CHECK(!tree.erase(boxes[0], 0));
+    BOOST_CHECK(tree.size() == indexed.size());
+
+    for (size_t q = 0; q < 50; ++q) {
+        Vector<double> lower{coord(gen), coord(gen)};
+        BoundingBox query(lower, lower + Vector<double>{side(gen), side(gen)});
+
+        std::set<size_t> expected, found;
+        for (const auto &i: indexed) {
+            if (!are_disjoint(boxes[i], query)) {
+                expected.insert(i);
+            }
+        }
+        tree.for_each_overlapping(query, [&found](const size_t &i) {
+            found.insert(i);
+        });
+
+        BOOST_CHECK(found == expected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_indexed_sets_union)
+{
+    using namespace LinearAlgebra;
+
+    std::vector<Vector<double>> A = {
+        {1,0},
+        {0,1}
+    };
+
+    BOOST_CHECK(SetsUnion<Bundle>::is_indexed);
+    BOOST_CHECK(SetsUnion<Polytope>::is_indexed);
+
+    // a grid of unit squares and, then, the squares
+    // including each pair of consecutive squares on a row
+    SetsUnion<Bundle> grid;
+    for (int i = 0; i < 10; ++i) {
+        for (int j = 0; j < 10; ++j) {
+            BOOST_CHECK(grid.add(Bundle(A, {2.0*i, 2.0*j}, {2.0*i+1, 2.0*j+1})));
+        }
+    }
+    BOOST_CHECK(grid.size() == 100);
+
+    BOOST_CHECK(!grid.add(Bundle(A, {0.25, 0.25}, {0.75, 0.75})));
+    BOOST_CHECK(grid.any_includes(Bundle(A, {4.25, 6.25}, {4.75, 6.75})));
+    BOOST_CHECK(!grid.any_includes(Bundle(A, {1.25, 6.25}, {1.75, 6.75})));
+    BOOST_CHECK(are_disjoint(grid, Bundle(A, {1.25, 6.25}, {1.75, 6.75})));
+    BOOST_CHECK(!are_disjoint(grid, Bundle(A, {0.5, 6.5}, {2.5, 6.75})));
+    BOOST_CHECK(!grid.is_subset_of(Bundle(A, {0, 0}, {10, 10})));
+    BOOST_CHECK(grid.is_subset_of(Bundle(A, {0, 0}, {19, 19})));
+
+    for (int i = 0; i < 10; i += 2) {
+        for (int j = 0; j < 10; ++j) {
+            BOOST_CHECK(grid.add(Bundle(A, {2.0*i, 2.0*j}, {2.0*i+3, 2.0*j+1})));
+        }
+    }
+    BOOST_CHECK(grid.size() == 50);
+
+    SetsUnion<Bundle> copy(grid), other;
+    BOOST_CHECK(copy.size() == 50);
+    BOOST_CHECK(!copy.add(Bundle(A, {2.25, 0.25}, {2.75, 0.75})));
+    BOOST_CHECK(copy.add(Bundle(A, {0, 0}, {19, 1})));
+    BOOST_CHECK(copy.size() == 46);
+
+    other = copy;
+    other.expand_by(0.5);
+    BOOST_CHECK(other.any_includes(Bundle(A, {-0.25, -0.25}, {19.25, 1.25})));
+    BOOST_CHECK(!copy.any_includes(Bundle(A, {-0.25, -0.25}, {19.25, 1.25})));
+
+    // the next addition re-indexes the expanded sets
+    BOOST_CHECK(other.add(Bundle(A, {30, 30}, {31, 31})));
+    BOOST_CHECK(other.size() == 47);
+    BOOST_CHECK(other.any_includes(Bundle(A, {-0.25, -0.25}, {19.25, 1.25})));
+    BOOST_CHECK(!other.add(Bundle(A, {18.75, 16.75}, {19.25, 17.25})));
+
+    // updates reuse the indexed boxes
+    SetsUnion<Bundle> joined;
+    joined.update(other);
+    BOOST_CHECK(joined.size() == 47);
+    BOOST_CHECK(joined.any_includes(Bundle(A, {18.75, 16.75}, {19.25, 17.25})));
+    BOOST_CHECK(!joined.any_includes(Bundle(A, {20.25, 0.25}, {20.75, 0.75})));
+    joined.update(std::move(other));
+    BOOST_CHECK(joined.size() == 47);
+
+    SetsUnion<Bundle> moved(std::move(copy));
+    BOOST_CHECK(moved.size() == 46);
+    BOOST_CHECK(moved.add(Bundle(A, {0, 0}, {19, 19})));
+    BOOST_CHECK(moved.size() == 1);
+}
@@ -1,6 +1,8 @@
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE simplex
 
+#include <cmath>
+
 #include <boost/test/unit_test.hpp>
 #include <boost/mpl/list.hpp>
 
@@ -352,4 +354,378 @@ BOOST_AUTO_TEST_CASE(test_simplex_GPLK_bug)
         BOOST_CHECK(value>=0);
     }
     BOOST_CHECK(approximate<double>(result,objective_value));
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_simplex_batch, T, test_types)
+{
+    using namespace LinearAlgebra;
+    using namespace LinearAlgebra::Dense;
+
+    Matrix<T> A = {
+        {1,1,0},
+        {0,1,0},
+        {0,0,1},
+        {-1,0,0},
+        {0,-1,2},
+        {0,0,-1}
+    };
+
+    Vector<T> b = {1,2,3,3,2,1};
+
+    std::vector<Vector<T>> objectives = {
+        {1,0,0},
+        {0,1,0},
+        {25,0,-3},
+        {-1,2,0},
+        {0,-1,-1}
+    };
+
+    SimplexMethodOptimizer optimizer;
+    SimplexMethodOptimizer::BatchOptimizer<T> batch(A, b, objectives);
+
+    BOOST_CHECK(batch.size() == objectives.size());
+    BOOST_CHECK(!batch.feasible_set_is_empty());
+
+    for (size_t i = 0; i < objectives.size(); ++i) {
+        for (auto goal: {OptimizationGoal::MINIMIZE,
+                         OptimizationGoal::MAXIMIZE}) {
+            auto expected = optimizer(A, b, objectives[i], goal);
+            auto result = batch(i, goal);
+
+            BOOST_CHECK(result.status() == expected.status());
+            BOOST_CHECK_MESSAGE(result.optimum() == expected.optimum(),
+                                "optimizing " << objectives[i] << " on "
+                                "A x<= b where A: " << A << " and b: " <<
+                                b << " produces " << result.optimum() <<
+                                ": " << expected.optimum() <<
+                                " was expected.");
+            BOOST_CHECK(result.objective_value() ==
+                        expected.objective_value());
+        }
+    }
+
+    BOOST_CHECK_THROW(batch.minimize(objectives.size()),
+                      std::domain_error);
+
+    // infeasible systems
+    b[5] = -4;
+
+    SimplexMethodOptimizer::BatchOptimizer<T> infeasible(A, b, objectives);
+
+    BOOST_CHECK(infeasible.feasible_set_is_empty());
+    for (size_t i = 0; i < objectives.size(); ++i) {
+        BOOST_CHECK(infeasible.maximize(i).status() ==
+                    OptimizationResult<T>::INFEASIBLE);
+    }
+
+    // unbounded objectives
+    A.resize(3);
+    b.resize(3);
+
+    SimplexMethodOptimizer::BatchOptimizer<T> unbounded(A, b, objectives);
+
+    BOOST_CHECK(!unbounded.feasible_set_is_empty());
+    BOOST_CHECK(unbounded.minimize(0).status() ==
+                OptimizationResult<T>::UNBOUNDED);
+    BOOST_CHECK(is_exactly<T>(unbounded.maximize(1), 2));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_revised_simplex, T, test_types)
+{
+    using namespace LinearAlgebra;
+    using namespace LinearAlgebra::Dense;
+
+    std::vector<std::pair<Matrix<T>, Vector<T>>> systems = {
+        {{{1,1,0}, {0,1,0}, {0,0,1}, {-1,0,0}, {0,-1,2}, {0,0,-1}},
+         {1,2,3,3,2,1}},
+        {{{1,0,0}, {0,1,0}, {0,0,1}, {-1,0,0}, {0,-1,0}, {0,0,-1}},
+         {1,2,3,-1,2,1}},
+        {{{1,0,0}, {0,1,0}, {0,0,1}, {-1,0,0}, {0,-1,0}, {0,0,-1}},
+         {1,2,3,-3,2,1}},
+        {{{0,1,0}, {0,0,1}, {-1,0,0}, {0,-1,0}},
+         {2,3,3,2}},
+        {{{1,2,-1}, {-3,1,1}, {1,-1,2}, {-1,-1,-1}, {2,1,-3}},
+         {4,-1,5,-2,3}}
+    };
+
+    std::vector<Vector<T>> objectives = {
+        {1,0,0},
+        {0,1,0},
+        {25,0,-3},
+        {-1,2,0},
+        {0,-1,-1}
+    };
+
+    SimplexMethodOptimizer tableau;
+    RevisedSimplexMethodOptimizer revised;
+
+    for (const auto& system: systems) {
+        const auto& A = system.first;
+        const auto& b = system.second;
+        for (const auto& obj: objectives) {
+            for (auto goal: {OptimizationGoal::MINIMIZE,
+                             OptimizationGoal::MAXIMIZE}) {
+                auto expected = tableau(A, b, obj, goal);
+                auto result = revised(A, b, obj, goal);
+
+                BOOST_CHECK_MESSAGE(result.status() == expected.status(),
+                                    "optimizing " << obj << " on "
+                                    "A x<= b where A: " << A << " and b: " <<
+                                    b << " produces " << result.status() <<
+                                    ": " << expected.status() <<
+                                    " was expected.");
+                if (expected.status() ==
+                        OptimizationResult<T>::OPTIMUM_AVAILABLE) {
+                    BOOST_CHECK(approximate<T>(result,
+                                               expected.objective_value()));
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_bounded_dual_simplex, T, test_types)
+{
+    using namespace LinearAlgebra;
+    using namespace LinearAlgebra::Dense;
+
+    Matrix<T> D = {
+        {1,0,0},
+        {0,1,0},
+        {0,0,1},
+        {1,1,0},
+        {0,-1,2},
+        {1,-1,1}
+    };
+
+    Vector<T> lower = {-3,-2,-1,-1,-2,-4};
+    Vector<T> upper = {1,2,3,1,2,1};
+
+    std::vector<Vector<T>> objectives = {
+        {1,0,0},
+        {0,1,0},
+        {25,0,-3},
+        {-1,2,0},
+        {0,-1,-1},
+        {0,0,0}
+    };
+
+    // the split system
+    Matrix<T> A;
+    Vector<T> b;
+    for (size_t i = 0; i < D.size(); ++i) {
+        A.push_back(D[i]);
+        b.push_back(upper[i]);
+        A.push_back(-D[i]);
+        b.push_back(-lower[i]);
+    }
+
+    SimplexMethodOptimizer tableau;
+    BoundedDualSimplexOptimizer<T> optimizer(D, lower, upper, {3, 4, 5},
+                                             objectives);
+
+    BOOST_CHECK(optimizer.size() == objectives.size());
+    BOOST_CHECK(!optimizer.feasible_set_is_empty());
+
+    for (size_t i = 0; i < objectives.size(); ++i) {
+        for (auto goal: {OptimizationGoal::MINIMIZE,
+                         OptimizationGoal::MAXIMIZE}) {
+            auto expected = tableau(A, b, objectives[i], goal);
+            auto result = optimizer(i, goal);
+
+            BOOST_REQUIRE(result.status() == expected.status());
+            BOOST_CHECK_MESSAGE(approximate<T>(result,
+                                               expected.objective_value()),
+                                "optimizing " << objectives[i] << " on "
+                                "l <= D x <= u where D: " << D << ", l: " <<
+                                lower << ", and u: " << upper <<
+                                " produces " << result.objective_value() <<
+                                ": " << expected.objective_value() <<
+                                " was expected.");
+            for (size_t j = 0; j < D.size(); ++j) {
+                const T value = D[j] * result.optimum();
+                BOOST_CHECK(value - upper[j] <= admitted_error<T>());
+                BOOST_CHECK(lower[j] - value <= admitted_error<T>());
+            }
+        }
+    }
+
+    BOOST_CHECK_THROW(optimizer.minimize(objectives.size()),
+                      std::domain_error);
+
+    // infeasible systems
+    lower[5] = 2;
+
+    BoundedDualSimplexOptimizer<T> infeasible(D, lower, upper, {0, 1, 2},
+                                              objectives);
+
+    BOOST_CHECK(infeasible.feasible_set_is_empty());
+    for (size_t i = 0; i < objectives.size(); ++i) {
+        BOOST_CHECK(infeasible.maximize(i).status() ==
+                    OptimizationResult<T>::INFEASIBLE);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_bounded_dual_simplex_unbounded)
+{
+    using namespace LinearAlgebra;
+    using namespace LinearAlgebra::Dense;
+
+    const double inf = std::numeric_limits<double>::infinity();
+
+    Matrix<double> D = {
+        {1,0},
+        {0,1},
+        {1,1}
+    };
+
+    Vector<double> lower = {-inf,-1,0};
+    Vector<double> upper = {2,1,inf};
+
+    BoundedDualSimplexOptimizer<double> optimizer(D, lower, upper, {0, 1},
+                                                  {{1,0}, {0,1}});
+
+    BOOST_CHECK(!optimizer.feasible_set_is_empty());
+    BOOST_CHECK(is_exactly<double>(optimizer.maximize(0), 2));
+    BOOST_CHECK(is_exactly<double>(optimizer.minimize(0), -1));
+    BOOST_CHECK(is_exactly<double>(optimizer.maximize(1), 1));
+    BOOST_CHECK(is_exactly<double>(optimizer.minimize(1), -1));
+
+    D[2] = {1,-1};
+    lower[2] = -inf;
+    upper[2] = 0;
+    BoundedDualSimplexOptimizer<double> unbounded(D, lower, upper, {0, 1},
+                                                  {{1,0}, {0,1}});
+
+    BOOST_CHECK(!unbounded.feasible_set_is_empty());
+    BOOST_CHECK(unbounded.minimize(0).status() ==
+                OptimizationResult<double>::UNBOUNDED);
+    BOOST_CHECK(is_exactly<double>(unbounded.maximize(0), 1));
+}
+
+BOOST_AUTO_TEST_CASE(test_bounded_dual_simplex_refactorization)
+{
+    using namespace LinearAlgebra;
+    using namespace LinearAlgebra::Dense;
+
+    // a polygon with many sides requires many pivots to move
+    // from a vertex to the opposite one
+    const size_t sides = 301;
+    Matrix<double> D;
+    for (size_t i = 0; i < sides; ++i) {
+        const double angle = 2 * std::acos(-1.0) * i / sides;
+        D.push_back({std::cos(angle), std::sin(angle)});
+    }
+    Vector<double> lower(sides, -1), upper(sides, 1);
+
+    std::vector<Vector<double>> objectives = {{-1, -0.01}, {0.3, -1}};
+
+    Matrix<double> A;
+    Vector<double> b;
+    for (size_t i = 0; i < D.size(); ++i) {
+        A.push_back(D[i]);
+        b.push_back(upper[i]);
+        A.push_back(-D[i]);
+        b.push_back(-lower[i]);
+    }
+
+    SimplexMethodOptimizer tableau;
+    BoundedDualSimplexOptimizer<double> optimizer(D, lower, upper, {0, 75},
+                                                  objectives);
+
+    BOOST_CHECK(!optimizer.feasible_set_is_empty());
+    for (size_t i = 0; i < objectives.size(); ++i) {
+        for (auto goal: {OptimizationGoal::MINIMIZE,
+                         OptimizationGoal::MAXIMIZE}) {
+            auto expected = tableau(A, b, objectives[i], goal);
+            auto result = optimizer(i, goal);
+
+            BOOST_REQUIRE(result.status() == expected.status());
+            BOOST_CHECK(approximate<double>(result,
+                                            expected.objective_value()));
+        }
+    }
+}
+
+#ifdef HAVE_GMP
+BOOST_AUTO_TEST_CASE(test_hybrid_bounded_dual_simplex)
+{
+    using namespace LinearAlgebra;
+    using namespace LinearAlgebra::Dense;
+
+    Matrix<double> D = {
+        {1,0,0},
+        {0,1,0},
+        {0,0,1},
+        {1,1,0},
+        {0,-1,2},
+        {1,-1,1},
+        {0.1,0.2,0.3}
+    };
+
+    Vector<double> lower = {-3,-2,-1,-1,-2,-4,-0.3};
+    Vector<double> upper = {1,2,3,1,2,1,0.7};
+
+    std::vector<Vector<double>> objectives = {
+        {1,0,0},
+        {0.1,0.2,0.3},
+        {25,0,-3},
+        {-1,2,0.1},
+        {0,-1,-1}
+    };
+
+    auto to_mpq = [](const Vector<double>& v) {
+        return Vector<mpq_class>(std::begin(v), std::end(v));
+    };
+
+    Matrix<mpq_class> exact_D;
+    for (const auto& row: D) {
+        exact_D.push_back(to_mpq(row));
+    }
+
+    std::vector<Vector<mpq_class>> exact_objectives;
+    for (const auto& objective: objectives) {
+        exact_objectives.push_back(to_mpq(objective));
+    }
+
+    BoundedDualSimplexOptimizer<mpq_class> exact(exact_D, to_mpq(lower),
+                                                 to_mpq(upper), {0, 1, 2},
+                                                 exact_objectives);
+    HybridBoundedDualSimplexOptimizer<double, mpq_class> hybrid(D, lower,
+                                                                upper,
+                                                                {0, 1, 2},
+                                                                objectives);
+
+    BOOST_CHECK(!hybrid.feasible_set_is_empty());
+
+    for (size_t i = 0; i < objectives.size(); ++i) {
+        for (auto goal: {OptimizationGoal::MINIMIZE,
+                         OptimizationGoal::MAXIMIZE}) {
+            auto expected = exact(i, goal);
+            auto result = hybrid(i, goal);
+
+            BOOST_REQUIRE(result.status() == expected.status());
+            BOOST_CHECK_MESSAGE(result.objective_value() ==
+                                    expected.objective_value(),
+                                "optimizing " << objectives[i] << " on "
+                                "l <= D x <= u where D: " << D << ", l: " <<
+                                lower << ", and u: " << upper <<
+                                " produces " << result.objective_value() <<
+                                ": " << expected.objective_value() <<
+                                " was expected.");
+        }
+    }
+
+    // a system that is empty because of the rounding of 0.1+0.2
+    Matrix<double> E = {
+        {1,0},
+        {0,1},
+        {1,1}
+    };
+
+    HybridBoundedDualSimplexOptimizer<double, mpq_class> empty(
+        E, {0.1,0.2,0.3}, {0.1,0.2,0.3}, {0,1}, {});
+
+    BOOST_CHECK(empty.feasible_set_is_empty());
+}
+#endif
@@ -4,7 +4,14 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/mpl/list.hpp>
 
+#ifdef WITH_THREADS
+#include <thread>
+#endif // WITH_THREADS
+
 #include "SymbolicAlgebra.h"
+#include "CompiledExpression.h"
+#include "ExpressionDAG.h"
+#include "Polynomial.h"
 
 #ifdef HAVE_GMP
 #include <gmpxx.h>
@@ -29,6 +36,48 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_symbols, T, test_types)
     BOOST_REQUIRE_THROW(Symbol<T>(""), std::domain_error);
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_symbol_blocks, T, test_types)
+{
+    Symbol<T> a1("block_a1");
+
+    auto block = Symbol<T>::get_symbol_block("block_a", 3);
+    BOOST_REQUIRE(block.size()==3);
+    BOOST_REQUIRE(block[1].get_id()==a1.get_id());
+    for (size_t i=0; i<block.size(); ++i) {
+        BOOST_REQUIRE(block[i].get_name()=="block_a"+std::to_string(i));
+    }
+
+    auto larger = Symbol<T>::get_symbol_block("block_a", 200);
+    BOOST_REQUIRE(larger.size()==200);
+    for (size_t i=0; i<block.size(); ++i) {
+        BOOST_REQUIRE(larger[i].get_id()==block[i].get_id());
+    }
+    BOOST_REQUIRE(larger[150].get_id()==Symbol<T>("block_a150").get_id());
+    BOOST_REQUIRE(Symbol<T>::get_symbol_block("block_a", 2).size()==2);
+    BOOST_REQUIRE(Symbol<T>::get_symbol_block("block_a", 0).empty());
+
+#ifdef WITH_THREADS
+    std::vector<std::vector<typename Symbol<T>::SymbolIdType>> ids(4);
+    std::vector<std::thread> threads;
+    for (size_t t=0; t<ids.size(); ++t) {
+        threads.emplace_back([&ids, t]() {
+            for (size_t i=0; i<500; ++i) {
+                ids[t].push_back(Symbol<T>("thread_s"+std::to_string(i)).get_id());
+            }
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+    for (size_t t=1; t<ids.size(); ++t) {
+        BOOST_REQUIRE(ids[t]==ids[0]);
+    }
+    for (size_t i=0; i<ids[0].size(); ++i) {
+        BOOST_REQUIRE(Symbol<T>::get_symbol_name(ids[0][i])=="thread_s"+std::to_string(i));
+    }
+#endif // WITH_THREADS
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_constants, T, test_types)
 {
     std::vector<T> tests{3, 3.4, 0, -1, static_cast<T>(7)/3};
@@ -307,6 +356,231 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_apply, T, test_types)
     }
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_compiled_expressions, T, test_types)
+{
+    Symbol<T> x("x"), y("y"), z("z");
+
+    std::vector<Expression<T>> expressions{
+        3+x,
+        3+4*x-x*y,
+        z*z,
+        3+4*y-x*y+z*(z*y)*z,
+        -y*(x-z*(z*z)-4)+3,
+        x*(y + z*y),
+        (3+z)+(4-(z*z*z+1)*x)*y,
+        3*x/y+4/(x/y),
+        7
+    };
+
+    CompiledExpressions<T> compiled(expressions, {x, y, z});
+
+    BOOST_REQUIRE(compiled.size()==expressions.size());
+    BOOST_REQUIRE(compiled.num_of_slots()==3);
+
+    std::vector<std::vector<T>> interpretations{
+        {1, 1, 2}, {2, 1, 3}, {-1, 2, 0}, {4, -2, 1}
+    };
+
+    for (const auto& values: interpretations) {
+        std::map<Symbol<T>,T> interpretation{
+            {x, values[0]}, {y, values[1]}, {z, values[2]}
+        };
+
+        auto results = compiled.evaluate(values);
+        for (size_t i=0; i<expressions.size(); ++i) {
+            auto eval = expressions[i].apply(interpretation);
+            std::ostringstream ss;
+            ss << "("<< expressions[i] << ").apply(" << interpretation << ") == " 
+               << eval << "!=" << results[i];
+            BOOST_REQUIRE_MESSAGE((eval == results[i]), ss.str());
+        }
+    }
+
+    BOOST_REQUIRE_THROW(compiled.evaluate({1, 2}), std::domain_error);
+    BOOST_REQUIRE_THROW(CompiledExpressions<T>(expressions, {x, y}), 
+                        symbol_evaluation_error);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_expression_DAG, T, test_types)
+{
+    Symbol<T> x("x"), y("y"), z("z");
+
+    const Expression<T> shared = 3+4*y-x*y+z*(z*y)*z;
+
+    std::vector<Expression<T>> expressions{
+        3+x,
+        shared,
+        -y*(x-z*(z*z)-4)+3,
+        x*(y + z*y)*shared,
+        (3+z)+(4-(z*z*z+1)*x)*y + shared,
+        3*x/y+4/(x/y),
+        shared,
+        7
+    };
+
+    ExpressionDAG<T> dag(expressions);
+
+    const auto &ids = dag.roots();
+
+    BOOST_REQUIRE(ids.size()==expressions.size());
+    BOOST_CHECK(ids[1]==ids[6]);
+    BOOST_CHECK(ids[1]!=ids[2]);
+    BOOST_CHECK(dag.intern(3+4*y-x*y+z*(z*y)*z)==ids[1]);
+
+    auto as_string = [](const Expression<T> &expression) {
+        std::ostringstream ss;
+        ss << expression;
+        return ss.str();
+    };
+
+    auto copies = dag.to_expressions(ids);
+    for (size_t i=0; i<expressions.size(); ++i) {
+        BOOST_CHECK_EQUAL(as_string(copies[i]), as_string(expressions[i]));
+    }
+
+    // the graph methods must build the very same trees of the
+    // expression methods
+    typename Expression<T>::replacement_type replacements{
+        {x, y+z*z}, {z, 2*x-y}
+    };
+    auto replaced = dag.replace(ids, replacements);
+    auto expanded = dag.expand(ids);
+    for (size_t i=0; i<expressions.size(); ++i) {
+        Expression<T> expected = expressions[i];
+        expected.replace(replacements);
+        BOOST_CHECK_EQUAL(as_string(replaced[i]), as_string(expected));
+
+        expected = expressions[i];
+        expected.expand();
+        BOOST_CHECK_EQUAL(as_string(expanded[i]), as_string(expected));
+    }
+
+    std::vector<std::vector<T>> interpretations{
+        {1, 1, 2}, {2, 1, 3}, {4, -2, 1}
+    };
+
+    for (const auto& values: interpretations) {
+        std::map<Symbol<T>,T> interpretation{
+            {x, values[0]}, {y, values[1]}, {z, values[2]}
+        };
+
+        auto applied = dag.apply(ids, {{x, values[0]}, {z, values[2]}});
+        auto evaluated = dag.evaluate(ids, interpretation);
+        for (size_t i=0; i<expressions.size(); ++i) {
+            auto expected = expressions[i].apply({{x, values[0]}, {z, values[2]}});
+            BOOST_CHECK_EQUAL(as_string(applied[i]), as_string(expected));
+            BOOST_CHECK(evaluated[i] == expressions[i].apply(interpretation).evaluate());
+        }
+    }
+
+    BOOST_REQUIRE_THROW(dag.evaluate(ids, {{x, 1}, {y, 2}}),
+                        symbol_evaluation_error);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_polynomials, T, test_types)
+{
+    Symbol<T> x("x"), y("y"), z("z");
+    const std::vector<Symbol<T>> vars{x, y, z};
+
+    std::vector<Expression<T>> expressions{
+        3+x,
+        3+4*y-x*y+z*(z*y)*z,
+        -y*(x-z*(z*z)-4)+3,
+        x*(y + z*y)*(x-y),
+        (3+z)+(4-(z*z*z+1)*x)*y,
+        7
+    };
+
+    std::vector<std::vector<T>> values{
+        {1, 1, 2}, {2, 1, 3}, {4, -2, 1}, {0, 0, 0}
+    };
+
+    auto evaluate = [&vars](const Expression<T> &expression,
+                            const std::vector<T> &value) {
+        std::map<Symbol<T>,T> interpretation;
+        for (size_t i=0; i<vars.size(); ++i) {
+            interpretation[vars[i]] = value[i];
+        }
+        return expression.apply(interpretation).evaluate();
+    };
+
+    for (const auto &expression: expressions) {
+        Polynomial<T> p(expression, vars);
+
+        BOOST_REQUIRE(p.num_of_variables()==vars.size());
+        for (size_t i=0; i<vars.size(); ++i) {
+            BOOST_CHECK(p.degree(i)==static_cast<unsigned int>(std::max(0, expression.degree(vars[i]))));
+        }
+        BOOST_CHECK(p.degrees()==std::vector<unsigned int>({p.degree(0), p.degree(1), p.degree(2)}));
+
+        // the monomials are sorted and their coefficients are not null
+        for (size_t i=0; i<p.size(); ++i) {
+            BOOST_CHECK(p.coefficient(i) != 0);
+            if (i>0) {
+                BOOST_CHECK(p.exponents(i-1) < p.exponents(i));
+            }
+        }
+
+        const auto back = p.to_expression(vars);
+        for (const auto &value: values) {
+            BOOST_CHECK(p.evaluate(value)==evaluate(expression, value));
+            BOOST_CHECK(evaluate(back, value)==evaluate(expression, value));
+        }
+
+        BOOST_CHECK(Polynomial<T>(back, vars)==p);
+    }
+
+    BOOST_CHECK(Polynomial<T>(x-x, vars).is_zero());
+    BOOST_CHECK(Polynomial<T>(7, vars).size()==1);
+
+    const Polynomial<T> px = Polynomial<T>::variable(3, 0),
+                        py = Polynomial<T>::variable(3, 1),
+                        pz = Polynomial<T>::variable(3, 2);
+
+    BOOST_CHECK((px+py)*(px-py)==px*px-py*py);
+    BOOST_CHECK((px+py)*(px+py)==Polynomial<T>((x+y)*(x+y), vars));
+    BOOST_CHECK(px-px==Polynomial<T>(3));
+    BOOST_CHECK(-(px*T(2))==T(-2)*px);
+
+    for (const auto &p_expr: expressions) {
+        const Polynomial<T> p(p_expr, vars);
+        for (const auto &q_expr: expressions) {
+            const Polynomial<T> q(q_expr, vars);
+
+            BOOST_CHECK(p+q==Polynomial<T>(p_expr+q_expr, vars));
+            BOOST_CHECK(p-q==Polynomial<T>(p_expr-q_expr, vars));
+            BOOST_CHECK(p*q==Polynomial<T>(p_expr*q_expr, vars));
+        }
+
+        // compose with (y+z^2, 2x-y, x)
+        const std::vector<Polynomial<T>> polys{py+pz*pz, T(2)*px-py, px};
+        auto replaced = p_expr;
+        replaced.replace({{x, y+z*z}, {y, 2*x-y}, {z, x}});
+        BOOST_CHECK(p.compose(polys)==Polynomial<T>(replaced, vars));
+
+        // substitute z by 3
+        const auto substituted = p.substitute(2, 3);
+        BOOST_CHECK(substituted.degree(2)==0);
+        for (const auto &value: values) {
+            BOOST_CHECK(substituted.evaluate(value)
+                        ==p.evaluate({value[0], value[1], 3}));
+        }
+    }
+
+    // dense coefficients
+    const Polynomial<T> p(2*x*x*y - 3*y + 5, {x, y});
+    BOOST_CHECK(p.get_dense_coefficients({2, 1})
+                ==std::vector<T>({5, -3, 0, 0, 0, 2}));
+    BOOST_CHECK(p.get_dense_coefficients({3, 2})
+                ==std::vector<T>({5, -3, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0}));
+    BOOST_REQUIRE_THROW(p.get_dense_coefficients({1, 1}), std::domain_error);
+
+    BOOST_REQUIRE_THROW(Polynomial<T>(x/y, vars), std::domain_error);
+    BOOST_REQUIRE_THROW(Polynomial<T>(x*y, {x}), std::domain_error);
+    BOOST_REQUIRE_THROW(px+Polynomial<T>(2), std::domain_error);
+    BOOST_REQUIRE_THROW(Polynomial<T>::variable(2, 2), std::domain_error);
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_derivative, T, test_types)
 {
     Symbol<T> x("x"), y("y"), z("z");
@@ -336,4 +610,51 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_derivative, T, test_types)
             BOOST_REQUIRE_MESSAGE(are_equivalent(eval,d_it->second), ss.str());
         }
     }
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_expression_arenas, T, test_types)
+{
+    Symbol<T> x("x"), y("y"), z("z");
+
+    const Expression<T> model = 3+4*y-x*y+z*(z*y)*z;
+
+    Expression<T> promoted;
+    {
+        ExpressionArena arena;
+        {
+            ExpressionArena::Scope scope(&arena);
+
+            BOOST_REQUIRE(ExpressionArena::in_arena());
+
+            Expression<T> ex = model;
+            ex.replace({{x, y+z}});
+            ex = ex*ex;
+            ex.expand();
+            for (unsigned int i=0; i<10; ++i) {
+                ex = ex + x*ex;
+                ex.expand();
+            }
+
+            Expression<T> expected = model;
+            expected.replace({{x, y+z}});
+            BOOST_REQUIRE(are_equivalent(expected, 3+4*y-(y+z)*y+z*z*z*y));
+
+            {
+                ExpressionArena::Scope heap_scope(nullptr);
+
+                BOOST_REQUIRE(!ExpressionArena::in_arena());
+
+                promoted = expected;
+            }
+
+            BOOST_REQUIRE(ExpressionArena::in_arena());
+        }
+
+        BOOST_REQUIRE(!ExpressionArena::in_arena());
+    }
+
+    // the promoted expression outlives the arena
+    Expression<T> expected = model;
+    expected.replace({{x, y+z}});
+    BOOST_REQUIRE(are_equivalent(promoted, expected));
+}
@@ -31,7 +31,12 @@ class InputData
 public:
   typedef enum { NOT_DECLARED, ODE, DISCRETE } SpecificationType;
 
-  typedef enum { EULER, RUNGE_KUTTA_4 } IntegratorType;
+  typedef enum {
+    EULER,
+    RUNGE_KUTTA_4,
+    POLYNOMIAL_RUNGE_KUTTA_4,
+    TAYLOR_4
+  } IntegratorType;
 
   InputData();
 
@@ -493,6 +498,16 @@ public:
     return integration_step_set;
   }
 
+  inline void setIntegratorMaxDegree(const unsigned int degree)
+  {
+    integrator_max_degree = degree;
+  }
+
+  inline const unsigned int &getIntegratorMaxDegree() const
+  {
+    return integrator_max_degree;
+  }
+
   inline void setRemoveDuplicateDirs(const bool &flag)
   {
     remove_duplicate_dirs = flag;
@@ -585,6 +600,7 @@ protected:
   bool use_invariant_directions;
   double integration_step;
   IntegratorType integrator_type;
+  unsigned int integrator_max_degree;
   bool remove_duplicate_dirs;
   bool remove_unused_dirs;
 };
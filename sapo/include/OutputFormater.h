@@ -775,4 +775,58 @@ OSTREAM &operator<<(OSTREAM &os, const Flowpipe &fp)
   return os;
 }
 
+/**
+ * @brief A flowpipe writer printing the flowpipe steps in a stream
+ *
+ * Every step is printed, flushed, and released as soon as it is
+ * written. The printed flowpipe is formatted as by the flowpipe
+ * stream operator once `close()` has been called.
+ *
+ * @tparam OSTREAM is the output stream type
+ */
+template<typename OSTREAM>
+class FlowpipePrinter : public FlowpipeWriter
+{
+  using OF = OutputFormater<OSTREAM>;
+
+  OSTREAM &_os; //!< the output stream
+  bool _empty;  //!< a flag to state whether no step has been printed yet
+
+public:
+  /**
+   * @brief A constructor
+   *
+   * @param os is the output stream
+   */
+  FlowpipePrinter(OSTREAM &os): _os(os), _empty(true)
+  {
+    _os << OF::sequence_begin();
+  }
+
+  /**
+   * @brief Print the next flowpipe step
+   *
+   * @param[in] step is the polytopes union reached in the next epoch
+   */
+  void write(SetsUnion<Polytope> &&step) override
+  {
+    if (_empty) {
+      _empty = false;
+    } else {
+      _os << OF::sequence_separator();
+    }
+
+    _os << step;
+    _os.flush();
+  }
+
+  /**
+   * @brief Terminate the printed flowpipe
+   */
+  void close()
+  {
+    _os << OF::sequence_end();
+  }
+};
+
 #endif // OUTPUTFORMATER_H_
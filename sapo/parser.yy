@@ -106,6 +106,7 @@ std::set<std::string> let_identifiers;
 	DELTA_THICKNESS
 	INTEGRATION_STEP
 	INTEGRATOR
+	INTEGRATOR_MAX_DEGREE
 	REMOVE_DUPLICATE_DIRS
 	REMOVE_UNUSED_DIRS
 	PSPLITS
@@ -1461,6 +1462,23 @@ option	: TRANS transType ";"
 		{
 			MISSING_SC(@2);
 		}
+		| INTEGRATOR_MAX_DEGREE NATURAL ";"
+		{
+			if (drv.data.getSpecificationType()==AbsSyn::InputData::DISCRETE) {
+				WARNING(@0,"The dynamics is specified as discrete: the integrator "
+				           "maximum degree will be ignored");
+			} else {
+				drv.data.setIntegratorMaxDegree($2);
+			}
+		}
+		| INTEGRATOR_MAX_DEGREE NATURAL error
+		{
+			MISSING_SC(@3);
+		}
+		| INTEGRATOR_MAX_DEGREE error
+		{
+			MISSING_SC(@2);
+		}
 		| REMOVE_DUPLICATE_DIRS ";"
 		{
 			drv.data.setRemoveDuplicateDirs(true);
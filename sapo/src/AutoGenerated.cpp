@@ -251,8 +251,107 @@ SetsUnion<Polytope> getParameterSet(const InputData &id)
   return SetsUnion<Polytope>(Polytope(pA, pb));
 }
 
+PolynomialODEIntegrator::domain_type<double>
+get_truncation_domain(const InputData &id, const Bundle &init_set,
+                      const SetsUnion<Polytope> &param_set)
+{
+  using namespace SymbolicAlgebra;
+
+  PolynomialODEIntegrator::domain_type<double> domain;
+
+  // the variables range over the box of the initial set
+  const auto variables = id.getVarSymbols();
+  const BoundingBox init_box = init_set.bounding_box();
+  for (size_t i = 0; i < variables.size(); ++i) {
+    domain.emplace(variables[i],
+                   Interval<double>(init_box.lower_corner()[i],
+                                    init_box.upper_corner()[i]));
+  }
+
+  const auto parameters = id.getParamSymbols();
+  if (parameters.size() == 0) {
+    return domain;
+  }
+
+  if (param_set.size() == 0) {
+    std::cerr << "The parameter set is required to truncate the "
+              << "integrated dynamics" << std::endl;
+    exit(1);
+  }
+
+  // the parameters range over the box of the parameter set
+  LinearAlgebra::Vector<double> lower, upper;
+  for (const auto &P: param_set) {
+    const BoundingBox P_box = P.bounding_box();
+    if (lower.size() == 0) {
+      lower = P_box.lower_corner();
+      upper = P_box.upper_corner();
+    } else {
+      for (size_t i = 0; i < parameters.size(); ++i) {
+        lower[i] = std::min(lower[i], P_box.lower_corner()[i]);
+        upper[i] = std::max(upper[i], P_box.upper_corner()[i]);
+      }
+    }
+  }
+
+  for (size_t i = 0; i < parameters.size(); ++i) {
+    domain.emplace(parameters[i], Interval<double>(lower[i], upper[i]));
+  }
+
+  return domain;
+}
+
+SetsUnion<Polytope> add_remainder_parameters(
+    const SetsUnion<Polytope> &param_set, const size_t num_of_parameters,
+    const std::vector<SymbolicAlgebra::Symbol<>> &parameters,
+    const PolynomialODEIntegrator::domain_type<double> &remainders)
+{
+  if (parameters.size() == num_of_parameters) {
+    return param_set;
+  }
+
+  std::list<Polytope> sets;
+  if (param_set.size() == 0) {
+    sets.emplace_back(std::vector<LinearAlgebra::Vector<double>>(),
+                      LinearAlgebra::Vector<double>());
+  } else {
+    sets.assign(std::begin(param_set), std::end(param_set));
+  }
+
+  for (auto &P: sets) {
+    std::vector<LinearAlgebra::Vector<double>> A;
+    LinearAlgebra::Vector<double> b;
+
+    // extend the original constraints to the remainder parameters
+    for (size_t i = 0; i < P.size(); ++i) {
+      A.push_back(P.A(i));
+      A.back().resize(parameters.size(), 0);
+      b.push_back(P.b(i));
+    }
+
+    // bound every remainder parameter by its interval
+    for (size_t j = num_of_parameters; j < parameters.size(); ++j) {
+      const auto &remainder = remainders.at(parameters[j]);
+
+      A.emplace_back(parameters.size(), 0);
+      A.back()[j] = 1;
+      b.push_back(remainder.upper());
+
+      A.emplace_back(parameters.size(), 0);
+      A.back()[j] = -1;
+      b.push_back(-remainder.lower());
+    }
+
+    P = Polytope(std::move(A), std::move(b));
+  }
+
+  return SetsUnion<Polytope>(std::move(sets));
+}
+
 DiscreteSystem<double> get_integrated_dynamics(const InputData &id,
-                                               const ODE<double> &ode)
+                                               const ODE<double> &ode,
+                                               const Bundle &init_set,
+                                               SetsUnion<Polytope> &param_set)
 {
   if (!id.isIntegrationStepSet()) {
     std::cerr << "Integration step is required for ODEs" << std::endl;
@@ -267,6 +366,30 @@ DiscreteSystem<double> get_integrated_dynamics(const InputData &id,
     integrator_type = InputData::EULER;
   }
 
+  const unsigned int max_degree = id.getIntegratorMaxDegree();
+  PolynomialODEIntegrator::domain_type<double> domain, remainders;
+  if (max_degree > 0) {
+    if (integrator_type != InputData::POLYNOMIAL_RUNGE_KUTTA_4
+        && integrator_type != InputData::TAYLOR_4) {
+      std::cerr << "The integrator maximum degree requires a polynomial "
+                << "integrator" << std::endl;
+      exit(1);
+    }
+
+    // the remainder parameters would be refined by the synthesis
+    if (id.getProblem() == problemType::SYNTH) {
+      std::cerr << "The integrator maximum degree is not supported "
+                << "by parameter synthesis" << std::endl;
+      exit(1);
+    }
+
+    std::cerr << "Warning: the truncation error is bounded exclusively "
+              << "inside the boxes of the initial and parameter sets"
+              << std::endl;
+
+    domain = get_truncation_domain(id, init_set, param_set);
+  }
+
   switch (integrator_type) {
   case InputData::EULER: {
     EulerIntegrator euler;
@@ -276,6 +399,22 @@ DiscreteSystem<double> get_integrated_dynamics(const InputData &id,
     RungeKutta4Integrator rk4;
     return rk4(ode, id.getIntegrationStep());
   }
+  case InputData::POLYNOMIAL_RUNGE_KUTTA_4: {
+    PolynomialRungeKutta4Integrator poly_rk4(max_degree);
+    auto ds = poly_rk4(ode, id.getIntegrationStep(), domain, remainders);
+
+    param_set = add_remainder_parameters(param_set, id.getParamNum(),
+                                         ds.parameters(), remainders);
+    return ds;
+  }
+  case InputData::TAYLOR_4: {
+    TaylorIntegrator taylor4(4, max_degree);
+    auto ds = taylor4(ode, id.getIntegrationStep(), domain, remainders);
+
+    param_set = add_remainder_parameters(param_set, id.getParamNum(),
+                                         ds.parameters(), remainders);
+    return ds;
+  }
   default:
     throw std::runtime_error("Unsupported integrator");
   }
@@ -325,7 +464,8 @@ Model *get_model(const InputData &id)
     SymbolicAlgebra::Symbol time("time");
     ODE<double> ode(variables, parameters, dynamics, time);
 
-    DiscreteSystem<double> ds = get_integrated_dynamics(id, ode);
+    DiscreteSystem<double> ds
+        = get_integrated_dynamics(id, ode, init_set, param_set);
 
     for (size_t i = 0; i < variables.size(); ++i) {
       if (getDegree(ds.dynamics()[i], id.getParamSymbols()) > 1) {
@@ -11,7 +11,10 @@ namespace AbsSyn
 {
 
 InputData::InputData():
-    available_integrators{{"euler", EULER}, {"runge_kutta4", RUNGE_KUTTA_4}},
+    available_integrators{{"euler", EULER},
+                          {"runge_kutta4", RUNGE_KUTTA_4},
+                          {"polynomial_runge_kutta4", POLYNOMIAL_RUNGE_KUTTA_4},
+                          {"taylor4", TAYLOR_4}},
     problem(problemType::P_UNDEF), varMode(modeType::M_UNDEF),
     paramMode(modeType::M_UNDEF), iterations(0), iter_set(false),
     max_k_induction(0), delta_thickness_threshold(0),
@@ -24,7 +27,8 @@ InputData::InputData():
     trans(transType::T_UNDEF), compose_dynamic(false), dynamic_degree(1),
     approx_type(Sapo::NO_APPROX), bern_caching(true), all_dirs_adaptive(false),
     use_invariant_directions(false), integration_step(), integrator_type(),
-    remove_duplicate_dirs(false), remove_unused_dirs(false)
+    integrator_max_degree(0), remove_duplicate_dirs(false),
+    remove_unused_dirs(false)
 {
 }
 
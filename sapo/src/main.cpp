@@ -12,6 +12,7 @@
 #include <sstream>
 
 #include <SapoThreads.h>
+#include <BinaryFlowpipe.h>
 #include <Bundle.h>
 #include <Sapo.h>
 #include <Version.h>
@@ -113,17 +114,22 @@ void reach_analysis(OSTREAM &os, Sapo &sapo, const Model *model,
         sapo.time_horizon, BAR_LENGTH, std::ref(std::cerr));
   }
 
+  // print the flowpipe steps as soon as they are computed
+  FlowpipePrinter<OSTREAM> printer(os);
+
   // if the model does not specify any parameter set
   if (model->parameters().size() == 0) {
 
     // perform the reachability analysis
-    os << sapo.reach(*(model->initial_set()), sapo.time_horizon, accounter);
+    sapo.reach(*(model->initial_set()), sapo.time_horizon, printer,
+               accounter);
   } else {
 
     // perform the parametric reachability analysis
-    os << sapo.reach(*(model->initial_set()), model->parameter_set(),
-                     sapo.time_horizon, accounter);
+    sapo.reach(*(model->initial_set()), model->parameter_set(),
+               sapo.time_horizon, printer, accounter);
   }
+  printer.close();
 
   os << OF::field_end() << OF::object_footer() << OF::list_end()
      << OF::field_end() << OF::object_footer();
@@ -133,6 +139,47 @@ void reach_analysis(OSTREAM &os, Sapo &sapo, const Model *model,
   }
 }
 
+void binary_reach_analysis(std::ostream &os, Sapo &sapo, const Model *model,
+                           const bool display_progress)
+{
+  ProgressAccounter *accounter = NULL;
+  if (display_progress) {
+    accounter = (ProgressAccounter *)new ProgressBar(
+        sapo.time_horizon, BAR_LENGTH, std::ref(std::cerr));
+  }
+
+  try {
+    // write the flowpipe steps as soon as they are computed
+    BinaryFlowpipeWriter writer(os);
+
+    // if the model does not specify any parameter set
+    if (model->parameters().size() == 0) {
+
+      // perform the reachability analysis
+      sapo.reach(*(model->initial_set()), sapo.time_horizon, writer,
+                 accounter);
+    } else {
+
+      // perform the parametric reachability analysis
+      sapo.reach(*(model->initial_set()), model->parameter_set(),
+                 sapo.time_horizon, writer, accounter);
+    }
+    writer.close();
+  } catch (std::exception &e) {
+    if (display_progress) {
+      std::cerr << std::endl;
+    }
+
+    std::cerr << e.what() << std::endl;
+
+    exit(EXIT_FAILURE);
+  }
+
+  if (display_progress) {
+    delete accounter;
+  }
+}
+
 template<typename OSTREAM>
 void output_synthesis(OSTREAM &os, const Model *model,
                       const std::list<SetsUnion<Polytope>> &synth_params,
@@ -348,12 +395,15 @@ void perform_computation_and_get_output(OSTREAM &os, Sapo &sapo,
   }
 }
 
+enum output_format { TEXT_OUTPUT, JSON_OUTPUT, BINARY_OUTPUT };
+
 struct prog_opts {
   std::string input_filename;
-  bool JSON_output;
+  output_format format;
   bool get_help;
   bool progress;
   unsigned int num_of_threads;
+  std::string Bernstein_cache_filename;
 };
 
 void print_help(std::ostream &os, const std::string exec_name)
@@ -362,6 +412,10 @@ void print_help(std::ostream &os, const std::string exec_name)
      << "Usage: " << exec_name << " [options] [input filename]" << std::endl
      << "Options:" << std::endl
      << "  -j\t\t\t\tGet the output in JSON format" << std::endl
+     << "  -f [format]\t\t\tGet the output in the format [format]: "
+     << "either" << std::endl
+     << "\t\t\t\t  \"text\", \"JSON\", or \"binary\" (reachability "
+     << "only)" << std::endl
 #ifdef WITH_THREADS
      << "  -t [num of active threads]\tEnable multi-threading and set the "
      << "number of " << std::endl
@@ -369,6 +423,9 @@ void print_help(std::ostream &os, const std::string exec_name)
      << std::thread::hardware_concurrency() << ")" << std::endl
 #endif
      << "  -b\t\t\t\tDisplay a progress bar" << std::endl
+     << "  --bernstein-cache [filename]\tLoad the Bernstein coefficients "
+     << "from, and save" << std::endl
+     << "\t\t\t\t  them in, the cache file [filename]" << std::endl
      << "  -h\t\t\t\tPrint this help" << std::endl
      << std::endl
      << "If either the filename is \"-\" or no filename is provided, "
@@ -398,13 +455,41 @@ void parser_option(prog_opts &opts, const int argc, char **argv, int &arg_pos)
     return;
   }
   if (std::string("-j") == argv_str) {
-    opts.JSON_output = true;
+    opts.format = JSON_OUTPUT;
+    return;
+  }
+  if (std::string("-f") == argv_str) {
+    const std::string format = (arg_pos + 1 < argc ? argv[++arg_pos] : "");
+    if (format == "text") {
+      opts.format = TEXT_OUTPUT;
+    } else if (format == "JSON" || format == "json") {
+      opts.format = JSON_OUTPUT;
+    } else if (format == "binary") {
+      opts.format = BINARY_OUTPUT;
+    } else {
+      std::cerr << "Syntax error: unknown output format \"" << format
+                << "\"" << std::endl;
+      print_help(std::cerr, argv[0]);
+
+      exit(EXIT_FAILURE);
+    }
     return;
   }
   if (std::string("-b") == argv_str) {
     opts.progress = true;
     return;
   }
+  if (std::string("--bernstein-cache") == argv_str) {
+    if (arg_pos + 1 >= argc) {
+      std::cerr << "Syntax error: missing Bernstein cache filename"
+                << std::endl;
+      print_help(std::cerr, argv[0]);
+
+      exit(EXIT_FAILURE);
+    }
+    opts.Bernstein_cache_filename = argv[++arg_pos];
+    return;
+  }
 #ifdef WITH_THREADS
   if (std::string("-t") == argv_str) {
     if (arg_pos + 1 < argc && is_number(argv[arg_pos + 1])) {
@@ -414,8 +499,6 @@ void parser_option(prog_opts &opts, const int argc, char **argv, int &arg_pos)
     }
     return;
   }
-#else
-  (void)argc;
 #endif
 
   opts.input_filename = argv_str;
@@ -423,12 +506,12 @@ void parser_option(prog_opts &opts, const int argc, char **argv, int &arg_pos)
 
 prog_opts parse_opts(const int argc, char **argv)
 {
-  prog_opts opts = {"-", false, false, false, 1};
+  prog_opts opts = {"-", TEXT_OUTPUT, false, false, 1, ""};
 
 #ifdef WITH_THREADS
-  if (argc > 6) {
+  if (argc > 10) {
 #else
-  if (argc > 4) {
+  if (argc > 8) {
 #endif
     std::cerr << "Syntax error: Too many parameters" << std::endl;
     print_help(std::cerr, argv[0]);
@@ -468,6 +551,13 @@ int main(int argc, char **argv)
     exit(EXIT_FAILURE);
   }
 
+  if (opts.format == BINARY_OUTPUT
+      && drv.data.getProblem() != AbsSyn::problemType::REACH) {
+    std::cerr << "The binary output is available exclusively for "
+              << "reachability analysis" << std::endl;
+    exit(EXIT_FAILURE);
+  }
+
   Model *model = get_model(drv.data);
 
   if (model==nullptr) {
@@ -480,15 +570,38 @@ int main(int argc, char **argv)
   Sapo sapo = init_sapo(model, drv.data, 0);
 #endif
 
-  if (opts.JSON_output) {
+  if (opts.Bernstein_cache_filename != "") {
+    try {
+      sapo.evolver()->load_Bernstein_cache(opts.Bernstein_cache_filename);
+    } catch (std::exception &e) {
+      std::cerr << "Warning: ignoring the Bernstein cache \""
+                << opts.Bernstein_cache_filename << "\": " << e.what()
+                << std::endl;
+    }
+  }
+
+  switch (opts.format) {
+  case JSON_OUTPUT: {
     JSON::ostream os(std::cout);
     perform_computation_and_get_output(os, sapo, model, drv.data.getProblem(),
                                        opts.progress);
-  } else {
+  } break;
+  case BINARY_OUTPUT:
+    binary_reach_analysis(std::cout, sapo, model, opts.progress);
+    break;
+  default:
     perform_computation_and_get_output(std::cout, sapo, model,
                                        drv.data.getProblem(), opts.progress);
   }
 
+  if (opts.Bernstein_cache_filename != "") {
+    try {
+      sapo.evolver()->save_Bernstein_cache(opts.Bernstein_cache_filename);
+    } catch (std::exception &e) {
+      std::cerr << "Warning: " << e.what() << std::endl;
+    }
+  }
+
   delete model;
 
   exit(EXIT_SUCCESS);